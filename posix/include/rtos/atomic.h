@@ -9,6 +9,7 @@
 #define __SOF_ATOMIC_H__
 
 #include <arch/atomic.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 static inline void atomic_init(atomic_t *a, int32_t value)
@@ -36,4 +37,16 @@ static inline int32_t atomic_sub(atomic_t *a, int32_t value)
 	return arch_atomic_sub(a, value);
 }
 
+/* sets a to new_value if it is old_value, returns true if it was */
+static inline bool atomic_cas(atomic_t *a, int32_t old_value, int32_t new_value)
+{
+	return arch_atomic_cas(a, old_value, new_value);
+}
+
+/* returns the value before the OR, like the Zephyr API */
+static inline int32_t atomic_or(atomic_t *a, int32_t value)
+{
+	return arch_atomic_or(a, value);
+}
+
 #endif /* __SOF_ATOMIC_H__ */
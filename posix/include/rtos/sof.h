@@ -23,7 +23,7 @@ struct ll_schedule_domain;
 struct mm;
 struct mn;
 struct ams_shared_context;
-struct notify_data;
+struct notify_queue;
 struct pm_runtime_data;
 struct sa;
 struct timer;
@@ -81,8 +81,8 @@ struct sof {
 	struct ams_shared_context *ams_shared_ctx;
 #endif
 
-	/* shared notifier data */
-	struct notify_data *notify_data;
+	/* notifier event queues, one per core */
+	struct notify_queue *notify_queue;
 
 	/* platform dai information */
 	const struct dai_info *dai_info;
@@ -78,6 +78,7 @@ def main():
 	command = [args.command]
 
 	executable = []
+	lazy = []
 	writable = []
 	readonly = []
 	readonly_dram = []
@@ -112,6 +113,8 @@ def main():
 				text_addr = max_alignment(text_addr, 0x1000, s_alignment)
 				text_size = s_size
 				command.append(f'-Wl,-Ttext=0x{text_addr:x}')
+			elif s_name.startswith('.lazy'):
+				lazy.append(section)
 			else:
 				executable.append(section)
 
@@ -182,7 +185,28 @@ def main():
 
 		dram_addr += section.header['sh_size']
 
-	start_addr = align_up(text_addr + text_size, 0x1000)
+	# Code, only used after the module has been prepared, is linked in SRAM
+	# directly after .text, starting on a new page. Those pages are only
+	# mapped and populated when needed. The LLEXT manager looks for .lazy
+	# and .lazy.literal sections.
+	start_addr = text_addr + text_size
+	first_lazy = None
+
+	for section in lazy:
+		s_alignment = section.header['sh_addralign']
+		s_name = section.name
+
+		if not first_lazy:
+			first_lazy = s_name
+			start_addr = align_up(start_addr, 0x1000)
+
+		start_addr = align_up(start_addr, s_alignment)
+
+		command.append(f'-Wl,--section-start={s_name}=0x{start_addr:x}')
+
+		start_addr += section.header['sh_size']
+
+	start_addr = align_up(start_addr, 0x1000)
 
 	for section in readonly:
 		s_alignment = section.header['sh_addralign']
@@ -220,6 +244,8 @@ def main():
 		copy_command.extend(['--set-section-alignment', f'{first_dram_text}=4096'])
 	if first_dram_rodata:
 		copy_command.extend(['--set-section-alignment', f'{first_dram_rodata}=4096'])
+	if first_lazy:
+		copy_command.extend(['--set-section-alignment', f'{first_lazy}=4096'])
 
 	copy_command.extend([f'{args.file}.tmp', f'{args.output}'])
 	subprocess.run(copy_command)
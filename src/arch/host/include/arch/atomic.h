@@ -11,6 +11,7 @@
 #ifndef __ARCH_ATOMIC_H__
 #define __ARCH_ATOMIC_H__
 
+#include <stdbool.h>
 #include <stdint.h>
 
 typedef struct {
@@ -44,6 +45,17 @@ static inline int32_t arch_atomic_sub(atomic_t *a, int32_t value)
 	return __atomic_sub_fetch(&a->value, value, __ATOMIC_SEQ_CST);
 }
 
+static inline bool arch_atomic_cas(atomic_t *a, int32_t old_value, int32_t new_value)
+{
+	return __atomic_compare_exchange_n(&a->value, &old_value, new_value, false,
+					   __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+static inline int32_t arch_atomic_or(atomic_t *a, int32_t value)
+{
+	return __atomic_fetch_or(&a->value, value, __ATOMIC_SEQ_CST);
+}
+
 #elif defined __XCC__
 
 /* fake locking: obviously this does nothing, and provides no real locking */
@@ -89,6 +101,30 @@ static inline int32_t arch_atomic_sub(atomic_t *a, int32_t value)
 	return tmp;
 }
 
+static inline bool arch_atomic_cas(atomic_t *a, int32_t old_value, int32_t new_value)
+{
+	bool ret = false;
+
+	lock();
+	if (a->value == old_value) {
+		a->value = new_value;
+		ret = true;
+	}
+	unlock();
+	return ret;
+}
+
+static inline int32_t arch_atomic_or(atomic_t *a, int32_t value)
+{
+	int32_t tmp;
+
+	lock();
+	tmp = a->value;
+	a->value |= value;
+	unlock();
+	return tmp;
+}
+
 #else
 
 #error "Not gcc, not xt-xcc"
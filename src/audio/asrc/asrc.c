@@ -252,32 +252,28 @@ static int asrc_initialize_buffers(struct processing_module *mod, struct asrc_fa
 	 * missing element wise wrap around while loading but allowing
 	 * aligned loads. FIR delay line write is initialized to last
 	 * position of first copy block for reverse direction write.
+	 * The delay lines of all channels are allocated as one block
+	 * so the filter reads them from adjacent memory.
 	 */
 	src_obj->buffer_length = src_obj->filter_length * 2;
 	src_obj->buffer_write_position = src_obj->filter_length - 1;
 
 	if (src_obj->bit_depth == 32) {
 		buffer_size = src_obj->buffer_length * sizeof(int32_t);
+		buf_32 = mod_zalloc(mod, buffer_size * src_obj->num_channels);
+		if (!buf_32)
+			return -ENOMEM;
 
-		for (ch = 0; ch < src_obj->num_channels; ch++) {
-			buf_32 = mod_zalloc(mod, buffer_size);
-
-			if (!buf_32)
-				return -ENOMEM;
-
-			src_obj->ring_buffers32[ch] = buf_32;
-		}
+		for (ch = 0; ch < src_obj->num_channels; ch++)
+			src_obj->ring_buffers32[ch] = buf_32 + ch * src_obj->buffer_length;
 	} else {
 		buffer_size = src_obj->buffer_length * sizeof(int16_t);
+		buf_16 = mod_zalloc(mod, buffer_size * src_obj->num_channels);
+		if (!buf_16)
+			return -ENOMEM;
 
-		for (ch = 0; ch < src_obj->num_channels; ch++) {
-			buf_16 = mod_zalloc(mod, buffer_size);
-
-			if (!buf_16)
-				return -ENOMEM;
-
-			src_obj->ring_buffers16[ch] = buf_16;
-		}
+		for (ch = 0; ch < src_obj->num_channels; ch++)
+			src_obj->ring_buffers16[ch] = buf_16 + ch * src_obj->buffer_length;
 	}
 
 	return 0;
@@ -285,31 +281,25 @@ static int asrc_initialize_buffers(struct processing_module *mod, struct asrc_fa
 
 static void asrc_release_buffers(struct processing_module *mod, struct asrc_farrow *src_obj)
 {
-	int32_t *buf_32;
-	int16_t *buf_16;
+	void *buf = NULL;
 	int ch;
 
 	if (!src_obj)
 		return;
 
-	if (src_obj->bit_depth == 32)
-		for (ch = 0; ch < src_obj->num_channels; ch++) {
-			buf_32 = src_obj->ring_buffers32[ch];
-
-			if (buf_32) {
-				src_obj->ring_buffers32[ch] = NULL;
-				mod_free(mod, buf_32);
-			}
-		}
-	else
-		for (ch = 0; ch < src_obj->num_channels; ch++) {
-			buf_16 = src_obj->ring_buffers16[ch];
+	/* the first channel points to the block of all delay lines */
+	if (src_obj->ring_buffers32) {
+		buf = src_obj->ring_buffers32[0];
+		for (ch = 0; ch < src_obj->num_channels; ch++)
+			src_obj->ring_buffers32[ch] = NULL;
+	} else if (src_obj->ring_buffers16) {
+		buf = src_obj->ring_buffers16[0];
+		for (ch = 0; ch < src_obj->num_channels; ch++)
+			src_obj->ring_buffers16[ch] = NULL;
+	}
 
-			if (buf_16) {
-				src_obj->ring_buffers16[ch] = NULL;
-				mod_free(mod, buf_16);
-			}
-		}
+	if (buf)
+		mod_free(mod, buf);
 }
 
 static int asrc_free(struct processing_module *mod)
@@ -11,15 +11,25 @@
 
 LOG_MODULE_DECLARE(asrc, CONFIG_SOF_LOG_LEVEL);
 
+/*
+ * The filter is applied to blocks of channels. Each impulse response bin
+ * is loaded once per block and multiplied with the delay lines of all
+ * channels of the block, instead of once per channel. The accumulation
+ * order per channel is unchanged so the result is bit exact.
+ */
+#define ASRC_FIR_CH_BLOCK	4
+
 void asrc_fir_filter16(struct asrc_farrow *src_obj, int16_t **output_buffers,
 		       int index_output_frame)
 {
-	int64_t prod;
+	int64_t prod[ASRC_FIR_CH_BLOCK];
+	const int16_t *buffer_p[ASRC_FIR_CH_BLOCK];
+	const int32_t *filter_p = &src_obj->impulse_response[0];
 	int32_t prod32;
-	int16_t prod16;
-	int32_t *filter_p;
-	int16_t *buffer_p;
+	int32_t coef;
+	int ch_count;
 	int ch;
+	int k;
 	int n;
 	int i;
 
@@ -28,46 +38,61 @@ void asrc_fir_filter16(struct asrc_farrow *src_obj, int16_t **output_buffers,
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
-		/* Pointer to the beginning of the impulse response */
-		filter_p = &src_obj->impulse_response[0];
-
-		/* Pointer to the buffered input data */
-		buffer_p = &src_obj->ring_buffers16[ch]
-			[src_obj->buffer_write_position];
+	/* Iterate over the blocks of channels */
+	for (ch = 0; ch < src_obj->num_channels; ch += ch_count) {
+		ch_count = MIN(src_obj->num_channels - ch, ASRC_FIR_CH_BLOCK);
 
-		/* Initialise the accumulator */
-		prod = 0;
+		/* Pointers to the buffered input data, initialise the accumulators */
+		for (k = 0; k < ch_count; k++) {
+			buffer_p[k] = &src_obj->ring_buffers16[ch + k]
+				[src_obj->buffer_write_position];
+			prod[k] = 0;
+		}
 
 		/* Iterate over the filter bins.
 		 * Data is Q1.15, coefficients are Q1.30. Prod will be Qx.45.
 		 */
-		for (n = 0; n < src_obj->filter_length; n++)
-			prod += (int64_t)(*buffer_p++) * (*filter_p++);
-
-		/* Shift left after accumulation, because interim
-		 * results might saturate during filtering prod = prod
-		 * << 1; will shift after last addition
-		 */
-		prod32 = sat_int32(Q_SHIFT(prod, 45, 31));
-
-		/* Round 'prod' to 16 bit and store it in
-		 * (de-)interleaved format in the output buffers
-		 */
-		prod16 = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
-		output_buffers[ch][i] = prod16;
+		if (ch_count == ASRC_FIR_CH_BLOCK) {
+			for (n = 0; n < src_obj->filter_length; n++) {
+				coef = filter_p[n];
+				prod[0] += (int64_t)buffer_p[0][n] * coef;
+				prod[1] += (int64_t)buffer_p[1][n] * coef;
+				prod[2] += (int64_t)buffer_p[2][n] * coef;
+				prod[3] += (int64_t)buffer_p[3][n] * coef;
+			}
+		} else {
+			for (n = 0; n < src_obj->filter_length; n++) {
+				coef = filter_p[n];
+				for (k = 0; k < ch_count; k++)
+					prod[k] += (int64_t)buffer_p[k][n] * coef;
+			}
+		}
+
+		for (k = 0; k < ch_count; k++) {
+			/* Shift left after accumulation, because interim
+			 * results might saturate during filtering prod = prod
+			 * << 1; will shift after last addition
+			 */
+			prod32 = sat_int32(Q_SHIFT(prod[k], 45, 31));
+
+			/* Round 'prod' to 16 bit and store it in
+			 * (de-)interleaved format in the output buffers
+			 */
+			output_buffers[ch + k][i] = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+		}
 	}
 }
 
 void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 		       int index_output_frame)
 {
-	int64_t prod;
-	int32_t prod32;
-	const int32_t *filter_p;
-	int32_t *buffer_p;
+	int64_t prod[ASRC_FIR_CH_BLOCK];
+	const int32_t *buffer_p[ASRC_FIR_CH_BLOCK];
+	const int32_t *filter_p = &src_obj->impulse_response[0];
+	int32_t coef;
+	int ch_count;
 	int ch;
+	int k;
 	int n;
 	int i;
 
@@ -76,17 +101,16 @@ void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 	else
 		i = index_output_frame;
 
-	/* Iterate over each channel */
-	for (ch = 0; ch < src_obj->num_channels; ch++) {
-		/* Pointer to the beginning of the impulse response */
-		filter_p = &src_obj->impulse_response[0];
+	/* Iterate over the blocks of channels */
+	for (ch = 0; ch < src_obj->num_channels; ch += ch_count) {
+		ch_count = MIN(src_obj->num_channels - ch, ASRC_FIR_CH_BLOCK);
 
-		/* Pointer to the buffered input data */
-		buffer_p = &src_obj->ring_buffers32[ch]
-			[src_obj->buffer_write_position];
-
-		/* Initialise the accumulator */
-		prod = 0;
+		/* Pointers to the buffered input data, initialise the accumulators */
+		for (k = 0; k < ch_count; k++) {
+			buffer_p[k] = &src_obj->ring_buffers32[ch + k]
+				[src_obj->buffer_write_position];
+			prod[k] = 0;
+		}
 
 		/* Iterate over the filter bins. Data is Q1.31, coefficients
 		 * are Q1.22. They are down scaled by 1 shift. In addition
@@ -95,19 +119,29 @@ void asrc_fir_filter32(struct asrc_farrow *src_obj, int32_t **output_buffers,
 		 * of 24 bits of 32 bits is not a practical limitation for
 		 * quality. The product is Qx.54.
 		 */
-		for (n = 0; n < src_obj->filter_length; n++)
-			prod += (int64_t)(*buffer_p++) * (*filter_p++ >> 8);
+		if (ch_count == ASRC_FIR_CH_BLOCK) {
+			for (n = 0; n < src_obj->filter_length; n++) {
+				coef = filter_p[n] >> 8;
+				prod[0] += (int64_t)buffer_p[0][n] * coef;
+				prod[1] += (int64_t)buffer_p[1][n] * coef;
+				prod[2] += (int64_t)buffer_p[2][n] * coef;
+				prod[3] += (int64_t)buffer_p[3][n] * coef;
+			}
+		} else {
+			for (n = 0; n < src_obj->filter_length; n++) {
+				coef = filter_p[n] >> 8;
+				for (k = 0; k < ch_count; k++)
+					prod[k] += (int64_t)buffer_p[k][n] * coef;
+			}
+		}
 
 		/* Shift left after accumulation, because interim
 		 * results might saturate during filtering prod = prod
-		 * << 1; will shift after last addition
-		 */
-		prod32 = sat_int32(Q_SHIFT(prod, 53, 31));
-
-		/* Store 'prod' in (de-)interleaved format in the output
-		 * buffers
+		 * << 1; will shift after last addition. Store 'prod' in
+		 * (de-)interleaved format in the output buffers.
 		 */
-		output_buffers[ch][i] = prod32;
+		for (k = 0; k < ch_count; k++)
+			output_buffers[ch + k][i] = sat_int32(Q_SHIFT(prod[k], 53, 31));
 	}
 }
 
@@ -17,6 +17,7 @@
 #include <sof_versions.h>
 #include <sof/lib/cpu-clk-manager.h>
 #include <sof/lib/cpu.h>
+#include <sof/lib/heap_stats.h>
 #include <sof/platform.h>
 #include <sof/lib_manager.h>
 #include <rtos/clk.h>
@@ -657,6 +658,24 @@ __cold static int io_global_perf_data_get(uint32_t *data_off_size, char *data)
 #endif
 }
 
+__cold static int basefw_heap_stats_get(uint32_t *data_offset, char *data)
+{
+	assert_can_be_cold();
+
+#if CONFIG_SOF_HEAP_STATS
+	struct ipc4_heap_stats_info *info = (struct ipc4_heap_stats_info *)data;
+	unsigned int max = (SOF_IPC_MSG_MAX_SIZE - sizeof(*info)) /
+			   sizeof(struct heap_stats_record);
+
+	info->heap_count = heap_stats_get((struct heap_stats_record *)info->heaps, max);
+	*data_offset = sizeof(*info) + info->heap_count * sizeof(struct heap_stats_record);
+
+	return IPC4_SUCCESS;
+#else
+	return IPC4_UNAVAILABLE;
+#endif
+}
+
 __cold static int io_perf_monitor_state_set(uint32_t data_size, const uint8_t *data)
 {
 	assert_can_be_cold();
@@ -719,6 +738,8 @@ __cold static int basefw_get_large_config(struct comp_dev *dev, uint32_t param_i
 		return io_global_perf_state_get(data_offset, data);
 	case IPC4_IO_GLOBAL_PERF_DATA:
 		return io_global_perf_data_get(data_offset, data);
+	case IPC4_HEAP_STATS_GET:
+		return basefw_heap_stats_get(data_offset, data);
 
 	/* TODO: add more support */
 	case IPC4_DSP_RESOURCE_STATE:
@@ -41,6 +41,7 @@
 #include "host_copier.h"
 #include "dai_copier.h"
 #include "ipcgtw_copier.h"
+#include "copier_gain.h"
 #if CONFIG_INTEL_ADSP_MIC_PRIVACY
 #include <zephyr/drivers/mic_privacy/intel/mic_privacy.h>
 #endif
@@ -889,6 +890,7 @@ __cold static int set_chmap(struct comp_dev *dev, const void *data, size_t data_
 	struct ipc4_audio_format out_fmt = cd->config.out_fmt;
 	pcm_converter_func process;
 	pcm_converter_func converters[IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT];
+	copier_gain_converter_func gain_converter = NULL;
 	int i;
 #ifndef CONFIG_SOF_USERSPACE_LL
 	uint32_t irq_flags;
@@ -930,6 +932,11 @@ __cold static int set_chmap(struct comp_dev *dev, const void *data, size_t data_
 		return -EINVAL;
 	}
 
+	/* the fused conversion and gain has no channel map, NULL for a remapping one */
+	if (cd->endpoint_num == 1 && cd->dd[0]->gain_data)
+		gain_converter = get_converter_gain_func(&in_fmt, &out_fmt, cd->gtw_type, dir,
+							 chmap_cfg->channel_map);
+
 	/* Channel map is same for all sinks. However, as sinks allowed to have different
 	 * sample formats, get new convert/remap function for each sink.
 	 */
@@ -958,6 +965,8 @@ __cold static int set_chmap(struct comp_dev *dev, const void *data, size_t data_
 
 	cd->dd[0]->chmap = chmap_cfg->channel_map;
 	cd->dd[0]->process = process;
+	if (cd->dd[0]->gain_data)
+		cd->dd[0]->gain_data->converter = gain_converter;
 	for (i = 0; i < IPC4_COPIER_MODULE_OUTPUT_PINS_COUNT; i++)
 		cd->converter[i] = converters[i];
 
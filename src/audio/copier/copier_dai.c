@@ -595,6 +595,12 @@ int copier_dai_params(struct copier_data *cd, struct comp_dev *dev,
 		cd->dd[0]->process =
 			get_converter_func(&in_fmt, &out_fmt, cd->gtw_type, dir, cd->dd[0]->chmap);
 
+		/* conversion and gain run in one pass when a fused function exists */
+		if (cd->dd[0]->gain_data)
+			cd->dd[0]->gain_data->converter =
+				get_converter_gain_func(&in_fmt, &out_fmt, cd->gtw_type, dir,
+							cd->dd[0]->chmap);
+
 		return ret;
 	}
 
@@ -86,6 +86,48 @@ int copier_gain_input(struct comp_dev *dev, struct comp_buffer *buff,
 	}
 }
 
+int copier_gain_copy_from_no_consume(struct comp_dev *dev, struct comp_buffer *source,
+				     struct comp_buffer *sink,
+				     struct copier_gain_params *gain_params,
+				     enum copier_gain_envelope_dir dir, uint32_t source_bytes)
+{
+	struct audio_stream *istream = &source->stream;
+	uint32_t channels = audio_stream_get_channels(istream);
+	uint32_t samples = source_bytes / audio_stream_sample_bytes(istream);
+	uint32_t sink_bytes = samples * audio_stream_sample_bytes(&sink->stream);
+	enum copier_gain_state state = copier_gain_eval_state(gain_params);
+
+	comp_dbg(dev, "copier selected gain state %d", state);
+
+	/* convert and apply gain in one pass over the data */
+	struct cir_buf_source cir_src = {
+		.buf_start = audio_stream_get_addr(istream),
+		.buf_end = audio_stream_get_end_addr(istream),
+		.ptr = audio_stream_get_rptr(istream),
+	};
+	struct cir_buf_sink cir_snk = {
+		.buf_start = audio_stream_get_addr(&sink->stream),
+		.buf_end = audio_stream_get_end_addr(&sink->stream),
+		.ptr = audio_stream_get_wptr(&sink->stream),
+	};
+
+	gain_params->converter(&cir_src, &cir_snk, samples, channels, gain_params, state, dir);
+	copier_gain_update_state(gain_params, state, dir, samples / channels);
+
+#if CONFIG_INTEL_ADSP_MIC_PRIVACY
+	struct copier_data *cd = module_get_private_data(comp_mod(dev));
+
+	if (cd->mic_priv)
+		mic_privacy_process(dev, cd->mic_priv, sink, samples);
+#endif
+
+	buffer_stream_writeback(sink, sink_bytes);
+
+	comp_update_buffer_produce(sink, sink_bytes);
+
+	return 0;
+}
+
 enum copier_gain_state copier_gain_eval_state(struct copier_gain_params *gain_params)
 {
 	enum copier_gain_state state = STATIC_GAIN;
@@ -74,6 +74,43 @@ enum copier_gain_envelope_dir {
 	GAIN_SUBTRACT, /**< gain envelope subtract direction */
 };
 
+struct copier_gain_params;
+
+/**
+ * @brief Fused PCM conversion and gain function.
+ *
+ * Converts samples from the source to the sink format and applies the gain of
+ * the given state to every sample before it is written to the sink, so the
+ * data is read and written only once. The gain state itself is not updated.
+ *
+ * @param source Source circular buffer descriptor.
+ * @param sink Sink circular buffer descriptor.
+ * @param samples The number of samples to be processed.
+ * @param channels The number of channels, the same in source and sink.
+ * @param gain_params The pointer to the copier_gain_params structure.
+ * @param state The state of the gain processing.
+ * @param dir Direction of the gain envelope change.
+ */
+typedef void (*copier_gain_converter_func)(const struct cir_buf_source *source,
+					   struct cir_buf_sink *sink, size_t samples,
+					   uint32_t channels,
+					   const struct copier_gain_params *gain_params,
+					   enum copier_gain_state state,
+					   enum copier_gain_envelope_dir dir);
+
+/**
+ * @brief Fused conversion function for a pair of frame formats.
+ */
+struct copier_gain_func_map {
+	enum sof_ipc_frame source;		/**< source frame format */
+	enum sof_ipc_frame sink;		/**< sink frame format */
+	copier_gain_converter_func func;	/**< fused conversion and gain function */
+};
+
+extern const struct copier_gain_func_map copier_gain_func_map[];
+
+extern const size_t copier_gain_func_count;
+
 /**
  * @brief Structure representing the parameters for copier gain processing.
  */
@@ -101,6 +138,7 @@ struct copier_gain_params {
 	uint64_t gain_env;  /**< Gain envelope for fade-in calculated in high precision */
 	uint64_t step_i64;  /**< Step for fade-in envelope in high precision */
 	uint16_t channels_count; /**< Number of channels */
+	copier_gain_converter_func converter; /**< Fused conversion, NULL if not available */
 };
 
 /** Gain Coefficients IO Control
@@ -202,6 +240,47 @@ int copier_gain_input(struct comp_dev *dev, struct comp_buffer *buff,
 		      struct copier_gain_params *gain_params,
 		      enum copier_gain_envelope_dir dir, uint32_t stream_bytes);
 
+/**
+ * @brief Converts and applies gain in one pass, without consuming the source.
+ *
+ * This function is used instead of stream_copy_from_no_consume() followed by
+ * copier_gain_input() when a fused conversion function has been selected for
+ * the source and sink formats. Source and sink must have the same number of
+ * channels.
+ *
+ * @param dev The pointer to the comp_dev structure representing the audio component device.
+ * @param source The pointer to the source buffer.
+ * @param sink The pointer to the sink buffer.
+ * @param gain_params The pointer to the copier_gain_params structure.
+ * @param dir Direction of the gain envelope change.
+ * @param source_bytes The number of bytes to be copied from the source.
+ * @return 0 on success, negative error code on failure.
+ */
+int copier_gain_copy_from_no_consume(struct comp_dev *dev, struct comp_buffer *source,
+				     struct comp_buffer *sink,
+				     struct copier_gain_params *gain_params,
+				     enum copier_gain_envelope_dir dir, uint32_t source_bytes);
+
+/**
+ * @brief Selects the fused conversion and gain function.
+ *
+ * Formats are resolved like in get_converter_func(). Fused functions exist only
+ * for plain conversions between 16 and 32 bit containers without channel
+ * remapping, for at most MAX_GAIN_COEFFS_CNT channels.
+ *
+ * @param in_fmt Input audio format.
+ * @param out_fmt Output audio format.
+ * @param type Gateway type.
+ * @param dir Stream direction.
+ * @param chmap Channel map.
+ * @return Fused function or NULL if there is none for the formats.
+ */
+copier_gain_converter_func get_converter_gain_func(const struct ipc4_audio_format *in_fmt,
+						   const struct ipc4_audio_format *out_fmt,
+						   enum ipc4_gateway_type type,
+						   enum ipc4_direction_type dir,
+						   uint32_t chmap);
+
 /**
  * Evaluates appropriate gain mode based on the current gain parameters
  *
@@ -210,6 +289,30 @@ int copier_gain_input(struct comp_dev *dev, struct comp_buffer *buff,
  */
 enum copier_gain_state copier_gain_eval_state(struct copier_gain_params *gain_params);
 
+/**
+ * Advances the silence and fade counters and the gain envelope after frames
+ * have been processed in the given state.
+ *
+ * @param gain_params The pointer to the copier_gain_params structure.
+ * @param state The state the frames were processed in.
+ * @param dir Direction of the gain envelope change.
+ * @param frames The number of frames processed.
+ */
+static inline void copier_gain_update_state(struct copier_gain_params *gain_params,
+					    enum copier_gain_state state,
+					    enum copier_gain_envelope_dir dir, uint32_t frames)
+{
+	if (state == MUTE) {
+		gain_params->silence_sg_count += frames;
+	} else if (state == TRANS_GAIN) {
+		gain_params->fade_in_sg_count += frames;
+		if (dir == GAIN_ADD)
+			gain_params->gain_env += gain_params->step_i64 * frames;
+		else
+			gain_params->gain_env -= gain_params->step_i64 * frames;
+	}
+}
+
 /**
  * Sets/modify gain for a copier module in runtime.
  *
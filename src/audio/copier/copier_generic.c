@@ -11,6 +11,7 @@
 #include <sof/common.h>
 #include <ipc/dai.h>
 #include "copier.h"
+#include "copier_gain.h"
 
 LOG_MODULE_DECLARE(copier, CONFIG_SOF_LOG_LEVEL);
 
@@ -23,7 +24,6 @@ LOG_MODULE_DECLARE(copier, CONFIG_SOF_LOG_LEVEL);
 #include <stddef.h>
 #include <errno.h>
 #include <stdint.h>
-#include "copier_gain.h"
 
 int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 		      struct comp_buffer *sink, int frame)
@@ -189,15 +189,7 @@ int copier_gain_input16(struct comp_buffer *buff, enum copier_gain_state state,
 		break;
 	}
 
-	if (state == MUTE) {
-		gain_params->silence_sg_count += frames;
-	} else if (state == TRANS_GAIN) {
-		gain_params->fade_in_sg_count += frames;
-		if (dir == GAIN_ADD)
-			gain_params->gain_env += gain_params->step_i64 * frames;
-		else
-			gain_params->gain_env -= gain_params->step_i64 * frames;
-	}
+	copier_gain_update_state(gain_params, state, dir, frames);
 
 	return 0;
 }
@@ -280,15 +272,7 @@ int copier_gain_input32(struct comp_buffer *buff, enum copier_gain_state state,
 		break;
 	}
 
-	if (state == MUTE) {
-		gain_params->silence_sg_count += frames;
-	} else if (state == TRANS_GAIN) {
-		gain_params->fade_in_sg_count += frames;
-		if (dir == GAIN_ADD)
-			gain_params->gain_env += gain_params->step_i64 * frames;
-		else
-			gain_params->gain_env -= gain_params->step_i64 * frames;
-	}
+	copier_gain_update_state(gain_params, state, dir, frames);
 
 	return 0;
 }
@@ -303,6 +287,178 @@ bool copier_is_unity_gain(struct copier_gain_params *gain_params)
 	return true;
 }
 
+/* Gain of each channel in Q10 format, constant for one call of a fused function */
+static void copier_gain_channel_coeffs(const struct copier_gain_params *gain_params,
+				       enum copier_gain_state state, int16_t *gain)
+{
+	int16_t gain_env_i16 = gain_params->gain_env >> I64_TO_I16_SHIFT;
+	int16_t gain_env, gain_env_sq;
+	int i;
+
+	for (i = 0; i < MAX_GAIN_COEFFS_CNT; i++) {
+		switch (state) {
+		case STATIC_GAIN:
+			gain[i] = gain_params->gain_coeffs[i];
+			break;
+		case MUTE:
+			gain[i] = 0;
+			break;
+		case TRANS_GAIN:
+			/* Quadratic fade part in Q15 format, applied to Q10 gain coeffs */
+			gain_env = gain_env_i16 + gain_params->init_gain[i];
+			gain_env_sq = q_multsr_16x16(gain_env, gain_env, 15);
+			gain[i] = q_multsr_16x16(gain_params->gain_coeffs[i], gain_env_sq, 15);
+			break;
+		}
+	}
+}
+
+static void copier_gain_convert_s16_to_s16(const struct cir_buf_source *source,
+					   struct cir_buf_sink *sink, size_t samples,
+					   uint32_t channels,
+					   const struct copier_gain_params *gain_params,
+					   enum copier_gain_state state,
+					   enum copier_gain_envelope_dir dir)
+{
+	const int16_t *src = source->ptr;
+	int16_t *dst = sink->ptr;
+	int16_t gain[MAX_GAIN_COEFFS_CNT];
+	size_t processed;
+	size_t nmax, i, n;
+	uint32_t ch = 0;
+
+	copier_gain_channel_coeffs(gain_params, state, gain);
+
+	for (processed = 0; processed < samples; processed += n) {
+		src = cir_buf_wrap(src, source->buf_start, source->buf_end);
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		n = samples - processed;
+		nmax = cir_buf_bytes_without_wrap(src, source->buf_end) / sizeof(*src);
+		n = MIN(n, nmax);
+		nmax = cir_buf_bytes_without_wrap(dst, sink->buf_end) / sizeof(*dst);
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i++) {
+			*dst = q_multsr_sat_16x16(*src, gain[ch], GAIN_Q10_INT_SHIFT);
+			src++;
+			dst++;
+			if (++ch == channels)
+				ch = 0;
+		}
+	}
+}
+
+static void copier_gain_convert_s16_to_s32(const struct cir_buf_source *source,
+					   struct cir_buf_sink *sink, size_t samples,
+					   uint32_t channels,
+					   const struct copier_gain_params *gain_params,
+					   enum copier_gain_state state,
+					   enum copier_gain_envelope_dir dir)
+{
+	const int16_t *src = source->ptr;
+	int32_t *dst = sink->ptr;
+	int16_t gain[MAX_GAIN_COEFFS_CNT];
+	size_t processed;
+	size_t nmax, i, n;
+	uint32_t ch = 0;
+
+	copier_gain_channel_coeffs(gain_params, state, gain);
+
+	for (processed = 0; processed < samples; processed += n) {
+		src = cir_buf_wrap(src, source->buf_start, source->buf_end);
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		n = samples - processed;
+		nmax = cir_buf_bytes_without_wrap(src, source->buf_end) / sizeof(*src);
+		n = MIN(n, nmax);
+		nmax = cir_buf_bytes_without_wrap(dst, sink->buf_end) / sizeof(*dst);
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i++) {
+			*dst = q_multsr_sat_32x32(*src << 16, gain[ch], GAIN_Q10_INT_SHIFT);
+			src++;
+			dst++;
+			if (++ch == channels)
+				ch = 0;
+		}
+	}
+}
+
+static void copier_gain_convert_s32_to_s16(const struct cir_buf_source *source,
+					   struct cir_buf_sink *sink, size_t samples,
+					   uint32_t channels,
+					   const struct copier_gain_params *gain_params,
+					   enum copier_gain_state state,
+					   enum copier_gain_envelope_dir dir)
+{
+	const int32_t *src = source->ptr;
+	int16_t *dst = sink->ptr;
+	int16_t gain[MAX_GAIN_COEFFS_CNT];
+	size_t processed;
+	size_t nmax, i, n;
+	uint32_t ch = 0;
+
+	copier_gain_channel_coeffs(gain_params, state, gain);
+
+	for (processed = 0; processed < samples; processed += n) {
+		src = cir_buf_wrap(src, source->buf_start, source->buf_end);
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		n = samples - processed;
+		nmax = cir_buf_bytes_without_wrap(src, source->buf_end) / sizeof(*src);
+		n = MIN(n, nmax);
+		nmax = cir_buf_bytes_without_wrap(dst, sink->buf_end) / sizeof(*dst);
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i++) {
+			*dst = q_multsr_sat_16x16(sat_int16(Q_SHIFT_RND(*src, 31, 15)), gain[ch],
+						  GAIN_Q10_INT_SHIFT);
+			src++;
+			dst++;
+			if (++ch == channels)
+				ch = 0;
+		}
+	}
+}
+
+static void copier_gain_convert_s32_to_s32(const struct cir_buf_source *source,
+					   struct cir_buf_sink *sink, size_t samples,
+					   uint32_t channels,
+					   const struct copier_gain_params *gain_params,
+					   enum copier_gain_state state,
+					   enum copier_gain_envelope_dir dir)
+{
+	const int32_t *src = source->ptr;
+	int32_t *dst = sink->ptr;
+	int16_t gain[MAX_GAIN_COEFFS_CNT];
+	size_t processed;
+	size_t nmax, i, n;
+	uint32_t ch = 0;
+
+	copier_gain_channel_coeffs(gain_params, state, gain);
+
+	for (processed = 0; processed < samples; processed += n) {
+		src = cir_buf_wrap(src, source->buf_start, source->buf_end);
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		n = samples - processed;
+		nmax = cir_buf_bytes_without_wrap(src, source->buf_end) / sizeof(*src);
+		n = MIN(n, nmax);
+		nmax = cir_buf_bytes_without_wrap(dst, sink->buf_end) / sizeof(*dst);
+		n = MIN(n, nmax);
+		for (i = 0; i < n; i++) {
+			*dst = q_multsr_sat_32x32(*src, gain[ch], GAIN_Q10_INT_SHIFT);
+			src++;
+			dst++;
+			if (++ch == channels)
+				ch = 0;
+		}
+	}
+}
+
+const struct copier_gain_func_map copier_gain_func_map[] = {
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, copier_gain_convert_s16_to_s16 },
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S32_LE, copier_gain_convert_s16_to_s32 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_LE, copier_gain_convert_s32_to_s16 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, copier_gain_convert_s32_to_s32 },
+};
+
+const size_t copier_gain_func_count = ARRAY_SIZE(copier_gain_func_map);
+
 #endif
 
 void copier_update_params(struct copier_data *cd, struct comp_dev *dev,
@@ -512,58 +668,69 @@ static bool is_remapping_chmap(uint32_t chmap, size_t out_channel_count)
 	return false;
 }
 
-pcm_converter_func get_converter_func(const struct ipc4_audio_format *in_fmt,
-				      const struct ipc4_audio_format *out_fmt,
-				      enum ipc4_gateway_type type,
-				      enum ipc4_direction_type dir,
-				      uint32_t chmap)
+/* Resolves the frame formats used to select a conversion function */
+static void get_converter_formats(const struct ipc4_audio_format *in_fmt,
+				  const struct ipc4_audio_format *out_fmt,
+				  enum ipc4_gateway_type type,
+				  enum ipc4_direction_type dir,
+				  enum sof_ipc_frame *in, enum sof_ipc_frame *in_valid,
+				  enum sof_ipc_frame *out, enum sof_ipc_frame *out_valid)
 {
-	enum sof_ipc_frame in, in_valid, out, out_valid;
-
-	audio_stream_fmt_conversion(in_fmt->depth, in_fmt->valid_bit_depth, &in, &in_valid,
+	audio_stream_fmt_conversion(in_fmt->depth, in_fmt->valid_bit_depth, in, in_valid,
 				    in_fmt->s_type);
-	audio_stream_fmt_conversion(out_fmt->depth, out_fmt->valid_bit_depth, &out, &out_valid,
+	audio_stream_fmt_conversion(out_fmt->depth, out_fmt->valid_bit_depth, out, out_valid,
 				    out_fmt->s_type);
 
 	/* use MSB sample type to select conversion function if the data is enter or exit dsp.
 	 * In playback case, host input and dai output and in capture case, host output and
 	 * dai input.
 	 */
-	if (in_fmt->s_type == IPC4_TYPE_MSB_INTEGER && in_valid == SOF_IPC_FRAME_S24_4LE) {
+	if (in_fmt->s_type == IPC4_TYPE_MSB_INTEGER && *in_valid == SOF_IPC_FRAME_S24_4LE) {
 		switch (type) {
 		case ipc4_gtw_host:
 			if (dir == ipc4_playback)
-				in_valid = SOF_IPC_FRAME_S24_4LE_MSB;
+				*in_valid = SOF_IPC_FRAME_S24_4LE_MSB;
 			break;
 		case ipc4_gtw_alh:
 		case ipc4_gtw_link:
 		case ipc4_gtw_ssp:
 		case ipc4_gtw_dmic:
 			if (dir == ipc4_capture)
-				in_valid = SOF_IPC_FRAME_S24_4LE_MSB;
+				*in_valid = SOF_IPC_FRAME_S24_4LE_MSB;
 			break;
 		default:
 			break;
 		}
 	}
 
-	if (out_fmt->s_type == IPC4_TYPE_MSB_INTEGER && out_valid == SOF_IPC_FRAME_S24_4LE) {
+	if (out_fmt->s_type == IPC4_TYPE_MSB_INTEGER && *out_valid == SOF_IPC_FRAME_S24_4LE) {
 		switch (type) {
 		case ipc4_gtw_host:
 			if (dir == ipc4_capture)
-				out_valid = SOF_IPC_FRAME_S24_4LE_MSB;
+				*out_valid = SOF_IPC_FRAME_S24_4LE_MSB;
 			break;
 		case ipc4_gtw_alh:
 		case ipc4_gtw_link:
 		case ipc4_gtw_ssp:
 		case ipc4_gtw_dmic:
 			if (dir == ipc4_playback)
-				out_valid = SOF_IPC_FRAME_S24_4LE_MSB;
+				*out_valid = SOF_IPC_FRAME_S24_4LE_MSB;
 			break;
 		default:
 			break;
 		}
 	}
+}
+
+pcm_converter_func get_converter_func(const struct ipc4_audio_format *in_fmt,
+				      const struct ipc4_audio_format *out_fmt,
+				      enum ipc4_gateway_type type,
+				      enum ipc4_direction_type dir,
+				      uint32_t chmap)
+{
+	enum sof_ipc_frame in, in_valid, out, out_valid;
+
+	get_converter_formats(in_fmt, out_fmt, type, dir, &in, &in_valid, &out, &out_valid);
 
 	if (in_fmt->channels_count != out_fmt->channels_count ||
 	    is_remapping_chmap(chmap, out_fmt->channels_count)) {
@@ -586,3 +753,31 @@ pcm_converter_func get_converter_func(const struct ipc4_audio_format *in_fmt,
 	else
 		return pcm_get_conversion_vc_function(in, in_valid, out, out_valid, type, dir);
 }
+
+copier_gain_converter_func get_converter_gain_func(const struct ipc4_audio_format *in_fmt,
+						   const struct ipc4_audio_format *out_fmt,
+						   enum ipc4_gateway_type type,
+						   enum ipc4_direction_type dir,
+						   uint32_t chmap)
+{
+	enum sof_ipc_frame in, in_valid, out, out_valid;
+	size_t i;
+
+	if (in_fmt->channels_count != out_fmt->channels_count ||
+	    out_fmt->channels_count > MAX_GAIN_COEFFS_CNT ||
+	    is_remapping_chmap(chmap, out_fmt->channels_count))
+		return NULL;
+
+	get_converter_formats(in_fmt, out_fmt, type, dir, &in, &in_valid, &out, &out_valid);
+
+	/* only conversions of full container samples are fused */
+	if (!use_no_container_convert_function(in, in_valid, out, out_valid))
+		return NULL;
+
+	for (i = 0; i < copier_gain_func_count; i++) {
+		if (in == copier_gain_func_map[i].source && out == copier_gain_func_map[i].sink)
+			return copier_gain_func_map[i].func;
+	}
+
+	return NULL;
+}
@@ -141,15 +141,11 @@ __cold int copier_gain_set_fade_params(struct comp_dev *dev, struct copier_gain_
 	return ret;
 }
 
-static inline ae_int16x4 copier_load_slots_and_gain16(ae_int16x4 **addr,
-						      ae_valign *align_in,
-						      const ae_int16x4 gains)
+static inline ae_int16x4 copier_gain16(ae_int16x4 d16_1, const ae_int16x4 gains)
 {
-	ae_int16x4 d16_1 = AE_ZERO16();
 	ae_int32x2 d32_1 = AE_ZERO32();
 	ae_int32x2 d32_2 = AE_ZERO32();
 
-	AE_LA16X4_IC(d16_1, align_in[0], addr[0]);
 	AE_MUL16X4(d32_1, d32_2, d16_1, gains);
 
 	/* Saturate if exists by moving to Q31 */
@@ -160,25 +156,80 @@ static inline ae_int16x4 copier_load_slots_and_gain16(ae_int16x4 **addr,
 	return AE_TRUNC16X4F32(d32_1, d32_2);
 }
 
+static inline void copier_gain32(const ae_int16x4 gains, ae_int32x2 *d32_h, ae_int32x2 *d32_l)
+{
+	/* Apply gains */
+	ae_int32x2 d32tmp_h = AE_MULFP32X16X2RAS_H(*d32_h, gains);
+	ae_int32x2 d32tmp_l = AE_MULFP32X16X2RAS_L(*d32_l, gains);
+
+	/* Gain is Q10 but treated in AE_MULFP32X16 as Q15,
+	 * so we need to compensate by shifting with saturation
+	 */
+	*d32_h = AE_SLAA32S(d32tmp_h, Q10_TO_Q15_SHIFT);
+	*d32_l = AE_SLAA32S(d32tmp_l, Q10_TO_Q15_SHIFT);
+}
+
+static inline ae_int16x4 copier_load_slots_and_gain16(ae_int16x4 **addr,
+						      ae_valign *align_in,
+						      const ae_int16x4 gains)
+{
+	ae_int16x4 d16_1 = AE_ZERO16();
+
+	AE_LA16X4_IC(d16_1, align_in[0], addr[0]);
+
+	return copier_gain16(d16_1, gains);
+}
+
 static inline void copier_load_slots_and_gain32(ae_int32x2 **addr, ae_valign *align_in,
 						const ae_int16x4 gains, ae_int32x2 *out_d32_h,
 						ae_int32x2 *out_d32_l)
 {
-	ae_int32x2 d32tmp_h = AE_ZERO32();
-	ae_int32x2 d32tmp_l = AE_ZERO32();
+	AE_LA32X2_IC(*out_d32_h, align_in[0], addr[0]);
+	AE_LA32X2_IC(*out_d32_l, align_in[0], addr[0]);
 
-	AE_LA32X2_IC(d32tmp_h, align_in[0], addr[0]);
-	AE_LA32X2_IC(d32tmp_l, align_in[0], addr[0]);
+	copier_gain32(gains, out_d32_h, out_d32_l);
+}
 
-	/* Apply gains */
-	d32tmp_h = AE_MULFP32X16X2RAS_H(d32tmp_h, gains);
-	d32tmp_l = AE_MULFP32X16X2RAS_L(d32tmp_l, gains);
+/* Gain of one vector of four samples, for the samples left at the end of a chunk */
+static inline ae_int16x4 copier_gain_vec16(ae_int16x4 d16_1, enum copier_gain_state state,
+					   const struct copier_gain_params *gain_params,
+					   ae_f16x4 gain_env)
+{
+	switch (state) {
+	case STATIC_GAIN:
+		return copier_gain16(d16_1, gain_params->gain_coeffs[0]);
+	case TRANS_GAIN:
+		if (!gain_params->unity_gain)
+			d16_1 = copier_gain16(d16_1, gain_params->gain_coeffs[0]);
+		d16_1 = AE_MULFP16X4S(d16_1, gain_env);
+		return AE_MULFP16X4S(d16_1, gain_env);
+	default:
+		return AE_ZERO16();
+	}
+}
 
-	/* Gain is Q10 but treated in AE_MULFP32X16 as Q15,
-	 * so we need to compensate by shifting with saturation
-	 */
-	*out_d32_h = AE_SLAA32S(d32tmp_h, Q10_TO_Q15_SHIFT);
-	*out_d32_l = AE_SLAA32S(d32tmp_l, Q10_TO_Q15_SHIFT);
+static inline void copier_gain_vec32(ae_int32x2 *d32_h, ae_int32x2 *d32_l,
+				     enum copier_gain_state state,
+				     const struct copier_gain_params *gain_params,
+				     ae_f16x4 gain_env)
+{
+	switch (state) {
+	case STATIC_GAIN:
+		copier_gain32(gain_params->gain_coeffs[0], d32_h, d32_l);
+		break;
+	case TRANS_GAIN:
+		if (!gain_params->unity_gain)
+			copier_gain32(gain_params->gain_coeffs[0], d32_h, d32_l);
+		*d32_h = AE_MULFP32X16X2RAS_H(*d32_h, gain_env);
+		*d32_h = AE_MULFP32X16X2RAS_H(*d32_h, gain_env);
+		*d32_l = AE_MULFP32X16X2RAS_L(*d32_l, gain_env);
+		*d32_l = AE_MULFP32X16X2RAS_L(*d32_l, gain_env);
+		break;
+	default:
+		*d32_h = AE_ZERO32();
+		*d32_l = AE_ZERO32();
+		break;
+	}
 }
 
 int copier_gain_input16(struct comp_buffer *buff, enum copier_gain_state state,
@@ -277,15 +328,7 @@ int copier_gain_input16(struct comp_buffer *buff, enum copier_gain_state state,
 		dst = audio_stream_wrap(&buff->stream, dst + nmax);
 	}
 
-	if (state == MUTE) {
-		gain_params->silence_sg_count += frames;
-	} else if (state == TRANS_GAIN) {
-		gain_params->fade_in_sg_count += frames;
-		if (dir == GAIN_ADD)
-			gain_params->gain_env += gain_params->step_i64 * frames;
-		else
-			gain_params->gain_env -= gain_params->step_i64 * frames;
-	}
+	copier_gain_update_state(gain_params, state, dir, frames);
 	return 0;
 }
 
@@ -407,15 +450,7 @@ int copier_gain_input32(struct comp_buffer *buff, enum copier_gain_state state,
 		dst = audio_stream_wrap(&buff->stream, dst + nmax);
 	}
 
-	if (state == MUTE) {
-		gain_params->silence_sg_count += frames;
-	} else if (state == TRANS_GAIN) {
-		gain_params->fade_in_sg_count += frames;
-		if (dir == GAIN_ADD)
-			gain_params->gain_env += gain_params->step_i64 * frames;
-		else
-			gain_params->gain_env -= gain_params->step_i64 * frames;
-	}
+	copier_gain_update_state(gain_params, state, dir, frames);
 
 	return 0;
 }
@@ -428,4 +463,212 @@ bool copier_is_unity_gain(struct copier_gain_params *gain_params)
 	return XT_ALL4(unity_gain_check) ? true : false;
 }
 
+static void copier_gain_convert_s16_to_s16(const struct cir_buf_source *source,
+					   struct cir_buf_sink *sink, size_t samples,
+					   uint32_t channels,
+					   const struct copier_gain_params *gain_params,
+					   enum copier_gain_state state,
+					   enum copier_gain_envelope_dir dir)
+{
+	const int16_t *src = source->ptr;
+	int16_t *dst = sink->ptr;
+	int16_t tmp[4] __attribute__((aligned(8)));
+	const ae_int16x4 gain_i16 = gain_params->gain_coeffs[0];
+	ae_f16x4 gain_env = AE_ZERO16();
+	ae_valign align_in;
+	ae_valign align_out;
+	ae_int16x4 *out_ptr;
+	ae_int16x4 *in_ptr;
+	ae_int16x4 d16_1;
+	size_t processed;
+	size_t nmax, n, i;
+	int rest;
+
+	for (processed = 0; processed < samples; processed += n) {
+		src = cir_buf_wrap(src, source->buf_start, source->buf_end);
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		n = samples - processed;
+		nmax = cir_buf_bytes_without_wrap(src, source->buf_end) / sizeof(*src);
+		n = MIN(n, nmax);
+		nmax = cir_buf_bytes_without_wrap(dst, sink->buf_end) / sizeof(*dst);
+		n = MIN(n, nmax);
+		in_ptr = (ae_int16x4 *)src;
+		out_ptr = (ae_int16x4 *)dst;
+		align_in = AE_LA64_PP(in_ptr);
+		align_out = AE_ZALIGN64();
+
+		/* the envelope restarts in each chunk, as in the two-pass path */
+		if (state == TRANS_GAIN) {
+			gain_env = (int16_t)(gain_params->gain_env >> I64_TO_I16_SHIFT);
+			gain_env = AE_ADD16S(gain_env, gain_params->init_gain);
+		}
+
+		switch (state) {
+		case STATIC_GAIN:
+			for (i = 0; i < (n >> 2); i++) {
+				AE_LA16X4_IP(d16_1, align_in, in_ptr);
+				d16_1 = copier_gain16(d16_1, gain_i16);
+				AE_SA16X4_IP(d16_1, align_out, out_ptr);
+			}
+			break;
+		case MUTE:
+			d16_1 = AE_ZERO16();
+			for (i = 0; i < (n >> 2); i++)
+				AE_SA16X4_IP(d16_1, align_out, out_ptr);
+			break;
+		case TRANS_GAIN:
+			for (i = 0; i < (n >> 2); i++) {
+				AE_LA16X4_IP(d16_1, align_in, in_ptr);
+				/* static gain part */
+				if (!gain_params->unity_gain)
+					d16_1 = copier_gain16(d16_1, gain_i16);
+
+				/* quadratic fade-in part */
+				d16_1 = AE_MULFP16X4S(d16_1, gain_env);
+				d16_1 = AE_MULFP16X4S(d16_1, gain_env);
+				AE_SA16X4_IP(d16_1, align_out, out_ptr);
+
+				if (dir == GAIN_ADD)
+					gain_env = AE_ADD16S(gain_env, gain_params->step_f16);
+				else
+					gain_env = AE_SUB16S(gain_env, gain_params->step_f16);
+			}
+			break;
+		}
+		AE_SA64POS_FP(align_out, out_ptr);
+
+		/* Process rest samples through an aligned vector */
+		rest = n & 0x3;
+		if (rest) {
+			src += n - rest;
+			dst += n - rest;
+			for (i = 0; i < rest; i++)
+				tmp[i] = src[i];
+			d16_1 = copier_gain_vec16(*(ae_int16x4 *)tmp, state, gain_params, gain_env);
+			*(ae_int16x4 *)tmp = d16_1;
+			for (i = 0; i < rest; i++)
+				dst[i] = tmp[i];
+			src += rest;
+			dst += rest;
+		} else {
+			src += n;
+			dst += n;
+		}
+	}
+}
+
+static void copier_gain_convert_s32_to_s32(const struct cir_buf_source *source,
+					   struct cir_buf_sink *sink, size_t samples,
+					   uint32_t channels,
+					   const struct copier_gain_params *gain_params,
+					   enum copier_gain_state state,
+					   enum copier_gain_envelope_dir dir)
+{
+	const int32_t *src = source->ptr;
+	int32_t *dst = sink->ptr;
+	int32_t tmp[4] __attribute__((aligned(8)));
+	const ae_int16x4 gain_i16 = gain_params->gain_coeffs[0];
+	ae_f16x4 gain_env = AE_ZERO16();
+	ae_valign align_in;
+	ae_valign align_out;
+	ae_int32x2 *out_ptr;
+	ae_int32x2 *in_ptr;
+	ae_int32x2 d32_h;
+	ae_int32x2 d32_l;
+	size_t processed;
+	size_t nmax, n, i;
+	int rest;
+
+	for (processed = 0; processed < samples; processed += n) {
+		src = cir_buf_wrap(src, source->buf_start, source->buf_end);
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		n = samples - processed;
+		nmax = cir_buf_bytes_without_wrap(src, source->buf_end) / sizeof(*src);
+		n = MIN(n, nmax);
+		nmax = cir_buf_bytes_without_wrap(dst, sink->buf_end) / sizeof(*dst);
+		n = MIN(n, nmax);
+		in_ptr = (ae_int32x2 *)src;
+		out_ptr = (ae_int32x2 *)dst;
+		align_in = AE_LA64_PP(in_ptr);
+		align_out = AE_ZALIGN64();
+
+		/* the envelope restarts in each chunk, as in the two-pass path */
+		if (state == TRANS_GAIN) {
+			gain_env = (int16_t)(gain_params->gain_env >> I64_TO_I16_SHIFT);
+			gain_env = AE_ADD16S(gain_env, gain_params->init_gain);
+		}
+
+		switch (state) {
+		case STATIC_GAIN:
+			for (i = 0; i < (n >> 2); i++) {
+				AE_LA32X2_IP(d32_h, align_in, in_ptr);
+				AE_LA32X2_IP(d32_l, align_in, in_ptr);
+				copier_gain32(gain_i16, &d32_h, &d32_l);
+				AE_SA32X2_IP(d32_h, align_out, out_ptr);
+				AE_SA32X2_IP(d32_l, align_out, out_ptr);
+			}
+			break;
+		case MUTE:
+			d32_l = AE_ZERO32();
+			for (i = 0; i < (n >> 2); i++) {
+				AE_SA32X2_IP(d32_l, align_out, out_ptr);
+				AE_SA32X2_IP(d32_l, align_out, out_ptr);
+			}
+			break;
+		case TRANS_GAIN:
+			for (i = 0; i < (n >> 2); i++) {
+				AE_LA32X2_IP(d32_h, align_in, in_ptr);
+				AE_LA32X2_IP(d32_l, align_in, in_ptr);
+				/* static gain part */
+				if (!gain_params->unity_gain)
+					copier_gain32(gain_i16, &d32_h, &d32_l);
+
+				/* quadratic fade-in part */
+				d32_h = AE_MULFP32X16X2RAS_H(d32_h, gain_env);
+				d32_h = AE_MULFP32X16X2RAS_H(d32_h, gain_env);
+				d32_l = AE_MULFP32X16X2RAS_L(d32_l, gain_env);
+				d32_l = AE_MULFP32X16X2RAS_L(d32_l, gain_env);
+				AE_SA32X2_IP(d32_h, align_out, out_ptr);
+				AE_SA32X2_IP(d32_l, align_out, out_ptr);
+
+				if (dir == GAIN_ADD)
+					gain_env = AE_ADD16S(gain_env, gain_params->step_f16);
+				else
+					gain_env = AE_SUB16S(gain_env, gain_params->step_f16);
+			}
+			break;
+		}
+		AE_SA64POS_FP(align_out, out_ptr);
+
+		/* Process rest samples through an aligned vector */
+		rest = n & 0x3;
+		if (rest) {
+			src += n - rest;
+			dst += n - rest;
+			for (i = 0; i < rest; i++)
+				tmp[i] = src[i];
+			d32_h = *(ae_int32x2 *)tmp;
+			d32_l = *(ae_int32x2 *)(tmp + 2);
+			copier_gain_vec32(&d32_h, &d32_l, state, gain_params, gain_env);
+			*(ae_int32x2 *)tmp = d32_h;
+			*(ae_int32x2 *)(tmp + 2) = d32_l;
+			for (i = 0; i < rest; i++)
+				dst[i] = tmp[i];
+			src += rest;
+			dst += rest;
+		} else {
+			src += n;
+			dst += n;
+		}
+	}
+}
+
+/* Conversions between 16 and 32 bit containers keep the two pass path on HiFi */
+const struct copier_gain_func_map copier_gain_func_map[] = {
+	{ SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, copier_gain_convert_s16_to_s16 },
+	{ SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, copier_gain_convert_s32_to_s32 },
+};
+
+const size_t copier_gain_func_count = ARRAY_SIZE(copier_gain_func_map);
+
 #endif
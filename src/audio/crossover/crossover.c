@@ -47,10 +47,8 @@ SOF_DEFINE_REG_UUID(crossover);
 static void crossover_reset_state(struct processing_module *mod)
 {
 	struct comp_data *cd = module_get_private_data(mod);
-	int i;
 
-	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
-		crossover_reset_state_ch(mod, &cd->state[i]);
+	crossover_reset_state_all(&cd->state);
 }
 
 /**
@@ -154,73 +152,44 @@ static int crossover_assign_sinks(struct processing_module *mod,
  *	       high/low pass filter.
  * \param[out] lr4 initialized struct
  */
-static int crossover_init_coef_lr4(struct processing_module *mod,
-				   struct sof_eq_iir_biquad *coef,
-				   struct iir_state_df1 *lr4)
+static void crossover_init_coef_lr4(struct sof_eq_iir_biquad *coef,
+				    struct crossover_lr4_state *lr4)
 {
 	int ret;
 
-	/* Ensure the LR4 can be processed with the simplified 4th order IIR */
-	if (CROSSOVER_LR4_NUM_BIQUADS != SOF_IIR_DF1_4TH_NUM_BIQUADS)
-		return -EINVAL;
-
 	/* Only one set of coefficients is stored in config for both biquads
-	 * in series due to identity. To maintain the structure of
-	 * iir_state_df1, it requires two copies of coefficients in a row.
+	 * in series due to identity. To maintain the layout of the 4th order
+	 * IIR, it requires two copies of coefficients in a row.
 	 */
-	lr4->coef = mod_zalloc(mod, sizeof(struct sof_eq_iir_biquad) * 2);
-	if (!lr4->coef)
-		return -ENOMEM;
-
-	/* coefficients of the first biquad */
 	ret = memcpy_s(lr4->coef, sizeof(struct sof_eq_iir_biquad),
 		       coef, sizeof(struct sof_eq_iir_biquad));
 	assert(!ret);
 
-	/* coefficients of the second biquad */
 	ret = memcpy_s(lr4->coef + SOF_EQ_IIR_NBIQUAD,
 		       sizeof(struct sof_eq_iir_biquad),
 		       coef, sizeof(struct sof_eq_iir_biquad));
 	assert(!ret);
 
-	/* LR4 filters are two 2nd order filters, so only need 4 delay slots
-	 * delay[0..1] -> state for first biquad
-	 * delay[2..3] -> state for second biquad
-	 */
-	lr4->delay = mod_zalloc(mod, sizeof(uint64_t) * CROSSOVER_NUM_DELAYS_LR4);
-	if (!lr4->delay)
-		return -ENOMEM;
-
-	lr4->biquads = CROSSOVER_LR4_NUM_BIQUADS;
-	lr4->biquads_in_series = CROSSOVER_LR4_NUM_BIQUADS;
-
-	return 0;
+	memset(lr4->delay, 0, sizeof(lr4->delay));
 }
 
-/**
- * \brief Initializes the crossover coefficients for one channel
- */
-int crossover_init_coef_ch(struct processing_module *mod,
-			   struct sof_eq_iir_biquad *coef,
-			   struct crossover_state *ch_state,
-			   int32_t num_sinks)
+int crossover_init_coef_state(struct sof_eq_iir_biquad *coef,
+			      struct crossover_state *state,
+			      int32_t num_sinks)
 {
 	int32_t i;
 	int32_t j = 0;
 	int32_t num_lr4s = num_sinks == CROSSOVER_2WAY_NUM_SINKS ? 1 : 3;
-	int err;
+
+	/* Ensure the LR4 can be processed with the simplified 4th order IIR */
+	if (CROSSOVER_LR4_NUM_BIQUADS != SOF_IIR_DF1_4TH_NUM_BIQUADS)
+		return -EINVAL;
 
 	for (i = 0; i < num_lr4s; i++) {
 		/* Get the low pass coefficients */
-		err = crossover_init_coef_lr4(mod, &coef[j],
-					      &ch_state->lowpass[i]);
-		if (err < 0)
-			return -EINVAL;
+		crossover_init_coef_lr4(&coef[j], &state->lowpass[i]);
 		/* Get the high pass coefficients */
-		err = crossover_init_coef_lr4(mod, &coef[j + 1],
-					      &ch_state->highpass[i]);
-		if (err < 0)
-			return -EINVAL;
+		crossover_init_coef_lr4(&coef[j + 1], &state->highpass[i]);
 		j += 2;
 	}
 
@@ -229,16 +198,15 @@ int crossover_init_coef_ch(struct processing_module *mod,
 
 /**
  * \brief Initializes the coefficients of the crossover filter
- *	  and assign them to the first nch channels.
+ *	  that are common for all channels.
  *
  * \param nch number of channels in the audio stream.
  */
 static int crossover_init_coef(struct processing_module *mod, int nch)
 {
 	struct comp_data *cd = module_get_private_data(mod);
-	struct sof_eq_iir_biquad *crossover;
 	struct sof_crossover_config *config = cd->config;
-	int ch, err;
+	int err;
 
 	if (!config) {
 		comp_err(mod->dev, "no config is set");
@@ -254,18 +222,11 @@ static int crossover_init_coef(struct processing_module *mod, int nch)
 	comp_info(mod->dev, "initializing %i-way crossover",
 		  config->num_sinks);
 
-	/* Collect the coef array and assign it to every channel */
-	crossover = config->coef;
-	for (ch = 0; ch < nch; ch++) {
-		err = crossover_init_coef_ch(mod, crossover, &cd->state[ch],
-					     config->num_sinks);
-		/* Free all previously allocated blocks in case of an error */
-		if (err < 0) {
-			comp_err(mod->dev, "could not assign coefficients to ch %d",
-				 ch);
-			crossover_reset_state(mod);
-			return err;
-		}
+	err = crossover_init_coef_state(config->coef, &cd->state, config->num_sinks);
+	if (err < 0) {
+		comp_err(mod->dev, "could not assign coefficients");
+		crossover_reset_state(mod);
+		return err;
 	}
 
 	return 0;
@@ -61,7 +61,7 @@ typedef void (*crossover_process)(struct comp_data *cd,
 /* Crossover component private data */
 struct comp_data {
 	/**< filter state */
-	struct crossover_state state[PLATFORM_MAX_CHANNELS];
+	struct crossover_state state;
 #if CONFIG_IPC_MAJOR_4
 	uint32_t output_pin_index[SOF_CROSSOVER_MAX_STREAMS];
 	uint32_t num_output_pins;
@@ -118,13 +118,13 @@ extern const crossover_split crossover_split_fnmap[];
 extern const size_t crossover_split_fncount;
 
 /*
- * \brief Runs input in through the LR4 filter and returns it's output.
+ * \brief Runs one frame of nch channels through the LR4 filter.
  */
-static inline int32_t crossover_generic_process_lr4(int32_t in,
-						    struct iir_state_df1 *lr4)
+static inline void crossover_generic_process_lr4(struct crossover_lr4_state *lr4,
+						 const int32_t *x, int32_t *y, int nch)
 {
 	/* Cascade two biquads with same coefficients in series. */
-	return iir_df1_4th(lr4, in);
+	iir_df1_4th_nch(lr4->coef, lr4->delay, x, y, nch);
 }
 
 static inline void crossover_free_config(struct sof_crossover_config **config)
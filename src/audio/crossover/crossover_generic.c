@@ -16,18 +16,18 @@
 /*
  * \brief Splits x into two based on the coefficients set in the lp
  *        and hp filters. The output of the lp is in y1, the output of
- *        the hp is in y2.
+ *        the hp is in y2. All nch channels of the frame are processed.
  *
  * As a side effect, this function mutates the delay values of both
  * filters.
  */
-static inline void crossover_generic_lr4_split(struct iir_state_df1 *lp,
-					       struct iir_state_df1 *hp,
-					       int32_t x, int32_t *y1,
-					       int32_t *y2)
+static inline void crossover_generic_lr4_split(struct crossover_lr4_state *lp,
+					       struct crossover_lr4_state *hp,
+					       const int32_t *x, int32_t *y1,
+					       int32_t *y2, int nch)
 {
-	*y1 = crossover_generic_process_lr4(x, lp);
-	*y2 = crossover_generic_process_lr4(x, hp);
+	crossover_generic_process_lr4(lp, x, y1, nch);
+	crossover_generic_process_lr4(hp, x, y2, nch);
 }
 
 /*
@@ -39,52 +39,57 @@ static inline void crossover_generic_lr4_split(struct iir_state_df1 *lp,
  * to be out of phase. We need to pass the signal through another set of LR4
  * filters to align back the phase.
  */
-static inline void crossover_generic_lr4_merge(struct iir_state_df1 *lp,
-					       struct iir_state_df1 *hp,
-					       int32_t x, int32_t *y)
+static inline void crossover_generic_lr4_merge(struct crossover_lr4_state *lp,
+					       struct crossover_lr4_state *hp,
+					       const int32_t *x, int32_t *y, int nch)
 {
-	int32_t z1, z2;
-
-	z1 = crossover_generic_process_lr4(x, lp);
-	z2 = crossover_generic_process_lr4(x, hp);
-	*y = sat_int32(((int64_t)z1) + z2);
+	int32_t z1[PLATFORM_MAX_CHANNELS];
+	int32_t z2[PLATFORM_MAX_CHANNELS];
+	int ch;
+
+	crossover_generic_process_lr4(lp, x, z1, nch);
+	crossover_generic_process_lr4(hp, x, z2, nch);
+	for (ch = 0; ch < nch; ch++)
+		y[ch] = sat_int32(((int64_t)z1[ch]) + z2[ch]);
 }
 
-static void crossover_generic_split_2way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_2way(const int32_t in[],
+					 int32_t out[][PLATFORM_MAX_CHANNELS],
+					 struct crossover_state *state, int nch)
 {
 	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &out[0], &out[1]);
+				    in, out[0], out[1], nch);
 }
 
-static void crossover_generic_split_3way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_3way(const int32_t in[],
+					 int32_t out[][PLATFORM_MAX_CHANNELS],
+					 struct crossover_state *state, int nch)
 {
-	int32_t z1, z2;
+	int32_t z1[PLATFORM_MAX_CHANNELS];
+	int32_t z2[PLATFORM_MAX_CHANNELS];
 
 	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &z1, &z2);
+				    in, z1, z2, nch);
 	/* Realign the phase of z1 */
 	crossover_generic_lr4_merge(&state->lowpass[1], &state->highpass[1],
-				    z1, &out[0]);
+				    z1, out[0], nch);
 	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[1], &out[2]);
+				    z2, out[1], out[2], nch);
 }
 
-static void crossover_generic_split_4way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_4way(const int32_t in[],
+					 int32_t out[][PLATFORM_MAX_CHANNELS],
+					 struct crossover_state *state, int nch)
 {
-	int32_t z1, z2;
+	int32_t z1[PLATFORM_MAX_CHANNELS];
+	int32_t z2[PLATFORM_MAX_CHANNELS];
 
 	crossover_generic_lr4_split(&state->lowpass[1], &state->highpass[1],
-				    in, &z1, &z2);
+				    in, z1, z2, nch);
 	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    z1, &out[0], &out[1]);
+				    z1, out[0], out[1], nch);
 	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[2], &out[3]);
+				    z2, out[2], out[3], nch);
 }
 
 static void crossover_default_pass(struct comp_data *cd,
@@ -111,33 +116,34 @@ static void crossover_s16_default(struct comp_data *cd,
 				  int32_t num_sinks,
 				  uint32_t frames)
 {
-	struct crossover_state *state;
 	const struct audio_stream *source_stream = bsource->data;
 	struct audio_stream *sink_stream;
 	int16_t *x, *y;
 	int ch, i, j;
-	int idx;
+	int idx = 0;
 	int nch = audio_stream_get_channels(source_stream);
-	int32_t out[num_sinks];
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		state = &cd->state[ch];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(source_stream, idx);
-			cd->crossover_split(*x << 16, out, state);
-
-			for (j = 0; j < num_sinks; j++) {
-				if (!bsinks[j])
-					continue;
-				sink_stream = bsinks[j]->data;
-				y = audio_stream_write_frag_s16(sink_stream,
-								idx);
-				*y = sat_int16(Q_SHIFT_RND(out[j], 31, 15));
-			}
+	int32_t in[PLATFORM_MAX_CHANNELS];
+	int32_t out[SOF_CROSSOVER_MAX_STREAMS][PLATFORM_MAX_CHANNELS];
 
-			idx += nch;
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < nch; ch++) {
+			x = audio_stream_read_frag_s16(source_stream, idx + ch);
+			in[ch] = *x << 16;
 		}
+
+		cd->crossover_split(in, out, &cd->state, nch);
+
+		for (j = 0; j < num_sinks; j++) {
+			if (!bsinks[j])
+				continue;
+			sink_stream = bsinks[j]->data;
+			for (ch = 0; ch < nch; ch++) {
+				y = audio_stream_write_frag_s16(sink_stream, idx + ch);
+				*y = sat_int16(Q_SHIFT_RND(out[j][ch], 31, 15));
+			}
+		}
+
+		idx += nch;
 	}
 }
 #endif /* CONFIG_FORMAT_S16LE */
@@ -149,33 +155,34 @@ static void crossover_s24_default(struct comp_data *cd,
 				  int32_t num_sinks,
 				  uint32_t frames)
 {
-	struct crossover_state *state;
 	const struct audio_stream *source_stream = bsource->data;
 	struct audio_stream *sink_stream;
 	int32_t *x, *y;
 	int ch, i, j;
-	int idx;
+	int idx = 0;
 	int nch = audio_stream_get_channels(source_stream);
-	int32_t out[num_sinks];
-
-	for (ch = 0; ch < nch; ch++) {
-		idx = ch;
-		state = &cd->state[ch];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source_stream, idx);
-			cd->crossover_split(*x << 8, out, state);
-
-			for (j = 0; j < num_sinks; j++) {
-				if (!bsinks[j])
-					continue;
-				sink_stream = bsinks[j]->data;
-				y = audio_stream_write_frag_s32(sink_stream,
-								idx);
-				*y = sat_int24(Q_SHIFT_RND(out[j], 31, 23));
-			}
+	int32_t in[PLATFORM_MAX_CHANNELS];
+	int32_t out[SOF_CROSSOVER_MAX_STREAMS][PLATFORM_MAX_CHANNELS];
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < nch; ch++) {
+			x = audio_stream_read_frag_s32(source_stream, idx + ch);
+			in[ch] = *x << 8;
+		}
+
+		cd->crossover_split(in, out, &cd->state, nch);
 
-			idx += nch;
+		for (j = 0; j < num_sinks; j++) {
+			if (!bsinks[j])
+				continue;
+			sink_stream = bsinks[j]->data;
+			for (ch = 0; ch < nch; ch++) {
+				y = audio_stream_write_frag_s32(sink_stream, idx + ch);
+				*y = sat_int24(Q_SHIFT_RND(out[j][ch], 31, 23));
+			}
 		}
+
+		idx += nch;
 	}
 }
 #endif /* CONFIG_FORMAT_S24LE */
@@ -203,18 +210,18 @@ static void crossover_s32_default(struct comp_data *cd,
 {
 	/* Array to hold active sink streams; initialized to null */
 	struct audio_stream *sink_stream[SOF_CROSSOVER_MAX_STREAMS] = { NULL };
-	struct crossover_state *state;
 	/* Source stream to read audio data from */
 	const struct audio_stream *source_stream = bsource->data;
 	int32_t *x, *y;
 	int ch, i, j;
-	int idx;
+	int idx = 0;
 	/* Counter for active sink streams */
 	int active_sinks = 0;
 	/* Number of channels in the source stream */
 	int nch = audio_stream_get_channels(source_stream);
-	/* Output buffer for processed data */
-	int32_t out[num_sinks];
+	/* One input frame and the processed output frames for every band */
+	int32_t in[PLATFORM_MAX_CHANNELS];
+	int32_t out[SOF_CROSSOVER_MAX_STREAMS][PLATFORM_MAX_CHANNELS];
 
 	/* Identify active sinks, avoid processing null sinks later */
 	for (j = 0; j < num_sinks; j++) {
@@ -222,29 +229,28 @@ static void crossover_s32_default(struct comp_data *cd,
 			sink_stream[active_sinks++] = bsinks[j]->data;
 	}
 
-	/* Process for each channel */
-	/* Loop through each channel in the source stream */
-	for (ch = 0; ch < nch; ch++) {
-		/* Set current crossover state for this channel */
-		state = &cd->state[ch];
-		/* Iterate over frames */
-		/* Loop through each frame */
-		for (i = 0, idx = ch; i < frames; i++, idx += nch) {
-			/* Read source */
-			/* Read the current audio frame for the channel */
-			x = audio_stream_read_frag_s32(source_stream, idx);
-			/* Apply the crossover split logic to the audio data */
-			cd->crossover_split(*x, out, state);
-
-			/* Write output to active sinks */
-			/* Write processed output to active sinks */
-			for (j = 0; j < active_sinks; j++) {
-				/* Write processed data to sink */
-				y = audio_stream_write_frag_s32(sink_stream[j], idx);
-				*y = out[j];
-			}
+	/* Process all channels of a frame at once so that the filter
+	 * coefficients are loaded once per frame.
+	 */
+	for (i = 0; i < frames; i++) {
+		/* Read the current audio frame */
+		for (ch = 0; ch < nch; ch++) {
+			x = audio_stream_read_frag_s32(source_stream, idx + ch);
+			in[ch] = *x;
+		}
+
+		/* Apply the crossover split logic to the audio data */
+		cd->crossover_split(in, out, &cd->state, nch);
 
+		/* Write processed output to active sinks */
+		for (j = 0; j < active_sinks; j++) {
+			for (ch = 0; ch < nch; ch++) {
+				y = audio_stream_write_frag_s32(sink_stream[j], idx + ch);
+				*y = out[j][ch];
+			}
 		}
+
+		idx += nch;
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE */
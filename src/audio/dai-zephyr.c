@@ -321,6 +321,38 @@ static int dai_get_fifo(struct dai *dai, int direction, int stream_id)
 	return props.fifo_address;
 }
 
+/* copies captured data from the DMA buffer to the local buffer */
+static int dai_capture_copy_local(struct dai_data *dd, struct comp_dev *dev, uint32_t bytes)
+{
+	int ret;
+
+#if CONFIG_IPC_MAJOR_4
+	/* Convert and apply gain in a single pass when the formats allow it */
+	if (dd->ipc_config.apply_gain && dd->gain_data && dd->gain_data->converter)
+		return copier_gain_copy_from_no_consume(dev, dd->dma_buffer, dd->local_buffer,
+							dd->gain_data, GAIN_ADD, bytes);
+#endif
+
+	/*
+	 * The PCM converter functions used during DMA buffer copy can never fail,
+	 * so no need to check the return value of stream_copy_from_no_consume().
+	 */
+	ret = stream_copy_from_no_consume(dev, dd->dma_buffer, dd->local_buffer,
+					  dd->process, bytes, dd->chmap);
+#if CONFIG_IPC_MAJOR_4
+	/* Apply gain to the local buffer */
+	if (dd->ipc_config.apply_gain) {
+		ret = copier_gain_input(dev, dd->local_buffer, dd->gain_data,
+					GAIN_ADD, bytes);
+		if (ret)
+			comp_err(dev, "copier_gain_input() failed err=%d", ret);
+		buffer_stream_writeback(dd->local_buffer, bytes);
+	}
+#endif
+
+	return ret;
+}
+
 /* this is called by DMA driver every time descriptor has completed */
 static enum sof_dma_cb_status
 dai_dma_cb(struct dai_data *dd, struct comp_dev *dev, uint32_t bytes,
@@ -397,23 +429,9 @@ dai_dma_cb(struct dai_data *dd, struct comp_dev *dev, uint32_t bytes,
 					 dd->process, bytes, dd->chmap);
 	} else {
 		audio_stream_invalidate(&dd->dma_buffer->stream, bytes);
-		/*
-		 * The PCM converter functions used during DMA buffer copy can never fail,
-		 * so no need to check the return value of stream_copy_from_no_consume().
-		 */
 
-		ret = stream_copy_from_no_consume(dev, dd->dma_buffer, dd->local_buffer,
-						  dd->process, bytes, dd->chmap);
+		ret = dai_capture_copy_local(dd, dev, bytes);
 #if CONFIG_IPC_MAJOR_4
-		/* Apply gain to the local buffer */
-		if (dd->ipc_config.apply_gain) {
-			ret = copier_gain_input(dev, dd->local_buffer, dd->gain_data,
-						GAIN_ADD, bytes);
-			if (ret)
-				comp_err(dev, "copier_gain_input() failed err=%d", ret);
-			buffer_stream_writeback(dd->local_buffer, bytes);
-		}
-
 		/* Skip in case of endpoint DAI devices created by the copier */
 		if (converter) {
 			/*
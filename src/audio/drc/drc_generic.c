@@ -102,24 +102,26 @@ void drc_update_detector_average(struct drc_state *state,
 		div_start = state->pre_delay_write_index - DRC_DIVISION_FRAMES;
 	}
 
-	/* The max abs value across all channels for this frame */
+	/* The max abs value across all channels for each frame. Each channel
+	 * pre-delay buffer is linear over one division so scan them one by one
+	 * for a contiguous, vectorizable inner loop.
+	 */
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		abs_input_array[i] = 0;
+
 	if (nbyte == 2) { /* 2 bytes per sample */
-		for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
-			abs_input_array[i] = 0;
-			for (ch = 0; ch < nch; ch++) {
-				sample16_p =
-					(int16_t *)state->pre_delay_buffers[ch] + div_start + i;
-				sample = Q_SHIFT_LEFT((int32_t)*sample16_p, 15, 31);
+		for (ch = 0; ch < nch; ch++) {
+			sample16_p = (int16_t *)state->pre_delay_buffers[ch] + div_start;
+			for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+				sample = Q_SHIFT_LEFT((int32_t)sample16_p[i], 15, 31);
 				abs_input_array[i] = MAX(abs_input_array[i], ABS(sample));
 			}
 		}
 	} else { /* 4 bytes per sample */
-		for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
-			abs_input_array[i] = 0;
-			for (ch = 0; ch < nch; ch++) {
-				sample32_p =
-					(int32_t *)state->pre_delay_buffers[ch] + div_start + i;
-				sample = *sample32_p;
+		for (ch = 0; ch < nch; ch++) {
+			sample32_p = (int32_t *)state->pre_delay_buffers[ch] + div_start;
+			for (i = 0; i < DRC_DIVISION_FRAMES; i++) {
+				sample = sample32_p[i];
 				abs_input_array[i] = MAX(abs_input_array[i], ABS(sample));
 			}
 		}
@@ -259,195 +261,98 @@ void drc_update_envelope(struct drc_state *state, const struct sof_drc_params *p
 	state->scaled_desired_gain = scaled_desired_gain;
 }
 
+/* Apply the per-frame gain of one division to the linear pre-delay buffer of
+ * one channel.
+ */
+static void drc_apply_gain_s16(int16_t *x, const int32_t *gain)
+{
+	int i;
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		x[i] = sat_int16(Q_MULTSR_32X32((int64_t)x[i], gain[i], 15, 24, 15));
+}
+
+static void drc_apply_gain_s32(int32_t *x, const int32_t *gain)
+{
+	int i;
+
+	for (i = 0; i < DRC_DIVISION_FRAMES; i++)
+		x[i] = sat_int32(Q_MULTSR_32X32((int64_t)x[i], gain[i], 31, 24, 31));
+}
+
 /* Calculate compress_gain from the envelope and apply total_gain to compress
- * the next output division. */
+ * the next output division. The gain envelope is evaluated once for the whole
+ * division and then applied to every channel in a separate pass.
+ */
 void drc_compress_output(struct drc_state *state,
 			 const struct sof_drc_params *p,
 			 int nbyte,
 			 int nch)
 {
 	const int div_start = state->pre_delay_read_index;
-	int count = DRC_DIVISION_FRAMES >> 2;
-
+	const int count = DRC_DIVISION_FRAMES >> 2;
+	int32_t total_gain[DRC_DIVISION_FRAMES]; /* Q8.24 */
 	int32_t c, base, r, r2, r4; /* Q2.30 */
 	int32_t x[4]; /* Q2.30 */
 	int32_t post_warp_compressor_gain;
-	int32_t total_gain;
-
+	int is_release = state->envelope_rate >= ONE_Q30;
 	int i, j, ch, inc;
-	int16_t *sample16_p; /* for s16 format case */
-	int32_t *sample32_p; /* for s24 and s32 format cases */
-	int32_t sample;
-	int is_2byte = (nbyte == 2); /* otherwise is 4-bytes */
 
 	/* Exponential approach to desired gain. */
-	if (state->envelope_rate < ONE_Q30) {
+	if (!is_release) {
 		/* Attack - reduce gain to desired. */
 		c = state->compressor_gain - state->scaled_desired_gain;
 		base = state->scaled_desired_gain;
 		r = ONE_Q30 - state->envelope_rate;
-		x[0] = Q_MULTSR_32X32((int64_t)c,  r, 30, 30, 30);
-		for (j = 1; j < 4; j++)
-			x[j] = Q_MULTSR_32X32((int64_t)x[j - 1], r, 30, 30, 30);
-		r2 = Q_MULTSR_32X32((int64_t)r, r, 30, 30, 30);
-		r4 = Q_MULTSR_32X32((int64_t)r2, r2, 30, 30, 30);
-
-		i = 0;
-		inc = 0;
-		if (is_2byte) { /* 2 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain =
-						drc_sin_fixed(x[j] + base); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					total_gain = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
-								    post_warp_compressor_gain,
-								    24, 31, 24); /* Q8.24 */
-
-					/* Apply final gain. */
-					for (ch = 0; ch < nch; ch++) {
-						sample16_p =
-							(int16_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = (int32_t)*sample16_p;
-						*sample16_p =
-							sat_int16(Q_MULTSR_32X32((int64_t)sample,
-										 total_gain,
-										 15, 24, 15));
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
-
-				for (j = 0; j < 4; j++)
-					x[j] = Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30);
-			}
-		} else { /* 4 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain =
-						drc_sin_fixed(x[j] + base); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					total_gain = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
-								    post_warp_compressor_gain,
-								    24, 31, 24); /* Q8.24 */
-
-					/* Apply final gain. */
-					for (ch = 0; ch < nch; ch++) {
-						sample32_p =
-							(int32_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = *sample32_p;
-						*sample32_p =
-							sat_int32(Q_MULTSR_32X32((int64_t)sample,
-										 total_gain,
-										 31, 24, 31));
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
-
-				for (j = 0; j < 4; j++)
-					x[j] = Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30);
-			}
-		}
-
-		state->compressor_gain = x[3] + base;
 	} else {
 		/* Release - exponentially increase gain to 1.0 */
 		c = state->compressor_gain;
+		base = 0;
 		r = state->envelope_rate;
-		x[0] = Q_MULTSR_32X32((int64_t)c,  r, 30, 30, 30);
-		for (j = 1; j < 4; j++)
-			x[j] = Q_MULTSR_32X32((int64_t)x[j - 1], r, 30, 30, 30);
-		r2 = Q_MULTSR_32X32((int64_t)r, r, 30, 30, 30);
-		r4 = Q_MULTSR_32X32((int64_t)r2, r2, 30, 30, 30);
-
-		i = 0;
-		inc = 0;
-		if (is_2byte) { /* 2 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain = drc_sin_fixed(x[j]); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					total_gain = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
-								    post_warp_compressor_gain,
-								    24, 31, 24); /* Q8.24 */
-
-					/* Apply final gain. */
-					for (ch = 0; ch < nch; ch++) {
-						sample16_p =
-							(int16_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = (int32_t)*sample16_p;
-						*sample16_p =
-							sat_int16(Q_MULTSR_32X32((int64_t)sample,
-										 total_gain,
-										 15, 24, 15));
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
+	}
 
-				for (j = 0; j < 4; j++)
-					x[j] = MIN(ONE_Q30,
-						   Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30));
-			}
-		} else { /* 4 bytes per sample */
-			while (1) {
-				for (j = 0; j < 4; j++) {
-					/* Warp pre-compression gain to smooth out sharp
-					 * exponential transition points.
-					 */
-					post_warp_compressor_gain = drc_sin_fixed(x[j]); /* Q1.31 */
-
-					/* Calculate total gain using master gain. */
-					total_gain = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
-								    post_warp_compressor_gain,
-								    24, 31, 24); /* Q8.24 */
-
-					/* Apply final gain. */
-					for (ch = 0; ch < nch; ch++) {
-						sample32_p =
-							(int32_t *)state->pre_delay_buffers[ch] +
-								div_start + inc;
-						sample = *sample32_p;
-						*sample32_p =
-							sat_int32(Q_MULTSR_32X32((int64_t)sample,
-										 total_gain,
-										 31, 24, 31));
-					}
-					inc++;
-				}
-
-				if (++i == count)
-					break;
+	x[0] = Q_MULTSR_32X32((int64_t)c,  r, 30, 30, 30);
+	for (j = 1; j < 4; j++)
+		x[j] = Q_MULTSR_32X32((int64_t)x[j - 1], r, 30, 30, 30);
+	r2 = Q_MULTSR_32X32((int64_t)r, r, 30, 30, 30);
+	r4 = Q_MULTSR_32X32((int64_t)r2, r2, 30, 30, 30);
+
+	inc = 0;
+	for (i = 0; i < count; i++) {
+		if (i) {
+			for (j = 0; j < 4; j++)
+				x[j] = Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30);
 
+			/* Release gain can't exceed 1.0 */
+			if (is_release)
 				for (j = 0; j < 4; j++)
-					x[j] = MIN(ONE_Q30,
-						   Q_MULTSR_32X32((int64_t)x[j], r4, 30, 30, 30));
-			}
+					x[j] = MIN(ONE_Q30, x[j]);
 		}
 
-		state->compressor_gain = x[3];
+		for (j = 0; j < 4; j++) {
+			/* Warp pre-compression gain to smooth out sharp
+			 * exponential transition points.
+			 */
+			post_warp_compressor_gain = drc_sin_fixed(x[j] + base); /* Q1.31 */
+
+			/* Calculate total gain using master gain. */
+			total_gain[inc++] = Q_MULTSR_32X32((int64_t)p->master_linear_gain,
+							   post_warp_compressor_gain,
+							   24, 31, 24); /* Q8.24 */
+		}
+	}
+
+	state->compressor_gain = x[3] + base;
+
+	/* Apply final gain. */
+	if (nbyte == 2) {
+		for (ch = 0; ch < nch; ch++)
+			drc_apply_gain_s16((int16_t *)state->pre_delay_buffers[ch] + div_start,
+					   total_gain);
+	} else {
+		for (ch = 0; ch < nch; ch++)
+			drc_apply_gain_s32((int32_t *)state->pre_delay_buffers[ch] + div_start,
+					   total_gain);
 	}
 }
 
@@ -68,8 +68,9 @@ static int eq_iir_init(struct processing_module *mod)
 	 */
 	comp_data_blob_set_validator(cd->model_handler, eq_iir_validate_config);
 
+	cd->num_groups = 0;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
-		iir_reset_df1(&cd->iir[i]);
+		iir_reset_df1(&cd->group[i].iir);
 
 	return 0;
 }
@@ -224,8 +225,9 @@ static int eq_iir_reset(struct processing_module *mod)
 	eq_iir_free_delaylines(mod);
 
 	cd->eq_iir_func = NULL;
+	cd->num_groups = 0;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
-		iir_reset_df1(&cd->iir[i]);
+		iir_reset_df1(&cd->group[i].iir);
 
 	return 0;
 }
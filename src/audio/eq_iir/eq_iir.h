@@ -33,9 +33,18 @@ struct eq_iir_func_map {
 	eq_iir_func func;			/**< processing function */
 };
 
+/** \brief Stream channels that share the same IIR response. */
+struct eq_iir_group {
+	struct iir_state_df1 iir;		/**< response coefficients */
+	int32_t *delay;				/**< delay lines of all channels */
+	int num_channels;			/**< number of channels in group */
+	uint8_t channel[PLATFORM_MAX_CHANNELS];	/**< stream channel indices */
+};
+
 /* IIR component private data */
 struct comp_data {
-	struct iir_state_df1 iir[PLATFORM_MAX_CHANNELS]; /**< filters state */
+	struct eq_iir_group group[PLATFORM_MAX_CHANNELS]; /**< filters state */
+	int num_groups;				/**< number of filtered groups */
 	struct comp_data_blob_handler *model_handler;
 	struct sof_eq_iir_config *config;
 	int32_t *iir_delay;			/**< pointer to allocated RAM */
@@ -48,6 +57,31 @@ struct comp_data {
 void sys_comp_module_eq_iir_interface_init(void);
 #endif
 
+/**
+ * \brief Filters one frame of samples with all channel groups.
+ *
+ * Channels set to bypass are not part of any group and are left as is.
+ * \param[in] cd IIR component private data.
+ * \param[in,out] frame Q1.31 samples of all channels of the frame.
+ */
+static inline void eq_iir_process_frame(struct comp_data *cd, int32_t *frame)
+{
+	struct eq_iir_group *group;
+	int32_t data[PLATFORM_MAX_CHANNELS];
+	int g;
+	int i;
+
+	for (g = 0; g < cd->num_groups; g++) {
+		group = &cd->group[g];
+		for (i = 0; i < group->num_channels; i++)
+			data[i] = frame[group->channel[i]];
+
+		iir_df1_nch(&group->iir, group->delay, data, group->num_channels);
+		for (i = 0; i < group->num_channels; i++)
+			frame[group->channel[i]] = data[i];
+	}
+}
+
 void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffer *bsource,
 			struct output_stream_buffer *bsink, uint32_t frames);
 
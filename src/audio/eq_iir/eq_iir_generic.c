@@ -44,9 +44,7 @@ void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffe
 	struct comp_data *cd = module_get_private_data(mod);
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
-	struct iir_state_df1 *filter;
-	int16_t *x0;
-	int16_t *y0;
+	int32_t frame[PLATFORM_MAX_CHANNELS];
 	int16_t *x;
 	int16_t *y;
 	int nmax;
@@ -67,19 +65,20 @@ void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffe
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 1;
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s16(filter, *x0);
-				x0 += nch;
-				y0 += nch;
-			}
+		for (j = 0; j < n; j += nch) {
+			for (i = 0; i < nch; i++)
+				frame[i] = ((int32_t)x[i]) << 16;
+
+			eq_iir_process_frame(cd, frame);
+			for (i = 0; i < nch; i++)
+				y[i] = iir_df1_q31_to_s16(frame[i]);
+
+			x += nch;
+			y += nch;
 		}
 		processed += n;
-		x = audio_stream_wrap(source, x + n);
-		y = audio_stream_wrap(sink, y + n);
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
 	}
 }
 #endif /* CONFIG_FORMAT_S16LE */
@@ -92,9 +91,7 @@ void eq_iir_s24_default(struct processing_module *mod, struct input_stream_buffe
 	struct comp_data *cd = module_get_private_data(mod);
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
-	struct iir_state_df1 *filter;
-	int32_t *x0;
-	int32_t *y0;
+	int32_t frame[PLATFORM_MAX_CHANNELS];
 	int32_t *x;
 	int32_t *y;
 	int nmax;
@@ -115,19 +112,20 @@ void eq_iir_s24_default(struct processing_module *mod, struct input_stream_buffe
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 2;
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s24(filter, *x0);
-				x0 += nch;
-				y0 += nch;
-			}
+		for (j = 0; j < n; j += nch) {
+			for (i = 0; i < nch; i++)
+				frame[i] = x[i] << 8;
+
+			eq_iir_process_frame(cd, frame);
+			for (i = 0; i < nch; i++)
+				y[i] = iir_df1_q31_to_s24(frame[i]);
+
+			x += nch;
+			y += nch;
 		}
 		processed += n;
-		x = audio_stream_wrap(source, x + n);
-		y = audio_stream_wrap(sink, y + n);
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
 	}
 }
 #endif /* CONFIG_FORMAT_S24LE */
@@ -140,9 +138,7 @@ void eq_iir_s32_default(struct processing_module *mod, struct input_stream_buffe
 	struct comp_data *cd = module_get_private_data(mod);
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
-	struct iir_state_df1 *filter;
-	int32_t *x0;
-	int32_t *y0;
+	int32_t frame[PLATFORM_MAX_CHANNELS];
 	int32_t *x;
 	int32_t *y;
 	int nmax;
@@ -163,19 +159,20 @@ void eq_iir_s32_default(struct processing_module *mod, struct input_stream_buffe
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 2;
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1(filter, *x0);
-				x0 += nch;
-				y0 += nch;
-			}
+		for (j = 0; j < n; j += nch) {
+			for (i = 0; i < nch; i++)
+				frame[i] = x[i];
+
+			eq_iir_process_frame(cd, frame);
+			for (i = 0; i < nch; i++)
+				y[i] = frame[i];
+
+			x += nch;
+			y += nch;
 		}
 		processed += n;
-		x = audio_stream_wrap(source, x + n);
-		y = audio_stream_wrap(sink, y + n);
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE */
@@ -349,13 +346,15 @@ static int eq_iir_init_coef(struct processing_module *mod, int nch)
 {
 	struct comp_data *cd = module_get_private_data(mod);
 	struct sof_eq_iir_config *config = cd->config;
-	struct iir_state_df1 *iir = cd->iir;
 	struct sof_eq_iir_header *lookup[SOF_EQ_IIR_MAX_RESPONSES];
 	struct sof_eq_iir_header *eq;
+	struct eq_iir_group *group;
+	int32_t group_response[PLATFORM_MAX_CHANNELS];
 	int32_t *assign_response;
 	int size_sum = 0;
 	int resp = 0;
 	int i;
+	int g;
 	int s;
 	int ret;
 
@@ -372,6 +371,7 @@ static int eq_iir_init_coef(struct processing_module *mod, int nch)
 		return ret;
 
 	/* Initialize 1st phase */
+	cd->num_groups = 0;
 	assign_response = ASSUME_ALIGNED(&config->data[0], 4);
 	for (i = 0; i < nch; i++) {
 		/* Check for not reading past blob response to channel assign
@@ -384,11 +384,10 @@ static int eq_iir_init_coef(struct processing_module *mod, int nch)
 			resp = assign_response[i];
 
 		if (resp < 0) {
-			/* Initialize EQ channel to bypass and continue with
-			 * next channel response.
+			/* A bypass channel is not added to any group and
+			 * continue with next channel response.
 			 */
 			comp_info(mod->dev, "ch %d is set to bypass", i);
-			iir_reset_df1(&iir[i]);
 			continue;
 		}
 
@@ -409,42 +408,61 @@ static int eq_iir_init_coef(struct processing_module *mod, int nch)
 			return -EINVAL;
 		}
 
-		iir_init_coef_df1(&iir[i], eq);
+		/* Channels with the same response are filtered together so
+		 * find the group or start a new one.
+		 */
+		for (g = 0; g < cd->num_groups; g++) {
+			if (group_response[g] == resp)
+				break;
+		}
+
+		group = &cd->group[g];
+		if (g == cd->num_groups) {
+			iir_init_coef_df1(&group->iir, eq);
+			group->num_channels = 0;
+			group_response[g] = resp;
+			cd->num_groups++;
+		}
+
+		group->channel[group->num_channels++] = i;
 		comp_info(mod->dev, "ch %d is set to response %d", i, resp);
 	}
 
 	return size_sum;
 }
 
-static void eq_iir_init_delay(struct iir_state_df1 *iir,
-			      int32_t *delay_start, int nch)
+static void eq_iir_init_delay(struct comp_data *cd, int32_t *delay_start)
 {
+	struct eq_iir_group *group;
 	int32_t *delay = delay_start;
-	int i;
+	int g;
 
-	/* Initialize second phase to set EQ delay lines pointers. A
-	 * bypass mode filter is indicated by biquads count of zero.
+	/* Initialize second phase to set EQ delay lines pointers. The
+	 * delay lines of a group are stored biquad by biquad for all
+	 * channels of the group.
 	 */
-	for (i = 0; i < nch; i++) {
-		if (iir[i].biquads > 0)
-			iir_init_delay_df1(&iir[i], &delay);
+	for (g = 0; g < cd->num_groups; g++) {
+		group = &cd->group[g];
+		group->delay = delay;
+		delay += IIR_DF1_NUM_STATE * group->iir.biquads * group->num_channels;
 	}
 }
 
 void eq_iir_free_delaylines(struct processing_module *mod)
 {
 	struct comp_data *cd = module_get_private_data(mod);
-	struct iir_state_df1 *iir = cd->iir;
 	int i = 0;
 
 	/* Free the common buffer for all EQs and point then
-	 * each IIR channel delay line to NULL.
+	 * each IIR group delay line to NULL. Without delay lines
+	 * there are no groups to filter.
 	 */
 	mod_free(mod, cd->iir_delay);
 	cd->iir_delay = NULL;
 	cd->iir_delay_size = 0;
+	cd->num_groups = 0;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
-		iir[i].delay = NULL;
+		cd->group[i].delay = NULL;
 }
 
 void eq_iir_pass(struct processing_module *mod, struct input_stream_buffer *bsource,
@@ -469,8 +487,10 @@ int eq_iir_setup(struct processing_module *mod, int nch)
 	 * sanity checks, including config->size vs cd->config_size.
 	 */
 	delay_size = eq_iir_init_coef(mod, nch);
-	if (delay_size < 0)
+	if (delay_size < 0) {
+		cd->num_groups = 0;
 		return delay_size; /* Contains error code */
+	}
 
 	/* If all channels were set to bypass there's no need to
 	 * allocate delay. Just return with success.
@@ -482,13 +502,14 @@ int eq_iir_setup(struct processing_module *mod, int nch)
 	cd->iir_delay = mod_zalloc(mod, delay_size);
 	if (!cd->iir_delay) {
 		comp_err(mod->dev, "delay allocation fail");
+		cd->num_groups = 0;
 		return -ENOMEM;
 	}
 
 	cd->iir_delay_size = delay_size;
 
-	/* Assign delay line to each channel EQ */
-	eq_iir_init_delay(cd->iir, cd->iir_delay, nch);
+	/* Assign delay lines to each group of channels */
+	eq_iir_init_delay(cd, cd->iir_delay);
 	return 0;
 }
 
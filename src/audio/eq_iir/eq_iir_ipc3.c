@@ -44,9 +44,7 @@ static void eq_iir_s32_16_default(struct processing_module *mod,
 	struct comp_data *cd = module_get_private_data(mod);
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
-	struct iir_state_df1 *filter;
-	int32_t *x0;
-	int16_t *y0;
+	int32_t frame[PLATFORM_MAX_CHANNELS];
 	int32_t *x;
 	int16_t *y;
 	int nmax;
@@ -67,19 +65,20 @@ static void eq_iir_s32_16_default(struct processing_module *mod,
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 1; /* divide 2 */
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s32_s16(filter, *x0);
-				x0 += nch;
-				y0 += nch;
-			}
+		for (j = 0; j < n; j += nch) {
+			for (i = 0; i < nch; i++)
+				frame[i] = x[i];
+
+			eq_iir_process_frame(cd, frame);
+			for (i = 0; i < nch; i++)
+				y[i] = iir_df1_q31_to_s16(frame[i]);
+
+			x += nch;
+			y += nch;
 		}
 		processed += n;
-		x = audio_stream_wrap(source, x + n);
-		y = audio_stream_wrap(sink, y + n);
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S16LE */
@@ -92,9 +91,7 @@ static void eq_iir_s32_24_default(struct processing_module *mod,
 	struct comp_data *cd = module_get_private_data(mod);
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
-	struct iir_state_df1 *filter;
-	int32_t *x0;
-	int32_t *y0;
+	int32_t frame[PLATFORM_MAX_CHANNELS];
 	int32_t *x;
 	int32_t *y;
 	int nmax;
@@ -115,19 +112,20 @@ static void eq_iir_s32_24_default(struct processing_module *mod,
 		n2 = audio_stream_bytes_without_wrap(sink, y) >> 2;
 		n = MIN(n1, n2);
 		n = MIN(n, nmax);
-		for (i = 0; i < nch; i++) {
-			x0 = x + i;
-			y0 = y + i;
-			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s32_s24(filter, *x0);
-				x0 += nch;
-				y0 += nch;
-			}
+		for (j = 0; j < n; j += nch) {
+			for (i = 0; i < nch; i++)
+				frame[i] = x[i];
+
+			eq_iir_process_frame(cd, frame);
+			for (i = 0; i < nch; i++)
+				y[i] = iir_df1_q31_to_s24(frame[i]);
+
+			x += nch;
+			y += nch;
 		}
 		processed += n;
-		x = audio_stream_wrap(source, x + n);
-		y = audio_stream_wrap(sink, y + n);
+		x = audio_stream_wrap(source, x);
+		y = audio_stream_wrap(sink, y);
 	}
 }
 #endif /* CONFIG_FORMAT_S32LE && CONFIG_FORMAT_S24LE */
@@ -14,12 +14,13 @@
 #include <rtos/symbol.h>
 #include <rtos/mutex.h>
 #include <sof/compiler_attributes.h>
-#include <sof/objpool.h>
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/audio/data_blob.h>
 #include <sof/lib/fast-get.h>
 #include <sof/lib/vregion.h>
+#include <sof/llext_manager.h>
 #include <sof/schedule/dp_schedule.h>
+#include <rtos/timer.h>
 #if CONFIG_IPC_MAJOR_4
 #include <ipc4/header.h>
 #include <ipc4/module.h>
@@ -29,14 +30,67 @@
 LOG_MODULE_DECLARE(module_adapter, CONFIG_SOF_LOG_LEVEL);
 
 /*
- * A single lock shared by all module resource pools. The resource API is only
- * ever entered from supervisor context (the z_impl_* syscall bodies), so the
- * lock does not need to live in the per-module, user-writable struct - a static
- * kernel object serialises all pools. Contention is negligible because resource
- * bookkeeping only happens at module setup/teardown, not on the processing path.
+ * The allocations of a module are recorded in a table of its own, with open
+ * addressing keyed by the pointer, so freeing finds the record in constant
+ * time. The resource API is only ever entered from supervisor context (the
+ * z_impl_* syscall bodies), so the lock does not need to live in the
+ * per-module, user-writable struct - static kernel objects, one per core,
+ * serialise the tables of the modules on that core. The lock is held only
+ * while records move, never across heap calls.
  */
+static struct k_spinlock mod_res_locks[CONFIG_CORE_COUNT];
+
+/* Initial number of record slots, the table is kept at most half full */
+#define MOD_RES_TABLE_MIN 8
+
+static struct k_spinlock *mod_res_lock_get(struct processing_module *mod)
+{
+	unsigned int core = mod->dev->ipc_config.core;
+
+	return &mod_res_locks[core < CONFIG_CORE_COUNT ? core : 0];
+}
+
+/*
+ * The tables come from the module heap and not from its allocation context:
+ * a vregion in lifetime mode would never reuse the tables left by growth.
+ */
+static struct module_resource *mod_res_table_alloc(struct module_resources *res,
+						   unsigned int size)
+{
+	struct module_resource *table = sof_heap_alloc(res->alloc->heap, 0,
+						       size * sizeof(*table), 0);
+
+	if (table)
+		memset(table, 0, size * sizeof(*table));
+
+	return table;
+}
+
+static void mod_res_table_free(struct module_resources *res, struct module_resource *table)
+{
+	sof_heap_free(res->alloc->heap, table);
+}
+
+#if CONFIG_MODULE_MEMORY_API_ARENA
+/* Arena size hints are shared by all modules, they change at setup only */
 static K_MUTEX_DEFINE(mod_res_lock);
 
+/* Smallest alignment of arena allocations, like heap chunks */
+#define MOD_ARENA_ALIGN 8
+
+/* Arena size learned from the init and prepare of a module type and configuration */
+struct mod_arena_hint {
+	struct sof_uuid uuid;
+	uint32_t cfg_hash;
+	size_t size;
+	size_t align;
+};
+
+/* protected by mod_res_lock */
+static struct mod_arena_hint mod_arena_hints[CONFIG_MODULE_MEMORY_API_ARENA_HINTS];
+static unsigned int mod_arena_hint_next;
+#endif
+
 int module_load_config(struct comp_dev *dev, const void *cfg, size_t size)
 {
 	int ret;
@@ -83,17 +137,244 @@ int module_load_config(struct comp_dev *dev, const void *cfg, size_t size)
 	return ret;
 }
 
+#if CONFIG_SOF_HEAP_STATS
+static void mod_stats_alloc(struct module_resources *res, size_t bytes, uint32_t start)
+{
+	heap_stats_alloc(&res->stats, bytes, (uint32_t)sof_cycle_get_64() - start);
+}
+
+static void mod_stats_free(struct module_resources *res, size_t bytes)
+{
+	heap_stats_free(&res->stats, bytes);
+}
+
+void mod_stats_register(struct processing_module *mod, uint32_t id)
+{
+	heap_stats_register(&mod->priv.resources.stats, HEAP_STATS_MODULE, id, 0, NULL);
+}
+
+void mod_stats_unregister(struct processing_module *mod)
+{
+	heap_stats_unregister(&mod->priv.resources.stats);
+}
+#else
+static inline void mod_stats_alloc(struct module_resources *res, size_t bytes,
+				   uint32_t start) {}
+static inline void mod_stats_free(struct module_resources *res, size_t bytes) {}
+#endif
+
 void mod_resource_init(struct processing_module *mod)
 {
 	struct module_resources *res = &mod->priv.resources;
 
-	/* Init memory list */
-	list_init(&res->objpool.list);
-	res->objpool.heap = res->alloc->heap;
-	res->objpool.vreg = res->alloc->vreg;
+	/* Init allocation records */
+	res->table = NULL;
+	res->table_size = 0;
+	res->count = 0;
 	res->heap_usage = 0;
 	res->heap_high_water_mark = 0;
+#if CONFIG_MODULE_MEMORY_API_ARENA
+	memset(&res->arena, 0, sizeof(res->arena));
+#endif
+}
+
+#if CONFIG_MODULE_MEMORY_API_ARENA
+/* FNV-1a of the init configuration, instances with other settings need other sizes */
+static uint32_t mod_arena_cfg_hash(struct processing_module *mod)
+{
+	const struct module_config *cfg = &mod->priv.cfg;
+	const uint8_t *data = cfg->data;
+	uint32_t hash = 2166136261u;
+	size_t i;
+
+#if CONFIG_IPC_MAJOR_4
+	for (i = 0; i < sizeof(cfg->base_cfg); i++)
+		hash = (hash ^ ((const uint8_t *)&cfg->base_cfg)[i]) * 16777619u;
+#endif
+	for (i = 0; data && i < cfg->size; i++)
+		hash = (hash ^ data[i]) * 16777619u;
+
+	return hash;
+}
+
+static struct mod_arena_hint *mod_arena_hint_find(const struct sof_uuid *uuid,
+						  uint32_t cfg_hash)
+{
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(mod_arena_hints); i++)
+		if (mod_arena_hints[i].size && mod_arena_hints[i].cfg_hash == cfg_hash &&
+		    !memcmp(&mod_arena_hints[i].uuid, uuid, sizeof(*uuid)))
+			return &mod_arena_hints[i];
+
+	return NULL;
+}
+
+/*
+ * The block comes from the module allocation context. Modules with a vregion,
+ * DP modules in userspace builds, get it from the vregion lifetime allocator
+ * as the arena is opened before init, when the vregion is still in lifetime
+ * mode. lifetime_alloc() is private to the vregion and there is no vregion for
+ * LL modules or without CONFIG_SOF_VREGIONS, those use the module heap.
+ */
+static int mod_arena_create(struct processing_module *mod, size_t size, size_t alignment)
+{
+	struct module_resources *res = &mod->priv.resources;
+	struct mod_arena *arena = &res->arena;
+	struct k_spinlock *lock = mod_res_lock_get(mod);
+	k_spinlock_key_t key;
+	uint32_t start;
+
+	if (arena->base)
+		return -EBUSY;
+
+	if (!size)
+		return -EINVAL;
+
+	start = (uint32_t)sof_cycle_get_64();
+	arena->base = sof_ctx_alloc(res->alloc, SOF_MEM_FLAG_USER, size, alignment);
+
+	key = k_spin_lock(lock);
+	mod_stats_alloc(res, arena->base ? size : 0, start);
+	if (!arena->base) {
+		k_spin_unlock(lock, key);
+		return -ENOMEM;
+	}
+
+	arena->size = size;
+	arena->used = 0;
+	arena->last = 0;
+
+	res->heap_usage += size;
+	if (res->heap_usage > res->heap_high_water_mark)
+		res->heap_high_water_mark = res->heap_usage;
+	k_spin_unlock(lock, key);
+
+	return 0;
+}
+
+/**
+ * Reserves the arena block for module init and prepare allocations.
+ * @param mod	Pointer to the module.
+ * @param size	Size of the block in bytes, e.g. from a size hint of the module.
+ * @return 0 on success, error code if the arena already has a block or on
+ *	   allocation failure.
+ *
+ * Without a reserved block the arena size is learned from the last
+ * instance of the module type with the same init configuration and
+ * reserved for the next ones.
+ */
+int mod_arena_reserve(struct processing_module *mod, size_t size)
+{
+	return mod_arena_create(mod, size, 0);
+}
+
+/* Reserve the learned size and take the allocations of init from the arena */
+static void mod_arena_open(struct processing_module *mod)
+{
+	const struct sof_uuid *uuid = mod->dev->drv->uid;
+	struct mod_arena_hint *hint;
+	size_t alignment = 0;
+	size_t size = 0;
+
+	if (uuid) {
+		k_mutex_lock(&mod_res_lock, K_FOREVER);
+		hint = mod_arena_hint_find(uuid, mod_arena_cfg_hash(mod));
+		if (hint) {
+			size = hint->size;
+			alignment = hint->align;
+		}
+		k_mutex_unlock(&mod_res_lock);
+	}
+
+	/* without a block the allocations are counted for the next instances */
+	if (size && mod_arena_create(mod, size, alignment) == -ENOMEM)
+		comp_warn(mod->dev, "no memory for %zu bytes arena", size);
+
+	mod->priv.resources.arena.open = true;
+}
+
+/* Allocations after the first prepare come from the heap, learn the size */
+static void mod_arena_close(struct processing_module *mod, bool learn)
+{
+	struct mod_arena *arena = &mod->priv.resources.arena;
+	const struct sof_uuid *uuid = mod->dev->drv->uid;
+	struct mod_arena_hint *hint;
+	uint32_t cfg_hash;
+
+	if (!arena->open)
+		return;
+
+	arena->open = false;
+
+	comp_dbg(mod->dev, "arena used %zu of %zu, needed %zu",
+		 arena->used, arena->size, arena->need);
+
+	if (!learn || !uuid || !arena->need)
+		return;
+
+	cfg_hash = mod_arena_cfg_hash(mod);
+
+	k_mutex_lock(&mod_res_lock, K_FOREVER);
+	hint = mod_arena_hint_find(uuid, cfg_hash);
+	if (!hint) {
+		hint = &mod_arena_hints[mod_arena_hint_next];
+		mod_arena_hint_next = (mod_arena_hint_next + 1) % ARRAY_SIZE(mod_arena_hints);
+		hint->uuid = *uuid;
+		hint->cfg_hash = cfg_hash;
+	}
+
+	/* follow the last instance, so the hint shrinks when less is needed */
+	hint->size = arena->need;
+	hint->align = arena->align;
+	k_mutex_unlock(&mod_res_lock);
+}
+
+/*
+ * The arena is only changed by the init, prepare and free of its module,
+ * which never run concurrently, so it needs no lock.
+ */
+static void *mod_arena_alloc(struct mod_arena *arena, size_t size, size_t alignment)
+{
+	size_t offset;
+
+	if (!arena->open)
+		return NULL;
+
+	alignment = MAX(alignment, MOD_ARENA_ALIGN);
+	arena->align = MAX(arena->align, alignment);
+	arena->need = ALIGN_UP(arena->need, alignment) + size;
+
+	if (!arena->base)
+		return NULL;
+
+	offset = ALIGN_UP((uintptr_t)arena->base + arena->used, alignment) -
+		(uintptr_t)arena->base;
+	if (offset + size > arena->size)
+		return NULL;
+
+	arena->last = offset;
+	arena->used = offset + size;
+
+	return arena->base + offset;
+}
+
+/* Memory of the arena is freed with the module, only the last allocation can be reused */
+static bool mod_arena_free(struct mod_arena *arena, const void *ptr)
+{
+	if (!arena->base || (const uint8_t *)ptr < arena->base ||
+	    (const uint8_t *)ptr >= arena->base + arena->size)
+		return false;
+
+	if (ptr == arena->base + arena->last)
+		arena->used = arena->last;
+
+	return true;
 }
+#else
+static inline void mod_arena_open(struct processing_module *mod) {}
+static inline void mod_arena_close(struct processing_module *mod, bool learn) {}
+#endif
 
 int module_init(struct processing_module *mod)
 {
@@ -122,6 +403,9 @@ int module_init(struct processing_module *mod)
 		return -EIO;
 	}
 
+	/* allocations of init and prepare come from the module arena */
+	mod_arena_open(mod);
+
 	/* Now we can proceed with module specific initialization */
 #if CONFIG_SOF_USERSPACE_APPLICATION
 	if (mod->dev->ipc_config.proc_domain == COMP_PROCESSING_DOMAIN_DP)
@@ -144,14 +428,141 @@ int module_init(struct processing_module *mod)
 	return 0;
 }
 
-static struct module_resource *container_get(struct processing_module *mod)
+static unsigned int mod_res_hash(const void *ptr, unsigned int table_size)
+{
+	uint32_t h = (uint32_t)(uintptr_t)ptr;
+
+	/* pointers are aligned, mix the upper bits into the index bits */
+	h ^= h >> 16;
+	h *= 0x45d9f3b;
+	h ^= h >> 16;
+
+	return h & (table_size - 1);
+}
+
+/* Put a record in the first free slot from its hash on, a free slot must exist */
+static void mod_res_insert(struct module_resource *table, unsigned int table_size,
+			   const struct module_resource *rec)
+{
+	unsigned int i = mod_res_hash(rec->ptr, table_size);
+
+	while (table[i].type != MOD_RES_UNINITIALIZED)
+		i = (i + 1) & (table_size - 1);
+
+	table[i] = *rec;
+}
+
+/* Account a record leaving the table, called with the lock taken */
+static void mod_res_account_free(struct module_resources *res, const struct module_resource *rec)
+{
+	if (rec->type != MOD_RES_HEAP)
+		return;
+
+	res->heap_usage -= rec->size;
+	mod_stats_free(res, rec->size);
+}
+
+/* Record an allocation, the table doubles when it would get more than half full */
+static int mod_res_add(struct processing_module *mod, const struct module_resource *rec,
+		       uint32_t start)
+{
+	struct module_resources *res = &mod->priv.resources;
+	struct k_spinlock *lock = mod_res_lock_get(mod);
+	struct module_resource *table, *old;
+	k_spinlock_key_t key;
+	unsigned int size;
+	unsigned int i;
+
+	for (;;) {
+		key = k_spin_lock(lock);
+		if (2 * (res->count + 1) <= res->table_size)
+			break;
+
+		size = res->table_size ? 2 * res->table_size : MOD_RES_TABLE_MIN;
+		k_spin_unlock(lock, key);
+
+		/* the heap can block, the records are moved with the lock taken */
+		table = mod_res_table_alloc(res, size);
+		if (!table)
+			return -ENOMEM;
+
+		key = k_spin_lock(lock);
+		if (res->table_size < size) {
+			for (i = 0; i < res->table_size; i++)
+				if (res->table[i].type != MOD_RES_UNINITIALIZED)
+					mod_res_insert(table, size, &res->table[i]);
+
+			old = res->table;
+			res->table = table;
+			res->table_size = size;
+			table = old;
+		}
+		k_spin_unlock(lock, key);
+
+		/* the old table, or the new one when the table was grown meanwhile */
+		mod_res_table_free(res, table);
+	}
+
+	mod_res_insert(res->table, res->table_size, rec);
+	res->count++;
+
+	if (rec->type == MOD_RES_HEAP) {
+		mod_stats_alloc(res, rec->size, start);
+		res->heap_usage += rec->size;
+		if (res->heap_usage > res->heap_high_water_mark)
+			res->heap_high_water_mark = res->heap_usage;
+	}
+
+	k_spin_unlock(lock, key);
+
+	return 0;
+}
+
+/* Take the record of ptr out of the table, called with the lock taken */
+static bool mod_res_remove(struct module_resources *res, const void *ptr,
+			   struct module_resource *rec)
 {
-	return objpool_alloc(&mod->priv.resources.objpool, sizeof(struct module_resource), 0);
+	unsigned int mask = res->table_size - 1;
+	unsigned int i, j;
+
+	if (!res->table_size)
+		return false;
+
+	for (i = mod_res_hash(ptr, res->table_size); res->table[i].ptr != ptr;
+	     i = (i + 1) & mask)
+		if (res->table[i].type == MOD_RES_UNINITIALIZED)
+			return false;
+
+	*rec = res->table[i];
+	res->count--;
+	mod_res_account_free(res, rec);
+
+	/*
+	 * Fill the hole with the following records that cannot be found past
+	 * it, those whose hash slot is not after the hole.
+	 */
+	for (j = (i + 1) & mask; res->table[j].type != MOD_RES_UNINITIALIZED;
+	     j = (j + 1) & mask) {
+		if (((j - mod_res_hash(res->table[j].ptr, res->table_size)) & mask) >=
+		    ((j - i) & mask)) {
+			res->table[i] = res->table[j];
+			i = j;
+		}
+	}
+
+	memset(&res->table[i], 0, sizeof(res->table[i]));
+
+	return true;
 }
 
-static void container_put(struct processing_module *mod, struct module_resource *container)
+/* Record a failed allocation in the statistics */
+static void mod_res_alloc_failed(struct processing_module *mod, uint32_t start)
 {
-	objpool_free(&mod->priv.resources.objpool, container);
+	struct k_spinlock *lock = mod_res_lock_get(mod);
+	k_spinlock_key_t key = k_spin_lock(lock);
+
+	mod_stats_alloc(&mod->priv.resources, 0, start);
+	k_spin_unlock(lock, key);
 }
 
 #if CONFIG_USERSPACE
@@ -171,6 +582,38 @@ void mod_heap_info(struct processing_module *mod, size_t *size, uintptr_t *start
 }
 #endif
 
+static int free_contents(struct processing_module *mod, struct module_resource *container)
+{
+	struct module_resources *res = &mod->priv.resources;
+#if CONFIG_FAST_GET
+	struct k_mem_domain *mdom;
+#endif
+
+	switch (container->type) {
+	case MOD_RES_HEAP:
+		sof_ctx_free(res->alloc, container->ptr);
+		return 0;
+#if CONFIG_COMP_BLOB
+	case MOD_RES_BLOB_HANDLER:
+		comp_data_blob_handler_free(container->bhp);
+		return 0;
+#endif
+#if CONFIG_FAST_GET
+	case MOD_RES_FAST_GET:
+#if CONFIG_USERSPACE
+		mdom = mod->mdom;
+#else
+		mdom = NULL;
+#endif
+		fast_put(res->alloc, mdom, container->sram_ptr);
+		return 0;
+#endif
+	default:
+		comp_err(mod->dev, "Unknown resource type: %d", container->type);
+	}
+	return -EINVAL;
+}
+
 /**
  * Allocates aligned buffer memory block for module.
  * @param mod		Pointer to the module this memory block is allocated for.
@@ -185,44 +628,34 @@ void mod_heap_info(struct processing_module *mod, size_t *size, uintptr_t *start
 void *z_impl_mod_balloc_align(struct processing_module *mod, size_t size, size_t alignment)
 {
 	struct module_resources *res = &mod->priv.resources;
-	struct module_resource *container;
-
-	k_mutex_lock(&mod_res_lock, K_FOREVER);
-
-	container = container_get(mod);
-	if (!container) {
-		k_mutex_unlock(&mod_res_lock);
-		return NULL;
-	}
+	struct module_resource rec;
 
 	if (!size) {
 		comp_err(mod->dev, "requested allocation of 0 bytes.");
-		container_put(mod, container);
-		k_mutex_unlock(&mod_res_lock);
 		return NULL;
 	}
 
 	/* Allocate buffer memory for module */
+	uint32_t start = (uint32_t)sof_cycle_get_64();
 	void *ptr = sof_heap_alloc(res->alloc->heap, SOF_MEM_FLAG_USER | SOF_MEM_FLAG_LARGE_BUFFER,
 				   size, alignment);
 
 	if (!ptr) {
+		mod_res_alloc_failed(mod, start);
 		comp_err(mod->dev, "Failed to alloc %zu bytes %zu alignment for comp %#x.",
 			 size, alignment, dev_comp_id(mod->dev));
-		container_put(mod, container);
-		k_mutex_unlock(&mod_res_lock);
 		return NULL;
 	}
-	/* Store reference to allocated memory */
-	container->ptr = ptr;
-	container->size = size;
-	container->type = MOD_RES_HEAP;
 
-	res->heap_usage += size;
-	if (res->heap_usage > res->heap_high_water_mark)
-		res->heap_high_water_mark = res->heap_usage;
+	/* Store reference to allocated memory */
+	rec.ptr = ptr;
+	rec.size = size;
+	rec.type = MOD_RES_HEAP;
+	if (mod_res_add(mod, &rec, start) < 0) {
+		sof_heap_free(res->alloc->heap, ptr);
+		return NULL;
+	}
 
-	k_mutex_unlock(&mod_res_lock);
 	return ptr;
 }
 EXPORT_SYMBOL(z_impl_mod_balloc_align);
@@ -241,43 +674,43 @@ void *z_impl_mod_alloc_ext(struct processing_module *mod, uint32_t flags, size_t
 			   size_t alignment)
 {
 	struct module_resources *res = &mod->priv.resources;
-	struct module_resource *container;
+	struct module_resource rec;
 
-	k_mutex_lock(&mod_res_lock, K_FOREVER);
+#if CONFIG_MODULE_MEMORY_API_ARENA
+	/* the arena only holds default module memory */
+	if (size && flags == SOF_MEM_FLAG_USER) {
+		void *ptr = mod_arena_alloc(&res->arena, size, alignment);
 
-	container = container_get(mod);
-	if (!container) {
-		k_mutex_unlock(&mod_res_lock);
-		return NULL;
+		if (ptr)
+			return ptr;
 	}
+#endif
 
 	if (!size) {
 		comp_err(mod->dev, "requested allocation of 0 bytes.");
-		container_put(mod, container);
-		k_mutex_unlock(&mod_res_lock);
 		return NULL;
 	}
 
 	/* Allocate memory for module */
+	uint32_t start = (uint32_t)sof_cycle_get_64();
 	void *ptr = sof_ctx_alloc(res->alloc, flags, size, alignment);
 
 	if (!ptr) {
+		mod_res_alloc_failed(mod, start);
 		comp_err(mod->dev, "Failed to alloc %zu bytes %zu alignment for comp %#x.",
 			 size, alignment, dev_comp_id(mod->dev));
-		container_put(mod, container);
-		k_mutex_unlock(&mod_res_lock);
 		return NULL;
 	}
-	/* Store reference to allocated memory */
-	container->ptr = ptr;
-	container->size = size;
-	container->type = MOD_RES_HEAP;
 
-	res->heap_usage += size;
-	if (res->heap_usage > res->heap_high_water_mark)
-		res->heap_high_water_mark = res->heap_usage;
+	/* Store reference to allocated memory */
+	rec.ptr = ptr;
+	rec.size = size;
+	rec.type = MOD_RES_HEAP;
+	if (mod_res_add(mod, &rec, start) < 0) {
+		sof_ctx_free(res->alloc, ptr);
+		return NULL;
+	}
 
-	k_mutex_unlock(&mod_res_lock);
 	return ptr;
 }
 EXPORT_SYMBOL(z_impl_mod_alloc_ext);
@@ -293,28 +726,20 @@ EXPORT_SYMBOL(z_impl_mod_alloc_ext);
 struct comp_data_blob_handler *z_impl_mod_data_blob_handler_new(struct processing_module *mod)
 {
 	struct comp_data_blob_handler *bhp;
-	struct module_resource *container;
+	struct module_resource rec;
 
-	k_mutex_lock(&mod_res_lock, K_FOREVER);
-
-	container = container_get(mod);
-	if (!container) {
-		k_mutex_unlock(&mod_res_lock);
+	bhp = comp_data_blob_handler_new_ext(mod->dev, false, NULL, NULL);
+	if (!bhp)
 		return NULL;
-	}
 
-	bhp = comp_data_blob_handler_new_ext(mod->dev, false, NULL, NULL);
-	if (!bhp) {
-		container_put(mod, container);
-		k_mutex_unlock(&mod_res_lock);
+	rec.bhp = bhp;
+	rec.size = 0;
+	rec.type = MOD_RES_BLOB_HANDLER;
+	if (mod_res_add(mod, &rec, 0) < 0) {
+		comp_data_blob_handler_free(bhp);
 		return NULL;
 	}
 
-	container->bhp = bhp;
-	container->size = 0;
-	container->type = MOD_RES_BLOB_HANDLER;
-
-	k_mutex_unlock(&mod_res_lock);
 	return bhp;
 }
 EXPORT_SYMBOL(z_impl_mod_data_blob_handler_new);
@@ -332,91 +757,26 @@ const void *z_impl_mod_fast_get(struct processing_module *mod, const void * cons
 				size_t size)
 {
 	struct module_resources *res = &mod->priv.resources;
-	struct module_resource *container;
+	struct module_resource rec;
 	const void *ptr;
 
-	k_mutex_lock(&mod_res_lock, K_FOREVER);
-
-	container = container_get(mod);
-	if (!container) {
-		k_mutex_unlock(&mod_res_lock);
+	ptr = fast_get(res->alloc, dram_ptr, size);
+	if (!ptr)
 		return NULL;
-	}
 
-	ptr = fast_get(res->alloc, dram_ptr, size);
-	if (!ptr) {
-		container_put(mod, container);
-		k_mutex_unlock(&mod_res_lock);
+	rec.sram_ptr = ptr;
+	rec.size = 0;
+	rec.type = MOD_RES_FAST_GET;
+	if (mod_res_add(mod, &rec, 0) < 0) {
+		free_contents(mod, &rec);
 		return NULL;
 	}
 
-	container->sram_ptr = ptr;
-	container->size = 0;
-	container->type = MOD_RES_FAST_GET;
-
-	k_mutex_unlock(&mod_res_lock);
 	return ptr;
 }
 EXPORT_SYMBOL(z_impl_mod_fast_get);
 #endif
 
-static int free_contents(struct processing_module *mod, struct module_resource *container)
-{
-	struct module_resources *res = &mod->priv.resources;
-#if CONFIG_FAST_GET
-	struct k_mem_domain *mdom;
-#endif
-
-	switch (container->type) {
-	case MOD_RES_HEAP:
-		sof_ctx_free(res->alloc, container->ptr);
-		res->heap_usage -= container->size;
-		return 0;
-#if CONFIG_COMP_BLOB
-	case MOD_RES_BLOB_HANDLER:
-		comp_data_blob_handler_free(container->bhp);
-		return 0;
-#endif
-#if CONFIG_FAST_GET
-	case MOD_RES_FAST_GET:
-#if CONFIG_USERSPACE
-		mdom = mod->mdom;
-#else
-		mdom = NULL;
-#endif
-		fast_put(res->alloc, mdom, container->sram_ptr);
-		return 0;
-#endif
-	default:
-		comp_err(mod->dev, "Unknown resource type: %d", container->type);
-	}
-	return -EINVAL;
-}
-
-struct mod_res_cb_arg {
-	struct processing_module *mod;
-	const void *ptr;
-};
-
-static bool mod_res_free(void *data, void *arg)
-{
-	struct mod_res_cb_arg *cb_arg = arg;
-	struct module_resource *container = data;
-
-	if (cb_arg->ptr && container->ptr != cb_arg->ptr)
-		return false;
-
-	int ret = free_contents(cb_arg->mod, container);
-
-	if (ret < 0)
-		comp_err(cb_arg->mod->dev, "Cannot free allocation %p", cb_arg->ptr);
-
-	container_put(cb_arg->mod, container);
-
-	/* cb_arg->ptr == NULL means, that we're freeing all. Continue iterating */
-	return !!cb_arg->ptr;
-}
-
 /**
  * Frees the memory block removes it from module's book keeping.
  * @param mod	Pointer to module this memory block was allocated for.
@@ -429,18 +789,28 @@ int z_impl_mod_free(struct processing_module *mod, const void *ptr)
 	if (!ptr)
 		return 0;
 
-	/* Find which container holds this memory */
-	struct mod_res_cb_arg cb_arg = {mod, ptr};
+#if CONFIG_MODULE_MEMORY_API_ARENA
+	if (mod_arena_free(&res->arena, ptr))
+		return 0;
+#endif
 
-	k_mutex_lock(&mod_res_lock, K_FOREVER);
-	int ret = objpool_iterate(&res->objpool, mod_res_free, &cb_arg);
+	/* Find the record of this memory */
+	struct k_spinlock *lock = mod_res_lock_get(mod);
+	struct module_resource rec;
+	k_spinlock_key_t key = k_spin_lock(lock);
+	bool found = mod_res_remove(res, ptr, &rec);
 
-	k_mutex_unlock(&mod_res_lock);
+	k_spin_unlock(lock, key);
 
-	if (ret < 0)
+	if (!found) {
 		comp_err(mod->dev, "error: could not find memory pointed by %p", ptr);
+		return -ENOENT;
+	}
 
-	return ret;
+	if (free_contents(mod, &rec) < 0)
+		comp_err(mod->dev, "Cannot free allocation %p", ptr);
+
+	return 0;
 }
 EXPORT_SYMBOL(z_impl_mod_free);
 
@@ -571,6 +941,16 @@ int module_prepare(struct processing_module *mod,
 	if (mod->priv.state < MODULE_INITIALIZED)
 		return -EPERM;
 #endif
+	/* .lazy code of a loadable module is needed from now on */
+	if (comp_is_llext(dev)) {
+		int ret = llext_manager_prefetch(dev->ipc_config.id);
+
+		if (ret < 0) {
+			comp_err(dev, "error %d: loading module code failed", ret);
+			return ret;
+		}
+	}
+
 	if (ops->prepare) {
 		int ret;
 
@@ -593,10 +973,14 @@ int module_prepare(struct processing_module *mod,
 
 		if (ret) {
 			comp_err(dev, "error %d: module specific prepare failed", ret);
+			mod_arena_close(mod, false);
 			return ret;
 		}
 	}
 
+	/* the next instances reserve the arena size this one needed */
+	mod_arena_close(mod, true);
+
 	/* After prepare is done we no longer need runtime configuration
 	 * as it has been applied during the procedure - it is safe to
 	 * free it.
@@ -758,14 +1142,37 @@ int module_reset(struct processing_module *mod)
 void z_impl_mod_free_all(struct processing_module *mod)
 {
 	struct module_resources *res = &mod->priv.resources;
+	struct k_spinlock *lock = mod_res_lock_get(mod);
+	struct module_resource *table;
+	unsigned int table_size;
+	k_spinlock_key_t key;
+	unsigned int i;
+
+	/* Take all records, their contents are freed without the lock */
+	key = k_spin_lock(lock);
+	table = res->table;
+	table_size = res->table_size;
+	res->table = NULL;
+	res->table_size = 0;
+	res->count = 0;
+	for (i = 0; i < table_size; i++)
+		mod_res_account_free(res, &table[i]);
+#if CONFIG_MODULE_MEMORY_API_ARENA
+	if (res->arena.base)
+		mod_stats_free(res, res->arena.size);
+#endif
+	k_spin_unlock(lock, key);
 
-	/* Free all contents found in used containers */
-	struct mod_res_cb_arg cb_arg = {mod, NULL};
+	for (i = 0; i < table_size; i++)
+		if (table[i].type != MOD_RES_UNINITIALIZED && free_contents(mod, &table[i]) < 0)
+			comp_err(mod->dev, "Cannot free allocation %p", table[i].ptr);
 
-	k_mutex_lock(&mod_res_lock, K_FOREVER);
-	objpool_iterate(&res->objpool, mod_res_free, &cb_arg);
-	objpool_prune(&res->objpool);
-	k_mutex_unlock(&mod_res_lock);
+	mod_res_table_free(res, table);
+
+#if CONFIG_MODULE_MEMORY_API_ARENA
+	/* all arena allocations go at once */
+	sof_ctx_free(res->alloc, res->arena.base);
+#endif
 
 	/* Make sure resource lists and accounting are reset */
 	mod_resource_init(mod);
@@ -856,7 +1263,10 @@ int module_set_configuration(struct processing_module *mod,
 			return -EINVAL;
 		}
 
-		/* Allocate buffer for new params */
+		/*
+		 * Allocate the final config storage, the fragments are assembled in it and
+		 * it replaces the current config when complete, without another copy.
+		 */
 		md->runtime_params = sof_heap_alloc(sof_sys_user_heap_get(),
 						    SOF_MEM_FLAG_USER | SOF_MEM_FLAG_LARGE_BUFFER,
 						    md->new_cfg_size, 0);
@@ -865,7 +1275,7 @@ int module_set_configuration(struct processing_module *mod,
 			return -ENOMEM;
 		}
 
-		memset(md->runtime_params, 0, md->new_cfg_size);
+		md->new_cfg_pos = 0;
 		break;
 	default:
 		if (!md->runtime_params) {
@@ -878,6 +1288,12 @@ int module_set_configuration(struct processing_module *mod,
 		break;
 	}
 
+	if (offset > md->new_cfg_size) {
+		comp_err(dev, "error: fragment offset %zu beyond cfg size %zu",
+			 offset, md->new_cfg_size);
+		return -EINVAL;
+	}
+
 	dst = (uint8_t *)md->runtime_params + offset;
 
 	ret = memcpy_s(dst, md->new_cfg_size - offset, fragment, fragment_size);
@@ -886,24 +1302,32 @@ int module_set_configuration(struct processing_module *mod,
 		return ret;
 	}
 
+	/* only the bytes no fragment has written are cleared */
+	if (offset > md->new_cfg_pos)
+		memset((uint8_t *)md->runtime_params + md->new_cfg_pos, 0,
+		       offset - md->new_cfg_pos);
+	md->new_cfg_pos = MAX(md->new_cfg_pos, offset + fragment_size);
+
 	/* return as more fragments of config data expected */
 	if (pos == MODULE_CFG_FRAGMENT_MIDDLE || pos == MODULE_CFG_FRAGMENT_FIRST)
 		return 0;
 
-	/* config fully copied, now load it */
-	ret = module_load_config(dev, md->runtime_params, md->new_cfg_size);
-	if (ret)
-		comp_err(dev, "error %d: config failed", ret);
-	else
-		comp_dbg(dev, "config load successful");
+	if (md->new_cfg_pos < md->new_cfg_size)
+		memset((uint8_t *)md->runtime_params + md->new_cfg_pos, 0,
+		       md->new_cfg_size - md->new_cfg_pos);
 
-	md->new_cfg_size = 0;
+	/* config fully assembled, it becomes the module config */
+	sof_heap_free(sof_sys_user_heap_get(), md->cfg.data);
+	md->cfg.data = md->runtime_params;
+	md->cfg.size = md->new_cfg_size;
+	md->cfg.avail = true;
+	comp_dbg(dev, "config load successful");
 
-	if (md->runtime_params)
-		sof_heap_free(sof_sys_user_heap_get(), md->runtime_params);
 	md->runtime_params = NULL;
+	md->new_cfg_size = 0;
+	md->new_cfg_pos = 0;
 
-	return ret;
+	return 0;
 }
 EXPORT_SYMBOL(module_set_configuration);
 
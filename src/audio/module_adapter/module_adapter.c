@@ -153,6 +153,7 @@ static struct processing_module *module_adapter_mem_alloc(const struct comp_driv
 	dev->ipc_config = *config;
 	mod->dev = dev;
 	dev->mod = mod;
+	mod_stats_register(mod, config->id);
 
 	return mod;
 
@@ -174,6 +175,8 @@ static void module_adapter_mem_free(struct processing_module *mod)
 	struct mod_alloc_ctx *alloc = mod->priv.resources.alloc;
 	struct k_heap *mod_heap = alloc->heap;
 
+	mod_stats_unregister(mod);
+
 	/*
 	 * In principle it shouldn't even be needed to free individual objects
 	 * on the module heap since we're freeing the heap itself too
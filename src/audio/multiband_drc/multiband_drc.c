@@ -48,8 +48,7 @@ static void multiband_drc_reset_state(struct processing_module *mod,
 		multiband_drc_iir_reset_state_ch(mod, &state->emphasis[i]);
 
 	/* Reset crossover state */
-	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
-		crossover_reset_state_ch(mod, &state->crossover[i]);
+	crossover_reset_state_all(&state->crossover);
 
 	/* Reset drc kernel state */
 	for (i = 0; i < SOF_MULTIBAND_DRC_MAX_BANDS; i++)
@@ -135,17 +134,12 @@ static int multiband_drc_init_coef(struct processing_module *mod, int16_t nch, u
 		return -EINVAL;
 	}
 
-	/* Crossover: collect the coef array and assign it to every channel */
+	/* Crossover: collect the coef array, it is common for all channels */
 	crossover = config->crossover_coef;
-	for (ch = 0; ch < nch; ch++) {
-		ret = crossover_init_coef_ch(mod, crossover, &state->crossover[ch],
-					     config->num_bands);
-		/* Free all previously allocated blocks in case of an error */
-		if (ret < 0) {
-			comp_err(dev,
-				 "could not assign coeffs to ch %d", ch);
-			goto err;
-		}
+	ret = crossover_init_coef_state(crossover, &state->crossover, config->num_bands);
+	if (ret < 0) {
+		comp_err(dev, "could not assign crossover coeffs");
+		goto err;
 	}
 
 	comp_info(dev, "initializing emphasis_eq");
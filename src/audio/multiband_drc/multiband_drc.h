@@ -23,7 +23,7 @@
  */
 struct multiband_drc_state {
 	struct iir_state_df1 emphasis[PLATFORM_MAX_CHANNELS];
-	struct crossover_state crossover[PLATFORM_MAX_CHANNELS];
+	struct crossover_state crossover;
 	struct drc_state drc[SOF_MULTIBAND_DRC_MAX_BANDS];
 	struct iir_state_df1 deemphasis[PLATFORM_MAX_CHANNELS];
 };
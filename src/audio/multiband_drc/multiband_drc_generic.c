@@ -23,37 +23,22 @@ int multiband_drc_default_pass(const struct processing_module *mod,
 static void multiband_drc_process_emp_crossover(struct multiband_drc_state *state,
 						crossover_split split_func,
 						int32_t *buf_src,
-						int32_t *buf_sink,
+						int32_t buf_sink[][PLATFORM_MAX_CHANNELS],
 						int enable_emp,
-						int nch,
-						int nband)
+						int nch)
 {
-	struct iir_state_df1 *emp_s;
-	struct crossover_state *crossover_s;
-	int32_t *buf_sink_band;
-	int ch, band;
-	int32_t emp_out;
-	int32_t crossover_out[nband];
-
-	for (ch = 0; ch < nch; ch++) {
-		emp_s = &state->emphasis[ch];
-		crossover_s = &state->crossover[ch];
+	int32_t emp_out[PLATFORM_MAX_CHANNELS];
+	int ch;
 
-		if (enable_emp)
-			emp_out = iir_df1_4th(emp_s, *buf_src);
-		else
-			emp_out = *buf_src;
+	if (enable_emp) {
+		for (ch = 0; ch < nch; ch++)
+			emp_out[ch] = iir_df1_4th(&state->emphasis[ch], buf_src[ch]);
 
-		split_func(emp_out, crossover_out, crossover_s);
-		buf_sink_band = buf_sink;
-		for (band = 0; band < nband; band++) {
-			*buf_sink_band = crossover_out[band];
-			buf_sink_band += PLATFORM_MAX_CHANNELS;
-		}
-
-		buf_src++;
-		buf_sink++;
+		buf_src = emp_out;
 	}
+
+	/* Split all channels of the frame to bands at once */
+	split_func(buf_src, buf_sink, &state->crossover, nch);
 }
 
 #if CONFIG_FORMAT_S16LE
@@ -213,7 +198,7 @@ static int multiband_drc_s16_default(const struct processing_module *mod,
 	struct multiband_drc_state *state = &cd->state;
 	int32_t buf_src[PLATFORM_MAX_CHANNELS];
 	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_drc_src[SOF_MULTIBAND_DRC_MAX_BANDS][PLATFORM_MAX_CHANNELS];
 	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
 	int32_t *band_buf_drc_src;
 	int32_t *band_buf_drc_sink;
@@ -255,9 +240,9 @@ static int multiband_drc_s16_default(const struct processing_module *mod,
 
 			multiband_drc_process_emp_crossover(state, cd->crossover_split,
 							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
+							    enable_emp_deemp, nch);
 
-			band_buf_drc_src = buf_drc_src;
+			band_buf_drc_src = buf_drc_src[0];
 			band_buf_drc_sink = buf_drc_sink;
 			for (band = 0; band < nband; ++band) {
 				multiband_drc_s16_process_drc(&state->drc[band],
@@ -298,7 +283,7 @@ static int multiband_drc_s24_default(const struct processing_module *mod,
 	struct multiband_drc_state *state = &cd->state;
 	int32_t buf_src[PLATFORM_MAX_CHANNELS];
 	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_drc_src[SOF_MULTIBAND_DRC_MAX_BANDS][PLATFORM_MAX_CHANNELS];
 	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
 	int32_t *band_buf_drc_src;
 	int32_t *band_buf_drc_sink;
@@ -340,9 +325,9 @@ static int multiband_drc_s24_default(const struct processing_module *mod,
 
 			multiband_drc_process_emp_crossover(state, cd->crossover_split,
 							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
+							    enable_emp_deemp, nch);
 
-			band_buf_drc_src = buf_drc_src;
+			band_buf_drc_src = buf_drc_src[0];
 			band_buf_drc_sink = buf_drc_sink;
 			for (band = 0; band < nband; ++band) {
 				multiband_drc_s32_process_drc(&state->drc[band],
@@ -383,7 +368,7 @@ static int multiband_drc_s32_default(const struct processing_module *mod,
 	struct multiband_drc_state *state = &cd->state;
 	int32_t buf_src[PLATFORM_MAX_CHANNELS];
 	int32_t buf_sink[PLATFORM_MAX_CHANNELS];
-	int32_t buf_drc_src[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
+	int32_t buf_drc_src[SOF_MULTIBAND_DRC_MAX_BANDS][PLATFORM_MAX_CHANNELS];
 	int32_t buf_drc_sink[PLATFORM_MAX_CHANNELS * SOF_MULTIBAND_DRC_MAX_BANDS];
 	int32_t *band_buf_drc_src;
 	int32_t *band_buf_drc_sink;
@@ -425,9 +410,9 @@ static int multiband_drc_s32_default(const struct processing_module *mod,
 
 			multiband_drc_process_emp_crossover(state, cd->crossover_split,
 							    buf_src, buf_drc_src,
-							    enable_emp_deemp, nch, nband);
+							    enable_emp_deemp, nch);
 
-			band_buf_drc_src = buf_drc_src;
+			band_buf_drc_src = buf_drc_src[0];
 			band_buf_drc_sink = buf_drc_sink;
 			for (band = 0; band < nband; ++band) {
 				multiband_drc_s32_process_drc(&state->drc[band],
@@ -5,6 +5,66 @@
 
 #include <sof/audio/pcm_converter.h>
 #include <sof/audio/audio_stream.h>
+#include <sof/lib/cpu.h>
+#include <sof/lib/memory.h>
+#include <sof/math/chmatrix.h>
+#include <stdbool.h>
+
+/* Number of remap configurations with a classified matrix, per core */
+#define REMAP_MATRIX_CACHE_ENTRIES	2
+
+struct remap_matrix_entry {
+	struct sofm_chmatrix m;
+	uint32_t chmap;
+	uint32_t src_channels;
+	uint32_t sink_channels;
+	enum sof_ipc_frame frame_fmt;
+	int ret;		/* result of the classification */
+	bool used;
+};
+
+struct remap_matrix_cache {
+	struct remap_matrix_entry entry[REMAP_MATRIX_CACHE_ENTRIES];
+	unsigned int victim;	/* entry replaced on the next miss */
+} __aligned(PLATFORM_DCACHE_ALIGN);
+
+/*
+ * The converters get the channel map on every call and keep no state, so the
+ * matrices they classified are kept here. Converters run from the LL
+ * scheduler of their core, each core has its own entries and a stream only
+ * classifies its matrix again when another configuration on the same core
+ * replaced it.
+ */
+static struct remap_matrix_cache remap_matrix_cache[CONFIG_CORE_COUNT];
+
+static const struct sofm_chmatrix *remap_matrix_get(enum sof_ipc_frame frame_fmt,
+						    uint32_t chmap, uint32_t src_channels,
+						    uint32_t sink_channels)
+{
+	struct remap_matrix_cache *cache = &remap_matrix_cache[cpu_get_id()];
+	struct remap_matrix_entry *e;
+	int i;
+
+	for (i = 0; i < REMAP_MATRIX_CACHE_ENTRIES; i++) {
+		e = &cache->entry[i];
+		if (e->used && e->chmap == chmap && e->frame_fmt == frame_fmt &&
+		    e->src_channels == src_channels && e->sink_channels == sink_channels)
+			return e->ret ? NULL : &e->m;
+	}
+
+	e = &cache->entry[cache->victim];
+	cache->victim = (cache->victim + 1) % REMAP_MATRIX_CACHE_ENTRIES;
+
+	e->chmap = chmap;
+	e->frame_fmt = frame_fmt;
+	e->src_channels = src_channels;
+	e->sink_channels = sink_channels;
+	e->ret = sofm_chmatrix_init_chmap(&e->m, frame_fmt, chmap, sink_channels,
+					  src_channels);
+	e->used = true;
+
+	return e->ret ? NULL : &e->m;
+}
 
 static void mute_channel_c16(struct cir_buf_sink *sink, uint32_t num_channels, uint32_t channel,
 			     size_t frames)
@@ -56,9 +116,17 @@ static int remap_c16(const struct cir_buf_source *source, uint32_t src_channels,
 		     struct cir_buf_sink *sink, uint32_t sink_channels,
 		     size_t source_samples, uint32_t chmap)
 {
+	const struct sofm_chmatrix *m;
 	uint32_t src_channel, sink_channel;
 	size_t frames = source_samples / src_channels;
 
+	/* whole frames are picked at once, channel by channel only for wider streams */
+	m = remap_matrix_get(SOF_IPC_FRAME_S16_LE, chmap, src_channels, sink_channels);
+	if (m) {
+		sofm_chmatrix_process(m, source, sink, frames);
+		return source_samples;
+	}
+
 	for (sink_channel = 0; sink_channel < sink_channels; sink_channel++) {
 		const int16_t *src;
 		int16_t *dst;
@@ -343,6 +411,14 @@ static int remap_c32(const struct cir_buf_source *source, uint32_t src_channels,
 		     struct cir_buf_sink *sink, uint32_t sink_channels,
 		     size_t source_samples, uint32_t chmap)
 {
+	const struct sofm_chmatrix *m;
+
+	m = remap_matrix_get(SOF_IPC_FRAME_S32_LE, chmap, src_channels, sink_channels);
+	if (m) {
+		sofm_chmatrix_process(m, source, sink, source_samples / src_channels);
+		return source_samples;
+	}
+
 	return remap_c32_left_shift(source, src_channels, sink, sink_channels,
 				    source_samples, chmap, 0);
 }
@@ -29,7 +29,7 @@ int phase_vocoder_source_s32(struct phase_vocoder_comp_data *cd, struct sof_sour
 			     int frames)
 {
 	struct phase_vocoder_state *state = &cd->state;
-	struct phase_vocoder_buffer *ibuf;
+	struct sofm_stft_buffer *ibuf;
 	int32_t const *x, *x_start, *x_end;
 	const int32_t mix_gain = cd->mono_mix_coef;
 	int64_t mix;
@@ -65,7 +65,7 @@ int phase_vocoder_source_s32(struct phase_vocoder_comp_data *cd, struct sof_sour
 		/* Find out samples to process before first wrap or end of data. */
 		ibuf = &state->ibuf[0];
 		n1 = (x_end - x) / stream_channels;
-		n2 = phase_vocoder_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
+		n2 = sofm_stft_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
 		n = MIN(n1, n2);
 		n = MIN(n, frames_left);
 		if (process_mono) {
@@ -88,7 +88,7 @@ int phase_vocoder_source_s32(struct phase_vocoder_comp_data *cd, struct sof_sour
 		/* One of the buffers needs a wrap (or end of data), so check for wrap */
 		for (j = 0; j < process_channels; j++) {
 			ibuf = &state->ibuf[j];
-			ibuf->w_ptr = phase_vocoder_buffer_wrap(ibuf, ibuf->w_ptr);
+			ibuf->w_ptr = sofm_stft_buffer_wrap(ibuf, ibuf->w_ptr);
 		}
 
 		if (x >= x_end)
@@ -125,7 +125,7 @@ int phase_vocoder_source_s32(struct phase_vocoder_comp_data *cd, struct sof_sour
 int phase_vocoder_sink_s32(struct phase_vocoder_comp_data *cd, struct sof_sink *sink, int frames)
 {
 	struct phase_vocoder_state *state = &cd->state;
-	struct phase_vocoder_buffer *obuf;
+	struct sofm_stft_buffer *obuf;
 	int32_t *y, *y_start, *y_end;
 	int frames_remain;
 	int bytes;
@@ -157,7 +157,7 @@ int phase_vocoder_sink_s32(struct phase_vocoder_comp_data *cd, struct sof_sink *
 		/* Find out samples to process before first wrap or end of data. */
 		obuf = &state->obuf[0];
 		n1 = (y_end - y) / stream_channels;
-		n = phase_vocoder_buffer_samples_without_wrap(obuf, obuf->r_ptr);
+		n = sofm_stft_buffer_samples_without_wrap(obuf, obuf->r_ptr);
 		n = MIN(n1, n);
 		n = MIN(n, frames_remain);
 
@@ -181,7 +181,7 @@ int phase_vocoder_sink_s32(struct phase_vocoder_comp_data *cd, struct sof_sink *
 		/* One of the buffers needs a wrap (or end of data), so check for wrap */
 		for (ch = 0; ch < process_channels; ch++) {
 			obuf = &state->obuf[ch];
-			obuf->r_ptr = phase_vocoder_buffer_wrap(obuf, obuf->r_ptr);
+			obuf->r_ptr = sofm_stft_buffer_wrap(obuf, obuf->r_ptr);
 		}
 
 		if (y >= y_end)
@@ -222,7 +222,7 @@ int phase_vocoder_source_s24(struct phase_vocoder_comp_data *cd, struct sof_sour
 			     int frames)
 {
 	struct phase_vocoder_state *state = &cd->state;
-	struct phase_vocoder_buffer *ibuf;
+	struct sofm_stft_buffer *ibuf;
 	int32_t const *x, *x_start, *x_end;
 	const int32_t mix_gain = cd->mono_mix_coef;
 	int64_t mix;
@@ -259,7 +259,7 @@ int phase_vocoder_source_s24(struct phase_vocoder_comp_data *cd, struct sof_sour
 		/* Find out samples to process before first wrap or end of data. */
 		ibuf = &state->ibuf[0];
 		n1 = (x_end - x) / stream_channels;
-		n2 = phase_vocoder_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
+		n2 = sofm_stft_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
 		n = MIN(n1, n2);
 		n = MIN(n, frames_left);
 		if (process_mono) {
@@ -285,7 +285,7 @@ int phase_vocoder_source_s24(struct phase_vocoder_comp_data *cd, struct sof_sour
 		/* One of the buffers needs a wrap (or end of data), so check for wrap */
 		for (j = 0; j < process_channels; j++) {
 			ibuf = &state->ibuf[j];
-			ibuf->w_ptr = phase_vocoder_buffer_wrap(ibuf, ibuf->w_ptr);
+			ibuf->w_ptr = sofm_stft_buffer_wrap(ibuf, ibuf->w_ptr);
 		}
 
 		if (x >= x_end)
@@ -323,7 +323,7 @@ int phase_vocoder_source_s24(struct phase_vocoder_comp_data *cd, struct sof_sour
 int phase_vocoder_sink_s24(struct phase_vocoder_comp_data *cd, struct sof_sink *sink, int frames)
 {
 	struct phase_vocoder_state *state = &cd->state;
-	struct phase_vocoder_buffer *obuf;
+	struct sofm_stft_buffer *obuf;
 	int32_t *y, *y_start, *y_end;
 	int frames_remain;
 	int bytes;
@@ -355,7 +355,7 @@ int phase_vocoder_sink_s24(struct phase_vocoder_comp_data *cd, struct sof_sink *
 		/* Find out samples to process before first wrap or end of data. */
 		obuf = &state->obuf[0];
 		n1 = (y_end - y) / stream_channels;
-		n = phase_vocoder_buffer_samples_without_wrap(obuf, obuf->r_ptr);
+		n = sofm_stft_buffer_samples_without_wrap(obuf, obuf->r_ptr);
 		n = MIN(n1, n);
 		n = MIN(n, frames_remain);
 
@@ -379,7 +379,7 @@ int phase_vocoder_sink_s24(struct phase_vocoder_comp_data *cd, struct sof_sink *
 		/* One of the buffers needs a wrap (or end of data), so check for wrap */
 		for (ch = 0; ch < process_channels; ch++) {
 			obuf = &state->obuf[ch];
-			obuf->r_ptr = phase_vocoder_buffer_wrap(obuf, obuf->r_ptr);
+			obuf->r_ptr = sofm_stft_buffer_wrap(obuf, obuf->r_ptr);
 		}
 
 		if (y >= y_end)
@@ -418,7 +418,7 @@ int phase_vocoder_source_s16(struct phase_vocoder_comp_data *cd, struct sof_sour
 			     int frames)
 {
 	struct phase_vocoder_state *state = &cd->state;
-	struct phase_vocoder_buffer *ibuf;
+	struct sofm_stft_buffer *ibuf;
 	const int32_t mix_gain = cd->mono_mix_coef;
 	int64_t mix;
 	int16_t const *x, *x_start, *x_end;
@@ -459,7 +459,7 @@ int phase_vocoder_source_s16(struct phase_vocoder_comp_data *cd, struct sof_sour
 		/* Find out samples to process before first wrap or end of data. */
 		ibuf = &state->ibuf[0];
 		n1 = (x_end - x) / stream_channels;
-		n2 = phase_vocoder_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
+		n2 = sofm_stft_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
 		n = MIN(n1, n2);
 		n = MIN(n, frames_left);
 		if (process_mono) {
@@ -483,7 +483,7 @@ int phase_vocoder_source_s16(struct phase_vocoder_comp_data *cd, struct sof_sour
 		/* One of the buffers needs a wrap (or end of data), so check for wrap */
 		for (j = 0; j < process_channels; j++) {
 			ibuf = &state->ibuf[j];
-			ibuf->w_ptr = phase_vocoder_buffer_wrap(ibuf, ibuf->w_ptr);
+			ibuf->w_ptr = sofm_stft_buffer_wrap(ibuf, ibuf->w_ptr);
 		}
 
 		if (x >= x_end)
@@ -519,7 +519,7 @@ int phase_vocoder_source_s16(struct phase_vocoder_comp_data *cd, struct sof_sour
 int phase_vocoder_sink_s16(struct phase_vocoder_comp_data *cd, struct sof_sink *sink, int frames)
 {
 	struct phase_vocoder_state *state = &cd->state;
-	struct phase_vocoder_buffer *obuf;
+	struct sofm_stft_buffer *obuf;
 	int16_t sample;
 	int16_t *y, *y_start, *y_end;
 	int frames_remain;
@@ -551,7 +551,7 @@ int phase_vocoder_sink_s16(struct phase_vocoder_comp_data *cd, struct sof_sink *
 		/* Find out samples to process before first wrap or end of data. */
 		obuf = &state->obuf[0];
 		n1 = (y_end - y) / stream_channels;
-		n = phase_vocoder_buffer_samples_without_wrap(obuf, obuf->r_ptr);
+		n = sofm_stft_buffer_samples_without_wrap(obuf, obuf->r_ptr);
 		n = MIN(n1, n);
 		n = MIN(n, frames_remain);
 
@@ -576,7 +576,7 @@ int phase_vocoder_sink_s16(struct phase_vocoder_comp_data *cd, struct sof_sink *
 		/* One of the buffers needs a wrap (or end of data), so check for wrap */
 		for (ch = 0; ch < process_channels; ch++) {
 			obuf = &state->obuf[ch];
-			obuf->r_ptr = phase_vocoder_buffer_wrap(obuf, obuf->r_ptr);
+			obuf->r_ptr = sofm_stft_buffer_wrap(obuf, obuf->r_ptr);
 		}
 
 		if (y >= y_end)
@@ -598,97 +598,15 @@ int phase_vocoder_sink_s16(struct phase_vocoder_comp_data *cd, struct sof_sink *
 }
 #endif /* CONFIG_FORMAT_S16LE */
 
-void phase_vocoder_fill_fft_buffer(struct phase_vocoder_state *state, int ch)
-{
-	struct phase_vocoder_buffer *ibuf = &state->ibuf[ch];
-	struct phase_vocoder_fft *fft = &state->fft;
-	struct icomplex32 *fft_buf_ptr;
-	int32_t *prev_data = state->prev_data[ch];
-	int32_t *r = ibuf->r_ptr;
-	const int prev_data_size = state->prev_data_size;
-	const int fft_hop_size = fft->fft_hop_size;
-	int samples_remain = fft_hop_size;
-	int j;
-	int n;
-
-	/* Copy overlapped samples from state buffer. Imaginary part of input
-	 * remains zero.
-	 */
-	fft_buf_ptr = fft->fft_buf;
-	for (j = 0; j < prev_data_size; j++) {
-		*fft_buf_ptr = (struct icomplex32){.real = prev_data[j], .imag = 0};
-		fft_buf_ptr++;
-	}
-
-	/* Copy hop size of new data from circular buffer */
-	fft_buf_ptr = &fft->fft_buf[prev_data_size];
-	while (samples_remain) {
-		n = phase_vocoder_buffer_samples_without_wrap(ibuf, r);
-		n = MIN(n, samples_remain);
-		for (j = 0; j < n; j++) {
-			*fft_buf_ptr = (struct icomplex32){.real = *r++, .imag = 0};
-			fft_buf_ptr++;
-		}
-		r = phase_vocoder_buffer_wrap(ibuf, r);
-		samples_remain -= n;
-	}
-
-	ibuf->r_ptr = r;
-	ibuf->s_avail -= fft_hop_size;
-	ibuf->s_free += fft_hop_size;
-
-	/* Copy for next time data back to input data overlap buffer */
-	fft_buf_ptr = &fft->fft_buf[fft_hop_size];
-	for (j = 0; j < prev_data_size; j++)
-		*prev_data++ = fft_buf_ptr++->real;
-}
-
 int phase_vocoder_overlap_add_ifft_buffer(struct phase_vocoder_state *state, int ch)
 {
-	struct phase_vocoder_buffer *obuf = &state->obuf[ch];
+	struct sofm_stft_buffer *obuf = &state->obuf[ch];
 	struct phase_vocoder_fft *fft = &state->fft;
-	int32_t *w = obuf->w_ptr;
-	int32_t sample;
-	int i;
-	int n;
-	int samples_remain = fft->fft_size;
-	int idx = 0;
 
-	if (obuf->s_free < samples_remain)
+	if (obuf->s_free < fft->fft_size)
 		return -EINVAL;
 
-	while (samples_remain) {
-		n = phase_vocoder_buffer_samples_without_wrap(obuf, w);
-		n = MIN(samples_remain, n);
-		for (i = 0; i < n; i++) {
-			sample = Q_MULTSR_32X32((int64_t)state->gain_comp, fft->fft_buf[idx].real,
-						31, 31, 31);
-			*w = sat_int32((int64_t)*w + sample);
-			w++;
-			idx++;
-		}
-		w = phase_vocoder_buffer_wrap(obuf, w);
-		samples_remain -= n;
-	}
-
-	w = obuf->w_ptr + fft->fft_hop_size;
-	obuf->w_ptr = phase_vocoder_buffer_wrap(obuf, w);
-	obuf->s_avail += fft->fft_hop_size;
-	obuf->s_free -= fft->fft_hop_size;
+	sofm_stft_overlap_add(obuf, fft->fft_buf, state->gain_comp, fft->fft_size,
+			      fft->fft_hop_size);
 	return 0;
 }
-
-void phase_vocoder_apply_window(struct phase_vocoder_state *state)
-{
-	struct phase_vocoder_fft *fft = &state->fft;
-	struct icomplex32 *fft_buf_ptr = fft->fft_buf;
-	const int32_t *window = state->window;
-	const int fft_size = fft->fft_size;
-	int i;
-
-	for (i = 0; i < fft_size; i++) {
-		fft_buf_ptr->real = sat_int32(Q_MULTSR_32X32((int64_t)fft_buf_ptr->real,
-							     window[i], 31, 31, 31));
-		fft_buf_ptr++;
-	}
-}
@@ -10,6 +10,7 @@
 #include <sof/math/auditory.h>
 #include <sof/math/dct.h>
 #include <sof/math/fft.h>
+#include <sof/math/stft.h>
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -69,26 +70,6 @@ struct sof_phase_vocoder_config {
 	enum sof_phase_vocoder_fft_window_type window;
 } __attribute__((packed));
 
-/**
- * struct phase_vocoder_buffer - Circular buffer for phase vocoder audio data
- * @addr: Start address of the buffer
- * @end_addr: End address of the buffer
- * @r_ptr: Read pointer
- * @w_ptr: Write pointer
- * @s_avail: Available samples count
- * @s_free: Free samples count
- * @s_length: Buffer length in samples for wrap
- */
-struct phase_vocoder_buffer {
-	int32_t *addr;
-	int32_t *end_addr;
-	int32_t *r_ptr;
-	int32_t *w_ptr;
-	int s_avail;
-	int s_free;
-	int s_length;
-};
-
 /**
  * struct phase_vocoder_fft - FFT processing state
  * @fft_buf: FFT input buffer, size is fft_size
@@ -151,8 +132,8 @@ struct phase_vocoder_polar {
  * @first_output_ifft_done: True after first output IFFT is completed
  */
 struct phase_vocoder_state {
-	struct phase_vocoder_buffer ibuf[PLATFORM_MAX_CHANNELS];
-	struct phase_vocoder_buffer obuf[PLATFORM_MAX_CHANNELS];
+	struct sofm_stft_buffer ibuf[PLATFORM_MAX_CHANNELS];
+	struct sofm_stft_buffer obuf[PLATFORM_MAX_CHANNELS];
 	struct phase_vocoder_fft fft;
 	struct phase_vocoder_polar polar;
 	size_t phase_vocoder_polar_bytes;
@@ -213,20 +194,6 @@ struct phase_vocoder_comp_data {
 	bool enable;
 };
 
-static inline int phase_vocoder_buffer_samples_without_wrap(struct phase_vocoder_buffer *buffer,
-							    int32_t *ptr)
-{
-	return buffer->end_addr - ptr;
-}
-
-static inline int32_t *phase_vocoder_buffer_wrap(struct phase_vocoder_buffer *buffer, int32_t *ptr)
-{
-	if (ptr >= buffer->end_addr)
-		ptr -= buffer->s_length;
-
-	return ptr;
-}
-
 /**
  * struct phase_vocoder_proc_fnmap - processing functions for frame formats
  * @frame_fmt: Current frame format
@@ -304,10 +271,6 @@ static inline int phase_vocoder_get_config(struct processing_module *mod, uint32
 }
 #endif
 
-void phase_vocoder_apply_window(struct phase_vocoder_state *state);
-
-void phase_vocoder_fill_fft_buffer(struct phase_vocoder_state *state, int ch);
-
 void phase_vocoder_free_buffers(struct processing_module *mod);
 
 int phase_vocoder_overlap_add_ifft_buffer(struct phase_vocoder_state *state, int ch);
@@ -9,6 +9,7 @@
 #include <sof/math/matrix.h>
 #include <sof/math/numbers.h>
 #include <sof/math/sqrt.h>
+#include <sof/math/stft.h>
 #include <sof/math/trig.h>
 #include <sof/math/window.h>
 #include <sof/trace/trace.h>
@@ -41,7 +42,7 @@ LOG_MODULE_REGISTER(phase_vocoder_common, CONFIG_SOF_LOG_LEVEL);
 
 static int stft_get_num_ffts_avail(struct phase_vocoder_state *state, int channel)
 {
-	struct phase_vocoder_buffer *ibuf = &state->ibuf[channel];
+	struct sofm_stft_buffer *ibuf = &state->ibuf[channel];
 	struct phase_vocoder_fft *fft = &state->fft;
 
 	/* Wait for FFT hop size of new data */
@@ -53,10 +54,11 @@ static void stft_do_fft(struct phase_vocoder_state *state, int ch)
 	struct phase_vocoder_fft *fft = &state->fft;
 
 	/* Copy data to FFT input buffer from overlap buffer and from new samples buffer */
-	phase_vocoder_fill_fft_buffer(state, ch);
+	sofm_stft_fill_fft_buffer(&state->ibuf[ch], state->prev_data[ch], state->prev_data_size,
+				  fft->fft_buf, fft->fft_hop_size);
 
 	/* Window function */
-	phase_vocoder_apply_window(state);
+	sofm_stft_apply_window(fft->fft_buf, state->window, fft->fft_size);
 
 #if STFT_DEBUG
 	debug_print_to_file_real(stft_debug_fft_in_fh, fft->fft_buf, fft->fft_size);
@@ -86,7 +88,7 @@ static int stft_do_ifft(struct phase_vocoder_state *state, int ch)
 #endif
 
 	/* Window function */
-	phase_vocoder_apply_window(state);
+	sofm_stft_apply_window(fft->fft_buf, state->window, fft->fft_size);
 
 	/* Copy to output buffer */
 	return phase_vocoder_overlap_add_ifft_buffer(state, ch);
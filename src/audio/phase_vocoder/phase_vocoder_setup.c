@@ -6,6 +6,7 @@
 #include <sof/audio/audio_stream.h>
 #include <sof/math/auditory.h>
 #include <sof/math/icomplex32.h>
+#include <sof/math/stft.h>
 #include <sof/math/trig.h>
 #include <sof/math/window.h>
 #include <sof/trace/trace.h>
@@ -19,41 +20,6 @@
 
 LOG_MODULE_REGISTER(phase_vocoder_setup, CONFIG_SOF_LOG_LEVEL);
 
-static void phase_vocoder_init_buffer(struct phase_vocoder_buffer *buf, int32_t *base, int size)
-{
-	buf->addr = base;
-	buf->end_addr = base + size;
-	buf->r_ptr = base;
-	buf->w_ptr = base;
-	buf->s_free = size;
-	buf->s_avail = 0;
-	buf->s_length = size;
-}
-
-static int phase_vocoder_get_window(struct phase_vocoder_state *state,
-				    enum sof_phase_vocoder_fft_window_type name)
-{
-	struct phase_vocoder_fft *fft = &state->fft;
-
-	switch (name) {
-	case STFT_RECTANGULAR_WINDOW:
-		win_rectangular_32b(state->window, fft->fft_size);
-		return 0;
-	case STFT_BLACKMAN_WINDOW:
-		win_blackman_32b(state->window, fft->fft_size, WIN_BLACKMAN_A0_Q31);
-		return 0;
-	case STFT_HAMMING_WINDOW:
-		win_hamming_32b(state->window, fft->fft_size);
-		return 0;
-	case STFT_HANN_WINDOW:
-		win_hann_32b(state->window, fft->fft_size);
-		return 0;
-
-	default:
-		return -EINVAL;
-	}
-}
-
 int phase_vocoder_setup(struct processing_module *mod)
 {
 	struct phase_vocoder_comp_data *cd = module_get_private_data(mod);
@@ -116,7 +82,7 @@ int phase_vocoder_setup(struct processing_module *mod)
 
 	/* Calculated parameters */
 	prev_size = fft->fft_size - fft->fft_hop_size;
-	ibuf_size = fft->fft_hop_size + cd->max_input_frames;
+	ibuf_size = ALIGN_UP(fft->fft_hop_size + cd->max_input_frames, 2);
 	obuf_size = fft->fft_size + fft->fft_hop_size;
 	state->prev_data_size = prev_size;
 
@@ -130,7 +96,7 @@ int phase_vocoder_setup(struct processing_module *mod)
 		return -EINVAL;
 	}
 
-	addr = mod_balloc(mod, sample_buffers_size);
+	addr = mod_balloc_align(mod, sample_buffers_size, 2 * sizeof(int32_t));
 	if (!addr) {
 		comp_err(dev, "Failed buffer allocate");
 		ret = -ENOMEM;
@@ -140,9 +106,9 @@ int phase_vocoder_setup(struct processing_module *mod)
 	memset(addr, 0, sample_buffers_size);
 	state->buffers = addr;
 	for (i = 0; i < channels; i++) {
-		phase_vocoder_init_buffer(&state->ibuf[i], addr, ibuf_size);
+		sofm_stft_buffer_init(&state->ibuf[i], addr, ibuf_size);
 		addr += ibuf_size;
-		phase_vocoder_init_buffer(&state->obuf[i], addr, obuf_size);
+		sofm_stft_buffer_init(&state->obuf[i], addr, obuf_size);
 		addr += obuf_size;
 		state->prev_data[i] = addr;
 		addr += prev_size;
@@ -181,7 +147,8 @@ int phase_vocoder_setup(struct processing_module *mod)
 	}
 
 	/* Setup window */
-	ret = phase_vocoder_get_window(state, config->window);
+	ret = sofm_stft_get_window(state->window, fft->fft_size,
+				   (enum sofm_stft_window_type)config->window);
 	if (ret < 0) {
 		comp_err(dev, "Failed Window function");
 		goto cleanup;
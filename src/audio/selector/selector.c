@@ -935,10 +935,48 @@ static struct ipc4_selector_coeffs_config *selector_config_array_search(struct c
 	return found;
 }
 
+/**
+ * \brief Classifies the mix coefficients for the cheapest mixing kernel.
+ *  A unit matrix for 1:1 stream copy activates the more efficient pass-through copy mode.
+ * \param[in,out] mod Selector base module device.
+ *
+ * \return Error code.
+ */
+static int selector_init_matrix(struct processing_module *mod)
+{
+	struct comp_data *cd = module_get_private_data(mod);
+	struct comp_dev *dev = mod->dev;
+	uint32_t source_channels = cd->config.in_channels_count;
+	uint32_t sink_channels = cd->config.out_channels_count;
+	int ret;
+
+	/* Channels beyond the coefficients matrix are not mixed */
+	ret = sofm_chmatrix_init_q10(&cd->matrix, cd->source_format,
+				     &cd->coeffs_config.coeffs[0][0], SEL_SOURCE_CHANNELS_MAX,
+				     MIN(SEL_SINK_CHANNELS_MAX, sink_channels),
+				     MIN(SEL_SOURCE_CHANNELS_MAX, source_channels));
+	if (!ret)
+		ret = sofm_chmatrix_set_frame_channels(&cd->matrix, source_channels,
+						       sink_channels);
+	if (ret) {
+		comp_err(dev, "Unsupported mix of %u to %u channels, format %d.",
+			 source_channels, sink_channels, cd->source_format);
+		return ret;
+	}
+
+	cd->passthrough = cd->matrix.type == SOFM_CHMATRIX_COPY;
+	if (cd->passthrough)
+		comp_info(dev, "Passthrough mode.");
+	else
+		comp_info(dev, "Using coefficients for %u to %u channels, matrix type %d.",
+			  source_channels, sink_channels, cd->matrix.type);
+
+	return 0;
+}
+
 /**
  * \brief Get mix coefficients set from configuration blob with multiple coefficients sets.
- *  Also activate more efficient pass-through copy mode if the coefficients indicate 1:1
- *  copy from source to sink.
+ *  The coefficients are then classified with selector_init_matrix().
  * \param[in,out] mod Selector base module device.
  * \param[in] source_channels Number of channels in source.
  * \param[in] sink_channels Number of channels in sink.
@@ -952,8 +990,7 @@ static int selector_find_coefficients(struct processing_module *mod)
 	struct ipc4_selector_coeffs_config *config;
 	uint32_t source_channels = cd->config.in_channels_count;
 	uint32_t sink_channels = cd->config.out_channels_count;
-	int16_t coef;
-	int ret, i, j;
+	int ret;
 
 	/* In set_config() the blob is copied to cd->multi_coeffs_config. A legacy blob contains a
 	 * single set of mix coefficients without channels information. A new blob with multiple
@@ -986,31 +1023,7 @@ static int selector_find_coefficients(struct processing_module *mod)
 			return ret;
 	}
 
-	/* The pass-through copy function can be used if coefficients are a unit matrix for
-	 * 1:1 stream copy.
-	 */
-	if (source_channels == sink_channels) {
-		cd->passthrough = true;
-		for (i = 0; i < sink_channels; i++) {
-			for (j = 0; j < source_channels; j++) {
-				coef = cd->coeffs_config.coeffs[i][j];
-				if ((i == j && coef != SEL_COEF_ONE_Q10) || (i != j && coef != 0)) {
-					cd->passthrough = false;
-					break;
-				}
-			}
-		}
-	} else {
-		cd->passthrough = false;
-	}
-
-	if (cd->passthrough)
-		comp_info(dev, "Passthrough mode.");
-	else
-		comp_info(dev, "Using coefficients for %u to %u channels.",
-			  source_channels, sink_channels);
-
-	return 0;
+	return selector_init_matrix(mod);
 }
 
 /**
@@ -1128,7 +1141,7 @@ static int selector_prepare(struct processing_module *mod,
 		return selector_find_coefficients(mod);
 	}
 
-	return 0;
+	return selector_init_matrix(mod);
 }
 
 /**
@@ -170,220 +170,34 @@ static void sel_s32le_nch(struct comp_dev *dev, struct audio_stream *sink,
 #endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
 
 #else
-#if CONFIG_FORMAT_S16LE
-/**
- * \brief Mixing routine for 16-bit, m channel input x n channel output single frame.
- * \param[out] dst Sink buffer.
- * \param[in] dst_channels Number of sink channels.
- * \param[in] src Source data.
- * \param[in] src_channels Number of source channels.
- * \param[in] coeffs_config IPC4 micsel config with Q10 coefficients.
- */
-static void process_frame_s16le(int16_t dst[], int dst_channels,
-				int16_t src[], int src_channels,
-				struct ipc4_selector_coeffs_config *coeffs_config)
-{
-	int32_t accum;
-	int i, j;
-
-	for (i = 0; i < dst_channels; i++) {
-		accum = 0;
-		for (j = 0; j < src_channels; j++)
-			accum += (int32_t)src[j] * (int32_t)coeffs_config->coeffs[i][j];
-
-		/* shift out 10 LSbits with rounding to get 16-bit result */
-		dst[i] = sat_int16((accum + (1 << 9)) >> 10);
-	}
-}
-
-/**
- * \brief Channel selection for 16-bit, m channel input x n channel output data format.
- * \param[in] mod Selector base module device.
- * \param[in,out] bsource Source buffer.
- * \param[in,out] bsink Sink buffer.
- * \param[in] frames Number of frames to process.
- */
-static void sel_s16le(struct processing_module *mod, struct input_stream_buffer *bsource,
-		      struct output_stream_buffer *bsink, uint32_t frames)
-{
-	struct comp_data *cd = module_get_private_data(mod);
-	struct audio_stream *source = bsource->data;
-	struct audio_stream *sink = bsink->data;
-	int16_t *src = audio_stream_get_rptr(source);
-	int16_t *dest = audio_stream_get_wptr(sink);
-	int nmax;
-	int i;
-	int n;
-	int processed = 0;
-	int source_frame_bytes = audio_stream_frame_bytes(source);
-	int sink_frame_bytes = audio_stream_frame_bytes(sink);
-	int n_chan_source = MIN(SEL_SOURCE_CHANNELS_MAX, audio_stream_get_channels(source));
-	int n_chan_sink = MIN(SEL_SINK_CHANNELS_MAX, audio_stream_get_channels(sink));
-
-	while (processed < frames) {
-		n = frames - processed;
-		nmax = audio_stream_bytes_without_wrap(source, src) / source_frame_bytes;
-		n = MIN(n, nmax);
-		nmax = audio_stream_bytes_without_wrap(sink, dest) / sink_frame_bytes;
-		n = MIN(n, nmax);
-		for (i = 0; i < n; i++) {
-			process_frame_s16le(dest, n_chan_sink, src, n_chan_source,
-					    &cd->coeffs_config);
-			src += audio_stream_get_channels(source);
-			dest += audio_stream_get_channels(sink);
-		}
-		src = audio_stream_wrap(source, src);
-		dest = audio_stream_wrap(sink, dest);
-		processed += n;
-	}
-
-	module_update_buffer_position(bsource, bsink, frames);
-}
-#endif /* CONFIG_FORMAT_S16LE */
-
-#if CONFIG_FORMAT_S24LE
-/**
- * \brief Mixing routine for 24-bit, m channel input x n channel output single frame.
- * \param[out] dst Sink buffer.
- * \param[in] dst_channels Number of sink channels.
- * \param[in] src Source data.
- * \param[in] src_channels Number of source channels.
- * \param[in] coeffs_config IPC4 micsel config with Q10 coefficients.
- */
-static void process_frame_s24le(int32_t dst[], int dst_channels,
-				int32_t src[], int src_channels,
-				struct ipc4_selector_coeffs_config *coeffs_config)
-{
-	int64_t accum;
-	int i, j;
-
-	for (i = 0; i < dst_channels; i++) {
-		accum = 0;
-		for (j = 0; j < src_channels; j++)
-			accum += (int64_t)src[j] * (int64_t)coeffs_config->coeffs[i][j];
-
-		/* accum is Q1.23 * Q6.10 --> Q7.33, shift right by 10 and
-		 * saturate to get Q1.23.
-		 */
-		dst[i] = sat_int24((accum + (1 << 9)) >> 10);
-	}
-}
-
-/**
- * \brief Channel selection for 24-bit, m channel input x n channel output data format.
- * \param[in] mod Selector base module device.
- * \param[in,out] bsource Source buffer.
- * \param[in,out] bsink Sink buffer.
- * \param[in] frames Number of frames to process.
- */
-static void sel_s24le(struct processing_module *mod, struct input_stream_buffer *bsource,
-		      struct output_stream_buffer *bsink, uint32_t frames)
-{
-	struct comp_data *cd = module_get_private_data(mod);
-	struct audio_stream *source = bsource->data;
-	struct audio_stream *sink = bsink->data;
-	int32_t *src = audio_stream_get_rptr(source);
-	int32_t *dest = audio_stream_get_wptr(sink);
-	int nmax;
-	int i;
-	int n;
-	int processed = 0;
-	int source_frame_bytes = audio_stream_frame_bytes(source);
-	int sink_frame_bytes = audio_stream_frame_bytes(sink);
-	int n_chan_source = MIN(SEL_SOURCE_CHANNELS_MAX, audio_stream_get_channels(source));
-	int n_chan_sink = MIN(SEL_SINK_CHANNELS_MAX, audio_stream_get_channels(sink));
-
-	while (processed < frames) {
-		n = frames - processed;
-		nmax = audio_stream_bytes_without_wrap(source, src) / source_frame_bytes;
-		n = MIN(n, nmax);
-		nmax = audio_stream_bytes_without_wrap(sink, dest) / sink_frame_bytes;
-		n = MIN(n, nmax);
-		for (i = 0; i < n; i++) {
-			process_frame_s24le(dest, n_chan_sink, src, n_chan_source,
-					    &cd->coeffs_config);
-			src += audio_stream_get_channels(source);
-			dest += audio_stream_get_channels(sink);
-		}
-		src = audio_stream_wrap(source, src);
-		dest = audio_stream_wrap(sink, dest);
-		processed += n;
-	}
-
-	module_update_buffer_position(bsource, bsink, frames);
-}
-#endif /* CONFIG_FORMAT_S24LE */
-
-#if CONFIG_FORMAT_S32LE
 /**
- * \brief Mixing routine for 32-bit, m channel input x n channel output single frame.
- * \param[out] dst Sink buffer.
- * \param[in] dst_channels Number of sink channels.
- * \param[in] src Source data.
- * \param[in] src_channels Number of source channels.
- * \param[in] coeffs_config IPC4 micsel config with Q10 coefficients.
- */
-static void process_frame_s32le(int32_t dst[], int dst_channels,
-				int32_t src[], int src_channels,
-				struct ipc4_selector_coeffs_config *coeffs_config)
-{
-	int64_t accum;
-	int i, j;
-
-	for (i = 0; i < dst_channels; i++) {
-		accum = 0;
-		for (j = 0; j < src_channels; j++)
-			accum += (int64_t)src[j] * (int64_t)coeffs_config->coeffs[i][j];
-
-		/* shift out 10 LSbits with rounding to get 32-bit result */
-		dst[i] = sat_int32((accum + (1 << 9)) >> 10);
-	}
-}
-
-/**
- * \brief Channel selection for 32-bit, m channel input x n channel output data format.
+ * \brief Mixing of m channel input to n channel output with the classified
+ *  coefficients, for all supported sample formats.
  * \param[in] mod Selector base module device.
  * \param[in,out] bsource Source buffer.
  * \param[in,out] bsink Sink buffer.
  * \param[in] frames Number of frames to process.
  */
-static void sel_s32le(struct processing_module *mod, struct input_stream_buffer *bsource,
-		      struct output_stream_buffer *bsink, uint32_t frames)
+static void sel_mix(struct processing_module *mod, struct input_stream_buffer *bsource,
+		    struct output_stream_buffer *bsink, uint32_t frames)
 {
 	struct comp_data *cd = module_get_private_data(mod);
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
-	int32_t *src = audio_stream_get_rptr(source);
-	int32_t *dest = audio_stream_get_wptr(sink);
-	int nmax;
-	int i;
-	int n;
-	int processed = 0;
-	int source_frame_bytes = audio_stream_frame_bytes(source);
-	int sink_frame_bytes = audio_stream_frame_bytes(sink);
-	int n_chan_source = MIN(SEL_SOURCE_CHANNELS_MAX, audio_stream_get_channels(source));
-	int n_chan_sink = MIN(SEL_SINK_CHANNELS_MAX, audio_stream_get_channels(sink));
-
-	while (processed < frames) {
-		n = frames - processed;
-		nmax = audio_stream_bytes_without_wrap(source, src) / source_frame_bytes;
-		n = MIN(n, nmax);
-		nmax = audio_stream_bytes_without_wrap(sink, dest) / sink_frame_bytes;
-		n = MIN(n, nmax);
-		for (i = 0; i < n; i++) {
-			process_frame_s32le(dest, n_chan_sink, src, n_chan_source,
-					    &cd->coeffs_config);
-			src += audio_stream_get_channels(source);
-			dest += audio_stream_get_channels(sink);
-		}
-		src = audio_stream_wrap(source, src);
-		dest = audio_stream_wrap(sink, dest);
-		processed += n;
-	}
-
+	struct cir_buf_source src = {
+		.buf_start = audio_stream_get_addr(source),
+		.buf_end = audio_stream_get_end_addr(source),
+		.ptr = audio_stream_get_rptr(source),
+	};
+	struct cir_buf_sink dst = {
+		.buf_start = audio_stream_get_addr(sink),
+		.buf_end = audio_stream_get_end_addr(sink),
+		.ptr = audio_stream_get_wptr(sink),
+	};
+
+	sofm_chmatrix_process(&cd->matrix, &src, &dst, frames);
 	module_update_buffer_position(bsource, bsink, frames);
 }
-#endif /* CONFIG_FORMAT_S32LE */
 #endif
 
 const struct comp_func_map func_table[] = {
@@ -405,13 +219,13 @@ const struct comp_func_map func_table[] = {
 #endif /* CONFIG_FORMAT_S32LE */
 #else
 #if CONFIG_FORMAT_S16LE
-	{SOF_IPC_FRAME_S16_LE, 0, sel_s16le},
+	{SOF_IPC_FRAME_S16_LE, 0, sel_mix},
 #endif
 #if CONFIG_FORMAT_S24LE
-	{SOF_IPC_FRAME_S24_4LE, 0, sel_s24le},
+	{SOF_IPC_FRAME_S24_4LE, 0, sel_mix},
 #endif
 #if CONFIG_FORMAT_S32LE
-	{SOF_IPC_FRAME_S32_LE, 0, sel_s32le},
+	{SOF_IPC_FRAME_S32_LE, 0, sel_mix},
 #endif
 #endif
 };
@@ -10,6 +10,7 @@
 #include <sof/math/auditory.h>
 #include <sof/math/dct.h>
 #include <sof/math/fft.h>
+#include <sof/math/stft.h>
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -50,16 +51,6 @@ struct sof_stft_process_config {
 	enum sof_stft_process_fft_window_type window; /**< Use RECTANGULAR_WINDOW, etc. */
 } __attribute__((packed));
 
-struct stft_process_buffer {
-	int32_t *addr;
-	int32_t *end_addr;
-	int32_t *r_ptr;
-	int32_t *w_ptr;
-	int s_avail; /**< samples count */
-	int s_free; /**< samples count */
-	int s_length; /**< length in samples for wrap */
-};
-
 struct stft_process_fft {
 	struct icomplex32 *fft_buf; /**< fft_padded_size */
 	struct icomplex32 *fft_out; /**< fft_padded_size */
@@ -75,8 +66,8 @@ struct stft_process_fft {
 };
 
 struct stft_process_state {
-	struct stft_process_buffer ibuf[PLATFORM_MAX_CHANNELS]; /**< Buffer for input data */
-	struct stft_process_buffer obuf[PLATFORM_MAX_CHANNELS]; /**< Buffer for output data */
+	struct sofm_stft_buffer ibuf[PLATFORM_MAX_CHANNELS]; /**< Buffer for input data */
+	struct sofm_stft_buffer obuf[PLATFORM_MAX_CHANNELS]; /**< Buffer for output data */
 	struct stft_process_fft fft; /**< FFT related */
 	int32_t *prev_data[PLATFORM_MAX_CHANNELS]; /**< prev_data_size */
 	int32_t gain_comp; /**< Gain to compensate window gain */
@@ -121,20 +112,6 @@ struct stft_comp_data {
 	bool fft_done;
 };
 
-static inline int stft_process_buffer_samples_without_wrap(struct stft_process_buffer *buffer,
-							   int32_t *ptr)
-{
-	return buffer->end_addr - ptr;
-}
-
-static inline int32_t *stft_process_buffer_wrap(struct stft_process_buffer *buffer, int32_t *ptr)
-{
-	if (ptr >= buffer->end_addr)
-		ptr -= buffer->s_length;
-
-	return ptr;
-}
-
 /**
  * struct stft_process_proc_fnmap - processing functions for frame formats
  * @frame_fmt: Current frame format
@@ -292,48 +269,4 @@ int stft_process_sink_s32(struct stft_comp_data *cd, struct sof_sink *sink, int
  */
 void stft_process_free_buffers(struct processing_module *mod);
 
-/**
- * stft_process_fill_prev_samples() - Save overlap samples for next STFT frame.
- * @buf: Circular buffer to read overlap samples from.
- * @prev_data: Destination array for the overlap data.
- * @prev_data_length: Number of samples to copy.
- *
- * Copies prev_data_length samples from the circular buffer into the
- * linear prev_data array, handling wrap-around as needed.
- */
-void stft_process_fill_prev_samples(struct stft_process_buffer *buf, int32_t *prev_data,
-				    int prev_data_length);
-
-/**
- * stft_process_fill_fft_buffer() - Assemble FFT input from overlap and new data.
- * @state: STFT processing state.
- * @ch: Channel index.
- *
- * Constructs the FFT input buffer by concatenating the previous overlap
- * samples and one hop of new samples from the input circular buffer.
- * Imaginary parts are set to zero. The overlap buffer is updated with
- * data for the next frame.
- */
-void stft_process_fill_fft_buffer(struct stft_process_state *state, int ch);
-
-/**
- * stft_process_apply_window() - Multiply FFT buffer by the analysis window.
- * @state: STFT processing state that contains the FFT buffer and window.
- *
- * The real part of each complex sample in the FFT buffer is multiplied
- * by the corresponding Q1.31 window coefficient.
- */
-void stft_process_apply_window(struct stft_process_state *state);
-
-/**
- * stft_process_overlap_add_ifft_buffer() - Overlap-add IFFT output to circular output buffer.
- * @state: STFT processing state.
- * @ch: Channel index.
- *
- * Each IFFT output sample is multiplied by the gain compensation value
- * and added with saturation to the existing content of the circular
- * output buffer.
- */
-void stft_process_overlap_add_ifft_buffer(struct stft_process_state *state, int ch);
-
 #endif //  __SOF_AUDIO_STFT_PROCESS_H__
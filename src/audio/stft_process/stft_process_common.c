@@ -45,7 +45,7 @@ static void debug_print_to_file_complex(FILE *fh, struct icomplex32 *c, int n)
 int stft_process_source_s32(struct stft_comp_data *cd, struct sof_source *source, int frames)
 {
 	struct stft_process_state *state = &cd->state;
-	struct stft_process_buffer *ibuf;
+	struct sofm_stft_buffer *ibuf;
 	int32_t const *x, *x_start, *x_end;
 	int x_size;
 	int bytes = frames * cd->frame_bytes;
@@ -72,7 +72,7 @@ int stft_process_source_s32(struct stft_comp_data *cd, struct sof_source *source
 		/* Find out samples to process before first wrap or end of data. */
 		ibuf = &state->ibuf[0];
 		n1 = (x_end - x) / cd->channels;
-		n2 = stft_process_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
+		n2 = sofm_stft_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
 		n = MIN(n1, n2);
 		n = MIN(n, frames_left);
 		for (i = 0; i < n; i++) {
@@ -85,7 +85,7 @@ int stft_process_source_s32(struct stft_comp_data *cd, struct sof_source *source
 		/* One of the buffers needs a wrap (or end of data), so check for wrap */
 		for (j = 0; j < channels; j++) {
 			ibuf = &state->ibuf[j];
-			ibuf->w_ptr = stft_process_buffer_wrap(ibuf, ibuf->w_ptr);
+			ibuf->w_ptr = sofm_stft_buffer_wrap(ibuf, ibuf->w_ptr);
 		}
 
 		if (x >= x_end)
@@ -109,7 +109,7 @@ int stft_process_source_s32(struct stft_comp_data *cd, struct sof_source *source
 int stft_process_sink_s32(struct stft_comp_data *cd, struct sof_sink *sink, int frames)
 {
 	struct stft_process_state *state = &cd->state;
-	struct stft_process_buffer *obuf;
+	struct sofm_stft_buffer *obuf;
 	int32_t *y, *y_start, *y_end;
 	int frames_remain = frames;
 	int channels = cd->channels;
@@ -131,7 +131,7 @@ int stft_process_sink_s32(struct stft_comp_data *cd, struct sof_sink *sink, int
 		/* Find out samples to process before first wrap or end of data. */
 		obuf = &state->obuf[0];
 		n1 = (y_end - y) / cd->channels;
-		n = stft_process_buffer_samples_without_wrap(obuf, obuf->r_ptr);
+		n = sofm_stft_buffer_samples_without_wrap(obuf, obuf->r_ptr);
 		n = MIN(n1, n);
 		n = MIN(n, frames_remain);
 
@@ -146,7 +146,7 @@ int stft_process_sink_s32(struct stft_comp_data *cd, struct sof_sink *sink, int
 		/* One of the buffers needs a wrap (or end of data), so check for wrap */
 		for (ch = 0; ch < cd->channels; ch++) {
 			obuf = &state->obuf[ch];
-			obuf->r_ptr = stft_process_buffer_wrap(obuf, obuf->r_ptr);
+			obuf->r_ptr = sofm_stft_buffer_wrap(obuf, obuf->r_ptr);
 		}
 
 		if (y >= y_end)
@@ -172,7 +172,7 @@ int stft_process_sink_s32(struct stft_comp_data *cd, struct sof_sink *sink, int
 int stft_process_source_s16(struct stft_comp_data *cd, struct sof_source *source, int frames)
 {
 	struct stft_process_state *state = &cd->state;
-	struct stft_process_buffer *ibuf;
+	struct sofm_stft_buffer *ibuf;
 	int16_t const *x, *x_start, *x_end;
 	int16_t in;
 	int x_size;
@@ -195,7 +195,7 @@ int stft_process_source_s16(struct stft_comp_data *cd, struct sof_source *source
 	while (frames_left) {
 		ibuf = &state->ibuf[0];
 		n1 = (x_end - x) / cd->channels;
-		n2 = stft_process_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
+		n2 = sofm_stft_buffer_samples_without_wrap(ibuf, ibuf->w_ptr);
 		n = MIN(n1, n2);
 		n = MIN(n, frames_left);
 		for (i = 0; i < n; i++) {
@@ -208,7 +208,7 @@ int stft_process_source_s16(struct stft_comp_data *cd, struct sof_source *source
 
 		for (j = 0; j < channels; j++) {
 			ibuf = &state->ibuf[j];
-			ibuf->w_ptr = stft_process_buffer_wrap(ibuf, ibuf->w_ptr);
+			ibuf->w_ptr = sofm_stft_buffer_wrap(ibuf, ibuf->w_ptr);
 		}
 
 		if (x >= x_end)
@@ -229,7 +229,7 @@ int stft_process_source_s16(struct stft_comp_data *cd, struct sof_source *source
 int stft_process_sink_s16(struct stft_comp_data *cd, struct sof_sink *sink, int frames)
 {
 	struct stft_process_state *state = &cd->state;
-	struct stft_process_buffer *obuf;
+	struct sofm_stft_buffer *obuf;
 	int16_t *y, *y_start, *y_end;
 	int frames_remain = frames;
 	int channels = cd->channels;
@@ -246,7 +246,7 @@ int stft_process_sink_s16(struct stft_comp_data *cd, struct sof_sink *sink, int
 	while (frames_remain) {
 		obuf = &state->obuf[0];
 		n1 = (y_end - y) / cd->channels;
-		n = stft_process_buffer_samples_without_wrap(obuf, obuf->r_ptr);
+		n = sofm_stft_buffer_samples_without_wrap(obuf, obuf->r_ptr);
 		n = MIN(n1, n);
 		n = MIN(n, frames_remain);
 
@@ -260,7 +260,7 @@ int stft_process_sink_s16(struct stft_comp_data *cd, struct sof_sink *sink, int
 
 		for (ch = 0; ch < channels; ch++) {
 			obuf = &state->obuf[ch];
-			obuf->r_ptr = stft_process_buffer_wrap(obuf, obuf->r_ptr);
+			obuf->r_ptr = sofm_stft_buffer_wrap(obuf, obuf->r_ptr);
 		}
 
 		if (y >= y_end)
@@ -280,74 +280,6 @@ int stft_process_sink_s16(struct stft_comp_data *cd, struct sof_sink *sink, int
 }
 #endif /* CONFIG_FORMAT_S16LE */
 
-void stft_process_fill_prev_samples(struct stft_process_buffer *buf, int32_t *prev_data,
-				    int prev_data_length)
-{
-	int32_t *r = buf->r_ptr;
-	int32_t *p = prev_data;
-	int copied;
-	int nmax;
-	int n;
-
-	for (copied = 0; copied < prev_data_length; copied += n) {
-		nmax = prev_data_length - copied;
-		n = stft_process_buffer_samples_without_wrap(buf, r);
-		n = MIN(n, nmax);
-		memcpy(p, r, sizeof(int32_t) * n);
-		p += n;
-		r += n;
-		r = stft_process_buffer_wrap(buf, r);
-	}
-
-	buf->s_avail -= copied;
-	buf->s_free += copied;
-	buf->r_ptr = r;
-}
-
-void stft_process_fill_fft_buffer(struct stft_process_state *state, int ch)
-{
-	struct stft_process_buffer *ibuf = &state->ibuf[ch];
-	struct stft_process_fft *fft = &state->fft;
-	int32_t *prev_data = state->prev_data[ch];
-	int32_t *r = ibuf->r_ptr;
-	int copied;
-	int nmax;
-	int idx;
-	int j;
-	int n;
-
-	/* Copy overlapped samples from state buffer. Imaginary part of input
-	 * remains zero.
-	 */
-	for (j = 0; j < state->prev_data_size; j++) {
-		fft->fft_buf[j].real = prev_data[j];
-		fft->fft_buf[j].imag = 0;
-	}
-
-	/* Copy hop size of new data from circular buffer */
-	idx = state->prev_data_size;
-	for (copied = 0; copied < fft->fft_hop_size; copied += n) {
-		nmax = fft->fft_hop_size - copied;
-		n = stft_process_buffer_samples_without_wrap(ibuf, r);
-		n = MIN(n, nmax);
-		for (j = 0; j < n; j++) {
-			fft->fft_buf[idx].real = *r++;
-			fft->fft_buf[idx].imag = 0;
-			idx++;
-		}
-		r = stft_process_buffer_wrap(ibuf, r);
-	}
-
-	ibuf->s_avail -= copied;
-	ibuf->s_free += copied;
-	ibuf->r_ptr = r;
-
-	/* Copy for next time data back to overlap buffer */
-	idx = fft->fft_hop_size;
-	for (j = 0; j < state->prev_data_size; j++)
-		prev_data[j] = fft->fft_buf[idx + j].real;
-}
-
 LOG_MODULE_REGISTER(stft_process_common, CONFIG_SOF_LOG_LEVEL);
 
 /*
@@ -356,7 +288,7 @@ LOG_MODULE_REGISTER(stft_process_common, CONFIG_SOF_LOG_LEVEL);
 
 static int stft_prepare_fft(struct stft_process_state *state, int channel)
 {
-	struct stft_process_buffer *ibuf = &state->ibuf[channel];
+	struct sofm_stft_buffer *ibuf = &state->ibuf[channel];
 	struct stft_process_fft *fft = &state->fft;
 
 	/* Wait for FFT hop size of new data */
@@ -371,10 +303,11 @@ static void stft_do_fft(struct stft_process_state *state, int ch)
 	struct stft_process_fft *fft = &state->fft;
 
 	/* Copy data to FFT input buffer from overlap buffer and from new samples buffer */
-	stft_process_fill_fft_buffer(state, ch);
+	sofm_stft_fill_fft_buffer(&state->ibuf[ch], state->prev_data[ch], state->prev_data_size,
+				  fft->fft_buf, fft->fft_hop_size);
 
 	/* Window function */
-	stft_process_apply_window(state);
+	sofm_stft_apply_window(fft->fft_buf, state->window, fft->fft_size);
 
 #if STFT_DEBUG
 	debug_print_to_file_real(stft_debug_fft_in_fh, fft->fft_buf, fft->fft_size);
@@ -404,10 +337,11 @@ static void stft_do_ifft(struct stft_process_state *state, int ch)
 #endif
 
 	/* Window function */
-	stft_process_apply_window(state);
+	sofm_stft_apply_window(fft->fft_buf, state->window, fft->fft_size);
 
 	/* Copy to output buffer */
-	stft_process_overlap_add_ifft_buffer(state, ch);
+	sofm_stft_overlap_add(&state->obuf[ch], fft->fft_buf, state->gain_comp, fft->fft_size,
+			      fft->fft_hop_size);
 }
 
 #if CONFIG_STFT_PROCESS_MAGNITUDE_PHASE
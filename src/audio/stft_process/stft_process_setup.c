@@ -5,6 +5,7 @@
 #include <sof/audio/component.h>
 #include <sof/audio/audio_stream.h>
 #include <sof/math/auditory.h>
+#include <sof/math/stft.h>
 #include <sof/math/trig.h>
 #include <sof/math/window.h>
 #include <sof/trace/trace.h>
@@ -23,41 +24,6 @@
 
 LOG_MODULE_REGISTER(stft_process_setup, CONFIG_SOF_LOG_LEVEL);
 
-static void stft_process_init_buffer(struct stft_process_buffer *buf, int32_t *base, int size)
-{
-	buf->addr = base;
-	buf->end_addr = base + size;
-	buf->r_ptr = base;
-	buf->w_ptr = base;
-	buf->s_free = size;
-	buf->s_avail = 0;
-	buf->s_length = size;
-}
-
-static int stft_process_get_window(struct stft_process_state *state,
-				   enum sof_stft_process_fft_window_type name)
-{
-	struct stft_process_fft *fft = &state->fft;
-
-	switch (name) {
-	case STFT_RECTANGULAR_WINDOW:
-		win_rectangular_32b(state->window, fft->fft_size);
-		return 0;
-	case STFT_BLACKMAN_WINDOW:
-		win_blackman_32b(state->window, fft->fft_size, WIN_BLACKMAN_A0_Q31);
-		return 0;
-	case STFT_HAMMING_WINDOW:
-		win_hamming_32b(state->window, fft->fft_size);
-		return 0;
-	case STFT_HANN_WINDOW:
-		win_hann_32b(state->window, fft->fft_size);
-		return 0;
-
-	default:
-		return -EINVAL;
-	}
-}
-
 /* TODO stft_process setup needs to use the config blob, not hard coded parameters.
  * Also this is a too long function. Split to STFT, Mel filter, etc. parts.
  */
@@ -152,9 +118,9 @@ int stft_process_setup(struct processing_module *mod, int max_frames,
 	bzero(state->buffers, sample_buffers_size);
 	addr = state->buffers;
 	for (i = 0; i < cd->channels; i++) {
-		stft_process_init_buffer(&state->ibuf[i], addr, ibuf_size);
+		sofm_stft_buffer_init(&state->ibuf[i], addr, ibuf_size);
 		addr += ibuf_size;
-		stft_process_init_buffer(&state->obuf[i], addr, obuf_size);
+		sofm_stft_buffer_init(&state->obuf[i], addr, obuf_size);
 		addr += obuf_size;
 		state->prev_data[i] = addr;
 		addr += prev_size;
@@ -198,7 +164,8 @@ int stft_process_setup(struct processing_module *mod, int max_frames,
 	}
 
 	/* Setup window */
-	ret = stft_process_get_window(state, config->window);
+	ret = sofm_stft_get_window(state->window, fft->fft_size,
+				   (enum sofm_stft_window_type)config->window);
 	if (ret < 0) {
 		comp_err(dev, "Failed Window function");
 		goto free_window_out;
@@ -11,6 +11,7 @@
 #include <sof/audio/component_ext.h>
 #include <sof/audio/ipc-config.h>
 #include <sof/common.h>
+#include <sof/math/chmatrix.h>
 #include <ipc/stream.h>
 #include <ipc4/module.h>
 #include <ipc4/base-config.h>
@@ -142,6 +143,11 @@ struct up_down_mixer_data {
 	/** In/out internal buffers */
 	int32_t *buf_in;
 	int32_t *buf_out;
+
+#if !(defined(__XCC__) && XCHAL_HAVE_HIFI3)
+	/** Channel pick of the generic upmix routines, classified on first use. */
+	struct sofm_chmatrix upmix;
+#endif
 };
 
 /**
@@ -1917,38 +1917,125 @@ void upmix32bit_quatro_to_5_1(struct up_down_mixer_data *cd, const uint8_t * con
 
 #else /* !XCHAL_HAVE_HIFI3 */
 
-/* TODO: replace with generic ANSI C version */
+#define UPMIX_MUTE	SOFM_CHMATRIX_CHMAP_MUTE
+
+/* Upmixes copy input channels to output channels, per output channel index
+ * the source channel or UPMIX_MUTE.
+ */
+static const uint8_t upmix_1_to_5_1_sources[] = {
+	[CHANNEL_LEFT] = 0, [CHANNEL_CENTER] = UPMIX_MUTE, [CHANNEL_RIGHT] = 0,
+	[CHANNEL_LEFT_SURROUND] = 0, [CHANNEL_RIGHT_SURROUND] = 0,
+	[CHANNEL_LEFT_SIDE] = UPMIX_MUTE, [CHANNEL_RIGHT_SIDE] = UPMIX_MUTE,
+	[CHANNEL_LFE] = UPMIX_MUTE,
+};
+
+/* 5.1 Surround has the side channels instead of the surround ones */
+static const uint8_t upmix_2_0_to_5_1_sources[] = {
+	[CHANNEL_LEFT] = 0, [CHANNEL_CENTER] = UPMIX_MUTE, [CHANNEL_RIGHT] = 1,
+	[CHANNEL_LEFT_SURROUND] = 0, [CHANNEL_RIGHT_SURROUND] = 1,
+	[CHANNEL_LEFT_SIDE] = 0, [CHANNEL_RIGHT_SIDE] = 1,
+	[CHANNEL_LFE] = UPMIX_MUTE,
+};
+
+static const uint8_t upmix_2_0_to_7_1_sources[] = {
+	[CHANNEL_LEFT] = 0, [CHANNEL_CENTER] = UPMIX_MUTE, [CHANNEL_RIGHT] = 1,
+	[CHANNEL_LEFT_SURROUND] = 0, [CHANNEL_RIGHT_SURROUND] = 1,
+	[CHANNEL_LEFT_SIDE] = UPMIX_MUTE, [CHANNEL_RIGHT_SIDE] = UPMIX_MUTE,
+	[CHANNEL_LFE] = UPMIX_MUTE,
+};
+
+/* Channel map with the source channel of each output channel */
+static uint32_t upmix_chmap(struct up_down_mixer_data *cd, const uint8_t *sources,
+			    int out_channels)
+{
+	enum ipc4_channel_index index;
+	uint32_t chmap = 0;
+	uint32_t source;
+	int i;
+
+	for (i = 0; i < out_channels; i++) {
+		index = get_channel_index(cd->out_channel_map, i);
+		source = index <= CHANNEL_LFE ? sources[index] : UPMIX_MUTE;
+		chmap |= source << (i * 4);
+	}
 
-void upmix32bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
-			 const uint32_t in_size, uint8_t * const out_data)
+	return chmap;
+}
+
+static void upmix32bit_pick(struct up_down_mixer_data *cd, const uint8_t *sources,
+			    const uint8_t * const in_data, const uint32_t in_size,
+			    uint8_t * const out_data, int in_channels, int out_channels)
 {
-	sof_panic(0);
+	/* the channel maps and the routine are fixed from init */
+	if (!cd->upmix.func &&
+	    sofm_chmatrix_init_chmap(&cd->upmix, SOF_IPC_FRAME_S32_LE,
+				     upmix_chmap(cd, sources, out_channels),
+				     out_channels, in_channels))
+		sof_panic(0);
+
+	sofm_chmatrix_process_linear(&cd->upmix, in_data, out_data,
+				     in_size / (sizeof(int32_t) * in_channels));
 }
 
-void upmix16bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+/* 16-bit input is upmixed to 32-bit output */
+static void upmix16bit_pick(struct up_down_mixer_data *cd, const uint8_t *sources,
+			    const uint8_t * const in_data, const uint32_t in_size,
+			    uint8_t * const out_data, int in_channels, int out_channels)
+{
+	const int16_t *x = (const int16_t *)in_data;
+	int32_t *y = (int32_t *)out_data;
+	const uint32_t frames = in_size / (sizeof(int16_t) * in_channels);
+	uint32_t chmap = upmix_chmap(cd, sources, out_channels);
+	uint8_t src[SOFM_CHMATRIX_CHANNELS_MAX];
+	uint32_t i;
+	int ch;
+
+	for (ch = 0; ch < out_channels; ch++) {
+		src[ch] = chmap & 0xf;
+		chmap >>= 4;
+	}
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < out_channels; ch++)
+			y[ch] = src[ch] == UPMIX_MUTE ? 0 : (int32_t)x[src[ch]] << 16;
+
+		x += in_channels;
+		y += out_channels;
+	}
+}
+
+void upmix32bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			 const uint32_t in_size, uint8_t * const out_data)
 {
-	sof_panic(0);
+	upmix32bit_pick(cd, upmix_1_to_5_1_sources, in_data, in_size, out_data, 1, 6);
 }
 
 void upmix32bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			   const uint32_t in_size, uint8_t * const out_data)
 {
-	sof_panic(0);
+	upmix32bit_pick(cd, upmix_2_0_to_5_1_sources, in_data, in_size, out_data, 2, 6);
 }
 
-void upmix16bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+void upmix32bit_2_0_to_7_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			   const uint32_t in_size, uint8_t * const out_data)
 {
-	sof_panic(0);
+	upmix32bit_pick(cd, upmix_2_0_to_7_1_sources, in_data, in_size, out_data, 2, 8);
 }
 
-void upmix32bit_2_0_to_7_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+void upmix16bit_1_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
+			 const uint32_t in_size, uint8_t * const out_data)
+{
+	upmix16bit_pick(cd, upmix_1_to_5_1_sources, in_data, in_size, out_data, 1, 6);
+}
+
+void upmix16bit_2_0_to_5_1(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			   const uint32_t in_size, uint8_t * const out_data)
 {
-	sof_panic(0);
+	upmix16bit_pick(cd, upmix_2_0_to_5_1_sources, in_data, in_size, out_data, 2, 6);
 }
 
+/* TODO: replace with generic ANSI C version */
+
 void shiftcopy32bit_mono(struct up_down_mixer_data *cd, const uint8_t * const in_data,
 			 const uint32_t in_size, uint8_t * const out_data)
 {
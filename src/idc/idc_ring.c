@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+/*
+ * Head and tail are free running counters, the entry index is the counter
+ * modulo the ring size. Only the producer writes head and only the consumer
+ * writes tail, so no lock is needed between the two cores.
+ */
+
+#include <sof/common.h>
+#include <sof/lib/idc_ring.h>
+#include <rtos/atomic.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* the entry index must stay continuous when the counters wrap */
+STATIC_ASSERT(!(CONFIG_IDC_RING_SIZE & (CONFIG_IDC_RING_SIZE - 1)),
+	      idc_ring_size_not_power_of_two);
+
+struct idc_ring_entry *idc_ring_reserve(struct idc_ring *ring)
+{
+	struct idc_ring_entry *entry;
+
+	if (ring->reserved - (uint32_t)atomic_read(&ring->tail) >= CONFIG_IDC_RING_SIZE)
+		return NULL;
+
+	entry = ring->entry + ring->reserved++ % CONFIG_IDC_RING_SIZE;
+	entry->waiter = NULL;
+
+	return entry;
+}
+
+uint32_t idc_ring_commit(struct idc_ring *ring)
+{
+	uint32_t n = ring->reserved - (uint32_t)atomic_read(&ring->head);
+
+	/* the entries are written before they are published */
+	if (n)
+		atomic_set(&ring->head, ring->reserved);
+
+	return n;
+}
+
+struct idc_ring_entry *idc_ring_peek(struct idc_ring *ring)
+{
+	uint32_t tail = atomic_read(&ring->tail);
+
+	if (tail == (uint32_t)atomic_read(&ring->head))
+		return NULL;
+
+	return ring->entry + tail % CONFIG_IDC_RING_SIZE;
+}
+
+void idc_ring_complete(struct idc_ring *ring)
+{
+	atomic_set(&ring->tail, (uint32_t)atomic_read(&ring->tail) + 1);
+}
@@ -4,18 +4,23 @@
 
 /*
  * Use P4WQ to implement IDC for SOF. We create a P4 work queue per core and
- * when the primary core sends a message to a secondary core, a work item from
- * a static per-core array is queued accordingly. The secondary core is then
- * woken up, it executes irc_handler(), which eventually calls idc_cmd() just
- * like in the native SOF case. One work item per secondary core is enough
- * because IDC on SOF is always synchronous, the primary core always waits for
- * secondary cores to complete operation, so no races can occur.
+ * each pair of source and target cores has a single producer, single
+ * consumer ring of messages. A sender copies the message and its payload to
+ * the next free entry of its ring to the target core, publishes it and,
+ * unless a handler of the ring is already pending, submits a work item of
+ * the ring to the queue of the target core. The target core is then woken
+ * up, it executes idc_handler(), which handles all published messages of the
+ * ring in order and eventually calls idc_cmd() just like in the native SOF
+ * case.
+ * Several messages can be in flight per core pair, senders on different
+ * cores never share a lock and a blocking sender waits for the completion
+ * of its own message only.
  *
  * Design:
  * - use K_P4WQ_ARRAY_DEFINE() to statically create one queue with one thread
  *	per DSP core.
  * - k_p4wq_submit()
- *	runs on primary CPU
+ *	runs on the source CPU
  *	send tasks to other CPUs.
  */
 
@@ -31,6 +36,7 @@
 #include <rtos/spinlock.h>
 #include <ipc/topology.h>
 #include <sof/trace/trace.h>
+#include <sof/lib/idc_ring.h>
 #include <sof/lib/uuid.h>
 
 #include <sof/debug/telemetry/performance_monitor.h>
@@ -64,28 +70,41 @@ int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 K_P4WQ_ARRAY_DEFINE(q_zephyr_idc, CONFIG_CORE_COUNT, SOF_STACK_SIZE,
 		    K_P4WQ_USER_CPU_MASK);
 
-struct zephyr_idc_msg {
+struct zephyr_idc_ring;
+
+struct zephyr_idc_work {
 	struct k_p4wq_work work;
-	struct idc_msg msg;
+	struct zephyr_idc_ring *zring;
 };
 
-static void idc_handler(struct k_p4wq_work *work)
+struct zephyr_idc_ring {
+	struct idc_ring ring;
+	struct k_spinlock lock;		/* serializes senders of the source core */
+	atomic_t kicked;		/* work submitted, handler not started yet */
+	/*
+	 * 2 work items, because the p4wq thread might just have returned from
+	 * the work handler, but hasn't released the work buffer yet (hasn't set
+	 * thread pointer to NULL). Then submitting the same work item again can
+	 * result in an assertion failure.
+	 */
+	struct zephyr_idc_work work[2];
+};
+
+/* Sender waiting for a blocking message, on the sender stack */
+struct zephyr_idc_waiter {
+	struct k_sem sem;
+	int status;
+};
+
+/* Indexed by source and target core, zero initialized rings are empty */
+static struct zephyr_idc_ring idc_rings[CONFIG_CORE_COUNT][CONFIG_CORE_COUNT];
+
+static void idc_handle_msg(struct idc_msg *msg)
 {
-	struct zephyr_idc_msg *zmsg = container_of(work, struct zephyr_idc_msg, work);
 	struct idc *idc = *idc_get();
 	struct ipc *ipc = ipc_get();
-	struct idc_msg *msg = &zmsg->msg;
-	int payload = -1;
 	k_spinlock_key_t key;
 
-	__ASSERT_NO_MSG(!is_cached(msg));
-
-	if (msg->size == sizeof(int)) {
-		const int idc_handler_memcpy_err __unused =
-			memcpy_s(&payload, sizeof(payload), msg->payload, msg->size);
-		assert(!idc_handler_memcpy_err);
-	}
-
 	idc->received_msg.core = msg->core;
 	idc->received_msg.header = msg->header;
 	idc->received_msg.extension = msg->extension;
@@ -113,25 +132,75 @@ static void idc_handler(struct k_p4wq_work *work)
 	}
 }
 
-/*
- * Used for *target* CPUs, since the initiator (usually core 0) can launch
- * several IDC messages at once. Also we need 2 work items per target core,
- * because the p4wq thread might just have returned from the work handler, but
- * hasn't released the work buffer yet (hasn't set thread pointer to NULL).
- * Then submitting the same work item again can result in an assertion failure.
- */
-static struct zephyr_idc_msg idc_work[CONFIG_CORE_COUNT * 2];
-/* Protect the above array */
-static K_MUTEX_DEFINE(idc_mutex);
+/* Handles all messages of one ring, also the ones committed meanwhile */
+static void idc_handler(struct k_p4wq_work *work)
+{
+	struct zephyr_idc_ring *zring = container_of(work, struct zephyr_idc_work, work)->zring;
+	struct idc_payload *payload = idc_payload_get(*idc_get(), cpu_get_id());
+	struct zephyr_idc_waiter *waiter;
+	struct idc_ring_entry *entry;
+	int idc_handler_memcpy_err __unused;
+	int status;
+
+	/* messages committed from now on need a new doorbell */
+	atomic_clear(&zring->kicked);
+
+	while ((entry = idc_ring_peek(&zring->ring))) {
+		__ASSERT_NO_MSG(!is_cached(entry));
+
+		/* commands read the payload of the core they run on */
+		if (entry->msg.size) {
+			idc_handler_memcpy_err = memcpy_s(payload->data, sizeof(payload->data),
+							  entry->payload, entry->msg.size);
+			assert(!idc_handler_memcpy_err);
+		}
+
+		idc_handle_msg(&entry->msg);
+		status = idc_msg_status_get(cpu_get_id());
+
+		/* the sender reuses the entry as soon as it is completed */
+		waiter = atomic_ptr_clear(&entry->waiter);
+		idc_ring_complete(&zring->ring);
+		if (waiter) {
+			waiter->status = status;
+			k_sem_give(&waiter->sem);
+		}
+	}
+}
+
+/* Publishes reserved messages and rings the doorbell if needed, lock held */
+static void idc_ring_kick(struct zephyr_idc_ring *zring, unsigned int target_cpu)
+{
+	struct zephyr_idc_work *zwork = zring->work;
+
+	if (!idc_ring_commit(&zring->ring))
+		return;
+
+	/* a handler not started yet will see the new messages */
+	if (!atomic_cas(&zring->kicked, 0, 1))
+		return;
+
+	if (unlikely(zwork->work.thread))
+		zwork++;
+
+	/* Same priority as the IPC thread which is an EDF task and under Zephyr */
+	zwork->zring = zring;
+	zwork->work.priority = CONFIG_EDF_THREAD_PRIORITY;
+	zwork->work.deadline = 0;
+	zwork->work.handler = idc_handler;
+	zwork->work.sync = false;
+
+	k_p4wq_submit(q_zephyr_idc + target_cpu, &zwork->work);
+}
 
 int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 {
-	struct idc *idc = *idc_get();
-	struct idc_payload *payload = idc_payload_get(idc, msg->core);
 	unsigned int target_cpu = msg->core;
-	struct zephyr_idc_msg *zmsg = idc_work + target_cpu * 2;
-	struct idc_msg *msg_cp = &zmsg->msg;
-	struct k_p4wq_work *work = &zmsg->work;
+	struct zephyr_idc_ring *zring = &idc_rings[cpu_get_id()][target_cpu];
+	struct zephyr_idc_waiter waiter;
+	struct idc_ring_entry *entry;
+	k_spinlock_key_t key;
+	int64_t deadline;
 	int ret;
 	int idc_send_memcpy_err __unused;
 
@@ -140,61 +209,73 @@ int idc_send_msg(struct idc_msg *msg, uint32_t mode)
 		return -EACCES;
 	}
 
-	k_mutex_lock(&idc_mutex, K_FOREVER);
-
-	if (unlikely(work->thread)) {
-		/* See comment above the idc_work[] array. */
-		zmsg++;
-		work = &zmsg->work;
-		msg_cp = &zmsg->msg;
+	if (msg->payload && msg->size > IDC_MAX_PAYLOAD_SIZE) {
+		tr_err(&zephyr_idc_tr, "IDC payload size %u too big", msg->size);
+		return -EINVAL;
 	}
 
-	idc_send_memcpy_err = memcpy_s(msg_cp, sizeof(*msg_cp), msg, sizeof(*msg));
-	assert(!idc_send_memcpy_err);
+	deadline = k_uptime_ticks() + k_us_to_ticks_ceil64(CONFIG_IDC_TIMEOUT_US);
 
-	/* Same priority as the IPC thread which is an EDF task and under Zephyr */
-	work->priority = CONFIG_EDF_THREAD_PRIORITY;
-	work->deadline = 0;
-	work->handler = idc_handler;
-	work->sync = mode == IDC_BLOCKING;
+	key = k_spin_lock(&zring->lock);
+
+	while (!(entry = idc_ring_reserve(&zring->ring))) {
+		/* all entries in flight, make sure the target is handling them */
+		idc_ring_kick(zring, target_cpu);
+		k_spin_unlock(&zring->lock, key);
 
+		if (k_uptime_ticks() > deadline) {
+			tr_err(&zephyr_idc_tr, "IDC ring to core %u full", target_cpu);
+			return -ETIMEDOUT;
+		}
+
+		k_yield();
+		key = k_spin_lock(&zring->lock);
+	}
+
+	__ASSERT_NO_MSG(!is_cached(entry));
+
+	entry->msg = *msg;
+	entry->msg.payload = NULL;
 	if (msg->payload) {
-		idc_send_memcpy_err = memcpy_s(payload->data, sizeof(payload->data),
+		idc_send_memcpy_err = memcpy_s(entry->payload, sizeof(entry->payload),
 					       msg->payload, msg->size);
 		assert(!idc_send_memcpy_err);
-
-		/* Sending a message to another core, write back local payload cache */
-		sys_cache_data_flush_range(payload->data, MIN(sizeof(payload->data), msg->size));
+	} else {
+		entry->msg.size = 0;
 	}
 
 	/* Temporarily store sender core ID */
-	msg_cp->core = cpu_get_id();
+	entry->msg.core = cpu_get_id();
 
-	__ASSERT_NO_MSG(!is_cached(msg_cp));
+	if (mode == IDC_BLOCKING) {
+		k_sem_init(&waiter.sem, 0, 1);
+		entry->waiter = &waiter;
+	}
 
-	k_p4wq_submit(q_zephyr_idc + target_cpu, work);
+	idc_ring_kick(zring, target_cpu);
 
-	k_mutex_unlock(&idc_mutex);
+	k_spin_unlock(&zring->lock, key);
 
 #ifdef CONFIG_SOF_TELEMETRY_IO_PERFORMANCE_MEASUREMENTS
 	/* Increment performance counters */
-	io_perf_monitor_update_data(idc->io_perf_out_msg_count, 1);
+	io_perf_monitor_update_data((*idc_get())->io_perf_out_msg_count, 1);
 #endif
 
-	switch (mode) {
-	case IDC_BLOCKING:
-		ret = k_p4wq_wait(work, K_USEC(CONFIG_IDC_TIMEOUT_US));
-		if (!ret)
-			/* message was sent and executed successfully, get status code */
-			ret = idc_msg_status_get(msg->core);
-		break;
-	case IDC_POWER_UP:
-	case IDC_NON_BLOCKING:
-	default:
-		ret = 0;
+	if (mode != IDC_BLOCKING)
+		return 0;
+
+	ret = k_sem_take(&waiter.sem, K_USEC(CONFIG_IDC_TIMEOUT_US));
+	if (ret < 0) {
+		/* the handler must not signal the waiter after the sender returned */
+		if (atomic_ptr_cas(&entry->waiter, &waiter, NULL))
+			return ret;
+
+		/* the handler is completing the message right now */
+		k_sem_take(&waiter.sem, K_FOREVER);
 	}
 
-	return ret;
+	/* message was sent and executed, get status code */
+	return waiter.status;
 }
 
 __cold void idc_init_thread(void)
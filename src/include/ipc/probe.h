@@ -10,3 +10,28 @@
 #else
 #include <ipc3/probe.h>
 #endif
+
+/**
+ * \brief Extraction options in the probe point purpose
+ *
+ * The purpose value is in the low bits, the options in the upper bits
+ * are zero for plain extraction.
+ *
+ * A - 16 bits - Channel mask of the extracted channels, 0 for all
+ * B - 4 bits - Decimation factor minus 1
+ * C - 1 bit - Compress with delta and Rice coding
+ * D - 1 bit - Truncate integer samples to 16 bits
+ * E - 8 bits - Purpose
+ *
+ * AAAAAAAAAAAAAAAA|BBBB|XX|C|D|EEEEEEEE
+ */
+#define PROBE_OPT_SHIFT_CH_MASK		16
+#define PROBE_OPT_SHIFT_DECIMATION	12
+#define PROBE_OPT_SHIFT_RICE		9
+#define PROBE_OPT_SHIFT_S16		8
+
+#define PROBE_OPT_MASK_CH_MASK		MASK(31, 16)
+#define PROBE_OPT_MASK_DECIMATION	MASK(15, 12)
+#define PROBE_OPT_MASK_RICE		MASK(9, 9)
+#define PROBE_OPT_MASK_S16		MASK(8, 8)
+#define PROBE_PURPOSE_MASK		MASK(7, 0)
@@ -57,6 +57,13 @@ struct probe_data_packet {
  * H - 1 bit - Specifies Sample Format - 0 for Integer, 1 for Floating point
  * I - 1 bit - Specifies Sample Endianness - 0 for LE
  * J - 1 bit - Specifies Interleaving - 1 for Sample Interleaving
+ * K - 4 bits - Specify Decimation factor minus 1, sample rate is the
+ *		rate before decimation
+ * L - 3 bits - Specify Compression - value enumerating compressions:
+ *				      none		= 0x0
+ *				      delta and Rice	= 0x1
+ *
+ * A|BBBB|CCCC|DDDD|EEEEE|FF|GG|H|I|J|KKKK|LLL
  */
 #define PROBE_SHIFT_FMT_TYPE		31
 #define PROBE_SHIFT_STANDARD_TYPE	27
@@ -68,6 +75,8 @@ struct probe_data_packet {
 #define PROBE_SHIFT_SAMPLE_FMT		9
 #define PROBE_SHIFT_SAMPLE_END		8
 #define PROBE_SHIFT_INTERLEAVING_ST	7
+#define PROBE_SHIFT_DECIMATION		3
+#define PROBE_SHIFT_COMPRESSION		0
 
 #define PROBE_MASK_FMT_TYPE		MASK(31, 31)
 #define PROBE_MASK_STANDARD_TYPE	MASK(30, 27)
@@ -79,5 +88,29 @@ struct probe_data_packet {
 #define PROBE_MASK_SAMPLE_FMT		MASK(9, 9)
 #define PROBE_MASK_SAMPLE_END		MASK(8, 8)
 #define PROBE_MASK_INTERLEAVING_ST	MASK(7, 7)
+#define PROBE_MASK_DECIMATION		MASK(6, 3)
+#define PROBE_MASK_COMPRESSION		MASK(2, 0)
+
+#define PROBE_COMPRESSION_NONE		0
+#define PROBE_COMPRESSION_RICE		1
+
+/**
+ * \brief Delta and Rice compressed data
+ *
+ * The data starts with 32 bit number of frames, followed by a bit stream
+ * with the most significant bit first. For each frame and channel the
+ * difference to the previous sample of the channel, zero for the first
+ * frame, is mapped to unsigned as (d << 1) ^ (d >> 31) and Rice coded
+ * with parameter k: the quotient in unary as ones ended by a zero, then
+ * k low bits. A quotient of PROBE_RICE_ESCAPE or more is coded as
+ * PROBE_RICE_ESCAPE ones followed by the 32 bit value. The parameter k
+ * is the smallest value for which n << k >= a, where a is the sum of
+ * the coded values and n their count for the channel. Both start from
+ * PROBE_RICE_INIT_A and 1, and are halved when n reaches
+ * PROBE_RICE_RESET.
+ */
+#define PROBE_RICE_ESCAPE		24
+#define PROBE_RICE_INIT_A		16
+#define PROBE_RICE_RESET		64
 
 #endif
@@ -298,6 +298,11 @@ enum ipc4_basefw_params {
 
 	/* Set policy mask for mic privacy in FW managed mode */
 	IPC4_SET_MIC_PRIVACY_FW_MANAGED_POLICY_MASK = 36,
+
+	/* SOF extension: usage, fragmentation and allocation latency statistics
+	 * of the heaps, see struct ipc4_heap_stats_info.
+	 */
+	IPC4_HEAP_STATS_GET = 37,
 };
 
 enum ipc4_fw_config_params {
@@ -692,6 +697,13 @@ struct ipc4_libraries_info {
 	struct ipc4_library_props libraries[0];
 } __packed __aligned(4);
 
+struct ipc4_heap_stats_info {
+	/* Specifies number of items in heaps array. */
+	uint32_t heap_count;
+	/* Array of struct heap_stats_record, see sof/lib/heap_stats.h */
+	uint32_t heaps[0];
+} __packed __aligned(4);
+
 struct ipc4_log_state_info {
 	/*
 	 * Specifies how frequently FW sends Log Buffer Status
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation.
+ */
+
+/**
+ * \file include/ipc4/batch.h
+ * \brief IPC4 batch message definitions
+ * NOTE: This ABI uses bit fields and is non portable.
+ */
+
+#ifndef __SOF_IPC4_BATCH_H__
+#define __SOF_IPC4_BATCH_H__
+
+#include <stdint.h>
+#include <ipc4/header.h>
+
+/**< Maximum number of operations in one batch */
+#define SOF_IPC4_BATCH_MAX_OPS		64
+
+/**< Size of an operation with its payload, payloads are padded to words */
+#define SOF_IPC4_BATCH_OP_SIZE(data_size) \
+	(sizeof(struct ipc4_batch_op) + (((data_size) + 3) & ~3))
+
+/*!
+ * SW Driver sends this IPC message to run several module and pipeline
+ * operations with one round trip. The payload is a sequence of
+ * struct ipc4_batch_op, each one a complete IPC4 request with the payload
+ * it would have in the mailbox when sent alone.
+ *
+ * Operations run in order and the batch stops at the first failure. Then
+ * the pipelines, module instances and bindings created by the batch are
+ * removed again and the states of pipelines changed by the batch are
+ * restored, in reverse order. Deletions and module configuration are not
+ * reverted.
+ *
+ * Supported operations are CREATE_PIPELINE, DELETE_PIPELINE and
+ * SET_PIPELINE_STATE for a single pipeline, and INIT_INSTANCE,
+ * DELETE_INSTANCE, BIND, UNBIND, CONFIG_SET and LARGE_CONFIG_SET in one
+ * block. Every operation must run on the core handling the batch, objects
+ * on other cores are refused with IPC4_INVALID_CORE_ID.
+ *
+ * The reply status is the status of the failing operation or
+ * IPC4_SUCCESS, the reply extension is the number of operations run. The
+ * reply payload holds the status of every operation run.
+ *
+ * \remark hide_methods
+ */
+struct ipc4_batch {
+	union {
+		uint32_t dat;
+
+		struct {
+			/**< number of operations */
+			uint32_t count		: 8;
+			uint32_t rsvd0		: 16;
+			/**< Global::BATCH */
+			uint32_t type		: 5;
+			/**< Msg::MSG_REQUEST */
+			uint32_t rsp		: 1;
+			/**< Msg::FW_GEN_MSG */
+			uint32_t msg_tgt	: 1;
+			uint32_t _reserved_0	: 1;
+		} r;
+	} primary;
+
+	union {
+		uint32_t dat;
+
+		struct {
+			/**< size of all operations in bytes */
+			uint32_t data_size	: 30;
+			uint32_t _reserved_2	: 2;
+		} r;
+	} extension;
+} __attribute__((packed, aligned(4)));
+
+/*!
+ * Operation of a batch, followed by data_size bytes of payload and padding
+ * to the next word.
+ */
+struct ipc4_batch_op {
+	/**< request header of the operation */
+	struct ipc4_message_request request;
+	/**< payload size in bytes */
+	uint32_t data_size;
+	uint32_t data[];
+} __attribute__((packed, aligned(4)));
+
+#endif /* __SOF_IPC4_BATCH_H__ */
@@ -105,6 +105,12 @@ __syscall void ipc_compound_post_start(uint32_t msg_id, int ret, bool delayed);
  */
 __syscall int ipc_wait_for_compound_msg(void);
 
+/**
+ * \brief Get and clear the error of the delayed operations of the IPC message.
+ * @return IPC4 error code of a failed delayed operation, 0 if none failed.
+ */
+__syscall int ipc_compound_msg_take_error(void);
+
 #include <zephyr/syscalls/handler.h>
 #else
 void z_impl_ipc_compound_pre_start(int msg_id);
@@ -113,6 +119,8 @@ void z_impl_ipc_compound_post_start(uint32_t msg_id, int ret, bool delayed);
 #define ipc_compound_post_start z_impl_ipc_compound_post_start
 int z_impl_ipc_wait_for_compound_msg(void);
 #define ipc_wait_for_compound_msg z_impl_ipc_wait_for_compound_msg
+int z_impl_ipc_compound_msg_take_error(void);
+#define ipc_compound_msg_take_error z_impl_ipc_compound_msg_take_error
 #endif
 
 #endif /* __SOF_IPC4_HANDLER_H__ */
@@ -87,7 +87,9 @@ enum ipc4_message_type {
 	SOF_IPC4_GLB_INTERNAL_MESSAGE = 26,
 	/**< Notification (FW to SW driver) */
 	SOF_IPC4_GLB_NOTIFICATION = 27,
-	/* GAP HERE- DO NOT USE - size 3 (28 .. 30)  */
+	/* GAP HERE- DO NOT USE - size 2 (28 .. 29)  */
+	/**< Batch of module and pipeline operations */
+	SOF_IPC4_GLB_BATCH = 30,
 	/**< Enter GDB stub to wait for commands in memory window */
 	SOF_IPC4_GLB_ENTER_GDB = 31,
 
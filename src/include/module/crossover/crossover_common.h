@@ -10,7 +10,9 @@
 
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/math/iir_df1.h>
+#include <sof/platform.h>
 #include <user/eq.h>
+#include <string.h>
 
 /* Number of sinks for a 2 way crossover filter */
 #define CROSSOVER_2WAY_NUM_SINKS 2
@@ -25,52 +27,49 @@
 /* Maximum Number of sinks allowed in config */
 #define SOF_CROSSOVER_MAX_STREAMS 4
 
+/* Number of coefficients for a LR4 filter, two identical biquads in series */
+#define CROSSOVER_NUM_COEF_LR4 (SOF_IIR_DF1_4TH_NUM_BIQUADS * SOF_EQ_IIR_NBIQUAD)
+
+/**
+ * Stores the state of one LR4 filter for all channels. The coefficients
+ * are common for all channels and the delay lines of the channels follow
+ * each other so that one LR4 filter is computed for all channels of a frame
+ * with a single coefficients load.
+ */
+struct crossover_lr4_state {
+	int32_t delay[PLATFORM_MAX_CHANNELS * SOF_IIR_DF1_4TH_NUM_BIQUADS * IIR_DF1_NUM_STATE]
+		__aligned(8);
+	int32_t coef[CROSSOVER_NUM_COEF_LR4];
+};
+
 /**
- * Stores the state of one channel of the Crossover filter
+ * Stores the state of the Crossover filter for all channels
  */
 struct crossover_state {
 	/* Store the state for each LR4 filter. */
-	struct iir_state_df1 lowpass[CROSSOVER_MAX_LR4];
-	struct iir_state_df1 highpass[CROSSOVER_MAX_LR4];
+	struct crossover_lr4_state lowpass[CROSSOVER_MAX_LR4];
+	struct crossover_lr4_state highpass[CROSSOVER_MAX_LR4];
 };
 
-typedef void (*crossover_split)(int32_t in, int32_t out[],
-				struct crossover_state *state);
+/* Split one frame of nch channels from in[] to out[band][channel] */
+typedef void (*crossover_split)(const int32_t in[],
+				int32_t out[][PLATFORM_MAX_CHANNELS],
+				struct crossover_state *state, int nch);
 
 extern const crossover_split crossover_split_fnmap[];
 
 /* crossover init function */
-int crossover_init_coef_ch(struct processing_module *mod,
-			   struct sof_eq_iir_biquad *coef,
-			   struct crossover_state *ch_state,
-			   int32_t num_sinks);
-
-/**
- * \brief Reset the state of an LR4 filter.
- */
-static inline void crossover_reset_state_lr4(struct processing_module *mod,
-					     struct iir_state_df1 *lr4)
-{
-	mod_free(mod, lr4->coef);
-	mod_free(mod, lr4->delay);
-
-	lr4->coef = NULL;
-	lr4->delay = NULL;
-}
+int crossover_init_coef_state(struct sof_eq_iir_biquad *coef,
+			      struct crossover_state *state,
+			      int32_t num_sinks);
 
 /**
  * \brief Reset the state (coefficients and delay) of the crossover filter
- *	  of a single channel.
+ *	  of all channels.
  */
-static inline void crossover_reset_state_ch(struct processing_module *mod,
-					    struct crossover_state *ch_state)
+static inline void crossover_reset_state_all(struct crossover_state *state)
 {
-	int i;
-
-	for (i = 0; i < CROSSOVER_MAX_LR4; i++) {
-		crossover_reset_state_lr4(mod, &ch_state->lowpass[i]);
-		crossover_reset_state_lr4(mod, &ch_state->highpass[i]);
-	}
+	memset(state, 0, sizeof(*state));
 }
 
 /**
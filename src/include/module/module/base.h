@@ -74,7 +74,8 @@ struct module_data {
 #ifdef SOF_MODULE_API_PRIVATE
 	enum module_state state;
 	size_t new_cfg_size; /**< size of new module config data */
-	void *runtime_params;
+	size_t new_cfg_pos; /**< end of new config data received so far */
+	void *runtime_params; /**< new config assembled in place, becomes cfg.data */
 	struct module_resources resources; /**< resources allocated by module */
 	struct module_processing_data mpd; /**< shared data comp <-> module */
 #endif /* SOF_MODULE_PRIVATE */
@@ -14,7 +14,7 @@
 #define __SOF_AUDIO_MODULE_GENERIC__
 
 #include <rtos/mutex.h>
-#include <sof/objpool.h>
+#include <sof/lib/heap_stats.h>
 #include <sof/ut.h>
 #include <sof/audio/component.h>
 #include <sof/audio/sink_api.h>
@@ -118,6 +118,22 @@ struct module_param {
 	int32_t data[];		/**< A pointer to memory where config is stored.*/
 };
 
+/**
+ * \struct mod_arena
+ * \brief module arena - one block for the allocations of init and prepare
+ * The allocations are taken from the block by bumping a pointer, without
+ * records, and the whole block is freed at once when the module unloads.
+ */
+struct mod_arena {
+	uint8_t *base;	/**< arena block, NULL if none is reserved */
+	size_t size;	/**< size of the block */
+	size_t used;	/**< bytes taken from the block */
+	size_t last;	/**< offset of the last allocation, it can be given back */
+	size_t need;	/**< bytes the allocations of init and prepare needed */
+	size_t align;	/**< largest alignment the allocations needed */
+	bool open;	/**< allocations of init and prepare are in progress */
+};
+
 /**
  * \struct module_resources
  * \brief module resources block - used for module allocation records
@@ -125,10 +141,18 @@ struct module_param {
  * when the module unloads.
  */
 struct module_resources {
-	struct objpool_head objpool;
+	struct module_resource *table;	/**< allocation records, keyed by pointer */
+	unsigned int table_size;	/**< number of record slots, a power of two */
+	unsigned int count;		/**< number of records */
 	size_t heap_usage;
 	size_t heap_high_water_mark;
 	struct mod_alloc_ctx *alloc;
+#if CONFIG_MODULE_MEMORY_API_ARENA
+	struct mod_arena arena;
+#endif
+#if CONFIG_SOF_HEAP_STATS
+	struct heap_stats stats;	/* module allocations, reported with the heaps */
+#endif
 };
 
 enum mod_resource_type {
@@ -148,9 +172,8 @@ struct module_resource {
 		struct comp_data_blob_handler *bhp; /**< Blob handler ptr */
 		const void *sram_ptr; /**< SRAM ptr from fast_get() */
 	};
-	struct list_item list; /**< list element */
 	size_t size; /**< Size of allocated heap memory, 0 if not from heap */
-	enum mod_resource_type type; /**< Resource type */
+	enum mod_resource_type type; /**< Resource type, MOD_RES_UNINITIALIZED if free */
 };
 
 /**
@@ -191,6 +214,21 @@ void *z_impl_mod_balloc_align(struct processing_module *mod, size_t size, size_t
 #define mod_balloc_align z_impl_mod_balloc_align
 #endif
 void mod_resource_init(struct processing_module *mod);
+#if CONFIG_MODULE_MEMORY_API_ARENA
+int mod_arena_reserve(struct processing_module *mod, size_t size);
+#else
+static inline int mod_arena_reserve(struct processing_module *mod, size_t size)
+{
+	return -ENOTSUP;
+}
+#endif
+#if CONFIG_SOF_HEAP_STATS
+void mod_stats_register(struct processing_module *mod, uint32_t id);
+void mod_stats_unregister(struct processing_module *mod);
+#else
+static inline void mod_stats_register(struct processing_module *mod, uint32_t id) {}
+static inline void mod_stats_unregister(struct processing_module *mod) {}
+#endif
 void mod_heap_info(struct processing_module *mod, size_t *size, uintptr_t *start);
 #if defined(__ZEPHYR__) && defined(CONFIG_SOF_FULL_ZEPHYR_APPLICATION)
 __syscall void *mod_alloc_ext(struct processing_module *mod, uint32_t flags, size_t size,
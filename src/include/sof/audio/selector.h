@@ -19,6 +19,7 @@
 #include <ipc/stream.h>
 #if CONFIG_IPC_MAJOR_4
 #include <ipc4/base-config.h>
+#include <sof/math/chmatrix.h>
 #endif
 #include <user/selector.h>
 #include <user/trace.h>
@@ -120,6 +121,7 @@ struct comp_data {
 	struct ipc4_selector_coeffs_config coeffs_config;
 	struct ipc4_selector_coeffs_config *multi_coeffs_config;
 	size_t multi_coeffs_config_size;
+	struct sofm_chmatrix matrix;	/**< classified mixing coefficients */
 #endif
 
 	uint32_t source_period_bytes;	/**< source number of period bytes */
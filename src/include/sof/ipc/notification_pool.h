@@ -11,12 +11,25 @@
 #include <stdint.h>
 #include <sof/ipc/msg.h>
 
+/**
+ * @brief Preallocates the IPC notification messages of all cores.
+ *
+ * This function allocates the messages of every core, so that no
+ * allocation is needed when a notification is raised. It must be called
+ * once before any notification message is retrieved.
+ *
+ * @return 0 on success, -ENOMEM if the messages cannot be allocated.
+ */
+int ipc_notification_pool_init(void);
+
 /**
  * @brief Retrieves an IPC notification message from the pool.
  *
  * This function retrieves and returns an IPC notification message
- * of the specified size from the notification pool. The size of the
- * message is limited by the maximum size available in the pool.
+ * of the specified size from the pool of the current core. It neither
+ * allocates nor locks, so it can be called from LL context. The message
+ * returns to the pool when it has been sent. When all messages are in
+ * flight the notification is dropped and logged.
  *
  * @param size The size of the IPC message to retrieve.
  * @return A pointer to the retrieved IPC message, or NULL if retrieval fails.
@@ -27,8 +40,8 @@ struct ipc_msg *ipc_notification_pool_get(size_t size);
 /**
  * @brief Frees all IPC notification messages in the pool.
  *
- * This function frees all notification messages currently held in
- * the pool free list and resets the pool depth counter. It is
+ * This function frees the preallocated notification messages of all
+ * cores. Messages still in flight must not be used afterwards. It is
  * required only in library (testbench) build.
  */
 void ipc_notification_pool_free(void);
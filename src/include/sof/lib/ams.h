@@ -22,12 +22,12 @@
 /* Wildcard for module_id and instance_id values */
 #define AMS_ANY_ID 0xFFFF
 
-/* max number of message UUIDs */
+/* max number of message UUIDs, message type IDs are 1 to this value */
 #define AMS_SERVICE_UUID_TABLE_SIZE 16
-/* max number of async message routes */
-#define AMS_ROUTING_TABLE_SIZE 16
-/* Space allocated for async message content*/
-#define AMS_MAX_MSG_SIZE 0x1000
+/* max number of consumers of one message type */
+#define AMS_TYPE_CONSUMERS 8
+/* max number of producers of one message type */
+#define AMS_TYPE_PRODUCERS 8
 
 /**
  * \brief IXC message payload
@@ -52,11 +52,7 @@ struct ams_message_payload {
 struct ams_slot {
 	uint16_t module_id;
 	uint16_t instance_id;
-	union {
-		struct ams_message_payload msg;
-		uint8_t msg_raw[AMS_MAX_MSG_SIZE];
-	} u;
-	uint32_t __aligned(PLATFORM_DCACHE_ALIGN) pad[];
+	struct ams_message_payload msg;
 };
 
 /**
@@ -71,12 +67,10 @@ typedef void (*ams_msg_callback_fn)(const struct ams_message_payload *const ams_
  * \brief Internal struct ams_consumer_entry
  *
  * Describes a single consumer's subscription to a single message.
- * Array of 'ams_consumer_entry' structs forms AsyncMessageService's routing
- * table which allows for message dispatch.
+ * The consumer entries of a message type form its routing table which
+ * allows for message dispatch.
  */
 struct ams_consumer_entry {
-	/* Message ID that will be routed via this entry */
-	uint32_t message_type_id;
 	/* Callback provided by the subscribed consumer */
 	ams_msg_callback_fn consumer_callback;
 	/* Additional context for consumer_callback (optional) */
@@ -90,8 +84,6 @@ struct ams_consumer_entry {
 };
 
 struct ams_producer {
-	/* Message ID that will be routed via this entry */
-	uint32_t message_type_id;
 	/* Subscribed producer's Module ID */
 	uint16_t producer_module_id;
 	/* Subscribed producer's Module Instance ID */
@@ -103,14 +95,32 @@ struct uuid_idx {
 	uint8_t message_uuid[UUID_SIZE];
 };
 
-struct ams_shared_context {
+/* Message type IDs assigned to message UUIDs */
+struct ams_uuid_table {
 	/* should be only used with ams_acquire/release function, not generic ones */
 	struct coherent c;
 
 	uint32_t last_used_msg_id;
-	struct ams_consumer_entry rt_table[AMS_ROUTING_TABLE_SIZE];
-	struct ams_producer producer_table[AMS_ROUTING_TABLE_SIZE];
 	struct uuid_idx uuid_table[AMS_SERVICE_UUID_TABLE_SIZE];
+};
+
+/* Routes of one message type, a send only acquires the record of its type */
+struct ams_type_record {
+	/* should be only used with ams_acquire/release function, not generic ones */
+	struct coherent c;
+
+	/* AMS_INVALID_MSG_TYPE until the type ID is assigned to a UUID */
+	uint32_t message_type_id;
+	uint32_t consumer_count;
+	uint32_t producer_count;
+	struct ams_consumer_entry consumers[AMS_TYPE_CONSUMERS];
+	struct ams_producer producers[AMS_TYPE_PRODUCERS];
+};
+
+/* Messages forwarded to other cores */
+struct ams_slot_table {
+	/* should be only used with ams_acquire/release function, not generic ones */
+	struct coherent c;
 
 	uint32_t slot_uses[CONFIG_CORE_COUNT];
 	/* marks which core already processed slot */
@@ -119,8 +129,16 @@ struct ams_shared_context {
 	struct ams_slot slots[CONFIG_CORE_COUNT];
 };
 
+/* Set up by the primary core and read-only after that */
+struct ams_shared_context {
+	struct ams_uuid_table *uuids;
+	struct ams_slot_table *slots;
+	/* indexed by message type ID - 1 */
+	struct ams_type_record *types[AMS_SERVICE_UUID_TABLE_SIZE];
+};
+
 struct ams_context {
-	/* shared context must be always accessed with shared->c taken */
+	/* records of shared context must be always accessed with their c taken */
 	struct ams_shared_context *shared;
 };
 
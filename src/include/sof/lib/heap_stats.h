@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation.
+ */
+
+/*
+ * Heap statistics. Heaps and modules count their allocations, track the
+ * usage and its peak and keep a histogram of allocation latencies. The
+ * registered statistics are reported through IPC4 and by the testbench,
+ * with the largest free block sampled at report time to show fragmentation.
+ */
+
+#ifndef __SOF_LIB_HEAP_STATS_H__
+#define __SOF_LIB_HEAP_STATS_H__
+
+#include <sof/common.h>
+#include <sof/list.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* bin n counts allocations of less than 2^(n + SHIFT) cycles, the last bin all slower */
+#define HEAP_STATS_LATENCY_BINS		12
+#define HEAP_STATS_LATENCY_SHIFT	5
+
+#define HEAP_STATS_LARGEST_FREE_UNKNOWN	UINT32_MAX
+
+enum heap_stats_type {
+	HEAP_STATS_SYSTEM = 0,	/**< id is enum heap_stats_system_id */
+	HEAP_STATS_VREGION,	/**< id is the creation count */
+	HEAP_STATS_MODULE,	/**< id is the component id */
+};
+
+enum heap_stats_system_id {
+	HEAP_STATS_SYSTEM_SOF = 0,
+	HEAP_STATS_SYSTEM_SHARED_BUFFER,
+};
+
+struct heap_stats;
+
+/** Largest block that can be allocated now, called from thread context */
+typedef size_t (*heap_stats_largest_free_t)(struct heap_stats *stats);
+
+struct heap_stats {
+	struct list_item list;
+	uint32_t type;
+	uint32_t id;
+	size_t size;		/**< heap size, 0 if not limited */
+	size_t used;		/**< bytes allocated */
+	size_t peak;		/**< peak of used */
+	uint32_t alloc_count;
+	uint32_t free_count;
+	uint32_t fail_count;
+	uint32_t latency[HEAP_STATS_LATENCY_BINS];
+	heap_stats_largest_free_t largest_free;	/**< NULL if not known */
+};
+
+/** Statistics of one heap in reports */
+struct heap_stats_record {
+	uint32_t type;
+	uint32_t id;
+	uint32_t size;
+	uint32_t used;
+	uint32_t peak;
+	uint32_t largest_free;
+	uint32_t alloc_count;
+	uint32_t free_count;
+	uint32_t fail_count;
+	uint32_t latency[HEAP_STATS_LATENCY_BINS];
+} __packed __aligned(4);
+
+#if CONFIG_SOF_HEAP_STATS
+
+/**
+ * \brief Reset statistics and add them to reports.
+ * \param[out] stats Statistics of the heap.
+ * \param[in] type Heap type, enum heap_stats_type.
+ * \param[in] id Heap id within the type.
+ * \param[in] size Heap size, 0 if not limited.
+ * \param[in] largest_free Largest free block query, NULL if not known.
+ */
+void heap_stats_register(struct heap_stats *stats, uint32_t type, uint32_t id, size_t size,
+			 heap_stats_largest_free_t largest_free);
+
+/** \brief Remove statistics from reports. */
+void heap_stats_unregister(struct heap_stats *stats);
+
+/**
+ * \brief Record an allocation, called with the heap lock held.
+ * \param[in] stats Statistics of the heap.
+ * \param[in] bytes Allocated bytes, 0 if the allocation failed.
+ * \param[in] cycles Cycles the allocation took.
+ */
+void heap_stats_alloc(struct heap_stats *stats, size_t bytes, uint32_t cycles);
+
+/** \brief Record a free of bytes, called with the heap lock held. */
+void heap_stats_free(struct heap_stats *stats, size_t bytes);
+
+/**
+ * \brief Fill records of the registered heaps.
+ * \param[out] records Records.
+ * \param[in] max Number of records that fit.
+ * \return Number of records filled.
+ */
+unsigned int heap_stats_get(struct heap_stats_record *records, unsigned int max);
+
+#else
+
+static inline void heap_stats_register(struct heap_stats *stats, uint32_t type, uint32_t id,
+				       size_t size, heap_stats_largest_free_t largest_free) {}
+static inline void heap_stats_unregister(struct heap_stats *stats) {}
+static inline void heap_stats_alloc(struct heap_stats *stats, size_t bytes, uint32_t cycles) {}
+static inline void heap_stats_free(struct heap_stats *stats, size_t bytes) {}
+static inline unsigned int heap_stats_get(struct heap_stats_record *records, unsigned int max)
+{
+	return 0;
+}
+
+#endif /* CONFIG_SOF_HEAP_STATS */
+
+#endif /* __SOF_LIB_HEAP_STATS_H__ */
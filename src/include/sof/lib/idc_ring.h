@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation.
+ */
+
+/*
+ * Single producer, single consumer IDC message ring. There is one ring per
+ * (source, target) core pair: the source core reserves and fills an entry
+ * and publishes it with a commit. The target core handles published entries
+ * in order and completes them, so the producer can reuse them.
+ */
+
+#ifndef __SOF_LIB_IDC_RING_H__
+#define __SOF_LIB_IDC_RING_H__
+
+#include <rtos/atomic.h>
+#include <rtos/idc.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/** \brief IDC ring entry. */
+struct idc_ring_entry {
+	struct idc_msg msg;			/**< message, payload pointer unused */
+	void *waiter;				/**< sender waiting for completion */
+	uint8_t payload[IDC_MAX_PAYLOAD_SIZE];	/**< copy of message payload */
+};
+
+/** \brief IDC ring of one (source, target) core pair. */
+struct idc_ring {
+	atomic_t head;		/**< published entries, written by producer */
+	atomic_t tail;		/**< completed entries, written by consumer */
+	uint32_t reserved;	/**< reserved entries, private to producer */
+	struct idc_ring_entry entry[CONFIG_IDC_RING_SIZE];
+};
+
+/**
+ * \brief Reserves the next entry, not visible to consumer until committed.
+ * \param[in] ring Ring, a zero initialized ring is empty.
+ * \return Entry or NULL if all entries are in flight.
+ */
+struct idc_ring_entry *idc_ring_reserve(struct idc_ring *ring);
+
+/**
+ * \brief Publishes all reserved entries to consumer.
+ * \param[in] ring Ring.
+ * \return Number of entries published.
+ */
+uint32_t idc_ring_commit(struct idc_ring *ring);
+
+/**
+ * \brief Gets the oldest published entry not completed yet.
+ * \param[in] ring Ring.
+ * \return Entry or NULL if there is none.
+ */
+struct idc_ring_entry *idc_ring_peek(struct idc_ring *ring);
+
+/**
+ * \brief Completes the oldest published entry, producer can reuse it.
+ * \param[in] ring Ring.
+ */
+void idc_ring_complete(struct idc_ring *ring);
+
+#endif /* __SOF_LIB_IDC_RING_H__ */
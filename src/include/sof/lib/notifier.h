@@ -12,6 +12,7 @@
 #include <sof/list.h>
 #include <rtos/spinlock.h>
 #include <rtos/sof.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 /* notifier target core masks */
@@ -46,6 +47,15 @@ struct notify_data {
 	void *data;
 };
 
+/* Events sent to one core by other cores, taken all at once by the core */
+struct notify_queue {
+	struct k_spinlock lock;	/* queue lock, shared by all cores */
+	bool idc_pending;	/* IDC sent, events not taken yet */
+	uint32_t count;		/* number of queued events */
+	uint32_t dropped;	/* events lost because the queue was full */
+	struct notify_data event[CONFIG_NOTIFIER_QUEUE_SIZE];
+};
+
 #ifdef CLK_SSP
 #define NOTIFIER_CLK_CHANGE_ID(clk) \
 	((clk) == CLK_SSP ? NOTIFIER_ID_SSP_FREQ : NOTIFIER_ID_CPU_FREQ)
@@ -98,9 +108,9 @@ void init_system_notify(struct sof *sof);
 
 void free_system_notify(void);
 
-static inline struct notify_data *notify_data_get(void)
+static inline struct notify_queue *notify_queue_get(void)
 {
-	return sof_get()->notify_data;
+	return sof_get()->notify_queue;
 }
 
 #endif /* __SOF_LIB_NOTIFIER_H__ */
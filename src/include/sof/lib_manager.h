@@ -96,6 +96,7 @@ enum {
 	LIB_MANAGER_BSS,
 	LIB_MANAGER_COLD,
 	LIB_MANAGER_COLDRODATA,
+	LIB_MANAGER_LAZY,
 	LIB_MANAGER_N_SEGMENTS,
 };
 
@@ -116,7 +117,9 @@ struct lib_manager_module {
 	unsigned int n_dependent; /* For auxiliary modules: number of dependents */
 	unsigned int n_mod;
 	bool mapped;
+	bool lazy_mapped;	/* .lazy code has been loaded to SRAM */
 	bool domain_dp;
+	size_t resident_size;	/* SRAM mapped for the module */
 	struct lib_manager_segment_desc segment[LIB_MANAGER_N_SEGMENTS];
 };
 
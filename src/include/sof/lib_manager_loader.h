@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation.
+ */
+
+/*
+ * Chunked library loader. The host DMA writes the library to a circular
+ * buffer of two or more chunks. Each chunk is copied to storage memory
+ * and the DMA buffer space is given back to the DMA right away, so the
+ * transfer of the next chunk overlaps with the copy of the current one.
+ * Compressed libraries are received in frames of one chunk, each is
+ * staged and decompressed to storage memory. The loader does not
+ * authenticate, the caller authenticates the stored library.
+ */
+
+#ifndef __SOF_LIB_MANAGER_LOADER_H__
+#define __SOF_LIB_MANAGER_LOADER_H__
+
+#include <stdint.h>
+
+struct lib_manager_loader_ops {
+	/** Wait until size bytes are available in the DMA buffer */
+	int (*dma_wait)(void *data, uint32_t size);
+	/** Give size bytes of the DMA buffer back to the DMA */
+	int (*dma_reload)(void *data, uint32_t size);
+};
+
+struct lib_manager_loader {
+	const struct lib_manager_loader_ops *ops;
+	void *data;		/**< ops private data */
+	uint8_t *dma_buf;	/**< DMA circular buffer */
+	uint32_t dma_size;	/**< DMA buffer size */
+	uint32_t chunk_size;	/**< size of one DMA chunk */
+	uint32_t r_off;		/**< DMA buffer read offset */
+};
+
+/**
+ * \brief Initialize loader.
+ * \param[out] ld Loader.
+ * \param[in] ops DMA operations.
+ * \param[in] data Private data of the operations.
+ * \param[in] dma_buf DMA circular buffer.
+ * \param[in] dma_size DMA buffer size, a multiple of chunk_size.
+ * \param[in] chunk_size Number of bytes copied at a time.
+ */
+void lib_manager_loader_init(struct lib_manager_loader *ld,
+			     const struct lib_manager_loader_ops *ops, void *data,
+			     void *dma_buf, uint32_t dma_size, uint32_t chunk_size);
+
+/**
+ * \brief Copy size bytes from host to dst.
+ * \param[in] ld Loader.
+ * \param[out] dst Destination memory.
+ * \param[in] size Number of bytes to copy.
+ * \return 0 on success, error code otherwise.
+ */
+int lib_manager_loader_store(struct lib_manager_loader *ld, void *dst, uint32_t size);
+
+/**
+ * \brief Decompress SOF_MAN_LZ4 frames from host to dst.
+ * \param[in] ld Loader, chunk_size is the frame size.
+ * \param[in] base Start of the image, matches can refer to data from here.
+ * \param[out] dst Destination memory, not before base.
+ * \param[in] size Number of decompressed bytes.
+ * \param[in] staging Buffer of two chunks for compressed frames.
+ * \return 0 on success, error code otherwise.
+ */
+int lib_manager_loader_store_lz4(struct lib_manager_loader *ld, const void *base, void *dst,
+				 uint32_t size, void *staging);
+
+#endif /* __SOF_LIB_MANAGER_LOADER_H__ */
@@ -30,6 +30,17 @@ int llext_manager_free_module(const uint32_t component_id);
 
 int llext_manager_add_library(uint32_t module_id);
 
+/**
+ * \brief Load .lazy code of a module to SRAM.
+ *
+ * Code, marked with __lazy, is only loaded to SRAM when the module is
+ * prepared. A module, that needs it earlier, e.g. when it is configured,
+ * can call this function. Must be called from the IPC context.
+ * \param[in] component_id Component ID of an instance of the module.
+ * \return 0 on success, error code otherwise.
+ */
+int llext_manager_prefetch(const uint32_t component_id);
+
 int llext_manager_add_domain(const uint32_t component_id, struct k_mem_domain *domain);
 int llext_manager_rm_domain(const uint32_t component_id, struct k_mem_domain *domain);
 
@@ -39,6 +50,7 @@ bool comp_is_llext(struct comp_dev *comp);
 #define llext_manager_allocate_module(ipc_config, ipc_specific_config) 0
 #define llext_manager_free_module(component_id) 0
 #define llext_manager_add_library(module_id) 0
+#define llext_manager_prefetch(component_id) 0
 #define llext_manager_add_domain(component_id, domain) 0
 #define comp_is_llext(comp) false
 #endif
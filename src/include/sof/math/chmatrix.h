@@ -0,0 +1,151 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation.
+ */
+
+/* Channel mixing matrix, classified when configured for the cheapest kernel */
+
+#ifndef __SOF_MATH_CHMATRIX_H__
+#define __SOF_MATH_CHMATRIX_H__
+
+#include <ipc/stream.h>
+#include <stddef.h>
+#include <stdint.h>
+
+struct cir_buf_source;
+struct cir_buf_sink;
+struct chmatrix_kernels;
+
+/** \brief Maximum number of source and sink channels. */
+#define SOFM_CHMATRIX_CHANNELS_MAX	8
+
+/** \brief Mixing coefficients are Q6.10, this is unity gain. */
+#define SOFM_CHMATRIX_ONE_Q10		1024
+
+/** \brief Channel map nibble for a muted sink channel. */
+#define SOFM_CHMATRIX_CHMAP_MUTE	0xf
+
+enum sofm_chmatrix_type {
+	SOFM_CHMATRIX_COPY,	/**< sink frames are the source frames */
+	SOFM_CHMATRIX_PICK,	/**< each sink channel is one source channel or silence */
+	SOFM_CHMATRIX_SPARSE,	/**< only the non-zero coefficients are applied */
+	SOFM_CHMATRIX_DENSE,	/**< full matrix multiply */
+};
+
+struct sofm_chmatrix;
+
+/** \brief Mixing kernel for frames in linear buffers. */
+typedef void (*sofm_chmatrix_func)(const struct sofm_chmatrix *m, const void *src,
+				   void *dst, size_t frames);
+
+struct sofm_chmatrix_tap {
+	int16_t coeff;		/**< Q6.10 coefficient */
+	uint8_t src;		/**< source channel */
+	uint8_t reserved;
+};
+
+struct sofm_chmatrix {
+	enum sofm_chmatrix_type type;
+	sofm_chmatrix_func func;
+	const struct chmatrix_kernels *kernels;
+	uint8_t src_channels;
+	uint8_t dst_channels;
+	uint8_t sample_bytes;
+	uint16_t src_stride;	/* samples per source frame */
+	uint16_t dst_stride;	/* samples per sink frame */
+	union {
+		/* SOFM_CHMATRIX_PICK */
+		struct {
+			uint8_t src[SOFM_CHMATRIX_CHANNELS_MAX];
+			int32_t mask[SOFM_CHMATRIX_CHANNELS_MAX]; /* zero for a muted channel */
+		} pick;
+		/* SOFM_CHMATRIX_SPARSE */
+		struct {
+			uint8_t num_taps[SOFM_CHMATRIX_CHANNELS_MAX];
+			struct sofm_chmatrix_tap
+				taps[SOFM_CHMATRIX_CHANNELS_MAX][SOFM_CHMATRIX_CHANNELS_MAX];
+		} sparse;
+		/* SOFM_CHMATRIX_DENSE */
+		int16_t coeffs[SOFM_CHMATRIX_CHANNELS_MAX][SOFM_CHMATRIX_CHANNELS_MAX];
+	};
+};
+
+/**
+ * \brief Classifies a mixing matrix and selects its kernel.
+ *
+ * A matrix with only zero and unity coefficients and at most one unity
+ * coefficient per sink channel is a channel pick, or a copy if it is the
+ * identity. Other matrices with at most half of the coefficients non-zero
+ * are sparse, the rest are dense. Results are rounded and saturated like a
+ * full Q6.10 matrix multiply.
+ *
+ * \param[out] m Channel matrix.
+ * \param[in] frame_fmt Sample format of source and sink, S16_LE, S24_4LE or S32_LE.
+ * \param[in] coeffs Q6.10 coefficients, row per sink channel.
+ * \param[in] row_stride Distance of rows in coeffs, in coefficients.
+ * \param[in] dst_channels Number of sink channels.
+ * \param[in] src_channels Number of source channels.
+ * \return 0 on success, -EINVAL for unsupported format or channels count.
+ */
+int sofm_chmatrix_init_q10(struct sofm_chmatrix *m, enum sof_ipc_frame frame_fmt,
+			   const int16_t *coeffs, size_t row_stride,
+			   int dst_channels, int src_channels);
+
+/**
+ * \brief Builds a channel pick from a channel map.
+ *
+ * Nibble n of chmap is the source channel of sink channel n. Sink channels
+ * with SOFM_CHMATRIX_CHMAP_MUTE or a source channel out of range are muted.
+ *
+ * \param[out] m Channel matrix.
+ * \param[in] frame_fmt Sample format of source and sink.
+ * \param[in] chmap Channel map.
+ * \param[in] dst_channels Number of sink channels.
+ * \param[in] src_channels Number of source channels.
+ * \return 0 on success, -EINVAL for unsupported format or channels count.
+ */
+int sofm_chmatrix_init_chmap(struct sofm_chmatrix *m, enum sof_ipc_frame frame_fmt,
+			     uint32_t chmap, int dst_channels, int src_channels);
+
+/**
+ * \brief Sets the number of channels in source and sink frames.
+ *
+ * By default frames have as many channels as the matrix. Frames with more
+ * channels are mixed from their first channels and the remaining sink
+ * channels are left untouched.
+ *
+ * \param[in,out] m Channel matrix.
+ * \param[in] src_frame_channels Number of channels in a source frame.
+ * \param[in] dst_frame_channels Number of channels in a sink frame.
+ * \return 0 on success, -EINVAL if a frame has fewer channels than the matrix.
+ */
+int sofm_chmatrix_set_frame_channels(struct sofm_chmatrix *m, int src_frame_channels,
+				     int dst_frame_channels);
+
+/**
+ * \brief Mixes frames from a circular source to a circular sink buffer.
+ *
+ * The buffer pointers are not updated.
+ *
+ * \param[in] m Channel matrix.
+ * \param[in] source Source buffer.
+ * \param[in] sink Sink buffer.
+ * \param[in] frames Number of frames to process.
+ */
+void sofm_chmatrix_process(const struct sofm_chmatrix *m, const struct cir_buf_source *source,
+			   struct cir_buf_sink *sink, size_t frames);
+
+/**
+ * \brief Mixes frames from a linear source to a linear sink buffer.
+ * \param[in] m Channel matrix.
+ * \param[in] src Source frames.
+ * \param[out] dst Sink frames.
+ * \param[in] frames Number of frames to process.
+ */
+static inline void sofm_chmatrix_process_linear(const struct sofm_chmatrix *m,
+						const void *src, void *dst, size_t frames)
+{
+	m->func(m, src, dst, frames);
+}
+
+#endif /* __SOF_MATH_CHMATRIX_H__ */
@@ -11,6 +11,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <sof/common.h>
+#include <sof/platform.h>
 
 #define IIR_DF1_NUM_STATE 4
 #define SOF_IIR_DF1_4TH_NUM_BIQUADS 2
@@ -53,6 +54,34 @@ int32_t iir_df1(struct iir_state_df1 *iir, int32_t x);
  */
 int32_t iir_df1_4th(struct iir_state_df1 *iir, int32_t x);
 
+/**
+ * Calculate a 4th order IIR filter with two biquads in series for one frame
+ * of several channels that share the same coefficients. The coefficients are
+ * loaded once for all channels. Note: There are no checks for parameters.
+ * @param coef	Coefficients of the two biquads, SOF_EQ_IIR_NBIQUAD values each
+ * @param delay	Delay lines of all channels, IIR_DF1_NUM_STATE *
+ *		SOF_IIR_DF1_4TH_NUM_BIQUADS values per channel in channel order
+ * @param x	Input s32 Q1.31 samples, one per channel
+ * @param y	Output s32 Q1.31 samples, one per channel, can be the same as x
+ * @param nch	Number of channels
+ */
+void iir_df1_4th_nch(const int32_t *coef, int32_t *delay, const int32_t *x, int32_t *y,
+		     int nch);
+
+/**
+ * Calculate IIR filter consisting of biquads for one frame of a group of
+ * channels that share the same response. The coefficients of each biquad
+ * are loaded once for all channels of the group. Note: There are no checks
+ * for parameters.
+ * @param iir	IIR state with configured biquad coefficients, the delay
+ *		member is not used
+ * @param delay	Delay lines of the group, for every biquad the
+ *		IIR_DF1_NUM_STATE values of each channel in channel order
+ * @param data	s32 Q1.31 samples, one per channel, filtered in place
+ * @param nch	Number of channels, max. PLATFORM_MAX_CHANNELS
+ */
+void iir_df1_nch(struct iir_state_df1 *iir, int32_t *delay, int32_t *data, int nch);
+
 /* Inline functions */
 #if SOF_USE_MIN_HIFI(3, FILTER)
 #include "iir_df1_hifi3.h"
@@ -10,24 +10,35 @@
 
 #include <stdint.h>
 
+/* Convert filter output in Q1.31 to s16 or s24 sample */
+static inline int16_t iir_df1_q31_to_s16(int32_t y)
+{
+	return sat_int16(Q_SHIFT_RND(y, 31, 15));
+}
+
+static inline int32_t iir_df1_q31_to_s24(int32_t y)
+{
+	return sat_int24(Q_SHIFT_RND(y, 31, 23));
+}
+
 static inline int16_t iir_df1_s16(struct iir_state_df1 *iir, int16_t x)
 {
-	return sat_int16(Q_SHIFT_RND(iir_df1(iir, ((int32_t)x) << 16), 31, 15));
+	return iir_df1_q31_to_s16(iir_df1(iir, ((int32_t)x) << 16));
 }
 
 static inline int32_t iir_df1_s24(struct iir_state_df1 *iir, int32_t x)
 {
-	return sat_int24(Q_SHIFT_RND(iir_df1(iir, x << 8), 31, 23));
+	return iir_df1_q31_to_s24(iir_df1(iir, x << 8));
 }
 
 static inline int16_t iir_df1_s32_s16(struct iir_state_df1 *iir, int32_t x)
 {
-	return sat_int16(Q_SHIFT_RND(iir_df1(iir, x), 31, 15));
+	return iir_df1_q31_to_s16(iir_df1(iir, x));
 }
 
 static inline int32_t iir_df1_s32_s24(struct iir_state_df1 *iir, int32_t x)
 {
-	return sat_int24(Q_SHIFT_RND(iir_df1(iir, x), 31, 23));
+	return iir_df1_q31_to_s24(iir_df1(iir, x));
 }
 
 #endif /* __IIR_DF1_GENERIC_H__ */
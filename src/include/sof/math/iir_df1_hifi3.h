@@ -11,32 +11,35 @@
 #include <xtensa/tie/xt_hifi3.h>
 #include <stdint.h>
 
-static inline int16_t iir_df1_s16(struct iir_state_df1 *iir, int16_t x)
+/* Convert filter output in Q1.31 to s16 or s24 sample */
+static inline int16_t iir_df1_q31_to_s16(ae_f32x2 y)
 {
-	ae_f32x2 y = iir_df1(iir, ((int32_t)x) << 16);
-
 	return AE_ROUND16X4F32SSYM(y, y);
 }
 
-static inline int32_t iir_df1_s24(struct iir_state_df1 *iir, int32_t x)
+static inline int32_t iir_df1_q31_to_s24(ae_f32x2 y)
 {
-	ae_f32x2 y = iir_df1(iir, x << 8);
-
 	return AE_SRAI32(AE_SLAI32S(AE_SRAI32R(y, 8), 8), 8);
 }
 
-static inline int16_t iir_df1_s32_s16(struct iir_state_df1 *iir, int32_t x)
+static inline int16_t iir_df1_s16(struct iir_state_df1 *iir, int16_t x)
 {
-	ae_f32x2 y = iir_df1(iir, x);
+	return iir_df1_q31_to_s16(iir_df1(iir, ((int32_t)x) << 16));
+}
 
-	return AE_ROUND16X4F32SSYM(y, y);
+static inline int32_t iir_df1_s24(struct iir_state_df1 *iir, int32_t x)
+{
+	return iir_df1_q31_to_s24(iir_df1(iir, x << 8));
 }
 
-static inline int32_t iir_df1_s32_s24(struct iir_state_df1 *iir, int32_t x)
+static inline int16_t iir_df1_s32_s16(struct iir_state_df1 *iir, int32_t x)
 {
-	ae_f32x2 y = iir_df1(iir, x);
+	return iir_df1_q31_to_s16(iir_df1(iir, x));
+}
 
-	return AE_SRAI32(AE_SLAI32S(AE_SRAI32R(y, 8), 8), 8);
+static inline int32_t iir_df1_s32_s24(struct iir_state_df1 *iir, int32_t x)
+{
+	return iir_df1_q31_to_s24(iir_df1(iir, x));
 }
 
 #endif /* __IIR_DF1_HIFI3_H__ */
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation.
+ */
+
+/*
+ * Short time Fourier transform (STFT) analysis and synthesis helpers.
+ *
+ * These are the sample buffer, framing, window and overlap-add steps the
+ * STFT based components had each carried a copy of. Every component
+ * instance still runs its own analysis on its own buffers and FFT plans,
+ * the spectral frames are not shared between components processing the
+ * same stream.
+ */
+
+#ifndef __SOF_MATH_STFT_H__
+#define __SOF_MATH_STFT_H__
+
+#include <sof/math/icomplex32.h>
+#include <stdint.h>
+
+/**
+ * enum sofm_stft_window_type - Analysis and synthesis window function
+ *
+ * The values match the window field of the STFT based components
+ * configuration blobs.
+ */
+enum sofm_stft_window_type {
+	SOFM_STFT_RECTANGULAR_WINDOW = 0,
+	SOFM_STFT_BLACKMAN_WINDOW = 1,
+	SOFM_STFT_HAMMING_WINDOW = 2,
+	SOFM_STFT_HANN_WINDOW = 3,
+};
+
+/**
+ * struct sofm_stft_buffer - Circular buffer for one channel of STFT samples
+ * @addr: Start address of the buffer
+ * @end_addr: End address of the buffer
+ * @r_ptr: Read pointer
+ * @w_ptr: Write pointer
+ * @s_avail: Available samples count
+ * @s_free: Free samples count
+ * @s_length: Buffer length in samples for wrap
+ */
+struct sofm_stft_buffer {
+	int32_t *addr;
+	int32_t *end_addr;
+	int32_t *r_ptr;
+	int32_t *w_ptr;
+	int s_avail;
+	int s_free;
+	int s_length;
+};
+
+static inline int sofm_stft_buffer_samples_without_wrap(struct sofm_stft_buffer *buffer,
+							int32_t *ptr)
+{
+	return buffer->end_addr - ptr;
+}
+
+static inline int32_t *sofm_stft_buffer_wrap(struct sofm_stft_buffer *buffer, int32_t *ptr)
+{
+	if (ptr >= buffer->end_addr)
+		ptr -= buffer->s_length;
+
+	return ptr;
+}
+
+/**
+ * sofm_stft_buffer_init() - Set up an empty circular buffer.
+ * @buf: Circular buffer to initialize.
+ * @base: Start of the samples storage.
+ * @size: Size of the storage in samples.
+ */
+void sofm_stft_buffer_init(struct sofm_stft_buffer *buf, int32_t *base, int size);
+
+/**
+ * sofm_stft_fill_prev_samples() - Save overlap samples for next STFT frame.
+ * @buf: Circular buffer to read overlap samples from.
+ * @prev_data: Destination array for the overlap data.
+ * @prev_data_length: Number of samples to copy.
+ *
+ * Copies prev_data_length samples from the circular buffer into the
+ * linear prev_data array, handling wrap-around as needed.
+ */
+void sofm_stft_fill_prev_samples(struct sofm_stft_buffer *buf, int32_t *prev_data,
+				 int prev_data_length);
+
+/**
+ * sofm_stft_fill_fft_buffer() - Assemble FFT input from overlap and new data.
+ * @ibuf: Circular buffer with at least fft_hop_size new samples.
+ * @prev_data: Overlap samples from previous frame, updated for next frame.
+ * @prev_data_size: Number of overlap samples, FFT size minus hop size.
+ * @fft_buf: FFT input buffer, FFT size of complex samples.
+ * @fft_hop_size: Number of new samples per FFT frame.
+ *
+ * Constructs the FFT input buffer by concatenating the previous overlap
+ * samples and one hop of new samples from the input circular buffer.
+ * Imaginary parts are set to zero.
+ */
+void sofm_stft_fill_fft_buffer(struct sofm_stft_buffer *ibuf, int32_t *prev_data,
+			       int prev_data_size, struct icomplex32 *fft_buf, int fft_hop_size);
+
+/**
+ * sofm_stft_apply_window() - Multiply FFT buffer by the window function.
+ * @fft_buf: FFT buffer, the real part of samples is multiplied.
+ * @window: Q1.31 window function coefficients.
+ * @fft_size: FFT size, must be a multiple of four.
+ */
+void sofm_stft_apply_window(struct icomplex32 *fft_buf, const int32_t *window, int fft_size);
+
+/**
+ * sofm_stft_overlap_add() - Overlap-add IFFT output to circular output buffer.
+ * @obuf: Circular output buffer, even length and 64-bit aligned.
+ * @fft_buf: IFFT output, the real part of samples is used.
+ * @gain: Q1.31 gain to compensate the window function gain.
+ * @fft_size: FFT size, must be even.
+ * @fft_hop_size: Number of samples the output advances per FFT frame.
+ *
+ * Each IFFT output sample is multiplied by the gain and added with
+ * saturation to the existing content of the circular output buffer.
+ * The caller needs to ensure there is fft_size of free space.
+ */
+void sofm_stft_overlap_add(struct sofm_stft_buffer *obuf, const struct icomplex32 *fft_buf,
+			   int32_t gain, int fft_size, int fft_hop_size);
+
+/**
+ * sofm_stft_get_window() - Calculate the window function.
+ * @window: Output Q1.31 window coefficients.
+ * @fft_size: Window length.
+ * @type: Window function type.
+ *
+ * Return: Zero if success, -EINVAL for not supported window type.
+ */
+int sofm_stft_get_window(int32_t *window, int fft_size, enum sofm_stft_window_type type);
+
+#endif /* __SOF_MATH_STFT_H__ */
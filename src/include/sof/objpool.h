@@ -14,10 +14,13 @@
 
 struct vregion;
 struct k_heap;
+struct heap_stats;
+
 struct objpool_head {
 	struct list_item list;
 	struct vregion *vreg;
 	struct k_heap *heap;
+	struct heap_stats *stats;	/* optional, counts the pool memory */
 	uint32_t flags;
 };
 
@@ -9,6 +9,7 @@
 #define __SOF_TRACE_DMA_TRACE_H__
 
 #include <sof/lib/dma.h>
+#include <rtos/atomic.h>
 #include <rtos/task.h>
 #include <rtos/sof.h>
 #include <rtos/spinlock.h>
@@ -27,6 +28,18 @@ struct dma_trace_buf {
 	uint32_t avail;		/* bytes available to read */
 };
 
+/* Per core ring of trace records. Each record is a length word followed
+ * by the record, a zero length word marks a wrap to the ring start.
+ * Written only by the owning core, read by trace_work().
+ */
+struct dma_trace_ring {
+	uint8_t *data;			/* ring base address */
+	uint32_t size;			/* size of ring in bytes */
+	atomic_t w_off;			/* write offset, updated by owning core */
+	atomic_t r_off;			/* read offset, updated by trace_work() */
+	uint32_t dropped_entries;	/* amount of dropped entries */
+};
+
 struct dma_trace_data {
 	struct dma_sg_config config;
 	struct dma_trace_buf dmatb;
@@ -42,7 +55,7 @@ struct dma_trace_data {
 	uint32_t dma_copy_align;	/* Minimal chunk of data possible to be
 					 *  copied by dma connected to host
 					 */
-	uint32_t dropped_entries;	/* amount of dropped entries */
+	struct dma_trace_ring ring[CONFIG_CORE_COUNT];	/* per core records */
 	struct k_spinlock lock;		/* dma trace lock */
 	uint64_t time_delta;		/* difference between the host time */
 };
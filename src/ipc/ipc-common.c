@@ -16,6 +16,7 @@
 #include <sof/ipc/common.h>
 #include <sof/ipc/msg.h>
 #include <sof/ipc/driver.h>
+#include <sof/ipc/notification_pool.h>
 #include <sof/ipc/schedule.h>
 #include <rtos/alloc.h>
 #include <rtos/cache.h>
@@ -533,6 +534,7 @@ __cold int ipc_init(struct sof *sof)
 {
 	struct k_heap *heap;
 	struct ipc *ipc;
+	int ret;
 
 	assert_can_be_cold();
 
@@ -575,6 +577,11 @@ __cold int ipc_init(struct sof *sof)
 	list_init(&ipc->msg_list);
 	list_init(&ipc->comp_list);
 
+	/* notifications raised from LL context must not allocate */
+	ret = ipc_notification_pool_init();
+	if (ret < 0)
+		return ret;
+
 #ifdef CONFIG_SOF_TELEMETRY_IO_PERFORMANCE_MEASUREMENTS
 	struct io_perf_data_item init_data = {IO_PERF_IPC_ID,
 					      cpu_get_id(),
@@ -249,6 +249,30 @@ int z_vrfy_ipc_wait_for_compound_msg(void)
 #endif
 #endif
 
+int z_impl_ipc_compound_msg_take_error(void)
+{
+	int error = msg_data.delayed_error;
+
+	msg_data.delayed_error = 0;
+	return error;
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * \brief Userspace verification wrapper for ipc_compound_msg_take_error().
+ *
+ * Forwards the call to z_impl_ipc_compound_msg_take_error(). No pointer
+ * validation is needed as no pointers are passed.
+ *
+ * @return Error of the delayed operations, 0 if none failed.
+ */
+int z_vrfy_ipc_compound_msg_take_error(void)
+{
+	return z_impl_ipc_compound_msg_take_error();
+}
+#include <zephyr/syscalls/ipc_compound_msg_take_error_mrsh.c>
+#endif
+
 #if CONFIG_LIBRARY_MANAGER
 __cold static int ipc4_load_library(struct ipc4_message_request *ipc4)
 {
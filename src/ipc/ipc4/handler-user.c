@@ -26,6 +26,7 @@
 #include <sof/math/numbers.h>
 #include <sof/tlv.h>
 #include <sof/trace/trace.h>
+#include <ipc4/batch.h>
 #include <ipc4/error_status.h>
 #include <ipc/header.h>
 #include <ipc4/module.h>
@@ -672,6 +673,322 @@ static int ipc_glb_gdb_debug(struct ipc4_message_request *ipc4)
 #endif
 }
 
+#ifndef CONFIG_SOF_USERSPACE_LL
+/* Working copy of a batch, the mailbox is reused for the operation payloads */
+struct ipc4_batch_ctx {
+	struct ipc4_message_request undo[SOF_IPC4_BATCH_MAX_OPS];
+	uint32_t status[SOF_IPC4_BATCH_MAX_OPS];
+	unsigned int undo_count;
+	uint8_t data[];
+};
+
+/* Core an operation runs on, the current one if the handler finds no object */
+__cold static unsigned int ipc4_batch_op_core(const struct ipc4_message_request *req)
+{
+	const struct ipc4_module_delete_instance *mod;
+	struct ipc_comp_dev *icd = NULL;
+	struct ipc *ipc = ipc_get();
+
+	assert_can_be_cold();
+
+	if (req->primary.r.msg_tgt == SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG) {
+		switch (req->primary.r.type) {
+		case SOF_IPC4_GLB_CREATE_PIPELINE:
+			return ((const struct ipc4_pipeline_create *)req)->extension.r.core_id;
+		case SOF_IPC4_GLB_DELETE_PIPELINE:
+			icd = ipc_get_pipeline_by_id(ipc,
+				((const struct ipc4_pipeline_delete *)req)->primary.r.instance_id);
+			break;
+		case SOF_IPC4_GLB_SET_PIPELINE_STATE:
+			icd = ipc_get_pipeline_by_id(ipc,
+				((const struct ipc4_pipeline_set_state *)req)->primary.r.ppl_id);
+			break;
+		default:
+			break;
+		}
+	} else if (req->primary.r.type == SOF_IPC4_MOD_INIT_INSTANCE) {
+		return ((const struct ipc4_module_init_instance *)req)->extension.r.core_id;
+	} else {
+		/* module and instance IDs are at the same place in all module messages */
+		mod = (const struct ipc4_module_delete_instance *)req;
+		icd = ipc_get_comp_by_id(ipc, IPC4_COMP_ID(mod->primary.r.module_id,
+							   mod->primary.r.instance_id));
+	}
+
+	return icd ? icd->core : cpu_get_id();
+}
+
+/* Checks an operation can run in a batch, the reply goes out only once */
+__cold static int ipc4_batch_op_check(const struct ipc4_message_request *req)
+{
+	const struct ipc4_module_large_config *config;
+
+	assert_can_be_cold();
+
+	if (req->primary.r.msg_tgt == SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG) {
+		switch (req->primary.r.type) {
+		case SOF_IPC4_GLB_CREATE_PIPELINE:
+		case SOF_IPC4_GLB_DELETE_PIPELINE:
+			break;
+		case SOF_IPC4_GLB_SET_PIPELINE_STATE:
+			if (((const struct ipc4_pipeline_set_state *)req)->extension.r.multi_ppl)
+				return IPC4_INVALID_REQUEST;
+			break;
+		default:
+			return IPC4_INVALID_REQUEST;
+		}
+	} else {
+		switch (req->primary.r.type) {
+		case SOF_IPC4_MOD_INIT_INSTANCE:
+		case SOF_IPC4_MOD_DELETE_INSTANCE:
+		case SOF_IPC4_MOD_BIND:
+		case SOF_IPC4_MOD_UNBIND:
+		case SOF_IPC4_MOD_CONFIG_SET:
+			break;
+		case SOF_IPC4_MOD_LARGE_CONFIG_SET:
+			config = (const struct ipc4_module_large_config *)req;
+			if (!config->extension.r.init_block || !config->extension.r.final_block)
+				return IPC4_INVALID_REQUEST;
+			break;
+		default:
+			return IPC4_INVALID_REQUEST;
+		}
+	}
+
+	/* forwarding to another core would make that core reply to the host */
+	if (!cpu_is_me(ipc4_batch_op_core(req)))
+		return IPC4_INVALID_CORE_ID;
+
+	return IPC4_SUCCESS;
+}
+
+/* Records the request reverting an operation, before the operation runs */
+__cold static bool ipc4_batch_add_undo(struct ipc4_batch_ctx *ctx,
+				       const struct ipc4_message_request *req)
+{
+	struct ipc4_message_request *undo = &ctx->undo[ctx->undo_count];
+	struct ipc4_pipeline_set_state *state;
+	struct ipc4_pipeline_delete *pipe;
+	struct ipc_comp_dev *icd;
+
+	assert_can_be_cold();
+
+	*undo = *req;
+
+	if (req->primary.r.msg_tgt == SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG) {
+		switch (req->primary.r.type) {
+		case SOF_IPC4_GLB_CREATE_PIPELINE:
+			pipe = (struct ipc4_pipeline_delete *)undo;
+			pipe->primary.dat = 0;
+			pipe->primary.r.instance_id =
+				((const struct ipc4_pipeline_create *)req)->primary.r.instance_id;
+			pipe->primary.r.type = SOF_IPC4_GLB_DELETE_PIPELINE;
+			pipe->primary.r.msg_tgt = SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG;
+			pipe->extension.dat = 0;
+			break;
+		case SOF_IPC4_GLB_SET_PIPELINE_STATE:
+			state = (struct ipc4_pipeline_set_state *)undo;
+			icd = ipc_get_pipeline_by_id(ipc_get(), state->primary.r.ppl_id);
+			if (!icd)
+				return false;
+
+			switch (icd->pipeline->status) {
+			case COMP_STATE_ACTIVE:
+				state->primary.r.ppl_state = SOF_IPC4_PIPELINE_STATE_RUNNING;
+				break;
+			case COMP_STATE_PAUSED:
+				state->primary.r.ppl_state = SOF_IPC4_PIPELINE_STATE_PAUSED;
+				break;
+			case COMP_STATE_READY:
+				state->primary.r.ppl_state = SOF_IPC4_PIPELINE_STATE_RESET;
+				break;
+			default:
+				/* a pipeline cannot go back to init */
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+	} else {
+		switch (req->primary.r.type) {
+		case SOF_IPC4_MOD_INIT_INSTANCE:
+			/* the module and instance IDs stay, extension is unused */
+			undo->primary.r.type = SOF_IPC4_MOD_DELETE_INSTANCE;
+			undo->extension.dat = 0;
+			break;
+		case SOF_IPC4_MOD_BIND:
+			undo->primary.r.type = SOF_IPC4_MOD_UNBIND;
+			break;
+		case SOF_IPC4_MOD_UNBIND:
+			undo->primary.r.type = SOF_IPC4_MOD_BIND;
+			break;
+		default:
+			return false;
+		}
+	}
+
+	ctx->undo_count++;
+	return true;
+}
+
+/* Copies the payload of an operation to where its handler reads it */
+__cold static int ipc4_batch_stage(const struct ipc4_batch_op *op)
+{
+#if CONFIG_LIBRARY
+	char *data = ipc_get()->comp_data;
+	int ret;
+
+	assert_can_be_cold();
+
+	ret = memcpy_s(data, SOF_IPC_MSG_MAX_SIZE, &op->request, sizeof(op->request));
+	if (ret < 0 || !op->data_size)
+		return ret;
+
+	return memcpy_s(data + sizeof(op->request), SOF_IPC_MSG_MAX_SIZE - sizeof(op->request),
+			op->data, op->data_size);
+#else
+	int ret;
+
+	assert_can_be_cold();
+
+	if (!op->data_size)
+		return 0;
+
+	ret = memcpy_s((void *)MAILBOX_HOSTBOX_BASE, MAILBOX_HOSTBOX_SIZE,
+		       op->data, op->data_size);
+	if (ret < 0)
+		return ret;
+
+	/* handlers invalidate the mailbox before reading it */
+	dcache_writeback_region((__sparse_force void __sparse_cache *)MAILBOX_HOSTBOX_BASE,
+				op->data_size);
+
+	return 0;
+#endif
+}
+
+__cold static int ipc4_batch_run_op(struct ipc4_message_request *req)
+{
+	int error;
+	int ret;
+
+	assert_can_be_cold();
+
+	if (req->primary.r.msg_tgt == SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG)
+		ret = ipc4_user_process_glb_message(req, msg_reply);
+	else
+		ret = ipc4_user_process_module_message(req, msg_reply);
+
+	/* pipeline triggers complete before the next operation */
+	if (!ret && ipc_wait_for_compound_msg() != 0)
+		ret = IPC4_FAILURE;
+
+	/* a failed delayed trigger fails the operation, and not the next one */
+	error = ipc_compound_msg_take_error();
+	if (!ret)
+		ret = error;
+
+	return ret;
+}
+
+__cold static int ipc4_process_batch(struct ipc4_message_request *ipc4)
+{
+	const struct ipc4_batch *batch = (const struct ipc4_batch *)ipc4;
+	uint32_t data_size = batch->extension.r.data_size;
+	uint32_t count = batch->primary.r.count;
+	struct ipc4_message_request req;
+	const struct ipc4_batch_op *op;
+	struct ipc4_batch_ctx *ctx;
+	const char *hostbox;
+	uint32_t offset = 0;
+	uint32_t *status;
+	uint32_t i;
+	bool undo;
+	int ret = IPC4_SUCCESS;
+
+	assert_can_be_cold();
+
+	if (!count || count > SOF_IPC4_BATCH_MAX_OPS ||
+	    data_size < sizeof(struct ipc4_batch_op) || data_size > MAILBOX_HOSTBOX_SIZE) {
+		ipc_cmd_err(&ipc_tr, "ipc4: invalid batch of %u ops, %u bytes",
+			    count, data_size);
+		return IPC4_ERROR_INVALID_PARAM;
+	}
+
+#if CONFIG_LIBRARY
+	hostbox = (const char *)ipc_get()->comp_data + sizeof(*batch);
+#else
+	hostbox = (const char *)MAILBOX_HOSTBOX_BASE;
+	dcache_invalidate_region((__sparse_force void __sparse_cache *)MAILBOX_HOSTBOX_BASE,
+				 data_size);
+#endif
+
+	ctx = rmalloc(SOF_MEM_FLAG_USER, sizeof(*ctx) + data_size);
+	if (!ctx)
+		return IPC4_OUT_OF_MEMORY;
+
+	ctx->undo_count = 0;
+	memcpy_s(ctx->data, data_size, hostbox, data_size);
+
+	for (i = 0; i < count; i++) {
+		op = (const struct ipc4_batch_op *)(ctx->data + offset);
+		if (data_size - offset < sizeof(*op) ||
+		    data_size - offset < SOF_IPC4_BATCH_OP_SIZE(op->data_size) ||
+		    op->data_size > MAILBOX_HOSTBOX_SIZE) {
+			ret = IPC4_ERROR_INVALID_PARAM;
+		} else {
+			ret = ipc4_batch_op_check(&op->request);
+		}
+
+		if (!ret)
+			ret = ipc4_batch_stage(op) ? IPC4_FAILURE : IPC4_SUCCESS;
+
+		if (!ret) {
+			/* handlers may update the request */
+			req = op->request;
+			undo = ipc4_batch_add_undo(ctx, &req);
+			ret = ipc4_batch_run_op(&req);
+			if (ret && undo)
+				ctx->undo_count--;
+		}
+
+		ctx->status[i] = ret;
+		if (ret) {
+			ipc_cmd_err(&ipc_tr, "ipc4: batch op %u failed %d", i, ret);
+			i++;
+			break;
+		}
+
+		offset += SOF_IPC4_BATCH_OP_SIZE(op->data_size);
+	}
+
+	/* revert to the state before the batch, latest operation first */
+	if (ret) {
+		while (ctx->undo_count--) {
+			req = ctx->undo[ctx->undo_count];
+			if (ipc4_batch_run_op(&req))
+				ipc_cmd_err(&ipc_tr, "ipc4: batch undo %#x|%#x failed",
+					    req.primary.dat, req.extension.dat);
+		}
+	}
+
+	status = ipc_get()->comp_data;
+#if CONFIG_LIBRARY
+	status = (uint32_t *)((char *)status + sizeof(struct ipc4_message_reply));
+#endif
+	memcpy_s(status, SOF_IPC_MSG_MAX_SIZE - sizeof(struct ipc4_message_reply),
+		 ctx->status, i * sizeof(*status));
+	rfree(ctx);
+
+	msg_reply->extension = i;
+	msg_reply->tx_data = status;
+	msg_reply->tx_size = i * sizeof(*status);
+
+	return ret;
+}
+#endif /* !CONFIG_SOF_USERSPACE_LL */
+
 int ipc4_user_process_glb_message(struct ipc4_message_request *ipc4,
 				  struct ipc_msg *reply)
 {
@@ -745,6 +1062,15 @@ int ipc4_user_process_glb_message(struct ipc4_message_request *ipc4,
 		ret = ipc_glb_gdb_debug(ipc4);
 		break;
 
+	case SOF_IPC4_GLB_BATCH:
+#ifdef CONFIG_SOF_USERSPACE_LL
+		ipc_cmd_err(&ipc_tr, "not implemented ipc message type %d", type);
+		ret = IPC4_UNAVAILABLE;
+#else
+		ret = ipc4_process_batch(ipc4);
+#endif
+		break;
+
 	default:
 		ipc_cmd_err(&ipc_tr, "unsupported ipc message type %d", type);
 		ret = IPC4_UNAVAILABLE;
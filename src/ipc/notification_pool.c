@@ -5,97 +5,141 @@
 // Author: Adrian Warecki <adrian.warecki@intel.com>
 //
 
+/*
+ * Notification messages are preallocated for every core when IPC is
+ * initialized. Each core takes messages from its own pool only, so
+ * notifications raised from LL context neither allocate nor take a lock.
+ * The free messages of a core are a bitmap, a message is taken by clearing
+ * its bit with a compare and swap and returned to the pool of its core by
+ * setting the bit again, from whichever core sent it.
+ */
+
 #include <stdint.h>
 #include <sof/common.h>
 #include <sof/list.h>
+#include <sof/lib/cpu.h>
 #include <sof/ipc/notification_pool.h>
+#include <rtos/alloc.h>
+#include <rtos/atomic.h>
 
 #include <rtos/symbol.h>
 
-#define NOTIFICATION_POOL_MAX_PAYLOAD_SIZE	40	/* IPC4 Resource Event needs 10dw */
-#define NOTIFICATION_POOL_MAX_DEPTH		8	/* Maximum number of notifications
-							 * in the pool
-							 */
-
 LOG_MODULE_REGISTER(notification_pool, CONFIG_SOF_LOG_LEVEL);
 
 SOF_DEFINE_REG_UUID(notification_pool);
 
 DECLARE_TR_CTX(notif_tr, SOF_UUID(notification_pool_uuid), LOG_LEVEL_INFO);
 
+/* the free messages of a core are one bitmap */
+STATIC_ASSERT(CONFIG_IPC_NOTIFICATION_POOL_COUNT <= 32, notification_pool_count_too_big);
+
 struct ipc_notif_pool_item {
 	struct ipc_msg msg;
-	uint32_t payload[SOF_DIV_ROUND_UP(NOTIFICATION_POOL_MAX_PAYLOAD_SIZE, sizeof(uint32_t))];
+	uint8_t core;		/* core owning the message */
+	uint8_t index;		/* bit of the message in the free bitmap */
+	uint32_t payload[SOF_DIV_ROUND_UP(CONFIG_IPC_NOTIFICATION_POOL_PAYLOAD_SIZE,
+					  sizeof(uint32_t))];
+};
+
+struct ipc_notif_core_pool {
+	atomic_t free;				/* bitmap of free messages */
+	struct ipc_notif_pool_item *items;	/* messages of the core */
+	atomic_t lost;				/* dropped since the last report */
 };
 
-static struct list_item pool_free_list = LIST_INIT(pool_free_list);
-static struct k_spinlock pool_free_list_lock;
-static int pool_depth;
+static struct ipc_notif_core_pool notif_pools[CONFIG_CORE_COUNT];
+static struct ipc_notif_pool_item *notif_block;
 
 static void ipc_notif_free(struct ipc_msg *msg)
 {
 	struct ipc_notif_pool_item *item = container_of(msg, struct ipc_notif_pool_item, msg);
-	k_spinlock_key_t key;
 
-	key = k_spin_lock(&pool_free_list_lock);
-	list_item_append(&item->msg.list, &pool_free_list);
-	k_spin_unlock(&pool_free_list_lock, key);
+	atomic_or(&notif_pools[item->core].free, BIT(item->index));
 }
 
-static struct ipc_msg *ipc_notif_new(size_t size)
+/* takes the lowest free message of a core or returns NULL */
+static struct ipc_notif_pool_item *ipc_notif_take(struct ipc_notif_core_pool *pool)
 {
-	struct ipc_notif_pool_item *item;
+	uint32_t map;
+	int index;
 
-	item = rzalloc(SOF_MEM_FLAG_USER | SOF_MEM_FLAG_COHERENT, sizeof(*item));
-	if (!item) {
-		tr_err(&notif_tr, "Unable to allocate memory for notification message");
-		return NULL;
+	do {
+		map = atomic_read(&pool->free);
+		if (!map)
+			return NULL;
+		index = ffs(map) - 1;
+	} while (!atomic_cas(&pool->free, map, map & ~BIT(index)));
+
+	return pool->items + index;
+}
+
+__cold int ipc_notification_pool_init(void)
+{
+	struct ipc_notif_pool_item *block, *item;
+	struct ipc_notif_core_pool *pool;
+	unsigned int core, i;
+
+	assert_can_be_cold();
+
+	if (!CONFIG_IPC_NOTIFICATION_POOL_COUNT)
+		return 0;
+
+	block = rzalloc(SOF_MEM_FLAG_USER | SOF_MEM_FLAG_COHERENT,
+			sizeof(*block) * CONFIG_IPC_NOTIFICATION_POOL_COUNT * CONFIG_CORE_COUNT);
+	if (!block) {
+		tr_err(&notif_tr, "Unable to allocate memory for notification messages");
+		return -ENOMEM;
 	}
 
-	list_init(&item->msg.list);
-	item->msg.tx_data = item->payload;
-	item->msg.tx_size = size;
-	item->msg.callback = ipc_notif_free;
-	return &item->msg;
+	notif_block = block;
+
+	for (core = 0; core < CONFIG_CORE_COUNT; core++) {
+		pool = &notif_pools[core];
+		pool->items = block + core * CONFIG_IPC_NOTIFICATION_POOL_COUNT;
+		atomic_init(&pool->lost, 0);
+
+		for (i = 0; i < CONFIG_IPC_NOTIFICATION_POOL_COUNT; i++) {
+			item = pool->items + i;
+			list_init(&item->msg.list);
+			item->msg.tx_data = item->payload;
+			item->msg.callback = ipc_notif_free;
+			item->core = core;
+			item->index = i;
+		}
+
+		atomic_init(&pool->free, UINT32_MAX >> (32 - CONFIG_IPC_NOTIFICATION_POOL_COUNT));
+	}
+
+	return 0;
 }
 
 struct ipc_msg *ipc_notification_pool_get(size_t size)
 {
+	struct ipc_notif_core_pool *pool = &notif_pools[cpu_get_id()];
 	struct ipc_notif_pool_item *item;
-	k_spinlock_key_t key;
-	struct ipc_msg *new_msg;
+	int32_t lost;
 
-	if (size > NOTIFICATION_POOL_MAX_PAYLOAD_SIZE) {
+	if (size > CONFIG_IPC_NOTIFICATION_POOL_PAYLOAD_SIZE) {
 		tr_err(&notif_tr, "Requested size %zu exceeds maximum payload size %u",
-		       size, NOTIFICATION_POOL_MAX_PAYLOAD_SIZE);
+		       size, CONFIG_IPC_NOTIFICATION_POOL_PAYLOAD_SIZE);
 		return NULL;
 	}
 
-	/* check if we have a free message */
-	key = k_spin_lock(&pool_free_list_lock);
-	if (list_is_empty(&pool_free_list)) {
-		/* allocate a new message */
-		if (pool_depth >= NOTIFICATION_POOL_MAX_DEPTH) {
-			k_spin_unlock(&pool_free_list_lock, key);
-			tr_err(&notif_tr, "Pool depth exceeded");
-			return NULL;
-		}
-		++pool_depth;
-		k_spin_unlock(&pool_free_list_lock, key);
-
-		new_msg = ipc_notif_new(size);
-		if (!new_msg) {
-			key = k_spin_lock(&pool_free_list_lock);
-			--pool_depth;
-			k_spin_unlock(&pool_free_list_lock, key);
-		}
-		return new_msg;
+	item = ipc_notif_take(pool);
+	if (!item) {
+		/* only the first drop of a burst is reported right away */
+		if (!atomic_read(&pool->lost))
+			tr_warn(&notif_tr, "No free notification message, dropping");
+		atomic_add(&pool->lost, 1);
+		return NULL;
 	}
 
-	/* take the first free message */
-	item = list_first_item(&pool_free_list, struct ipc_notif_pool_item, msg.list);
-	list_item_del(&item->msg.list);
-	k_spin_unlock(&pool_free_list_lock, key);
+	/* the whole burst is reported once messages are available again */
+	lost = atomic_read(&pool->lost);
+	if (lost) {
+		atomic_sub(&pool->lost, lost);
+		tr_warn(&notif_tr, "%d notifications lost", lost);
+	}
 
 	item->msg.tx_size = size;
 	return &item->msg;
@@ -104,18 +148,8 @@ struct ipc_msg *ipc_notification_pool_get(size_t size)
 #if CONFIG_LIBRARY
 void ipc_notification_pool_free(void)
 {
-	struct ipc_notif_pool_item *item;
-	k_spinlock_key_t key;
-
-	key = k_spin_lock(&pool_free_list_lock);
-	while (!list_is_empty(&pool_free_list)) {
-		item = list_first_item(&pool_free_list, struct ipc_notif_pool_item, msg.list);
-		list_item_del(&item->msg.list);
-		--pool_depth;
-		k_spin_unlock(&pool_free_list_lock, key);
-		rfree(item);
-		key = k_spin_lock(&pool_free_list_lock);
-	}
-	k_spin_unlock(&pool_free_list_lock, key);
+	rfree(notif_block);
+	notif_block = NULL;
+	memset(notif_pools, 0, sizeof(notif_pools));
 }
 #endif /* CONFIG_LIBRARY */
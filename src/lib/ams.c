@@ -31,25 +31,61 @@ DECLARE_TR_CTX(ams_tr, SOF_UUID(ams_uuid), LOG_LEVEL_INFO);
 
 static struct ams_context ctx[CONFIG_CORE_COUNT];
 
-static struct ams_shared_context __sparse_cache *ams_acquire(struct ams_shared_context *shared)
+static struct ams_uuid_table __sparse_cache *ams_uuids_acquire(struct ams_uuid_table *uuids)
 {
-	struct coherent __sparse_cache *c = coherent_acquire(&shared->c,
-								    sizeof(*shared));
+	struct coherent __sparse_cache *c = coherent_acquire(&uuids->c, sizeof(*uuids));
 
-	return attr_container_of(c, struct ams_shared_context __sparse_cache,
-					c, __sparse_cache);
+	return attr_container_of(c, struct ams_uuid_table __sparse_cache,
+				 c, __sparse_cache);
 }
 
-static void ams_release(struct ams_shared_context __sparse_cache *shared)
+static void ams_uuids_release(struct ams_uuid_table __sparse_cache *uuids)
 {
-	coherent_release(&shared->c, sizeof(*shared));
+	coherent_release(&uuids->c, sizeof(*uuids));
 }
 
-static struct uuid_idx __sparse_cache *ams_find_uuid_entry_by_uuid(struct ams_shared_context __sparse_cache *ctx_shared,
+static struct ams_type_record __sparse_cache *ams_type_acquire(struct ams_type_record *type)
+{
+	struct coherent __sparse_cache *c = coherent_acquire(&type->c, sizeof(*type));
+
+	return attr_container_of(c, struct ams_type_record __sparse_cache,
+				 c, __sparse_cache);
+}
+
+static void ams_type_release(struct ams_type_record __sparse_cache *type)
+{
+	coherent_release(&type->c, sizeof(*type));
+}
+
+static struct ams_slot_table __sparse_cache *ams_slots_acquire(struct ams_slot_table *slots)
+{
+	struct coherent __sparse_cache *c = coherent_acquire(&slots->c, sizeof(*slots));
+
+	return attr_container_of(c, struct ams_slot_table __sparse_cache,
+				 c, __sparse_cache);
+}
+
+static void ams_slots_release(struct ams_slot_table __sparse_cache *slots)
+{
+	coherent_release(&slots->c, sizeof(*slots));
+}
+
+/* Record of a message type, the type IDs index the records directly */
+static struct ams_type_record *ams_type_get(struct ams_shared_context *shared,
+					    uint32_t message_type_id)
+{
+	if (message_type_id == AMS_INVALID_MSG_TYPE ||
+	    message_type_id > AMS_SERVICE_UUID_TABLE_SIZE)
+		return NULL;
+
+	return shared->types[message_type_id - 1];
+}
+
+static struct uuid_idx __sparse_cache *ams_find_uuid_entry_by_uuid(struct ams_uuid_table __sparse_cache *uuids,
 								   uint8_t const *uuid)
 {
 	unsigned int index;
-	struct uuid_idx __sparse_cache *uuid_table = ctx_shared->uuid_table;
+	struct uuid_idx __sparse_cache *uuid_table = uuids->uuid_table;
 
 	if (!uuid)
 		return NULL;
@@ -72,7 +108,7 @@ static struct uuid_idx __sparse_cache *ams_find_uuid_entry_by_uuid(struct ams_sh
 				return NULL;
 			}
 
-			uuid_table[index].message_type_id = ++ctx_shared->last_used_msg_id;
+			uuid_table[index].message_type_id = ++uuids->last_used_msg_id;
 			return &uuid_table[index];
 		}
 	}
@@ -85,45 +121,58 @@ int ams_get_message_type_id(const uint8_t *message_uuid,
 			    uint32_t *message_type_id)
 {
 	struct async_message_service *ams = *arch_ams_get();
+	struct ams_type_record __sparse_cache *type_c;
 	struct uuid_idx __sparse_cache *uuid_entry;
-	struct ams_shared_context __sparse_cache *shared_c;
+	struct ams_uuid_table __sparse_cache *uuids_c;
+	struct ams_type_record *type;
 
 	if (!ams->ams_context)
 		return -EINVAL;
 
 	*message_type_id = AMS_INVALID_MSG_TYPE;
 
-	shared_c = ams_acquire(ams->ams_context->shared);
+	uuids_c = ams_uuids_acquire(ams->ams_context->shared->uuids);
 
-	uuid_entry = ams_find_uuid_entry_by_uuid(shared_c, message_uuid);
+	uuid_entry = ams_find_uuid_entry_by_uuid(uuids_c, message_uuid);
 	if (!uuid_entry) {
-		ams_release(shared_c);
+		ams_uuids_release(uuids_c);
 		return -EINVAL;
 	}
 
 	*message_type_id = uuid_entry->message_type_id;
-	ams_release(shared_c);
+
+	/* enable the routes of the type, the UUID table is taken first */
+	type = ams_type_get(ams->ams_context->shared, *message_type_id);
+	type_c = ams_type_acquire(type);
+	type_c->message_type_id = *message_type_id;
+	ams_type_release(type_c);
+
+	ams_uuids_release(uuids_c);
 
 	return 0;
 }
 
-static int ams_find_uuid_index_by_msg_type_id(struct ams_shared_context __sparse_cache *ctx_shared,
-					      uint32_t const message_type_id)
+/* Acquires the record of an assigned message type */
+static struct ams_type_record __sparse_cache *ams_type_acquire_valid(struct async_message_service *ams,
+								     uint32_t message_type_id)
 {
-	struct uuid_idx __sparse_cache *iter;
+	struct ams_type_record __sparse_cache *type_c;
+	struct ams_type_record *type;
 
-	if (message_type_id == AMS_INVALID_MSG_TYPE)
-		return -EINVAL;
+	if (!ams->ams_context)
+		return NULL;
 
-	for (int i = 0; i < AMS_SERVICE_UUID_TABLE_SIZE; i++) {
-		iter = &ctx_shared->uuid_table[i];
+	type = ams_type_get(ams->ams_context->shared, message_type_id);
+	if (!type)
+		return NULL;
 
-		/* we got the id */
-		if (message_type_id == iter->message_type_id)
-			return i;
+	type_c = ams_type_acquire(type);
+	if (type_c->message_type_id != message_type_id) {
+		ams_type_release(type_c);
+		return NULL;
 	}
 
-	return -ENOENT;
+	return type_c;
 }
 
 int ams_register_producer(uint32_t message_type_id,
@@ -131,37 +180,22 @@ int ams_register_producer(uint32_t message_type_id,
 			  uint16_t instance_id)
 {
 	struct async_message_service *ams = *arch_ams_get();
-	struct ams_producer __sparse_cache *producer_table;
-	struct ams_shared_context __sparse_cache *shared_c;
-	int idx;
+	struct ams_type_record __sparse_cache *type_c;
+	struct ams_producer __sparse_cache *producer;
 	int err = -EINVAL;
 
-	if (!ams->ams_context)
+	type_c = ams_type_acquire_valid(ams, message_type_id);
+	if (!type_c)
 		return -EINVAL;
 
-	shared_c = ams_acquire(ams->ams_context->shared);
-
-	idx = ams_find_uuid_index_by_msg_type_id(shared_c, message_type_id);
-	if (idx < 0) {
-		ams_release(shared_c);
-		return -EINVAL;
-	}
-
-	producer_table = shared_c->producer_table;
-	for (int iter = 0; iter < AMS_ROUTING_TABLE_SIZE; iter++) {
-		/* Search for first invalid entry */
-		if (producer_table[iter].message_type_id == AMS_INVALID_MSG_TYPE) {
-			producer_table[iter].message_type_id = message_type_id;
-			producer_table[iter].producer_module_id = module_id;
-			producer_table[iter].producer_instance_id = instance_id;
-
-			/* Exit loop since we added new entry */
-			err = 0;
-			break;
-		}
+	if (type_c->producer_count < AMS_TYPE_PRODUCERS) {
+		producer = &type_c->producers[type_c->producer_count++];
+		producer->producer_module_id = module_id;
+		producer->producer_instance_id = instance_id;
+		err = 0;
 	}
 
-	ams_release(shared_c);
+	ams_type_release(type_c);
 	return err;
 }
 
@@ -170,36 +204,28 @@ int ams_unregister_producer(uint32_t message_type_id,
 			    uint16_t instance_id)
 {
 	struct async_message_service *ams = *arch_ams_get();
-	struct ams_producer __sparse_cache *producer_table;
-	struct ams_shared_context __sparse_cache *shared_c;
-	int idx;
+	struct ams_type_record __sparse_cache *type_c;
+	struct ams_producer __sparse_cache *producers;
 	int err = -EINVAL;
 
-	if (!ams->ams_context)
+	type_c = ams_type_acquire_valid(ams, message_type_id);
+	if (!type_c)
 		return -EINVAL;
 
-	shared_c = ams_acquire(ams->ams_context->shared);
-
-	idx = ams_find_uuid_index_by_msg_type_id(shared_c, message_type_id);
-	if (idx < 0) {
-		ams_release(shared_c);
-		return -EINVAL;
-	}
+	producers = type_c->producers;
+	for (int iter = 0; iter < type_c->producer_count; iter++) {
+		if ((producers[iter].producer_instance_id == instance_id) &&
+		    (producers[iter].producer_module_id == module_id)) {
+			/* the last entry takes the place of the removed one */
+			producers[iter] = producers[--type_c->producer_count];
 
-	producer_table = shared_c->producer_table;
-	for (int iter = 0; iter < AMS_ROUTING_TABLE_SIZE; iter++) {
-		if ((producer_table[iter].message_type_id == message_type_id) &&
-		    (producer_table[iter].producer_instance_id == instance_id) &&
-		    (producer_table[iter].producer_module_id == module_id)) {
-			producer_table[iter].message_type_id = AMS_INVALID_MSG_TYPE;
-
-			/* Exit loop since we added new entry */
+			/* Exit loop since we removed entry */
 			err = 0;
 			break;
 		}
 	}
 
-	ams_release(shared_c);
+	ams_type_release(type_c);
 	return err;
 }
 
@@ -210,34 +236,29 @@ int ams_register_consumer(uint32_t message_type_id,
 			  void *ctx)
 {
 	struct async_message_service *ams = *arch_ams_get();
-	struct ams_consumer_entry __sparse_cache *routing_table;
-	struct ams_shared_context __sparse_cache *shared_c;
+	struct ams_type_record __sparse_cache *type_c;
+	struct ams_consumer_entry __sparse_cache *consumer;
 	int err = -EINVAL;
 
-	if (!ams->ams_context || !function)
+	if (!function)
 		return -EINVAL;
 
-	shared_c = ams_acquire(ams->ams_context->shared);
-
-	routing_table = shared_c->rt_table;
-	for (int iter = 0; iter < AMS_ROUTING_TABLE_SIZE; iter++) {
-		/* Search for first invalid entry */
-		if (routing_table[iter].message_type_id == AMS_INVALID_MSG_TYPE) {
-			/* Add entry to routing table for local service */
-			routing_table[iter].consumer_callback = function;
-			routing_table[iter].message_type_id = message_type_id;
-			routing_table[iter].consumer_instance_id = instance_id;
-			routing_table[iter].consumer_module_id = module_id;
-			routing_table[iter].consumer_core_id = cpu_get_id();
-			routing_table[iter].ctx = ctx;
-
-			/* Exit loop since we added new entry */
-			err = 0;
-			break;
-		}
+	type_c = ams_type_acquire_valid(ams, message_type_id);
+	if (!type_c)
+		return -EINVAL;
+
+	if (type_c->consumer_count < AMS_TYPE_CONSUMERS) {
+		/* Add entry to routing table of the message type */
+		consumer = &type_c->consumers[type_c->consumer_count++];
+		consumer->consumer_callback = function;
+		consumer->consumer_instance_id = instance_id;
+		consumer->consumer_module_id = module_id;
+		consumer->consumer_core_id = cpu_get_id();
+		consumer->ctx = ctx;
+		err = 0;
 	}
 
-	ams_release(shared_c);
+	ams_type_release(type_c);
 	return err;
 }
 
@@ -247,24 +268,22 @@ int ams_unregister_consumer(uint32_t message_type_id,
 			    ams_msg_callback_fn function)
 {
 	struct async_message_service *ams = *arch_ams_get();
-	struct ams_consumer_entry __sparse_cache *routing_table;
-	struct ams_shared_context __sparse_cache *shared_c;
+	struct ams_type_record __sparse_cache *type_c;
+	struct ams_consumer_entry __sparse_cache *consumers;
 	int err = -EINVAL;
 
-	if (!ams->ams_context)
+	type_c = ams_type_acquire_valid(ams, message_type_id);
+	if (!type_c)
 		return -EINVAL;
 
-	shared_c = ams_acquire(ams->ams_context->shared);
-	routing_table = shared_c->rt_table;
-	for (int iter = 0; iter < AMS_ROUTING_TABLE_SIZE; iter++) {
+	consumers = type_c->consumers;
+	for (int iter = 0; iter < type_c->consumer_count; iter++) {
 		/* Search for required entry */
-		if ((routing_table[iter].message_type_id == message_type_id) &&
-		    (routing_table[iter].consumer_module_id == module_id) &&
-		    (routing_table[iter].consumer_instance_id == instance_id) &&
-		    (routing_table[iter].consumer_callback == function)) {
-			/* Remove this entry from routing table */
-			routing_table[iter].message_type_id = AMS_INVALID_MSG_TYPE;
-			routing_table[iter].consumer_callback = NULL;
+		if ((consumers[iter].consumer_module_id == module_id) &&
+		    (consumers[iter].consumer_instance_id == instance_id) &&
+		    (consumers[iter].consumer_callback == function)) {
+			/* the last entry takes the place of the removed one */
+			consumers[iter] = consumers[--type_c->consumer_count];
 
 			/* Exit loop since we removed entry */
 			err = 0;
@@ -272,32 +291,23 @@ int ams_unregister_consumer(uint32_t message_type_id,
 		}
 	}
 
-	ams_release(shared_c);
+	ams_type_release(type_c);
 	return err;
 }
 
-static uint32_t ams_push_slot(struct ams_shared_context __sparse_cache *ctx_shared,
+static uint32_t ams_push_slot(struct ams_slot_table __sparse_cache *slots_c,
 			      const struct ams_message_payload *msg,
 			      uint16_t module_id, uint16_t instance_id)
 {
-	int err;
-
-	for (uint32_t i = 0; i < ARRAY_SIZE(ctx_shared->slots); ++i) {
-		if (ctx_shared->slot_uses[i] == 0) {
-			/* the slot only carries the payload struct (read back
-			 * via u.msg); message points to a caller-owned buffer
-			 * rather than inline data, so copy exactly the struct
+	for (uint32_t i = 0; i < ARRAY_SIZE(slots_c->slots); ++i) {
+		if (slots_c->slot_uses[i] == 0) {
+			/* the slot only carries the payload struct, message
+			 * points to a caller-owned buffer rather than inline data
 			 */
-			err = memcpy_s((__sparse_force void *)ctx_shared->slots[i].u.msg_raw,
-				       sizeof(ctx_shared->slots[i].u.msg_raw),
-				       msg, sizeof(*msg));
-
-			if (err != 0)
-				return AMS_INVALID_SLOT;
-
-			ctx_shared->slots[i].module_id = module_id;
-			ctx_shared->slots[i].instance_id = instance_id;
-			ctx_shared->slot_done[i] = 0;
+			slots_c->slots[i].msg = *msg;
+			slots_c->slots[i].module_id = module_id;
+			slots_c->slots[i].instance_id = instance_id;
+			slots_c->slot_done[i] = 0;
 
 			return i;
 		}
@@ -352,13 +362,16 @@ static int ams_message_send_internal(struct async_message_service *ams,
 				     uint16_t module_id, uint16_t instance_id,
 				     uint32_t incoming_slot)
 {
-	bool found_any = false;
+	struct ams_consumer_entry targets[AMS_TYPE_CONSUMERS];
 	bool incoming = (incoming_slot != AMS_INVALID_SLOT);
-	struct ams_consumer_entry __sparse_cache *routing_table;
-	struct ams_shared_context __sparse_cache *shared_c;
+	struct ams_consumer_entry __sparse_cache *consumers;
+	struct ams_type_record __sparse_cache *type_c;
+	struct ams_slot_table __sparse_cache *slots_c;
+	struct ams_consumer_entry *target;
+	struct ams_slot_table *slots;
 	uint32_t forwarded = 0;
+	uint32_t count = 0;
 	uint32_t slot;
-	struct ams_consumer_entry ams_target;
 	int ixc_route;
 	int cpu_id;
 	int err = 0;
@@ -366,95 +379,80 @@ static int ams_message_send_internal(struct async_message_service *ams,
 	if (!ams->ams_context || !ams_message_payload)
 		return -EINVAL;
 
-	shared_c = ams_acquire(ams->ams_context->shared);
+	slots = ams->ams_context->shared->slots;
 	cpu_id = cpu_get_id();
 
-	if (incoming)
-		shared_c->slot_done[incoming_slot] |= BIT(cpu_id);
-
-	routing_table = shared_c->rt_table;
+	/*
+	 * Copy the routes of the message type, only its record is acquired
+	 * and the callbacks run with nothing acquired.
+	 */
+	type_c = ams_type_acquire_valid(ams, ams_message_payload->message_type_id);
+	if (type_c) {
+		consumers = type_c->consumers;
+		for (int iter = 0; iter < type_c->consumer_count; iter++) {
+			/* check if we want to limit to specific module* */
+			if (module_id != AMS_ANY_ID && instance_id != AMS_ANY_ID &&
+			    (consumers[iter].consumer_module_id != module_id ||
+			     consumers[iter].consumer_instance_id != instance_id))
+				continue;
 
-	for (int iter = 0; iter < AMS_ROUTING_TABLE_SIZE; iter++) {
-		slot = AMS_INVALID_SLOT;
+			targets[count++] = consumers[iter];
+		}
 
-		/* Search for required entry */
-		if (routing_table[iter].message_type_id != ams_message_payload->message_type_id)
-			continue;
+		ams_type_release(type_c);
+	}
 
-		/* check if we want to limit to specific module* */
-		if (module_id != AMS_ANY_ID && instance_id != AMS_ANY_ID) {
-			if (routing_table[iter].consumer_module_id != module_id ||
-			    routing_table[iter].consumer_instance_id != instance_id) {
-				continue;
-			}
-		}
+	if (incoming) {
+		slots_c = ams_slots_acquire(slots);
+		slots_c->slot_done[incoming_slot] |= BIT(cpu_id);
+		ams_slots_release(slots_c);
+	}
 
-		found_any = true;
-		ams_target = routing_table[iter];
-		ixc_route = ams_get_ixc_route_to_target(cpu_id,
-							ams_target.consumer_core_id);
+	for (int iter = 0; iter < count; iter++) {
+		target = &targets[iter];
+		ixc_route = ams_get_ixc_route_to_target(cpu_id, target->consumer_core_id);
 
 		if (ixc_route == cpu_id) {
 			/* we are on target core already */
-			/* release lock here, callback are NOT supposed to change routing_table */
-			ams_release(shared_c);
-
-			ams_target.consumer_callback(ams_message_payload, ams_target.ctx);
+			target->consumer_callback(ams_message_payload, target->ctx);
 			err = 0;
-		} else {
-			/* we have to go through idc */
-			if (incoming) {
-				/* if bit is set we are forwarding it again */
-				if (shared_c->slot_done[incoming_slot] & BIT(ams_target.consumer_core_id)) {
-					/* slot was already processed for that core, skip it */
-					continue;
-				}
-			} else {
-				slot = ams_push_slot(shared_c,
-						     ams_message_payload, module_id,
-						     instance_id);
-				if (slot == AMS_INVALID_SLOT) {
-					ams_release(shared_c);
-					return -EINVAL;
-				}
-			}
-			if ((forwarded & BIT(ams_target.consumer_core_id)) == 0) {
-				/* bump uses count, mark current as processed already */
-				if (slot != AMS_INVALID_SLOT) {
-					shared_c->slot_uses[slot]++;
-					shared_c->slot_done[slot] |= BIT(cpu_id);
-				}
-
-				/* release lock here, so other core can acquire it again */
-				ams_release(shared_c);
-
-				if (slot != AMS_INVALID_SLOT) {
-					forwarded |= BIT(ams_target.consumer_core_id);
-					err = ams_send_over_ixc(ams, slot, &ams_target);
-					if (err != 0) {
-						/* idc not sent, update slot refs locally */
-						shared_c = ams_acquire(ams->ams_context->shared);
-						shared_c->slot_uses[slot]--;
-						shared_c->slot_done[slot] |= BIT(ams_target.consumer_core_id);
-						ams_release(shared_c);
-					}
-				}
-			} else {
-				/* message already forwarded, nothing to do here */
-				ams_release(shared_c);
-			}
+			continue;
 		}
 
-		/* acquire shared context lock again */
-		shared_c = ams_acquire(ams->ams_context->shared);
-	}
+		/* incoming messages are not forwarded again, one slot per core */
+		if (incoming || (forwarded & BIT(target->consumer_core_id)))
+			continue;
 
-	if (incoming)
-		shared_c->slot_uses[incoming_slot]--;
+		slots_c = ams_slots_acquire(slots);
+		slot = ams_push_slot(slots_c, ams_message_payload, module_id, instance_id);
+		if (slot != AMS_INVALID_SLOT) {
+			/* bump uses count, mark current as processed already */
+			slots_c->slot_uses[slot]++;
+			slots_c->slot_done[slot] |= BIT(cpu_id);
+		}
+		ams_slots_release(slots_c);
+
+		if (slot == AMS_INVALID_SLOT)
+			return -EINVAL;
+
+		forwarded |= BIT(target->consumer_core_id);
+		err = ams_send_over_ixc(ams, slot, target);
+		if (err != 0) {
+			/* idc not sent, update slot refs locally */
+			slots_c = ams_slots_acquire(slots);
+			slots_c->slot_uses[slot]--;
+			slots_c->slot_done[slot] |= BIT(target->consumer_core_id);
+			ams_slots_release(slots_c);
+		}
+	}
 
-	ams_release(shared_c);
+	if (incoming) {
+		slots_c = ams_slots_acquire(slots);
+		slots_c->slot_uses[incoming_slot]--;
+		ams_slots_release(slots_c);
+	}
 
-	if (!found_any)
+	if (!count)
 		tr_err(&ams_tr, "No entries found!");
 
 	return err;
@@ -486,18 +484,18 @@ int ams_send_mi(const struct ams_message_payload *const ams_message_payload,
 
 static int ams_process_slot(struct async_message_service *ams, uint32_t slot)
 {
-	struct ams_shared_context __sparse_cache *shared_c;
+	struct ams_slot_table __sparse_cache *slots_c;
 	struct ams_message_payload msg;
 	uint16_t module_id;
 	uint16_t instance_id;
 
-	shared_c = ams_acquire(ams->ams_context->shared);
+	slots_c = ams_slots_acquire(ams->ams_context->shared->slots);
 
-	msg = shared_c->slots[slot].u.msg;
-	module_id = shared_c->slots[slot].module_id;
-	instance_id = shared_c->slots[slot].instance_id;
+	msg = slots_c->slots[slot].msg;
+	module_id = slots_c->slots[slot].module_id;
+	instance_id = slots_c->slots[slot].instance_id;
 
-	ams_release(shared_c);
+	ams_slots_release(slots_c);
 	tr_info(&ams_tr, "slot %d msg %d from 0x%08x",
 		slot, msg.message_type_id,
 		msg.producer_module_id << 16 | msg.producer_instance_id);
@@ -570,20 +568,57 @@ static int ams_task_init(void)
 	return ret;
 }
 
-static int ams_create_shared_context(struct ams_shared_context *ctx)
+static void ams_free_shared_context(struct ams_shared_context *shared)
 {
-	struct ams_shared_context __sparse_cache *shared_c;
+	int i;
 
-	shared_c = ams_acquire(ctx);
-	shared_c->last_used_msg_id = AMS_INVALID_MSG_TYPE;
-	ams_release(shared_c);
+	for (i = 0; i < AMS_SERVICE_UUID_TABLE_SIZE; i++)
+		if (shared->types[i])
+			coherent_free(shared->types[i], c);
 
-	return 0;
+	if (shared->slots)
+		coherent_free(shared->slots, c);
+	if (shared->uuids)
+		coherent_free(shared->uuids, c);
+
+	rfree(shared);
+}
+
+/* Separate records for the UUIDs, the slots and each message type */
+static struct ams_shared_context *ams_create_shared_context(void)
+{
+	struct ams_shared_context *shared;
+	int i;
+
+	shared = rzalloc(SOF_MEM_FLAG_USER | SOF_MEM_FLAG_COHERENT, sizeof(*shared));
+	if (!shared)
+		return NULL;
+
+	shared->uuids = coherent_init(struct ams_uuid_table, c);
+	shared->slots = coherent_init(struct ams_slot_table, c);
+	if (!shared->uuids || !shared->slots)
+		goto err;
+
+	coherent_shared(shared->uuids, c);
+	coherent_shared(shared->slots, c);
+
+	for (i = 0; i < AMS_SERVICE_UUID_TABLE_SIZE; i++) {
+		shared->types[i] = coherent_init(struct ams_type_record, c);
+		if (!shared->types[i])
+			goto err;
+
+		coherent_shared(shared->types[i], c);
+	}
+
+	return shared;
+
+err:
+	ams_free_shared_context(shared);
+	return NULL;
 }
 
 __cold int ams_init(void)
 {
-	struct ams_shared_context *ams_shared_ctx;
 	struct async_message_service **ams = arch_ams_get();
 	struct sof *sof;
 	int ret = 0;
@@ -600,16 +635,12 @@ __cold int ams_init(void)
 
 	if (cpu_get_id() == PLATFORM_PRIMARY_CORE_ID) {
 		sof = sof_get();
-		sof->ams_shared_ctx = coherent_init(struct ams_shared_context, c);
+		sof->ams_shared_ctx = ams_create_shared_context();
 		if (!sof->ams_shared_ctx)
 			goto err;
-		coherent_shared(sof->ams_shared_ctx, c);
 	}
 
-	ams_shared_ctx = ams_ctx_get();
-	(*ams)->ams_context->shared = ams_shared_ctx;
-
-	ams_create_shared_context((*ams)->ams_context->shared);
+	(*ams)->ams_context->shared = ams_ctx_get();
 
 #if CONFIG_SMP
 	ret = ams_task_init();
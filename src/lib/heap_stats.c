@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <rtos/mutex.h>
+#include <sof/lib/heap_stats.h>
+#include <sof/list.h>
+#include <sof/math/numbers.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Registered statistics, the counters themselves are under the heap locks.
+ * The list lock is a mutex: reports probe the heaps for their largest free
+ * block, which must not run with interrupts disabled.
+ */
+static struct list_item heap_stats_list = LIST_INIT(heap_stats_list);
+static K_MUTEX_DEFINE(heap_stats_lock);
+
+void heap_stats_register(struct heap_stats *stats, uint32_t type, uint32_t id, size_t size,
+			 heap_stats_largest_free_t largest_free)
+{
+	memset(stats, 0, sizeof(*stats));
+	stats->type = type;
+	stats->id = id;
+	stats->size = size;
+	stats->largest_free = largest_free;
+
+	k_mutex_lock(&heap_stats_lock, K_FOREVER);
+	list_item_append(&stats->list, &heap_stats_list);
+	k_mutex_unlock(&heap_stats_lock);
+}
+
+void heap_stats_unregister(struct heap_stats *stats)
+{
+	k_mutex_lock(&heap_stats_lock, K_FOREVER);
+	list_item_del(&stats->list);
+	k_mutex_unlock(&heap_stats_lock);
+}
+
+static unsigned int heap_stats_latency_bin(uint32_t cycles)
+{
+	unsigned int bin = 0;
+
+	for (cycles >>= HEAP_STATS_LATENCY_SHIFT; cycles && bin < HEAP_STATS_LATENCY_BINS - 1;
+	     cycles >>= 1)
+		bin++;
+
+	return bin;
+}
+
+void heap_stats_alloc(struct heap_stats *stats, size_t bytes, uint32_t cycles)
+{
+	stats->latency[heap_stats_latency_bin(cycles)]++;
+
+	if (!bytes) {
+		stats->fail_count++;
+		return;
+	}
+
+	stats->alloc_count++;
+	stats->used += bytes;
+	stats->peak = MAX(stats->peak, stats->used);
+}
+
+void heap_stats_free(struct heap_stats *stats, size_t bytes)
+{
+	stats->free_count++;
+	stats->used -= MIN(bytes, stats->used);
+}
+
+unsigned int heap_stats_get(struct heap_stats_record *records, unsigned int max)
+{
+	struct heap_stats_record *rec = records;
+	struct heap_stats *stats;
+	struct list_item *item;
+	size_t largest;
+	int i;
+
+	/* statistics cannot be unregistered while their heap is probed */
+	k_mutex_lock(&heap_stats_lock, K_FOREVER);
+
+	list_for_item(item, &heap_stats_list) {
+		if (rec == records + max)
+			break;
+
+		stats = container_of(item, struct heap_stats, list);
+
+		/* counters can change meanwhile, reports are snapshots */
+		rec->type = stats->type;
+		rec->id = stats->id;
+		rec->size = stats->size;
+		rec->used = stats->used;
+		rec->peak = stats->peak;
+		rec->alloc_count = stats->alloc_count;
+		rec->free_count = stats->free_count;
+		rec->fail_count = stats->fail_count;
+		for (i = 0; i < HEAP_STATS_LATENCY_BINS; i++)
+			rec->latency[i] = stats->latency[i];
+
+		if (stats->largest_free) {
+			largest = stats->largest_free(stats);
+			rec->largest_free = MIN(largest, (size_t)UINT32_MAX - 1);
+		} else {
+			rec->largest_free = HEAP_STATS_LARGEST_FREE_UNKNOWN;
+		}
+
+		rec++;
+	}
+
+	k_mutex_unlock(&heap_stats_lock);
+
+	return rec - records;
+}
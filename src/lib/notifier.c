@@ -26,7 +26,14 @@ SOF_DEFINE_REG_UUID(notifier);
 
 DECLARE_TR_CTX(nt_tr, SOF_UUID(notifier_uuid), LOG_LEVEL_INFO);
 
-static SHARED_DATA struct notify_data notify_data_shared[CONFIG_CORE_COUNT];
+static SHARED_DATA struct notify_queue notify_queue_shared[CONFIG_CORE_COUNT];
+
+/*
+ * Events the receivers handle the same way if delivered once or repeatedly.
+ * Clock events carry pre and post change messages and DMA copy events carry
+ * byte counts, so they are always delivered one by one.
+ */
+#define NOTIFIER_COALESCE_MASK	BIT(NOTIFIER_ID_MIC_PRIVACY_STATE_CHANGE)
 
 struct callback_handle {
 	void *receiver;
@@ -146,22 +153,85 @@ static void notifier_notify(const void *caller, enum notify_id type, void *data)
 void notifier_notify_remote(void)
 {
 	struct notify *notify = *arch_notify_get();
-	struct notify_data *notify_data = notify_data_get() + cpu_get_id();
+	struct notify_queue *queue = notify_queue_get() + cpu_get_id();
+	struct notify_data events[CONFIG_NOTIFIER_QUEUE_SIZE];
+	struct notify_data *event;
+	k_spinlock_key_t key;
+	uint32_t dropped;
+	uint32_t count;
+	uint32_t i;
+
+	/* take all queued events, new events need a new IDC */
+	key = k_spin_lock(&queue->lock);
+	count = queue->count;
+	for (i = 0; i < count; i++)
+		events[i] = queue->event[i];
+	dropped = queue->dropped;
+	queue->count = 0;
+	queue->dropped = 0;
+	queue->idc_pending = false;
+	k_spin_unlock(&queue->lock, key);
+
+	if (dropped)
+		tr_err(&nt_tr, "%u events to core %d lost, queue full", dropped, cpu_get_id());
+
+	for (i = 0; i < count; i++) {
+		event = events + i;
+		if (list_is_empty(&notify->list[event->type]))
+			continue;
+
+		dcache_invalidate_region((__sparse_force void __sparse_cache *)event->data,
+					 event->data_size);
+		notifier_notify(event->caller, event->type, event->data);
+	}
+}
+
+/* Queues an event for another core, returns true if an IDC has to be sent */
+static bool notifier_queue_event(struct notify_queue *queue, const void *caller,
+				 enum notify_id type, void *data, uint32_t data_size)
+{
+	struct notify_data *event;
+	k_spinlock_key_t key;
+	bool send = false;
+	uint32_t i;
+
+	key = k_spin_lock(&queue->lock);
 
-	if (!list_is_empty(&notify->list[notify_data->type])) {
-		dcache_invalidate_region((__sparse_force void __sparse_cache *)notify_data->data,
-					 notify_data->data_size);
-		notifier_notify(notify_data->caller, notify_data->type,
-				notify_data->data);
+	/* the receiver reads the same data once for all repeated events */
+	if (IS_ENABLED(CONFIG_NOTIFIER_COALESCE) && (NOTIFIER_COALESCE_MASK & BIT(type))) {
+		for (i = 0; i < queue->count; i++) {
+			event = queue->event + i;
+			if (event->type == type && event->caller == caller && event->data == data)
+				goto out;
+		}
 	}
 
+	if (queue->count < CONFIG_NOTIFIER_QUEUE_SIZE) {
+		event = queue->event + queue->count++;
+		event->caller = caller;
+		event->type = type;
+		event->data = data;
+		event->data_size = data_size;
+	} else {
+		queue->dropped++;
+	}
+
+	/* one IDC for all events queued until the core takes them */
+	send = !queue->idc_pending;
+	queue->idc_pending = true;
+
+out:
+	k_spin_unlock(&queue->lock, key);
+	return send;
 }
 
 void notifier_event(const void *caller, enum notify_id type, uint32_t core_mask,
 		    void *data, uint32_t data_size)
 {
-	struct notify_data *notify_data;
+	struct notify_queue *queue;
 	struct idc_msg notify_msg = { IDC_MSG_NOTIFY, IDC_MSG_NOTIFY_EXT };
+	bool written_back = false;
+	k_spinlock_key_t key;
 	int i;
 
 	/* notify selected targets */
@@ -170,21 +240,26 @@ void notifier_event(const void *caller, enum notify_id type, uint32_t core_mask,
 			if (i == cpu_get_id()) {
 				notifier_notify(caller, type, data);
 			} else if (cpu_is_core_enabled(i)) {
-				notify_msg.core = i;
-				notify_data = notify_data_get() + i;
-				notify_data->caller = caller;
-				notify_data->type = type;
-
 				/* NOTE: for transcore events, payload has to
 				 * be allocated on heap, not on stack
 				 */
-				notify_data->data = data;
-				notify_data->data_size = data_size;
+				if (!written_back) {
+					dcache_writeback_region((__sparse_force void __sparse_cache *)
+								data, data_size);
+					written_back = true;
+				}
 
-				dcache_writeback_region((__sparse_force void __sparse_cache *)
-							notify_data->data, data_size);
+				queue = notify_queue_get() + i;
+				if (!notifier_queue_event(queue, caller, type, data, data_size))
+					continue;
 
-				idc_send_msg(&notify_msg, IDC_NON_BLOCKING);
+				notify_msg.core = i;
+				if (idc_send_msg(&notify_msg, IDC_NON_BLOCKING) < 0) {
+					/* the events are sent with the next IDC */
+					key = k_spin_lock(&queue->lock);
+					queue->idc_pending = false;
+					k_spin_unlock(&queue->lock, key);
+				}
 			}
 		}
 	}
@@ -208,8 +283,12 @@ __cold void init_system_notify(struct sof *sof)
 	for (i = NOTIFIER_ID_CPU_FREQ; i < NOTIFIER_ID_COUNT; i++)
 		list_init(&(*notify)->list[i]);
 
-	if (cpu_get_id() == PLATFORM_PRIMARY_CORE_ID)
-		sof->notify_data = notify_data_shared;
+	if (cpu_get_id() == PLATFORM_PRIMARY_CORE_ID) {
+		for (i = 0; i < CONFIG_CORE_COUNT; i++)
+			k_spinlock_init(&notify_queue_shared[i].lock);
+
+		sof->notify_queue = notify_queue_shared;
+	}
 }
 
 void free_system_notify(void)
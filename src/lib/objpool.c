@@ -7,7 +7,9 @@
 #include <sof/objpool.h>
 #include <sof/common.h>
 #include <sof/list.h>
+#include <sof/lib/heap_stats.h>
 #include <sof/lib/vregion.h>
+#include <rtos/timer.h>
 
 #include <errno.h>
 #include <limits.h>
@@ -38,6 +40,7 @@ static int objpool_add(struct objpool_head *head, unsigned int n, size_t size, u
 	if (!head->heap)
 		head->heap = sof_sys_heap_get();
 
+	uint32_t start = (uint32_t)sof_cycle_get_64();
 	struct objpool *pobjpool;
 
 	if (!head->vreg)
@@ -50,6 +53,10 @@ static int objpool_add(struct objpool_head *head, unsigned int n, size_t size, u
 		pobjpool = vregion_alloc(head->vreg,
 					 aligned_size + sizeof(*pobjpool));
 
+	if (head->stats)
+		heap_stats_alloc(head->stats, pobjpool ? aligned_size + sizeof(*pobjpool) : 0,
+				 (uint32_t)sof_cycle_get_64() - start);
+
 	if (!pobjpool)
 		return -ENOMEM;
 
@@ -163,6 +170,9 @@ void objpool_prune(struct objpool_head *head)
 		struct objpool *pool = container_of(next, struct objpool, list);
 
 		list_item_del(next);
+		if (head->stats)
+			heap_stats_free(head->stats, pool->n * ALIGN_UP(pool->size, sizeof(int)) +
+					sizeof(*pool));
 		if (head->vreg)
 			vregion_free(head->vreg, pool);
 		else
@@ -22,6 +22,7 @@
 #include <rtos/userspace_helper.h>
 #include <sof/lib/cpu-clk-manager.h>
 #include <sof/lib_manager.h>
+#include <sof/lib_manager_loader.h>
 #include <sof/llext_manager.h>
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/audio/module_adapter/module/modules.h>
@@ -57,11 +58,18 @@ SOF_DEFINE_REG_UUID(lib_manager);
 
 DECLARE_TR_CTX(lib_manager_tr, SOF_UUID(lib_manager_uuid), LOG_LEVEL_INFO);
 
+/*
+ * Number of MAN_MAX_SIZE_V1_8 chunks in DMA buffer, the next chunk is received
+ * while the previous one is copied to storage
+ */
+#define LIB_MANAGER_DMA_CHUNKS	2
+
 struct lib_manager_dma_ext {
 	struct sof_dma *dma;
 	struct dma_chan_data *chan;
 	uintptr_t dma_addr;		/**< buffer start pointer */
 	uint32_t addr_align;
+	struct lib_manager_loader loader;	/**< chunked loader */
 };
 
 static struct ext_library loader_ext_lib;
@@ -919,8 +927,9 @@ static int lib_manager_dma_deinit(struct lib_manager_dma_ext *dma_ext, uint32_t
 	return 0;
 }
 
-static int lib_manager_load_data_from_host(struct lib_manager_dma_ext *dma_ext, uint32_t size)
+static int lib_manager_load_data_from_host(void *data, uint32_t size)
 {
+	struct lib_manager_dma_ext *dma_ext = data;
 	uint64_t timeout = k_ms_to_cyc_ceil64(200);
 	struct dma_status stat;
 	int ret;
@@ -944,31 +953,23 @@ static int lib_manager_load_data_from_host(struct lib_manager_dma_ext *dma_ext,
 	return -ETIMEDOUT;
 }
 
-static int lib_manager_store_data(struct lib_manager_dma_ext *dma_ext,
-				  void __sparse_cache *dst_addr, uint32_t dst_size)
+static int lib_manager_dma_reload(void *data, uint32_t size)
 {
-	uint32_t copied_bytes = 0;
-
-	while (copied_bytes < dst_size) {
-		uint32_t bytes_to_copy;
-		int ret;
+	struct lib_manager_dma_ext *dma_ext = data;
 
-		if ((dst_size - copied_bytes) > MAN_MAX_SIZE_V1_8)
-			bytes_to_copy = MAN_MAX_SIZE_V1_8;
-		else
-			bytes_to_copy = dst_size - copied_bytes;
-
-		ret = lib_manager_load_data_from_host(dma_ext, bytes_to_copy);
-		if (ret < 0)
-			return ret;
+	return dma_reload(dma_ext->chan->dma->z_dev, dma_ext->chan->index, 0, 0, size);
+}
 
-		memcpy_s((__sparse_force uint8_t *)dst_addr + copied_bytes, bytes_to_copy,
-			 (void *)dma_ext->dma_addr, bytes_to_copy);
-		copied_bytes += bytes_to_copy;
-		dma_reload(dma_ext->chan->dma->z_dev, dma_ext->chan->index, 0, 0, bytes_to_copy);
-	}
+static const struct lib_manager_loader_ops lib_manager_loader_ops = {
+	.dma_wait = lib_manager_load_data_from_host,
+	.dma_reload = lib_manager_dma_reload,
+};
 
-	return 0;
+static int lib_manager_store_data(struct lib_manager_dma_ext *dma_ext,
+				  void __sparse_cache *dst_addr, uint32_t dst_size)
+{
+	return lib_manager_loader_store(&dma_ext->loader, (__sparse_force void *)dst_addr,
+					dst_size);
 }
 
 static void __sparse_cache *lib_manager_allocate_store_mem(uint32_t size,
@@ -993,6 +994,34 @@ static void __sparse_cache *lib_manager_allocate_store_mem(uint32_t size,
 	return local_add;
 }
 
+/*
+ * Decompress the library to storage while it is transferred, only the smaller
+ * compressed image is transferred
+ */
+static int lib_manager_store_compressed(struct lib_manager_dma_ext *dma_ext,
+					void __sparse_cache *library_base_address,
+					uint32_t preload_size)
+{
+	void *staging = rballoc_align(SOF_MEM_FLAG_USER | SOF_MEM_FLAG_DMA,
+				      SOF_MAN_LZ4_FRAME_SIZE * 2, CONFIG_MM_DRV_PAGE_SIZE);
+	int ret;
+
+	if (!staging)
+		return -ENOMEM;
+
+	ret = lib_manager_loader_store_lz4(&dma_ext->loader,
+					   (__sparse_force void *)library_base_address,
+					   (__sparse_force uint8_t *)library_base_address +
+					   MAN_MAX_SIZE_V1_8,
+					   preload_size - MAN_MAX_SIZE_V1_8, staging);
+	if (ret < 0)
+		tr_err(&lib_manager_tr, "compressed library load failed: %d", ret);
+
+	rfree(staging);
+
+	return ret;
+}
+
 static int lib_manager_store_library(struct lib_manager_dma_ext *dma_ext,
 				     const void __sparse_cache *man_buffer,
 				     uint32_t lib_id, struct auth_api_ctx *auth_ctx)
@@ -1046,8 +1075,11 @@ static int lib_manager_store_library(struct lib_manager_dma_ext *dma_ext,
 		 (__sparse_force const void *)man_buffer, MAN_MAX_SIZE_V1_8);
 
 	/* Copy remaining library part into storage buffer */
-	ret = lib_manager_store_data(dma_ext, (uint8_t __sparse_cache *)library_base_address +
-				     MAN_MAX_SIZE_V1_8, preload_size - MAN_MAX_SIZE_V1_8);
+	if (man_desc->header.fw_image_flags.fields.compressed)
+		ret = lib_manager_store_compressed(dma_ext, library_base_address, preload_size);
+	else
+		ret = lib_manager_store_data(dma_ext, (uint8_t __sparse_cache *)library_base_address +
+					     MAN_MAX_SIZE_V1_8, preload_size - MAN_MAX_SIZE_V1_8);
 	if (ret < 0) {
 		rfree((__sparse_force void *)library_base_address);
 		return ret;
@@ -1077,7 +1109,7 @@ static int lib_manager_setup(uint32_t dma_id)
 	struct ext_library *_ext_lib = ext_lib_get();
 	struct lib_manager_dma_ext *dma_ext;
 	struct dma_block_config dma_block_cfg = {
-		.block_size = MAN_MAX_SIZE_V1_8,
+		.block_size = MAN_MAX_SIZE_V1_8 * LIB_MANAGER_DMA_CHUNKS,
 		.flow_control_mode = 1,
 	};
 	struct dma_config config = {
@@ -1106,11 +1138,14 @@ static int lib_manager_setup(uint32_t dma_id)
 	if (ret < 0)
 		goto err_dma_init;
 
-	ret = lib_manager_dma_buffer_alloc(dma_ext, MAN_MAX_SIZE_V1_8);
+	ret = lib_manager_dma_buffer_alloc(dma_ext, MAN_MAX_SIZE_V1_8 * LIB_MANAGER_DMA_CHUNKS);
 	if (ret < 0)
 		goto err_dma_buffer;
 
 	dma_block_cfg.dest_address = dma_ext->dma_addr;
+	lib_manager_loader_init(&dma_ext->loader, &lib_manager_loader_ops, dma_ext,
+				(void *)dma_ext->dma_addr, MAN_MAX_SIZE_V1_8 * LIB_MANAGER_DMA_CHUNKS,
+				MAN_MAX_SIZE_V1_8);
 
 #if CONFIG_KCPS_DYNAMIC_CLOCK_CONTROL
 	/*
@@ -0,0 +1,242 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+/*
+ * Chunked library loader overlapping host DMA with the copy to storage.
+ */
+
+#include <sof/common.h>
+#include <sof/lib_manager_loader.h>
+#include <sof/math/numbers.h>
+#include <rtos/cache.h>
+#include <rtos/string.h>
+#include <rimage/sof/user/manifest.h>
+
+#include <errno.h>
+#include <stdint.h>
+
+/* Decompression state of a compressed library */
+struct lib_manager_lz4 {
+	const uint8_t *base;	/* matches cannot refer before this */
+	uint8_t *out;		/* next decompressed byte */
+	uint8_t *end;		/* end of decompressed data */
+	uint8_t *staging;	/* two chunks of compressed data */
+};
+
+void lib_manager_loader_init(struct lib_manager_loader *ld,
+			     const struct lib_manager_loader_ops *ops, void *data,
+			     void *dma_buf, uint32_t dma_size, uint32_t chunk_size)
+{
+	ld->ops = ops;
+	ld->data = data;
+	ld->dma_buf = dma_buf;
+	ld->dma_size = dma_size;
+	ld->chunk_size = chunk_size;
+	ld->r_off = 0;
+}
+
+/* Copy one chunk out of the DMA buffer and give the space back to DMA */
+static int lib_manager_loader_copy(struct lib_manager_loader *ld, uint8_t *dst, uint32_t size)
+{
+	uint32_t head = MIN(size, ld->dma_size - ld->r_off);
+	int ret;
+
+	ret = ld->ops->dma_wait(ld->data, size);
+	if (ret < 0)
+		return ret;
+
+	memcpy_s(dst, size, ld->dma_buf + ld->r_off, head);
+	if (head < size)
+		memcpy_s(dst + head, size - head, ld->dma_buf, size - head);
+
+	ld->r_off += size;
+	if (ld->r_off >= ld->dma_size)
+		ld->r_off -= ld->dma_size;
+
+	/* the DMA can fill the space while the chunk is written back */
+	ret = ld->ops->dma_reload(ld->data, size);
+	if (ret < 0)
+		return ret;
+
+	/* make the chunk visible to other cores */
+	dcache_writeback_region((__sparse_force void __sparse_cache *)dst, size);
+
+	return 0;
+}
+
+/* Extended length of LZ4 literals or match, continued while bytes are 255 */
+static int lib_manager_lz4_len(const uint8_t **in, const uint8_t *in_end, uint32_t *len)
+{
+	uint8_t b;
+
+	do {
+		if (*in == in_end)
+			return -EINVAL;
+
+		b = *(*in)++;
+		*len += b;
+	} while (b == 255);
+
+	return 0;
+}
+
+static int lib_manager_lz4_block(struct lib_manager_lz4 *lz4, const uint8_t *in,
+				 uint32_t in_size, uint32_t raw_size)
+{
+	const uint8_t *in_end = in + in_size;
+	uint8_t *out = lz4->out;
+	uint8_t *out_end = out + raw_size;
+	uint32_t offset;
+	uint32_t len;
+	uint8_t token;
+
+	while (in < in_end) {
+		token = *in++;
+
+		/* literals */
+		len = token >> 4;
+		if (len == 15 && lib_manager_lz4_len(&in, in_end, &len) < 0)
+			return -EINVAL;
+
+		if (len > in_end - in || len > out_end - out)
+			return -EINVAL;
+
+		memcpy_s(out, out_end - out, in, len);
+		in += len;
+		out += len;
+
+		/* the last sequence has no match */
+		if (in == in_end)
+			break;
+
+		if (in_end - in < 2)
+			return -EINVAL;
+
+		offset = in[0] | (uint32_t)in[1] << 8;
+		in += 2;
+		if (!offset || offset > out - lz4->base)
+			return -EINVAL;
+
+		len = token & 0xf;
+		if (len == 15 && lib_manager_lz4_len(&in, in_end, &len) < 0)
+			return -EINVAL;
+
+		len += SOF_MAN_LZ4_MIN_MATCH;
+		if (len > out_end - out)
+			return -EINVAL;
+
+		if (offset >= len) {
+			memcpy_s(out, out_end - out, out - offset, len);
+			out += len;
+		} else {
+			/* the match overlaps its copy, repeating the last offset bytes */
+			for (; len; len--, out++)
+				*out = *(out - offset);
+		}
+	}
+
+	if (out != out_end)
+		return -EINVAL;
+
+	lz4->out = out;
+
+	return 0;
+}
+
+/* Decompress all blocks of one frame */
+static int lib_manager_lz4_frame(struct lib_manager_lz4 *lz4, const uint8_t *frame,
+				 uint32_t size)
+{
+	const uint8_t *end = frame + size;
+	uint8_t *out = lz4->out;
+	struct sof_man_lz4_block blk;
+	int ret;
+
+	while (end - frame >= sizeof(blk) && lz4->out < lz4->end) {
+		memcpy_s(&blk, sizeof(blk), frame, sizeof(blk));
+		frame += sizeof(blk);
+		if (!blk.raw_size)
+			break;
+
+		if (blk.comp_size > end - frame || blk.raw_size > lz4->end - lz4->out)
+			return -EINVAL;
+
+		if (blk.comp_size == blk.raw_size) {
+			memcpy_s(lz4->out, lz4->end - lz4->out, frame, blk.raw_size);
+			lz4->out += blk.raw_size;
+		} else {
+			ret = lib_manager_lz4_block(lz4, frame, blk.comp_size, blk.raw_size);
+			if (ret < 0)
+				return ret;
+		}
+
+		frame += blk.comp_size;
+	}
+
+	/* every frame must make progress, the end is only known from the size */
+	if (lz4->out == out)
+		return -EINVAL;
+
+	dcache_writeback_region((__sparse_force void __sparse_cache *)out, lz4->out - out);
+
+	return 0;
+}
+
+static int lib_manager_loader_run(struct lib_manager_loader *ld, uint8_t *dst, uint32_t size,
+				  struct lib_manager_lz4 *lz4)
+{
+	uint32_t copied = 0;
+	uint8_t *chunk;
+	unsigned int i;
+	uint32_t n;
+	int ret;
+
+	for (i = 0; copied < size; i++) {
+		if (lz4) {
+			/* whole frames, until all data is decompressed */
+			chunk = lz4->staging + (i & 1) * ld->chunk_size;
+			n = ld->chunk_size;
+		} else {
+			chunk = dst + copied;
+			n = MIN(ld->chunk_size, size - copied);
+		}
+
+		ret = lib_manager_loader_copy(ld, chunk, n);
+		if (ret < 0)
+			return ret;
+
+		if (lz4) {
+			ret = lib_manager_lz4_frame(lz4, chunk, n);
+			if (ret < 0)
+				return ret;
+
+			copied = lz4->out - dst;
+		} else {
+			copied += n;
+		}
+	}
+
+	return 0;
+}
+
+int lib_manager_loader_store(struct lib_manager_loader *ld, void *dst, uint32_t size)
+{
+	return lib_manager_loader_run(ld, dst, size, NULL);
+}
+
+int lib_manager_loader_store_lz4(struct lib_manager_loader *ld, const void *base, void *dst,
+				 uint32_t size, void *staging)
+{
+	struct lib_manager_lz4 lz4 = {
+		.base = base,
+		.out = dst,
+		.end = (uint8_t *)dst + size,
+		.staging = staging,
+	};
+
+	if ((const uint8_t *)dst < lz4.base)
+		return -EINVAL;
+
+	return lib_manager_loader_run(ld, dst, size, &lz4);
+}
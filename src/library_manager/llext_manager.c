@@ -18,6 +18,7 @@
 
 #include <rtos/sof.h>
 #include <rtos/spinlock.h>
+#include <rtos/symbol.h>
 #include <sof/lib/cpu-clk-manager.h>
 #include <sof/lib_manager.h>
 #include <sof/lib/regions_mm.h>
@@ -78,6 +79,19 @@ static int llext_manager_align_unmap(void __sparse_cache *vma, size_t size)
 	return sys_mm_drv_unmap_region(aligned_vma, ALIGN_UP(pre_pad_size + size, PAGE_SZ));
 }
 
+/* SRAM used by a mapping of 'size' bytes at 'vma' */
+static size_t llext_manager_map_size(const void __sparse_cache *vma, size_t size)
+{
+	size_t pre_pad_size = (uintptr_t)vma & (PAGE_SZ - 1);
+
+	return size ? ALIGN_UP(pre_pad_size + size, PAGE_SZ) : 0;
+}
+
+static bool llext_manager_section_detached(const elf_shdr_t *shdr)
+{
+	return shdr->sh_addr < SOF_MODULE_DRAM_LINK_END;
+}
+
 static void llext_manager_detached_update_flags(void __sparse_cache *vma,
 						size_t size, uint32_t flags)
 {
@@ -96,13 +110,15 @@ static void llext_manager_detached_update_flags(void __sparse_cache *vma,
  * Map the memory range covered by 'vma' and 'size' as writable, copy all
  * sections that belong to the specified 'region' and are contained in the
  * memory range, then remap the same area according to the 'flags' parameter.
+ * If 'detached' is set, detached sections of the region are made accessible
+ * in storage with the same 'flags'.
  */
 static int llext_manager_load_data_from_storage(const struct sys_mm_drv_region *virtual_region,
 						const struct llext_loader *ldr,
 						const struct llext *ext,
 						enum llext_mem region,
 						void __sparse_cache *vma,
-						size_t size, uint32_t flags)
+						size_t size, uint32_t flags, bool detached)
 {
 	unsigned int i;
 	const void *region_addr;
@@ -136,9 +152,11 @@ static int llext_manager_load_data_from_storage(const struct sys_mm_drv_region *
 		if (s_region != region)
 			continue;
 
-		/* skip detached sections (will be outside requested VMA area) */
-		if ((uintptr_t)shdr->sh_addr < (uintptr_t)vma ||
-		    (uintptr_t)shdr->sh_addr >= (uintptr_t)vma + size) {
+		/* detached sections are used in place in storage */
+		if (llext_manager_section_detached(shdr)) {
+			if (!detached)
+				continue;
+
 			llext_manager_detached_update_flags((__sparse_cache void *)
 							    ((uint8_t *)region_addr + s_offset),
 							    shdr->sh_size, flags);
@@ -149,7 +167,13 @@ static int llext_manager_load_data_from_storage(const struct sys_mm_drv_region *
 			continue;
 		}
 
-		ret = memcpy_s((__sparse_force void *)shdr->sh_addr, size - s_offset,
+		/* skip sections outside of the requested VMA area, e.g. .lazy code */
+		if ((uintptr_t)shdr->sh_addr < (uintptr_t)vma ||
+		    (uintptr_t)shdr->sh_addr >= (uintptr_t)vma + size)
+			continue;
+
+		ret = memcpy_s((__sparse_force void *)shdr->sh_addr,
+			       (uintptr_t)vma + size - (uintptr_t)shdr->sh_addr,
 			       (const uint8_t *)region_addr + s_offset, shdr->sh_size);
 		if (ret < 0)
 			return ret;
@@ -170,9 +194,7 @@ static int llext_manager_load_data_from_storage(const struct sys_mm_drv_region *
 
 static void llext_manager_unmap_detached_sections(const struct llext_loader *ldr,
 						  const struct llext *ext,
-						  enum llext_mem region,
-						  void __sparse_cache *vma,
-						  size_t size)
+						  enum llext_mem region)
 {
 #ifdef CONFIG_MMU
 	unsigned int i;
@@ -191,9 +213,8 @@ static void llext_manager_unmap_detached_sections(const struct llext_loader *ldr
 		if (s_region != region)
 			continue;
 
-		/* unmap detached sections (will be outside requested VMA area) */
-		if ((uintptr_t)shdr->sh_addr < (uintptr_t)vma ||
-		    (uintptr_t)shdr->sh_addr >= (uintptr_t)vma + size)
+		/* unmap detached sections */
+		if (llext_manager_section_detached(shdr))
 			llext_manager_detached_update_flags((__sparse_force void *)
 							    ((uint8_t *)region_addr + s_offset),
 							    shdr->sh_size, 0);
@@ -208,12 +229,61 @@ static int llext_manager_rm_mod_domain(struct lib_manager_module *mctx,
 				       struct k_mem_domain *domain);
 #endif
 
+/* find dedicated virtual memory zone */
+static const struct sys_mm_drv_region *llext_manager_virtual_region(void)
+{
+	const struct sys_mm_drv_region *virtual_memory_regions = sys_mm_drv_query_memory_regions();
+	const struct sys_mm_drv_region *virtual_region;
+
+	if (!virtual_memory_regions)
+		return NULL;
+
+	SYS_MM_DRV_MEMORY_REGION_FOREACH(virtual_memory_regions, virtual_region) {
+		if (virtual_region->attr == VIRTUAL_REGION_LLEXT_LIBRARIES_ATTR)
+			break;
+	}
+
+	return virtual_region->size ? virtual_region : NULL;
+}
+
+/*
+ * Copy .lazy code of a mapped module to SRAM. It is linked at the end of .text
+ * but only used once the module is prepared, so until then it doesn't occupy
+ * any SRAM.
+ */
+static int llext_manager_load_lazy(struct lib_manager_module *mctx)
+{
+	void __sparse_cache *va_base_lazy = (void __sparse_cache *)
+		mctx->segment[LIB_MANAGER_LAZY].addr;
+	size_t lazy_size = mctx->segment[LIB_MANAGER_LAZY].size;
+	const struct sys_mm_drv_region *virtual_region = llext_manager_virtual_region();
+	int ret;
+
+	if (!virtual_region)
+		return -EFAULT;
+
+	ret = llext_manager_load_data_from_storage(virtual_region, &mctx->ebl->loader,
+						   mctx->llext, LLEXT_MEM_TEXT, va_base_lazy,
+						   lazy_size, SYS_MM_MEM_PERM_EXEC, false);
+	if (ret < 0)
+		return ret;
+
+	mctx->lazy_mapped = true;
+	mctx->resident_size += llext_manager_map_size(va_base_lazy, lazy_size);
+
+	tr_info(&lib_manager_tr, "%s: .lazy %#zx loaded, resident %#zx",
+		mctx->llext->name, lazy_size, mctx->resident_size);
+
+	return 0;
+}
+
 static int llext_manager_load_module(struct lib_manager_module *mctx)
 {
-	/* Executable code (.text) */
+	/* Executable code (.text) without .lazy code at its end */
 	void __sparse_cache *va_base_text = (void __sparse_cache *)
 		mctx->segment[LIB_MANAGER_TEXT].addr;
-	size_t text_size = mctx->segment[LIB_MANAGER_TEXT].size;
+	size_t text_size = mctx->segment[LIB_MANAGER_TEXT].size -
+		mctx->segment[LIB_MANAGER_LAZY].size;
 
 	/* Read-only data (.rodata and others) */
 	void __sparse_cache *va_base_rodata = (void __sparse_cache *)
@@ -259,31 +329,21 @@ static int llext_manager_load_module(struct lib_manager_module *mctx)
 
 	const struct llext_loader *ldr = &mctx->ebl->loader;
 	const struct llext *ext = mctx->llext;
+	const struct sys_mm_drv_region *virtual_region = llext_manager_virtual_region();
 
-	/* find dedicated virtual memory zone */
-	const struct sys_mm_drv_region *virtual_memory_regions = sys_mm_drv_query_memory_regions();
-	const struct sys_mm_drv_region *virtual_region;
-
-	if (!virtual_memory_regions)
-		return -EFAULT;
-
-	SYS_MM_DRV_MEMORY_REGION_FOREACH(virtual_memory_regions, virtual_region) {
-		if (virtual_region->attr == VIRTUAL_REGION_LLEXT_LIBRARIES_ATTR)
-			break;
-	}
-
-	if (!virtual_region->size)
+	if (!virtual_region)
 		return -EFAULT;
 
 	/* Copy Code */
 	ret = llext_manager_load_data_from_storage(virtual_region, ldr, ext, LLEXT_MEM_TEXT,
-						   va_base_text, text_size, SYS_MM_MEM_PERM_EXEC);
+						   va_base_text, text_size, SYS_MM_MEM_PERM_EXEC,
+						   true);
 	if (ret < 0)
 		return ret;
 
 	/* Copy read-only data */
 	ret = llext_manager_load_data_from_storage(virtual_region, ldr, ext, LLEXT_MEM_RODATA,
-						   va_base_rodata, rodata_size, 0);
+						   va_base_rodata, rodata_size, 0, true);
 	if (ret < 0)
 		goto e_text;
 
@@ -294,29 +354,53 @@ static int llext_manager_load_module(struct lib_manager_module *mctx)
 	 *       both, but only LLEXT_MEM_DATA sections will be copied.
 	 */
 	ret = llext_manager_load_data_from_storage(virtual_region, ldr, ext, LLEXT_MEM_DATA,
-						   va_base_data, data_size, SYS_MM_MEM_PERM_RW);
+						   va_base_data, data_size, SYS_MM_MEM_PERM_RW, true);
 	if (ret < 0)
 		goto e_rodata;
 
+	mctx->resident_size = llext_manager_map_size(va_base_text, text_size) +
+		llext_manager_map_size(va_base_rodata, rodata_size) +
+		llext_manager_map_size(va_base_data, data_size);
+
+	/*
+	 * Memory domain partitions cover the whole .text, so with user space
+	 * support .lazy code cannot be left unmapped
+	 */
+	if (IS_ENABLED(CONFIG_USERSPACE) && mctx->segment[LIB_MANAGER_LAZY].size) {
+		ret = llext_manager_load_lazy(mctx);
+		if (ret < 0)
+			goto e_data;
+	}
+
 	memset((__sparse_force void *)bss_addr, 0, bss_size);
 	mctx->mapped = true;
 
+	tr_dbg(&lib_manager_tr, "%s: resident %#zx", ext->name, mctx->resident_size);
+
 #ifdef CONFIG_SOF_USERSPACE_LL
 	if (!mctx->domain_dp) {
 		ret = llext_manager_add_mod_domain(mctx, zephyr_ll_mem_domain());
 		if (ret < 0) {
 			tr_err(&lib_manager_tr, "failed to add domain: %d", ret);
-			goto e_data;
+			goto e_lazy;
 		}
 	}
 #endif
 
 	return 0;
 #ifdef CONFIG_SOF_USERSPACE_LL
+e_lazy:
+	mctx->mapped = false;
+	if (mctx->lazy_mapped) {
+		llext_manager_align_unmap((void __sparse_cache *)mctx->segment[LIB_MANAGER_LAZY].addr,
+					  mctx->segment[LIB_MANAGER_LAZY].size);
+		mctx->lazy_mapped = false;
+	}
+#endif
 e_data:
+	mctx->resident_size = 0;
 	if (data_size)
 		llext_manager_align_unmap(va_base_data, data_size);
-#endif
 e_rodata:
 	if (rodata_size)
 		llext_manager_align_unmap(va_base_rodata, rodata_size);
@@ -331,10 +415,11 @@ static int llext_manager_unload_module(struct lib_manager_module *mctx)
 	const struct llext_loader *ldr = &mctx->ebl->loader;
 	const struct llext *ext = mctx->llext;
 
-	/* Executable code (.text) */
+	/* Executable code (.text) without .lazy code at its end */
 	void __sparse_cache *va_base_text = (void __sparse_cache *)
 		mctx->segment[LIB_MANAGER_TEXT].addr;
-	size_t text_size = mctx->segment[LIB_MANAGER_TEXT].size;
+	size_t text_size = mctx->segment[LIB_MANAGER_TEXT].size -
+		mctx->segment[LIB_MANAGER_LAZY].size;
 
 	/* Read-only data (.rodata, etc.) */
 	void __sparse_cache *va_base_rodata = (void __sparse_cache *)
@@ -350,31 +435,38 @@ static int llext_manager_unload_module(struct lib_manager_module *mctx)
 		mctx->segment[LIB_MANAGER_BSS].size;
 	int err = 0, ret;
 
-	llext_manager_unmap_detached_sections(ldr, ext, LLEXT_MEM_TEXT,
-					      va_base_text, text_size);
+	llext_manager_unmap_detached_sections(ldr, ext, LLEXT_MEM_TEXT);
 	ret = llext_manager_align_unmap(va_base_text, text_size);
 	if (ret < 0)
 		err = ret;
 
+	if (mctx->lazy_mapped) {
+		ret = llext_manager_align_unmap((void __sparse_cache *)
+						mctx->segment[LIB_MANAGER_LAZY].addr,
+						mctx->segment[LIB_MANAGER_LAZY].size);
+		if (ret < 0 && !err)
+			err = ret;
+		mctx->lazy_mapped = false;
+	}
+
 	/* Mimic the logic from load_module where the .bss address is used for mapping
 	 * in case of e.g. lack of writable .data section
 	 */
 	if (!va_base_data)
 		va_base_data = va_base_bss;
 
-	llext_manager_unmap_detached_sections(ldr, ext, LLEXT_MEM_DATA,
-					      va_base_data, data_size);
+	llext_manager_unmap_detached_sections(ldr, ext, LLEXT_MEM_DATA);
 	ret = llext_manager_align_unmap(va_base_data, data_size);
 	if (ret < 0 && !err)
 		err = ret;
 
-	llext_manager_unmap_detached_sections(ldr, ext, LLEXT_MEM_RODATA,
-					      va_base_rodata, rodata_size);
+	llext_manager_unmap_detached_sections(ldr, ext, LLEXT_MEM_RODATA);
 	ret = llext_manager_align_unmap(va_base_rodata, rodata_size);
 	if (ret < 0 && !err)
 		err = ret;
 
 	mctx->mapped = false;
+	mctx->resident_size = 0;
 
 #ifdef CONFIG_SOF_USERSPACE_LL
 	if (!mctx->domain_dp)
@@ -384,9 +476,37 @@ static int llext_manager_unload_module(struct lib_manager_module *mctx)
 	return err;
 }
 
-static bool llext_manager_section_detached(const elf_shdr_t *shdr)
+static int llext_manager_lazy_init(struct llext_loader *ldr, struct llext *ext,
+				   struct lib_manager_module *mctx)
 {
-	return shdr->sh_addr < SOF_MODULE_DRAM_LINK_END;
+	static const char * const lazy_name[] = {".lazy", ".lazy.literal"};
+	uintptr_t text_addr = mctx->segment[LIB_MANAGER_TEXT].addr;
+	uintptr_t text_end = text_addr + mctx->segment[LIB_MANAGER_TEXT].size;
+	uintptr_t lazy_addr = text_end;
+	elf_shdr_t shdr;
+	unsigned int i;
+
+	for (i = 0; i < ARRAY_SIZE(lazy_name); i++)
+		if (!llext_get_section_header(ldr, ext, lazy_name[i], &shdr) &&
+		    shdr.sh_size && !llext_manager_section_detached(&shdr))
+			lazy_addr = MIN(lazy_addr, (uintptr_t)shdr.sh_addr);
+
+	/* .lazy code must be in its own pages after hot code */
+	if (lazy_addr < text_end &&
+	    (lazy_addr <= text_addr || lazy_addr & (PAGE_SZ - 1))) {
+		tr_err(&lib_manager_tr, ".lazy @%#lx not page aligned after .text @%#lx",
+		       lazy_addr, text_addr);
+		return -ENOEXEC;
+	}
+
+	mctx->segment[LIB_MANAGER_LAZY].addr = lazy_addr < text_end ? lazy_addr : 0;
+	mctx->segment[LIB_MANAGER_LAZY].size = text_end - lazy_addr;
+
+	tr_dbg(&lib_manager_tr, ".lazy: start: %#lx size %#x",
+	       mctx->segment[LIB_MANAGER_LAZY].addr,
+	       mctx->segment[LIB_MANAGER_LAZY].size);
+
+	return 0;
 }
 
 static int llext_manager_link(const char *name,
@@ -436,6 +556,11 @@ static int llext_manager_link(const char *name,
 	       mctx->segment[LIB_MANAGER_TEXT].addr,
 	       mctx->segment[LIB_MANAGER_TEXT].size);
 
+	/* Code only used after prepare(), placed by the linker at the end of .text */
+	ret = llext_manager_lazy_init(ldr, *llext, mctx);
+	if (ret < 0)
+		return ret;
+
 	/* All read-only data sections */
 	llext_get_region_info(ldr, *llext, LLEXT_MEM_RODATA, &hdr, NULL, NULL);
 	mctx->segment[LIB_MANAGER_RODATA].addr = hdr->sh_addr;
@@ -524,6 +649,8 @@ static int llext_manager_mod_init(struct lib_manager_mod_ctx *ctx,
 		if (mod_array[i].segment[LIB_MANAGER_TEXT].file_offset != offs) {
 			offs = mod_array[i].segment[LIB_MANAGER_TEXT].file_offset;
 			ctx->mod[n_mod].mapped = false;
+			ctx->mod[n_mod].lazy_mapped = false;
+			ctx->mod[n_mod].resident_size = 0;
 			ctx->mod[n_mod].domain_dp = false;
 			ctx->mod[n_mod].llext = NULL;
 			ctx->mod[n_mod].ebl = NULL;
@@ -1134,6 +1261,50 @@ int llext_manager_free_module(const uint32_t component_id)
 	return llext_manager_unload_module(mctx);
 }
 
+static int llext_manager_prefetch_mod(struct lib_manager_module *mctx)
+{
+	if (!mctx->mapped || mctx->lazy_mapped || !mctx->segment[LIB_MANAGER_LAZY].size)
+		return 0;
+
+	return llext_manager_load_lazy(mctx);
+}
+
+int llext_manager_prefetch(const uint32_t component_id)
+{
+	const uint32_t module_id = IPC4_MOD_ID(component_id);
+	struct lib_manager_mod_ctx *ctx = lib_manager_get_mod_ctx(module_id);
+	const uint32_t entry_index = LIB_MANAGER_GET_MODULE_INDEX(module_id);
+
+	if (!ctx || !ctx->mod)
+		return -ENOENT;
+
+	const int mod_idx = llext_manager_mod_find(ctx, entry_index);
+
+	if (mod_idx < 0)
+		return mod_idx;
+
+	struct lib_manager_module *mctx = ctx->mod + mod_idx;
+	int i, ret;
+
+	/* Protected by IPC serialization, dependencies first */
+	for (i = 0; i < ARRAY_SIZE(mctx->llext->dependency); i++) {
+		struct lib_manager_module *dep;
+
+		if (!mctx->llext->dependency[i])
+			break;
+
+		if (llext_lib_find(mctx->llext->dependency[i], &dep) < 0)
+			continue;
+
+		ret = llext_manager_prefetch_mod(dep);
+		if (ret < 0)
+			return ret;
+	}
+
+	return llext_manager_prefetch_mod(mctx);
+}
+EXPORT_SYMBOL(llext_manager_prefetch);
+
 /* An auxiliary library has been loaded, need to read in its exported symbols */
 int llext_manager_add_library(uint32_t module_id)
 {
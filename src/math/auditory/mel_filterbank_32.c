@@ -14,73 +14,89 @@
 void psy_apply_mel_filterbank_32(struct psy_mel_filterbank *fb, struct icomplex32 *fft_out,
 				 int32_t *power_spectra, int32_t *mel_log, int bitshift)
 {
-	int64_t pmax;
+	uint64_t power;
 	int64_t p;
 	int32_t log_arg;
+	int32_t log_offs;
 	int32_t log;
+	int32_t mag = 0;
+	int32_t re;
+	int32_t im;
+	int power_bins = 0;
 	int next_idx;
 	int start_bin;
+	int end_bin;
 	int num_bins;
 	int coef_idx;
 	int i, j;
 	int base_idx = 0;
 	int lshift;
 
-	/* A FFT out bin is used several times in Mel bands conversion, so first
-	 * convert FFT to real power spectra, p = (a + bi)(a - bi) = a^2 + b^2
+	/* Find the common headroom of FFT output from OR of one's complement
+	 * absolute values. The power a^2 + b^2 then fits Q2.62 with a left shift
+	 * of twice the headroom, except when a and b are both the negative power
+	 * of two -2^(31 - n) and the shifted power reaches 2^63, so it is kept
+	 * unsigned and saturated after the conversion. Limit to 31 as with a
+	 * 32-bit norm of the power.
 	 */
-	pmax = 0;
 	for (i = 0; i < fb->half_fft_bins; i++) {
-		p = (int64_t)fft_out[i].real * fft_out[i].real +
-			(int64_t)fft_out[i].imag * fft_out[i].imag;
-		pmax = MAX(pmax, p);
+		re = fft_out[i].real;
+		im = fft_out[i].imag;
+		mag |= (re ^ (re >> 31)) | (im ^ (im >> 31));
 	}
 
-	/* Product Q2.62, convert to 2.30 */
-	pmax = sat_int32(pmax >> 32);
-	lshift = norm_int32(pmax);
-	for (i = 0; i < fb->half_fft_bins; i++) {
-		p = (int64_t)fft_out[i].real * fft_out[i].real +
-			(int64_t)fft_out[i].imag * fft_out[i].imag;
-		power_spectra[i] = Q_SHIFT_RND(p << lshift, 62, 30);
-	}
+	lshift = MIN(2 * norm_int32(mag), 31);
 
 	for (i = 0; i < fb->mel_bins; i++) {
-		/* Integrate power spectrum with Mel filter bank triangle weights */
-		p = 0;
 		next_idx = fb->data[base_idx];
 		start_bin = fb->data[base_idx + 1];
 		num_bins = fb->data[base_idx + 2];
 		coef_idx = base_idx + 3;
 		base_idx = next_idx; /* For next round */
 
-		/* Accumulate power as Q3.45 (Q2.30 x Q1.15). Note that filter bank need
+		/* A FFT out bin is used by two adjacent Mel bands, so convert it to
+		 * real power spectra, p = (a + bi)(a - bi) = a^2 + b^2, only when the
+		 * first band needs it. The product Q2.62 is converted to Q2.30.
+		 */
+		end_bin = start_bin + num_bins;
+		for (; power_bins < end_bin; power_bins++) {
+			power = (uint64_t)((int64_t)fft_out[power_bins].real *
+					   fft_out[power_bins].real) +
+				(uint64_t)((int64_t)fft_out[power_bins].imag *
+					   fft_out[power_bins].imag);
+			power <<= lshift;
+			power_spectra[power_bins] = sat_int32(Q_SHIFT_RND(power, 62, 30));
+		}
+
+		/* Integrate power spectrum with Mel filter bank triangle weights.
+		 * Accumulate power as Q3.45 (Q2.30 x Q1.15). Note that filter bank need
 		 * to be later scaled with fb->scale.
 		 */
+		p = 0;
 		for (j = 0; j < num_bins; j++)
 			p += (int64_t)power_spectra[start_bin + j] * fb->data[coef_idx + j];
 
 		/* Convert Mel band energy from Q19.45 to Q7.25 that has sufficient headroom
-		 * for worst-case all ones FFT output. Log2() function input is unsigned Q32.0,
-		 * output is signed Q16.16. The Q7.25 scale log2(2^25) need to be subtracted
-		 * from log output.
+		 * for worst-case all ones FFT output. Log2() function input is unsigned Q32.0.
+		 * The arguments are kept in mel_log for the logarithm pass.
 		 */
 		log_arg = sat_int32(Q_SHIFT_RND(p, 45, 25));
-		log_arg = MAX(log_arg, AUDITORY_EPS_Q31);
-		log = base2_logarithm((uint32_t)log_arg);
-		log -= AUDITORY_LOG2_2P25_Q16;
-
-		/* Compensate Mel triangles scale */
-		log += fb->scale_log2;
+		mel_log[i] = MAX(log_arg, AUDITORY_EPS_Q31);
+	}
 
-		/* Subtract the applied lshift for power spectra
-		 * log2(x * 2^(-n)) = log2(x) - n. Note that the bitshift need to be subtracted
-		 * as doubled because it was applied in linear domain, from log(x * 2^(-2 * n))
-		 */
-		log -= ((int32_t)lshift + 2 * bitshift) << 16;
+	/* Log2() output is signed Q16.16. The Q7.25 scale log2(2^25) need to be
+	 * subtracted from log output and the Mel triangles scale compensated.
+	 * Subtract also the applied lshift for power spectra
+	 * log2(x * 2^(-n)) = log2(x) - n. Note that the bitshift need to be subtracted
+	 * as doubled because it was applied in linear domain, from log(x * 2^(-2 * n)).
+	 * The offset is the same for all bands.
+	 */
+	log_offs = fb->scale_log2 - AUDITORY_LOG2_2P25_Q16 -
+		   (((int32_t)lshift + 2 * bitshift) << 16);
+	for (i = 0; i < fb->mel_bins; i++) {
+		log = base2_logarithm((uint32_t)mel_log[i]) + log_offs;
 
 		/* Scale for desired log, output as Q9.23 */
-		log = Q_MULTSR_32X32((int64_t)log, fb->log_mult, 16, 29, 23);
-		mel_log[i] = log; /* Q9.23 */
+		mel_log[i] = Q_MULTSR_32X32((int64_t)log, fb->log_mult, 16, 29, 23);
 	}
 }
@@ -0,0 +1,515 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+/*
+ * Channel mixing with a Q6.10 coefficient matrix. The matrix is classified
+ * when it is configured: channel selection, swap and duplication are picks
+ * that only move samples, typical downmixes are sparse and only their
+ * non-zero coefficients are applied. Only the remaining matrices use the
+ * full multiply of every source channel for every sink channel.
+ */
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/format.h>
+#include <sof/math/chmatrix.h>
+#include <sof/common.h>
+#include <rtos/string.h>
+#include <rtos/symbol.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Q6.10 accumulator to sample with rounding */
+#define CHMATRIX_Q10_ROUND(acc)	(((acc) + (1 << 9)) >> 10)
+
+static void chmatrix_copy(const struct sofm_chmatrix *m, const void *src, void *dst,
+			  size_t frames)
+{
+	size_t bytes = frames * m->src_stride * m->sample_bytes;
+
+	memcpy_s(dst, bytes, src, bytes);
+}
+
+static void chmatrix_pick_s16(const struct sofm_chmatrix *m, const void *src, void *dst,
+			      size_t frames)
+{
+	const int16_t *x = src;
+	int16_t *y = dst;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	size_t i;
+	int ch;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++)
+			y[ch] = x[m->pick.src[ch]] & m->pick.mask[ch];
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+static void chmatrix_pick_s32(const struct sofm_chmatrix *m, const void *src, void *dst,
+			      size_t frames)
+{
+	const int32_t *x = src;
+	int32_t *y = dst;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	size_t i;
+	int ch;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++)
+			y[ch] = x[m->pick.src[ch]] & m->pick.mask[ch];
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+static void chmatrix_pick_s24(const struct sofm_chmatrix *m, const void *src, void *dst,
+			      size_t frames)
+{
+	const int32_t *x = src;
+	int32_t *y = dst;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	size_t i;
+	int ch;
+
+	/* unit gain is applied with saturation like the other coefficients */
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++)
+			y[ch] = sat_int24(x[m->pick.src[ch]]) & m->pick.mask[ch];
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+static void chmatrix_sparse_s16(const struct sofm_chmatrix *m, const void *src, void *dst,
+				size_t frames)
+{
+	const struct sofm_chmatrix_tap *tap;
+	const int16_t *x = src;
+	int16_t *y = dst;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	int32_t acc;
+	size_t i;
+	int ch, k;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++) {
+			tap = m->sparse.taps[ch];
+			acc = 0;
+			for (k = 0; k < m->sparse.num_taps[ch]; k++)
+				acc += (int32_t)x[tap[k].src] * tap[k].coeff;
+
+			y[ch] = sat_int16(CHMATRIX_Q10_ROUND(acc));
+		}
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+static void chmatrix_sparse_s24(const struct sofm_chmatrix *m, const void *src, void *dst,
+				size_t frames)
+{
+	const struct sofm_chmatrix_tap *tap;
+	const int32_t *x = src;
+	int32_t *y = dst;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	int64_t acc;
+	size_t i;
+	int ch, k;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++) {
+			tap = m->sparse.taps[ch];
+			acc = 0;
+			for (k = 0; k < m->sparse.num_taps[ch]; k++)
+				acc += (int64_t)x[tap[k].src] * tap[k].coeff;
+
+			y[ch] = sat_int24(CHMATRIX_Q10_ROUND(acc));
+		}
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+static void chmatrix_sparse_s32(const struct sofm_chmatrix *m, const void *src, void *dst,
+				size_t frames)
+{
+	const struct sofm_chmatrix_tap *tap;
+	const int32_t *x = src;
+	int32_t *y = dst;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	int64_t acc;
+	size_t i;
+	int ch, k;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++) {
+			tap = m->sparse.taps[ch];
+			acc = 0;
+			for (k = 0; k < m->sparse.num_taps[ch]; k++)
+				acc += (int64_t)x[tap[k].src] * tap[k].coeff;
+
+			y[ch] = sat_int32(CHMATRIX_Q10_ROUND(acc));
+		}
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+static void chmatrix_dense_s16(const struct sofm_chmatrix *m, const void *src, void *dst,
+			       size_t frames)
+{
+	const int16_t *x = src;
+	int16_t *y = dst;
+	const int src_channels = m->src_channels;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	int32_t acc;
+	size_t i;
+	int ch, j;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++) {
+			acc = 0;
+			for (j = 0; j < src_channels; j++)
+				acc += (int32_t)x[j] * m->coeffs[ch][j];
+
+			y[ch] = sat_int16(CHMATRIX_Q10_ROUND(acc));
+		}
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+static void chmatrix_dense_s24(const struct sofm_chmatrix *m, const void *src, void *dst,
+			       size_t frames)
+{
+	const int32_t *x = src;
+	int32_t *y = dst;
+	const int src_channels = m->src_channels;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	int64_t acc;
+	size_t i;
+	int ch, j;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++) {
+			acc = 0;
+			for (j = 0; j < src_channels; j++)
+				acc += (int64_t)x[j] * m->coeffs[ch][j];
+
+			y[ch] = sat_int24(CHMATRIX_Q10_ROUND(acc));
+		}
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+static void chmatrix_dense_s32(const struct sofm_chmatrix *m, const void *src, void *dst,
+			       size_t frames)
+{
+	const int32_t *x = src;
+	int32_t *y = dst;
+	const int src_channels = m->src_channels;
+	const int dst_channels = m->dst_channels;
+	const int src_stride = m->src_stride;
+	const int dst_stride = m->dst_stride;
+	int64_t acc;
+	size_t i;
+	int ch, j;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < dst_channels; ch++) {
+			acc = 0;
+			for (j = 0; j < src_channels; j++)
+				acc += (int64_t)x[j] * m->coeffs[ch][j];
+
+			y[ch] = sat_int32(CHMATRIX_Q10_ROUND(acc));
+		}
+
+		x += src_stride;
+		y += dst_stride;
+	}
+}
+
+struct chmatrix_kernels {
+	enum sof_ipc_frame frame_fmt;
+	uint8_t sample_bytes;
+	sofm_chmatrix_func pick;
+	sofm_chmatrix_func sparse;
+	sofm_chmatrix_func dense;
+};
+
+/*
+ * Only portable C kernels so far. HiFi pick and sparse kernels would be
+ * selected here per format, until they exist the HiFi3 builds of
+ * up_down_mixer keep their hand-written routines.
+ */
+static const struct chmatrix_kernels chmatrix_kernels[] = {
+	{ SOF_IPC_FRAME_S16_LE, sizeof(int16_t), chmatrix_pick_s16, chmatrix_sparse_s16,
+	  chmatrix_dense_s16 },
+	{ SOF_IPC_FRAME_S24_4LE, sizeof(int32_t), chmatrix_pick_s24, chmatrix_sparse_s24,
+	  chmatrix_dense_s24 },
+	{ SOF_IPC_FRAME_S32_LE, sizeof(int32_t), chmatrix_pick_s32, chmatrix_sparse_s32,
+	  chmatrix_dense_s32 },
+};
+
+static const struct chmatrix_kernels *chmatrix_find_kernels(enum sof_ipc_frame frame_fmt)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(chmatrix_kernels); i++)
+		if (chmatrix_kernels[i].frame_fmt == frame_fmt)
+			return &chmatrix_kernels[i];
+
+	return NULL;
+}
+
+static int chmatrix_init(struct sofm_chmatrix *m, const struct chmatrix_kernels *kernels,
+			 int dst_channels, int src_channels)
+{
+	if (!kernels || dst_channels < 1 || dst_channels > SOFM_CHMATRIX_CHANNELS_MAX ||
+	    src_channels < 1 || src_channels > SOFM_CHMATRIX_CHANNELS_MAX)
+		return -EINVAL;
+
+	m->dst_channels = dst_channels;
+	m->src_channels = src_channels;
+	m->dst_stride = dst_channels;
+	m->src_stride = src_channels;
+	m->sample_bytes = kernels->sample_bytes;
+	m->kernels = kernels;
+	return 0;
+}
+
+/* selects the pick kernel, or the copy if the pick is the identity */
+static void chmatrix_set_pick(struct sofm_chmatrix *m, const struct chmatrix_kernels *kernels)
+{
+	int ch;
+
+	m->type = SOFM_CHMATRIX_PICK;
+	m->func = kernels->pick;
+
+	if (m->src_channels != m->dst_channels)
+		return;
+
+	for (ch = 0; ch < m->dst_channels; ch++)
+		if (m->pick.src[ch] != ch || !m->pick.mask[ch])
+			return;
+
+	m->type = SOFM_CHMATRIX_COPY;
+	m->func = chmatrix_copy;
+}
+
+int sofm_chmatrix_init_q10(struct sofm_chmatrix *m, enum sof_ipc_frame frame_fmt,
+			   const int16_t *coeffs, size_t row_stride,
+			   int dst_channels, int src_channels)
+{
+	const struct chmatrix_kernels *kernels = chmatrix_find_kernels(frame_fmt);
+	const int16_t *row;
+	bool pick = true;
+	int nonzero = 0;
+	int ch, j, n;
+	int ret;
+
+	ret = chmatrix_init(m, kernels, dst_channels, src_channels);
+	if (ret)
+		return ret;
+
+	for (ch = 0; ch < dst_channels; ch++) {
+		row = coeffs + ch * row_stride;
+		m->pick.src[ch] = 0;
+		m->pick.mask[ch] = 0;
+		n = 0;
+		for (j = 0; j < src_channels; j++) {
+			if (!row[j])
+				continue;
+
+			n++;
+			m->pick.src[ch] = j;
+			m->pick.mask[ch] = -1;
+			if (row[j] != SOFM_CHMATRIX_ONE_Q10)
+				pick = false;
+		}
+
+		if (n > 1)
+			pick = false;
+		nonzero += n;
+	}
+
+	if (pick) {
+		chmatrix_set_pick(m, kernels);
+		return 0;
+	}
+
+	if (2 * nonzero <= dst_channels * src_channels) {
+		m->type = SOFM_CHMATRIX_SPARSE;
+		m->func = kernels->sparse;
+		for (ch = 0; ch < dst_channels; ch++) {
+			row = coeffs + ch * row_stride;
+			n = 0;
+			for (j = 0; j < src_channels; j++) {
+				if (!row[j])
+					continue;
+
+				m->sparse.taps[ch][n].coeff = row[j];
+				m->sparse.taps[ch][n].src = j;
+				n++;
+			}
+			m->sparse.num_taps[ch] = n;
+		}
+
+		return 0;
+	}
+
+	m->type = SOFM_CHMATRIX_DENSE;
+	m->func = kernels->dense;
+	for (ch = 0; ch < dst_channels; ch++)
+		for (j = 0; j < src_channels; j++)
+			m->coeffs[ch][j] = coeffs[ch * row_stride + j];
+
+	return 0;
+}
+EXPORT_SYMBOL(sofm_chmatrix_init_q10);
+
+int sofm_chmatrix_init_chmap(struct sofm_chmatrix *m, enum sof_ipc_frame frame_fmt,
+			     uint32_t chmap, int dst_channels, int src_channels)
+{
+	const struct chmatrix_kernels *kernels = chmatrix_find_kernels(frame_fmt);
+	uint32_t src;
+	int ch;
+	int ret;
+
+	ret = chmatrix_init(m, kernels, dst_channels, src_channels);
+	if (ret)
+		return ret;
+
+	for (ch = 0; ch < dst_channels; ch++) {
+		src = chmap & 0xf;
+		chmap >>= 4;
+
+		/* 0xf means "mute"; also mute any out-of-range source channel */
+		if (src == SOFM_CHMATRIX_CHMAP_MUTE || src >= src_channels) {
+			m->pick.src[ch] = 0;
+			m->pick.mask[ch] = 0;
+		} else {
+			m->pick.src[ch] = src;
+			m->pick.mask[ch] = -1;
+		}
+	}
+
+	chmatrix_set_pick(m, kernels);
+	return 0;
+}
+EXPORT_SYMBOL(sofm_chmatrix_init_chmap);
+
+int sofm_chmatrix_set_frame_channels(struct sofm_chmatrix *m, int src_frame_channels,
+				     int dst_frame_channels)
+{
+	if (src_frame_channels < m->src_channels || src_frame_channels > UINT16_MAX ||
+	    dst_frame_channels < m->dst_channels || dst_frame_channels > UINT16_MAX)
+		return -EINVAL;
+
+	m->src_stride = src_frame_channels;
+	m->dst_stride = dst_frame_channels;
+
+	/* frames with channels outside of the matrix are not a plain copy */
+	if (m->type == SOFM_CHMATRIX_COPY &&
+	    (m->src_stride != m->src_channels || m->dst_stride != m->dst_channels)) {
+		m->type = SOFM_CHMATRIX_PICK;
+		m->func = m->kernels->pick;
+	}
+
+	return 0;
+}
+EXPORT_SYMBOL(sofm_chmatrix_set_frame_channels);
+
+/* A frame split by the wrap of the source or the sink buffer goes through linear copies.
+ * Only the channels of the matrix are copied, the other sink channels are left as they are.
+ */
+static void chmatrix_split_frame(const struct sofm_chmatrix *m,
+				 const struct cir_buf_source *source, const uint8_t **src,
+				 struct cir_buf_sink *sink, uint8_t **dst)
+{
+	int32_t in[SOFM_CHMATRIX_CHANNELS_MAX];
+	int32_t out[SOFM_CHMATRIX_CHANNELS_MAX];
+	const size_t src_bytes = m->src_channels * m->sample_bytes;
+	const size_t dst_bytes = m->dst_channels * m->sample_bytes;
+	const uint8_t *x = *src;
+	uint8_t *y = *dst;
+	uint8_t *in_bytes = (uint8_t *)in;
+	uint8_t *out_bytes = (uint8_t *)out;
+	size_t i;
+
+	for (i = 0; i < src_bytes; i++) {
+		x = cir_buf_wrap(x, source->buf_start, source->buf_end);
+		in_bytes[i] = *x++;
+	}
+
+	m->func(m, in, out, 1);
+
+	for (i = 0; i < dst_bytes; i++) {
+		y = cir_buf_wrap(y, sink->buf_start, sink->buf_end);
+		*y++ = out_bytes[i];
+	}
+
+	x += (m->src_stride - m->src_channels) * m->sample_bytes;
+	y += (m->dst_stride - m->dst_channels) * m->sample_bytes;
+	*src = x;
+	*dst = y;
+}
+
+void sofm_chmatrix_process(const struct sofm_chmatrix *m, const struct cir_buf_source *source,
+			   struct cir_buf_sink *sink, size_t frames)
+{
+	const size_t src_frame_bytes = m->src_stride * m->sample_bytes;
+	const size_t dst_frame_bytes = m->dst_stride * m->sample_bytes;
+	const uint8_t *src = source->ptr;
+	uint8_t *dst = sink->ptr;
+	size_t n, nmax;
+
+	while (frames) {
+		src = cir_buf_wrap(src, source->buf_start, source->buf_end);
+		dst = cir_buf_wrap(dst, sink->buf_start, sink->buf_end);
+		n = frames;
+		nmax = cir_buf_bytes_without_wrap(src, source->buf_end) / src_frame_bytes;
+		n = MIN(n, nmax);
+		nmax = cir_buf_bytes_without_wrap(dst, sink->buf_end) / dst_frame_bytes;
+		n = MIN(n, nmax);
+		if (!n) {
+			chmatrix_split_frame(m, source, &src, sink, &dst);
+			frames--;
+			continue;
+		}
+
+		m->func(m, src, dst, n);
+		src += n * src_frame_bytes;
+		dst += n * dst_frame_bytes;
+		frames -= n;
+	}
+}
+EXPORT_SYMBOL(sofm_chmatrix_process);
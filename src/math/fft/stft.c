@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <sof/audio/format.h>
+#include <sof/math/fft.h>
+#include <sof/math/icomplex32.h>
+#include <sof/math/stft.h>
+#include <sof/math/window.h>
+#include <sof/common.h>
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+void sofm_stft_buffer_init(struct sofm_stft_buffer *buf, int32_t *base, int size)
+{
+	buf->addr = base;
+	buf->end_addr = base + size;
+	buf->r_ptr = base;
+	buf->w_ptr = base;
+	buf->s_free = size;
+	buf->s_avail = 0;
+	buf->s_length = size;
+}
+
+void sofm_stft_fill_prev_samples(struct sofm_stft_buffer *buf, int32_t *prev_data,
+				 int prev_data_length)
+{
+	int32_t *r = buf->r_ptr;
+	int32_t *p = prev_data;
+	int copied;
+	int nmax;
+	int n;
+
+	for (copied = 0; copied < prev_data_length; copied += n) {
+		nmax = prev_data_length - copied;
+		n = sofm_stft_buffer_samples_without_wrap(buf, r);
+		n = MIN(n, nmax);
+		memcpy(p, r, sizeof(int32_t) * n);
+		p += n;
+		r += n;
+		r = sofm_stft_buffer_wrap(buf, r);
+	}
+
+	buf->s_avail -= copied;
+	buf->s_free += copied;
+	buf->r_ptr = r;
+}
+
+void sofm_stft_fill_fft_buffer(struct sofm_stft_buffer *ibuf, int32_t *prev_data,
+			       int prev_data_size, struct icomplex32 *fft_buf, int fft_hop_size)
+{
+	struct icomplex32 *fft_buf_ptr = fft_buf;
+	int32_t *r = ibuf->r_ptr;
+	int samples_remain = fft_hop_size;
+	int j;
+	int n;
+
+	/* Copy overlapped samples from state buffer. Imaginary part of input
+	 * remains zero.
+	 */
+	for (j = 0; j < prev_data_size; j++) {
+		fft_buf_ptr->real = prev_data[j];
+		fft_buf_ptr->imag = 0;
+		fft_buf_ptr++;
+	}
+
+	/* Copy hop size of new data from circular buffer */
+	while (samples_remain) {
+		n = sofm_stft_buffer_samples_without_wrap(ibuf, r);
+		n = MIN(n, samples_remain);
+		for (j = 0; j < n; j++) {
+			fft_buf_ptr->real = *r++;
+			fft_buf_ptr->imag = 0;
+			fft_buf_ptr++;
+		}
+		r = sofm_stft_buffer_wrap(ibuf, r);
+		samples_remain -= n;
+	}
+
+	ibuf->r_ptr = r;
+	ibuf->s_avail -= fft_hop_size;
+	ibuf->s_free += fft_hop_size;
+
+	/* Copy for next time data back to overlap buffer */
+	fft_buf_ptr = &fft_buf[fft_hop_size];
+	for (j = 0; j < prev_data_size; j++)
+		prev_data[j] = fft_buf_ptr[j].real;
+}
+
+int sofm_stft_get_window(int32_t *window, int fft_size, enum sofm_stft_window_type type)
+{
+	switch (type) {
+	case SOFM_STFT_RECTANGULAR_WINDOW:
+		win_rectangular_32b(window, fft_size);
+		return 0;
+	case SOFM_STFT_BLACKMAN_WINDOW:
+		win_blackman_32b(window, fft_size, WIN_BLACKMAN_A0_Q31);
+		return 0;
+	case SOFM_STFT_HAMMING_WINDOW:
+		win_hamming_32b(window, fft_size);
+		return 0;
+	case SOFM_STFT_HANN_WINDOW:
+		win_hann_32b(window, fft_size);
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+#if SOF_USE_HIFI(NONE, MATH_STFT)
+void sofm_stft_apply_window(struct icomplex32 *fft_buf, const int32_t *window, int fft_size)
+{
+	int j;
+
+	/* Multiply Q1.31 by Q1.31 gives Q2.62, shift right by 31 to get Q1.31 */
+	for (j = 0; j < fft_size; j++)
+		fft_buf[j].real = sat_int32(Q_MULTSR_32X32((int64_t)fft_buf[j].real,
+							   window[j], 31, 31, 31));
+}
+
+void sofm_stft_overlap_add(struct sofm_stft_buffer *obuf, const struct icomplex32 *fft_buf,
+			   int32_t gain, int fft_size, int fft_hop_size)
+{
+	int32_t *w = obuf->w_ptr;
+	int32_t sample;
+	int samples_remain = fft_size;
+	int idx = 0;
+	int i;
+	int n;
+
+	while (samples_remain) {
+		n = sofm_stft_buffer_samples_without_wrap(obuf, w);
+		n = MIN(samples_remain, n);
+
+		/* Abort if n is zero to avoid infinite loop. The assert can
+		 * trigger only with incorrect usage of this function.
+		 */
+		assert(n);
+		for (i = 0; i < n; i++) {
+			sample = Q_MULTSR_32X32((int64_t)gain, fft_buf[idx].real, 31, 31, 31);
+			*w = sat_int32((int64_t)*w + sample);
+			w++;
+			idx++;
+		}
+		w = sofm_stft_buffer_wrap(obuf, w);
+		samples_remain -= n;
+	}
+
+	obuf->w_ptr = sofm_stft_buffer_wrap(obuf, obuf->w_ptr + fft_hop_size);
+	obuf->s_avail += fft_hop_size;
+	obuf->s_free -= fft_hop_size;
+}
+#endif /* SOF_USE_HIFI(NONE, MATH_STFT) */
@@ -2,41 +2,25 @@
 //
 // Copyright(c) 2025-2026 Intel Corporation.
 
-/**
- * \file
- * \brief HiFi3 SIMD-optimized helpers for the STFT processing component.
- *
- * This compilation unit provides HiFi3 intrinsic versions of selected
- * hot-path helpers. It is guarded by SOF_USE_MIN_HIFI(3, COMP_STFT_PROCESS)
- * so only one of the generic or hifi implementations is active.
- */
-
 #include <sof/audio/format.h>
+#include <sof/math/fft.h>
+#include <sof/math/icomplex32.h>
+#include <sof/math/stft.h>
 #include <sof/common.h>
 #include <assert.h>
 #include <stdint.h>
-#include "stft_process.h"
 
-#if SOF_USE_MIN_HIFI(3, COMP_STFT_PROCESS)
+#if SOF_USE_MIN_HIFI(3, MATH_STFT)
 
 #include <xtensa/tie/xt_hifi3.h>
 
-/**
- * stft_process_apply_window() - Multiply FFT buffer by the analysis window.
- * @state: STFT processing state that contains the FFT buffer and window.
- *
- * The real part of each icomplex32 sample in the FFT buffer is multiplied
- * by the corresponding Q1.31 window coefficient.
- */
-void stft_process_apply_window(struct stft_process_state *state)
+void sofm_stft_apply_window(struct icomplex32 *fft_buf, const int32_t *window, int fft_size)
 {
-	struct stft_process_fft *fft = &state->fft;
 	ae_int32 *buf;
 	const ae_int32x2 *win;
 	ae_f32x2 data01, data23;
 	ae_f32x2 win01, win23;
 	ae_int32x2 d0, d1;
-	int fft_size = fft->fft_size;
 	int j;
 	int n4;
 
@@ -51,8 +35,8 @@ void stft_process_apply_window(struct stft_process_state *state)
 	 * Stride for buf  is sizeof(ae_int32x2) = 8 bytes per complex sample.
 	 * Stride for win  is sizeof(ae_int32)   = 4 bytes per scalar window value.
 	 */
-	buf = (ae_int32 *)fft->fft_buf;
-	win = (const ae_int32x2 *)state->window;
+	buf = (ae_int32 *)fft_buf;
+	win = (const ae_int32x2 *)window;
 
 	assert(!(fft_size & 3));
 
@@ -87,33 +71,20 @@ void stft_process_apply_window(struct stft_process_state *state)
 	}
 }
 
-/**
- * stft_process_overlap_add_ifft_buffer() - Overlap-add IFFT output to circular output buffer.
- * @state: STFT processing state.
- * @ch: Channel index.
- *
- * Each IFFT output sample is multiplied by gain_comp (Q1.31 x Q1.31) and
- * added with saturation to the existing content of the circular output
- * buffer.  HiFi3 AE_MULF32S_HH handles the multiply and
- * AE_ADD32S provides the saturating accumulation.
- *
- * Note: obuf must be even number of samples and 64-bit aligned.
- */
-void stft_process_overlap_add_ifft_buffer(struct stft_process_state *state, int ch)
+void sofm_stft_overlap_add(struct sofm_stft_buffer *obuf, const struct icomplex32 *fft_buf,
+			   int32_t gain, int fft_size, int fft_hop_size)
 {
-	struct stft_process_buffer *obuf = &state->obuf[ch];
-	struct stft_process_fft *fft = &state->fft;
-	ae_f32x2 gain = AE_MOVDA32(state->gain_comp);
+	ae_f32x2 gain_f32 = AE_MOVDA32(gain);
 	ae_f32x2 buffer_data;
 	ae_f32x2 fft_data;
 	ae_f32x2 d0, d1;
 	ae_f32x2 *w = (ae_f32x2 *)obuf->w_ptr;
-	ae_f32 *fft_p = (ae_f32 *)fft->fft_buf;
-	int samples_remain = fft->fft_size;
+	ae_f32 *fft_p = (ae_f32 *)fft_buf;
+	int samples_remain = fft_size;
 	int i, n;
 
 	while (samples_remain) {
-		n = stft_process_buffer_samples_without_wrap(obuf, (int32_t *)w);
+		n = sofm_stft_buffer_samples_without_wrap(obuf, (int32_t *)w);
 
 		/* The samples count must be even and not zero, the latter to avoid infinite
 		 * loop. The assert can trigger only with incorrect usage of this function.
@@ -130,16 +101,16 @@ void stft_process_overlap_add_ifft_buffer(struct stft_process_state *state, int
 			 * store to output buffer.
 			 */
 			buffer_data = AE_L32X2_I(w, 0);
-			AE_MULAFP32X2RS(buffer_data, fft_data, gain);
+			AE_MULAFP32X2RS(buffer_data, fft_data, gain_f32);
 			AE_S32X2_IP(buffer_data, w, sizeof(ae_f32x2));
 		}
-		w = (ae_f32x2 *)stft_process_buffer_wrap(obuf, (int32_t *)w);
+		w = (ae_f32x2 *)sofm_stft_buffer_wrap(obuf, (int32_t *)w);
 		samples_remain -= n << 1;
 	}
 
-	obuf->w_ptr = stft_process_buffer_wrap(obuf, obuf->w_ptr + fft->fft_hop_size);
-	obuf->s_avail += fft->fft_hop_size;
-	obuf->s_free -= fft->fft_hop_size;
+	obuf->w_ptr = sofm_stft_buffer_wrap(obuf, obuf->w_ptr + fft_hop_size);
+	obuf->s_avail += fft_hop_size;
+	obuf->s_free -= fft_hop_size;
 }
 
-#endif /* SOF_USE_MIN_HIFI(3, COMP_STFT_PROCESS) */
+#endif /* SOF_USE_MIN_HIFI(3, MATH_STFT) */
@@ -163,4 +163,131 @@ int32_t iir_df1_4th(struct iir_state_df1 *iir, int32_t x)
 }
 EXPORT_SYMBOL(iir_df1_4th);
 
+void iir_df1_4th_nch(const int32_t *coef, int32_t *delay, const int32_t *x, int32_t *y,
+		     int nch)
+{
+	int32_t cf[SOF_IIR_DF1_4TH_NUM_BIQUADS * SOF_EQ_IIR_NBIQUAD];
+	int32_t *d = delay;
+	int32_t in;
+	int32_t tmp;
+	int64_t acc;
+	int ch;
+	int i;
+	int c;
+
+	/* Keep the coefficients in local variables for all channels */
+	for (i = 0; i < SOF_IIR_DF1_4TH_NUM_BIQUADS * SOF_EQ_IIR_NBIQUAD; i++)
+		cf[i] = coef[i];
+
+	/* Coefficients order in coef[] is {a2, a1, b2, b1, b0, shift, gain} */
+	/* Delay order in state[] is {y(n - 2), y(n - 1), x(n - 2), x(n - 1)} */
+	for (ch = 0; ch < nch; ch++) {
+		in = x[ch];
+		c = 0;
+		for (i = 0; i < SOF_IIR_DF1_4TH_NUM_BIQUADS; i++) {
+			/* Same arithmetic as in iir_df1_4th() */
+			acc = ((int64_t)cf[c]) * d[0]; /* a2 * y(n - 2) */
+			acc += ((int64_t)cf[c + 1]) * d[1]; /* a1 * y(n - 1) */
+			acc += ((int64_t)cf[c + 2]) * d[2]; /* b2 * x(n - 2) */
+			acc += ((int64_t)cf[c + 3]) * d[3]; /* b1 * x(n - 1) */
+			acc += ((int64_t)cf[c + 4]) * in; /* b0 * x */
+			tmp = (int32_t)sat_int32(Q_SHIFT_RND(acc, 61, 31));
+
+			/* update the delay value */
+			d[0] = d[1];
+			d[1] = tmp;
+			d[2] = d[3];
+			d[3] = in;
+
+			/* Apply gain and output shift */
+			acc = ((int64_t)cf[c + 6]) * tmp;
+			acc = Q_SHIFT_RND(acc, 45 + cf[c + 5], 31);
+			in = sat_int32(acc);
+
+			c += SOF_EQ_IIR_NBIQUAD;
+			d += IIR_DF1_NUM_STATE;
+		}
+		y[ch] = in;
+	}
+}
+EXPORT_SYMBOL(iir_df1_4th_nch);
+
+void iir_df1_nch(struct iir_state_df1 *iir, int32_t *delay, int32_t *data, int nch)
+{
+	int64_t out[PLATFORM_MAX_CHANNELS];
+	int32_t in[PLATFORM_MAX_CHANNELS];
+	int32_t *coefp = iir->coef;
+	int32_t *d = delay;
+	int32_t a2;
+	int32_t a1;
+	int32_t b2;
+	int32_t b1;
+	int32_t b0;
+	int32_t shift;
+	int32_t gain;
+	int32_t tmp;
+	int64_t acc;
+	int ch;
+	int i;
+	int j;
+	int nseries = iir->biquads_in_series;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads)
+		return;
+
+	for (ch = 0; ch < nch; ch++)
+		out[ch] = 0;
+
+	/* Coefficients order in coef[] is {a2, a1, b2, b1, b0, shift, gain} */
+	/* Delay order in state[] is {y(n - 2), y(n - 1), x(n - 2), x(n - 1)} */
+	for (j = 0; j < iir->biquads; j += nseries) {
+		for (ch = 0; ch < nch; ch++)
+			in[ch] = data[ch];
+
+		for (i = 0; i < nseries; i++) {
+			/* Keep the biquad coefficients in local variables for
+			 * all channels.
+			 */
+			a2 = coefp[0];
+			a1 = coefp[1];
+			b2 = coefp[2];
+			b1 = coefp[3];
+			b0 = coefp[4];
+			shift = coefp[5];
+			gain = coefp[6];
+			for (ch = 0; ch < nch; ch++) {
+				/* Same arithmetic as in iir_df1() */
+				acc = ((int64_t)a2) * d[0]; /* a2 * y(n - 2) */
+				acc += ((int64_t)a1) * d[1]; /* a1 * y(n - 1) */
+				acc += ((int64_t)b2) * d[2]; /* b2 * x(n - 2) */
+				acc += ((int64_t)b1) * d[3]; /* b1 * x(n - 1) */
+				acc += ((int64_t)b0) * in[ch]; /* b0 * x */
+				tmp = (int32_t)sat_int32(Q_SHIFT_RND(acc, 61, 31));
+
+				/* update the delay value */
+				d[0] = d[1];
+				d[1] = tmp;
+				d[2] = d[3];
+				d[3] = in[ch];
+
+				/* Apply gain and output shift */
+				acc = ((int64_t)gain) * tmp;
+				acc = Q_SHIFT_RND(acc, 45 + shift, 31);
+				in[ch] = sat_int32(acc);
+				d += IIR_DF1_NUM_STATE;
+			}
+			coefp += SOF_EQ_IIR_NBIQUAD;
+		}
+
+		/* Output of previous section is in array in */
+		for (ch = 0; ch < nch; ch++)
+			out[ch] += (int64_t)in[ch];
+	}
+
+	for (ch = 0; ch < nch; ch++)
+		data[ch] = sat_int32(out[ch]);
+}
+EXPORT_SYMBOL(iir_df1_nch);
+
 #endif
@@ -194,4 +194,157 @@ int32_t iir_df1_4th(struct iir_state_df1 *iir, int32_t x)
 }
 EXPORT_SYMBOL(iir_df1_4th);
 
+void iir_df1_4th_nch(const int32_t *coef, int32_t *delay, const int32_t *x, int32_t *y,
+		     int nch)
+{
+	ae_int64 acc;
+	ae_valign coef_align;
+	ae_int32x2 coef_a2a1[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 coef_b2b1[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 coef_b0[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 gain[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 shift[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 delay_y2y1;
+	ae_int32x2 delay_x2x1;
+	ae_int32 in;
+	ae_int32 tmp;
+	ae_int32x2 *coefp = (ae_int32x2 *)coef;
+	ae_int32x2 *delayp = (ae_int32x2 *)delay;
+	int32_t *delay_update;
+	int ch;
+	int i;
+
+	/* Load coefficients of both biquads once for all channels. The
+	 * order in coef[] is {a2, a1, b2, b1, b0, shift, gain}.
+	 */
+	for (i = 0; i < SOF_IIR_DF1_4TH_NUM_BIQUADS; i++) {
+		coef_align = AE_LA64_PP(coefp);
+		AE_LA32X2_IP(coef_a2a1[i], coef_align, coefp);
+		AE_LA32X2_IP(coef_b2b1[i], coef_align, coefp);
+		AE_L32_IP(coef_b0[i], (ae_int32 *)coefp, 4);
+		AE_L32_IP(shift[i], (ae_int32 *)coefp, 4);
+		AE_L32_IP(gain[i], (ae_int32 *)coefp, 4);
+	}
+
+	/* The delay lines of channels follow each other */
+	for (ch = 0; ch < nch; ch++) {
+		in = x[ch];
+		for (i = 0; i < SOF_IIR_DF1_4TH_NUM_BIQUADS; i++) {
+			/* Same arithmetic as in iir_df1_4th() */
+			AE_L32X2_IP(delay_y2y1, delayp, 8);
+			AE_L32X2_IP(delay_x2x1, delayp, 8);
+
+			acc = AE_MULF32R_HH(coef_a2a1[i], delay_y2y1); /* a2 * y(n - 2) */
+			AE_MULAF32R_LL(acc, coef_a2a1[i], delay_y2y1); /* a1 * y(n - 1) */
+			AE_MULAF32R_HH(acc, coef_b2b1[i], delay_x2x1); /* b2 * x(n - 2) */
+			AE_MULAF32R_LL(acc, coef_b2b1[i], delay_x2x1); /* b1 * x(n - 1) */
+			AE_MULAF32R_HH(acc, coef_b0[i], in); /*  b0 * x  */
+			acc = AE_SLAI64S(acc, 1); /* Convert to Q17.47 */
+			tmp = AE_ROUND32F48SSYM(acc); /* Round to Q1.31 */
+
+			/* update the state value */
+			delay_update = (int32_t *)delayp - 4;
+			delay_update[0] = delay_update[1];
+			delay_update[1] = tmp;
+			delay_update[2] = delay_update[3];
+			delay_update[3] = in;
+
+			/* Apply gain Q18.14 x Q1.31 -> Q34.30 */
+			acc = AE_MULF32R_HH(gain[i], tmp); /* Gain */
+			acc = AE_SLAI64S(acc, 17); /* Convert to Q17.47 */
+
+			/* Apply biquad output shift right parameter and then
+			 * round and saturate to 32 bits Q1.31.
+			 */
+			acc = AE_SRAA64(acc, shift[i]);
+			in = AE_ROUND32F48SSYM(acc);
+		}
+		y[ch] = in;
+	}
+}
+EXPORT_SYMBOL(iir_df1_4th_nch);
+
+void iir_df1_nch(struct iir_state_df1 *iir, int32_t *delay, int32_t *data, int nch)
+{
+	ae_int64 acc;
+	ae_valign coef_align;
+	ae_int32x2 coef_a2a1;
+	ae_int32x2 coef_b2b1;
+	ae_int32x2 coef_b0;
+	ae_int32x2 gain;
+	ae_int32x2 shift;
+	ae_int32x2 delay_y2y1;
+	ae_int32x2 delay_x2x1;
+	ae_int32 in[PLATFORM_MAX_CHANNELS];
+	ae_int32 out[PLATFORM_MAX_CHANNELS];
+	ae_int32 tmp;
+	ae_int32x2 *coefp = (ae_int32x2 *)iir->coef;
+	ae_int32x2 *delayp = (ae_int32x2 *)delay;
+	int32_t *delay_update;
+	int ch;
+	int i;
+	int j;
+	int nseries = iir->biquads_in_series;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads)
+		return;
+
+	for (ch = 0; ch < nch; ch++)
+		out[ch] = 0;
+
+	/* Coefficients order in coef[] is {a2, a1, b2, b1, b0, shift, gain}.
+	 * The delay lines of all channels of a biquad follow each other.
+	 */
+	for (j = 0; j < iir->biquads; j += nseries) {
+		for (ch = 0; ch < nch; ch++)
+			in[ch] = data[ch];
+
+		for (i = 0; i < nseries; i++) {
+			/* Load coefficients once for all channels */
+			coef_align = AE_LA64_PP(coefp);
+			AE_LA32X2_IP(coef_a2a1, coef_align, coefp);
+			AE_LA32X2_IP(coef_b2b1, coef_align, coefp);
+			AE_L32_IP(coef_b0, (ae_int32 *)coefp, 4);
+			AE_L32_IP(shift, (ae_int32 *)coefp, 4);
+			AE_L32_IP(gain, (ae_int32 *)coefp, 4);
+
+			for (ch = 0; ch < nch; ch++) {
+				/* Same arithmetic as in iir_df1() */
+				AE_L32X2_IP(delay_y2y1, delayp, 8);
+				AE_L32X2_IP(delay_x2x1, delayp, 8);
+
+				acc = AE_MULF32R_HH(coef_a2a1, delay_y2y1); /* a2 * y(n - 2) */
+				AE_MULAF32R_LL(acc, coef_a2a1, delay_y2y1); /* a1 * y(n - 1) */
+				AE_MULAF32R_HH(acc, coef_b2b1, delay_x2x1); /* b2 * x(n - 2) */
+				AE_MULAF32R_LL(acc, coef_b2b1, delay_x2x1); /* b1 * x(n - 1) */
+				AE_MULAF32R_HH(acc, coef_b0, in[ch]); /*  b0 * x  */
+				acc = AE_SLAI64S(acc, 1); /* Convert to Q17.47 */
+				tmp = AE_ROUND32F48SSYM(acc); /* Round to Q1.31 */
+
+				/* update the state value */
+				delay_update = (int32_t *)delayp - 4;
+				delay_update[0] = delay_update[1];
+				delay_update[1] = tmp;
+				delay_update[2] = delay_update[3];
+				delay_update[3] = in[ch];
+
+				/* Apply gain and output shift */
+				acc = AE_MULF32R_HH(gain, tmp); /* Gain */
+				acc = AE_SLAI64S(acc, 17); /* Convert to Q17.47 */
+				acc = AE_SRAA64(acc, shift);
+				in[ch] = AE_ROUND32F48SSYM(acc);
+			}
+		}
+
+		/* Output of previous section is in array in */
+		for (ch = 0; ch < nch; ch++)
+			out[ch] = AE_F32_ADDS_F32(out[ch], in[ch]);
+	}
+
+	for (ch = 0; ch < nch; ch++)
+		data[ch] = out[ch];
+}
+EXPORT_SYMBOL(iir_df1_nch);
+
 #endif
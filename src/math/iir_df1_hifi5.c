@@ -175,4 +175,145 @@ int32_t iir_df1_4th(struct iir_state_df1 *iir, int32_t x)
 }
 EXPORT_SYMBOL(iir_df1_4th);
 
+void iir_df1_4th_nch(const int32_t *coef, int32_t *delay, const int32_t *x, int32_t *y,
+		     int nch)
+{
+	ae_valignx2 coef_align;
+	ae_valignx2 data_r_align;
+	ae_valignx2 data_w_align = AE_ZALIGN128();
+	ae_f64 acc;
+	ae_int32x2 delay_y2y1;
+	ae_int32x2 delay_x2x1;
+	ae_int32x2 coef_a2a1[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 coef_b2b1[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 coef_b0[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 gain[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32x2 shift[SOF_IIR_DF1_4TH_NUM_BIQUADS];
+	ae_int32 in;
+	ae_int32x4 *coefp = (ae_int32x4 *)coef;
+	ae_int32x4 *delay_r  = (ae_int32x4 *)delay;
+	ae_int32x4 *delay_w = delay_r;
+	int ch;
+	int i;
+
+	/* Load coefficients of both biquads once for all channels. The
+	 * order in coef[] is {a2, a1, b2, b1, b0, shift, gain}.
+	 */
+	for (i = 0; i < SOF_IIR_DF1_4TH_NUM_BIQUADS; i++) {
+		coef_align = AE_LA128_PP(coefp);
+		AE_LA32X2X2_IP(coef_a2a1[i], coef_b2b1[i], coef_align, coefp);
+		AE_L32_IP(coef_b0[i], (ae_int32 *)coefp, 4);
+		AE_L32_IP(shift[i], (ae_int32 *)coefp, 4);
+		AE_L32_IP(gain[i], (ae_int32 *)coefp, 4);
+	}
+
+	/* The delay lines of channels follow each other so they can be read
+	 * and written as one continuous stream.
+	 */
+	data_r_align = AE_LA128_PP(delay_r);
+	for (ch = 0; ch < nch; ch++) {
+		in = x[ch];
+		for (i = 0; i < SOF_IIR_DF1_4TH_NUM_BIQUADS; i++) {
+			/* Same arithmetic as in iir_df1_4th() */
+			AE_LA32X2X2_IP(delay_y2y1, delay_x2x1, data_r_align, delay_r);
+
+			acc = AE_MULF32RA_HH(coef_b0[i], in);		     /* acc = b0 * in */
+			AE_MULAAFD32RA_HH_LL(acc, coef_a2a1[i], delay_y2y1); /* + a2 * y2 + a1 * y1 */
+			AE_MULAAFD32RA_HH_LL(acc, coef_b2b1[i], delay_x2x1); /* + b2 * x2 + b1 * x1 */
+			AE_PKSR32(delay_y2y1, acc, 1);		/* y2 = y1, y1 = acc(q1.31) */
+			delay_x2x1 = AE_SEL32_LL(delay_x2x1, in);	/* x2 = x1, x1 = in */
+
+			AE_SA32X2X2_IP(delay_y2y1, delay_x2x1, data_w_align, delay_w);
+
+			/* Apply gain and output shift */
+			acc = AE_MULF32R_LL(gain[i], delay_y2y1);	/* acc = gain * y1 */
+			acc = AE_SLAI64S(acc, 17);			/* Convert to Q17.47 */
+			acc = AE_SRAA64(acc, shift[i]);
+			in = AE_ROUND32F48SSYM(acc);
+		}
+		y[ch] = in;
+	}
+	AE_SA128POS_FP(data_w_align, delay_w);
+}
+EXPORT_SYMBOL(iir_df1_4th_nch);
+
+void iir_df1_nch(struct iir_state_df1 *iir, int32_t *delay, int32_t *data, int nch)
+{
+	ae_valignx2 coef_align;
+	ae_valignx2 data_r_align;
+	ae_valignx2 data_w_align = AE_ZALIGN128();
+	ae_f64 acc;
+	ae_int32x2 delay_y2y1;
+	ae_int32x2 delay_x2x1;
+	ae_int32x2 coef_a2a1;
+	ae_int32x2 coef_b2b1;
+	ae_int32x2 coef_b0;
+	ae_int32x2 gain;
+	ae_int32x2 shift;
+	ae_int32 in[PLATFORM_MAX_CHANNELS];
+	ae_int32 out[PLATFORM_MAX_CHANNELS];
+	ae_int32x4 *coefp = (ae_int32x4 *)iir->coef;
+	ae_int32x4 *delay_r  = (ae_int32x4 *)delay;
+	ae_int32x4 *delay_w = delay_r;
+	int ch;
+	int i;
+	int j;
+	int nseries = iir->biquads_in_series;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads)
+		return;
+
+	for (ch = 0; ch < nch; ch++)
+		out[ch] = 0;
+
+	/* Coefficients order in coef[] is {a2, a1, b2, b1, b0, shift, gain} */
+	/* Delay order in state[] is {y(n - 2), y(n - 1), x(n - 2), x(n - 1)}.
+	 * The delay lines of all channels of a biquad follow each other so
+	 * they can be read and written as one continuous stream.
+	 */
+	data_r_align = AE_LA128_PP(delay_r);
+	for (j = 0; j < iir->biquads; j += nseries) {
+		for (ch = 0; ch < nch; ch++)
+			in[ch] = data[ch];
+
+		for (i = 0; i < nseries; i++) {
+			/* Load coefficients once for all channels */
+			coef_align = AE_LA128_PP(coefp);
+			AE_LA32X2X2_IP(coef_a2a1, coef_b2b1, coef_align, coefp);
+			AE_L32_IP(coef_b0, (ae_int32 *)coefp, 4);
+			AE_L32_IP(shift, (ae_int32 *)coefp, 4);
+			AE_L32_IP(gain, (ae_int32 *)coefp, 4);
+
+			for (ch = 0; ch < nch; ch++) {
+				/* Same arithmetic as in iir_df1() */
+				AE_LA32X2X2_IP(delay_y2y1, delay_x2x1, data_r_align, delay_r);
+
+				acc = AE_MULF32RA_HH(coef_b0, in[ch]);		  /* acc = b0 * in */
+				AE_MULAAFD32RA_HH_LL(acc, coef_a2a1, delay_y2y1); /* + a2 * y2 + a1 * y1 */
+				AE_MULAAFD32RA_HH_LL(acc, coef_b2b1, delay_x2x1); /* + b2 * x2 + b1 * x1 */
+				AE_PKSR32(delay_y2y1, acc, 1);		/* y2 = y1, y1 = acc(q1.31) */
+				delay_x2x1 = AE_SEL32_LL(delay_x2x1, in[ch]);	/* x2 = x1, x1 = in */
+
+				AE_SA32X2X2_IP(delay_y2y1, delay_x2x1, data_w_align, delay_w);
+
+				/* Apply gain and output shift */
+				acc = AE_MULF32R_LL(gain, delay_y2y1);	/* acc = gain * y1 */
+				acc = AE_SLAI64S(acc, 17);		/* Convert to Q17.47 */
+				acc = AE_SRAA64(acc, shift);
+				in[ch] = AE_ROUND32F48SSYM(acc);
+			}
+		}
+
+		/* Output of previous section is in array in */
+		for (ch = 0; ch < nch; ch++)
+			out[ch] = AE_F32_ADDS_F32(out[ch], in[ch]);
+	}
+
+	AE_SA128POS_FP(data_w_align, delay_w);
+	for (ch = 0; ch < nch; ch++)
+		data[ch] = out[ch];
+}
+EXPORT_SYMBOL(iir_df1_nch);
+
 #endif
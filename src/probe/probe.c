@@ -7,6 +7,7 @@
 
 #include <sof/audio/buffer.h>
 #include <sof/audio/component.h>
+#include <sof/audio/format.h>
 #include <sof/probe/probe.h>
 #include <sof/trace/trace.h>
 #include <user/trace.h>
@@ -75,6 +76,49 @@ struct probe_dma_ext {
 	struct dma_copy dc;		/**< DMA copy */
 };
 
+/**
+ * Extraction data collected during one LL tick
+ */
+struct probe_batch {
+	uint8_t *data;		/**< batch buffer, NULL if not batched */
+	uint8_t *packed;	/**< compressed data buffer */
+	uint32_t size;		/**< data size in bytes */
+	uint32_t format;	/**< format of the data */
+	uint64_t timestamp;	/**< timestamp of first transaction */
+};
+
+/**
+ * Extraction options of a probe point
+ */
+struct probe_extract_opts {
+	uint32_t ch_mask;	/**< extracted channels, 0 for all */
+	uint32_t decimation;	/**< decimation factor */
+	uint32_t phase;		/**< frames to skip until next extracted frame */
+	bool s16;		/**< truncate integer samples to 16 bits */
+	bool rice;		/**< compress with delta and Rice coding */
+};
+
+/**
+ * Delta and Rice encoder state
+ */
+struct probe_rice_enc {
+	uint8_t *w_ptr;		/**< write pointer */
+	uint8_t *end;		/**< end of output buffer */
+	uint64_t acc;		/**< bits not yet written */
+	uint32_t bits;		/**< number of bits in acc */
+};
+
+/**
+ * Probe point context, passed to buffer callbacks so that the probe
+ * point is found without searching
+ */
+struct probe_point_ctx {
+	struct probe_point *point;	/**< probe point */
+	struct probe_dma_ext *dma;	/**< injection DMA of the probe point */
+	struct probe_batch batch;	/**< pending extraction data */
+	struct probe_extract_opts opts;	/**< extraction options */
+};
+
 /**
  * Probe main struct
  */
@@ -83,9 +127,14 @@ struct probe_pdata {
 	struct probe_dma_ext ext_dma;				  /**< extraction DMA */
 	struct probe_dma_ext inject_dma[CONFIG_PROBE_DMA_MAX];	  /**< injection DMA */
 	struct probe_point probe_points[CONFIG_PROBE_POINTS_MAX]; /**< probe points */
+	struct probe_point_ctx ctx[CONFIG_PROBE_POINTS_MAX];	  /**< probe point contexts */
 	struct probe_data_packet header;			  /**< data packet header */
 };
 
+#if CONFIG_PROBE_EXTRACTION_BATCH
+static void probe_batch_flush_all(struct probe_pdata *_probe);
+#endif
+
 /**
  * \brief Allocate and initialize probe buffer with correct alignment.
  * \param[out] buffer return value.
@@ -292,6 +341,10 @@ static enum task_state probe_task(void *data)
 	uint32_t copy_align, avail;
 	int err;
 
+#if CONFIG_PROBE_EXTRACTION_BATCH
+	probe_batch_flush_all(_probe);
+#endif
+
 	if (!_probe->ext_dma.dmapb.avail)
 		return SOF_TASK_STATE_RESCHEDULE;
 #if CONFIG_ZEPHYR_NATIVE_DRIVERS
@@ -719,18 +772,17 @@ static int copy_from_pbuffer(struct probe_dma_buf *pbuf, void *data,
  * \param[in] buffer_id component buffer id
  * \param[in] size data size.
  * \param[in] format audio format.
+ * \param[in] timestamp of the data.
  * \param[out] checksum.
  * \return 0 on success, error code otherwise.
  */
 static int probe_gen_header(uint32_t buffer_id, uint32_t size,
-			    uint32_t format, uint64_t *checksum)
+			    uint32_t format, uint64_t timestamp, uint64_t *checksum)
 {
 	struct probe_pdata *_probe = probe_get();
 	struct probe_data_packet *header;
-	uint64_t timestamp;
 
 	header = &_probe->header;
-	timestamp = sof_cycle_get_64();
 
 	header->sync_word = PROBE_EXTRACT_SYNC_WORD;
 	header->buffer_id = buffer_id;
@@ -876,7 +928,8 @@ static ssize_t probe_logging_hook(uint8_t *buffer, size_t length)
 	max_len = _probe->ext_dma.dmapb.avail - sizeof(struct probe_data_packet) - sizeof(checksum);
 	length = MIN(max_len, length);
 
-	ret = probe_gen_header(PROBE_LOGGING_BUFFER_ID, length, 0, &checksum);
+	ret = probe_gen_header(PROBE_LOGGING_BUFFER_ID, length, 0, sof_cycle_get_64(),
+			       &checksum);
 	if (ret < 0)
 		return ret;
 
@@ -895,51 +948,384 @@ static ssize_t probe_logging_hook(uint8_t *buffer, size_t length)
 }
 #endif
 
+/**
+ * \brief Copy one extraction data packet to probe buffer. The data may be
+ *	  in two parts when it wraps in the component buffer.
+ * \param[in] buffer_id component buffer id.
+ * \param[in] format audio format.
+ * \param[in] timestamp of the data.
+ * \param[in] head first part of data.
+ * \param[in] head_size first part size.
+ * \param[in] tail second part of data.
+ * \param[in] tail_size second part size.
+ * \return 0 on success, error code otherwise.
+ */
+static int probe_extract_packet(uint32_t buffer_id, uint32_t format, uint64_t timestamp,
+				void *head, uint32_t head_size,
+				void *tail, uint32_t tail_size)
+{
+	struct probe_pdata *_probe = probe_get();
+	struct probe_dma_buf *pbuf = &_probe->ext_dma.dmapb;
+	uint64_t checksum;
+	int ret;
+
+	/* drop the whole packet rather than send a partial one */
+	if (pbuf->size - pbuf->avail < sizeof(struct probe_data_packet) + head_size +
+	    tail_size + sizeof(checksum))
+		return -EINVAL;
+
+	ret = probe_gen_header(buffer_id, head_size + tail_size, format, timestamp,
+			       &checksum);
+	if (ret < 0)
+		return ret;
+
+	ret = copy_to_pbuffer(pbuf, head, head_size);
+	if (ret < 0)
+		return ret;
+
+	ret = copy_to_pbuffer(pbuf, tail, tail_size);
+	if (ret < 0)
+		return ret;
+
+	return copy_to_pbuffer(pbuf, &checksum, sizeof(checksum));
+}
+
+#if CONFIG_PROBE_EXTRACTION_BATCH
+static int probe_rice_put(struct probe_rice_enc *enc, uint32_t value, uint32_t bits)
+{
+	if (bits < 32)
+		value &= (1u << bits) - 1;
+
+	enc->acc = (enc->acc << bits) | value;
+	enc->bits += bits;
+	while (enc->bits >= 8) {
+		if (enc->w_ptr == enc->end)
+			return -ENOSPC;
+
+		enc->bits -= 8;
+		*enc->w_ptr++ = enc->acc >> enc->bits;
+	}
+
+	return 0;
+}
+
+static int probe_rice_put_ones(struct probe_rice_enc *enc, uint32_t count)
+{
+	uint32_t n;
+	int ret;
+
+	for (; count; count -= n) {
+		n = MIN(count, 32);
+		ret = probe_rice_put(enc, UINT32_MAX, n);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * \brief Compress interleaved samples with delta and Rice coding, see
+ *	  PROBE_COMPRESSION_RICE for the data format.
+ * \param[out] dst output buffer of CONFIG_PROBE_EXTRACTION_BATCH_SIZE bytes.
+ * \param[in] src samples.
+ * \param[in] bytes size of samples.
+ * \param[in] format format of the samples.
+ * \return compressed size, error code if the data doesn't fit.
+ */
+static int probe_rice_encode(uint8_t *dst, const uint8_t *src, uint32_t bytes,
+			     uint32_t format)
+{
+	struct probe_rice_enc enc;
+	uint32_t channels = ((format & PROBE_MASK_NB_CHANNELS) >> PROBE_SHIFT_NB_CHANNELS) + 1;
+	uint32_t sample_bytes = ((format & PROBE_MASK_CONTAINER_SIZE) >>
+				 PROBE_SHIFT_CONTAINER_SIZE) + 1;
+	uint32_t frames = bytes / (channels * sample_bytes);
+	int32_t prev[(PROBE_MASK_NB_CHANNELS >> PROBE_SHIFT_NB_CHANNELS) + 1];
+	uint64_t sum[ARRAY_SIZE(prev)];
+	uint64_t count[ARRAY_SIZE(prev)];
+	uint32_t frame;
+	uint32_t value;
+	uint32_t ch;
+	uint32_t k;
+	int32_t sample;
+	int32_t delta;
+	int ret;
+
+	/* frame count goes first */
+	memcpy_s(dst, CONFIG_PROBE_EXTRACTION_BATCH_SIZE, &frames, sizeof(frames));
+	enc.w_ptr = dst + sizeof(frames);
+	enc.end = dst + CONFIG_PROBE_EXTRACTION_BATCH_SIZE;
+	enc.acc = 0;
+	enc.bits = 0;
+
+	for (ch = 0; ch < channels; ch++) {
+		prev[ch] = 0;
+		sum[ch] = PROBE_RICE_INIT_A;
+		count[ch] = 1;
+	}
+
+	for (frame = 0; frame < frames; frame++) {
+		for (ch = 0; ch < channels; ch++) {
+			if (sample_bytes == sizeof(int16_t)) {
+				sample = *(const int16_t *)src;
+				src += sizeof(int16_t);
+			} else {
+				sample = *(const int32_t *)src;
+				src += sizeof(int32_t);
+			}
+
+			delta = (int32_t)((uint32_t)sample - (uint32_t)prev[ch]);
+			prev[ch] = sample;
+			value = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+
+			for (k = 0; k < 31 && (count[ch] << k) < sum[ch]; k++)
+				;
+
+			if ((value >> k) >= PROBE_RICE_ESCAPE) {
+				ret = probe_rice_put_ones(&enc, PROBE_RICE_ESCAPE);
+				if (ret < 0)
+					return ret;
+
+				ret = probe_rice_put(&enc, value, 32);
+			} else {
+				ret = probe_rice_put_ones(&enc, value >> k);
+				if (ret < 0)
+					return ret;
+
+				/* zero ends the quotient, then k low bits */
+				ret = probe_rice_put(&enc, value & ((1u << k) - 1), k + 1);
+			}
+			if (ret < 0)
+				return ret;
+
+			sum[ch] += value;
+			if (++count[ch] == PROBE_RICE_RESET) {
+				sum[ch] >>= 1;
+				count[ch] >>= 1;
+			}
+		}
+	}
+
+	/* pad the last byte with zeros */
+	if (enc.bits) {
+		ret = probe_rice_put(&enc, 0, 8 - enc.bits);
+		if (ret < 0)
+			return ret;
+	}
+
+	return enc.w_ptr - dst;
+}
+
+/**
+ * \brief Send the data collected for a probe point as one packet.
+ * \param[in] ctx probe point context.
+ */
+static void probe_batch_flush(struct probe_point_ctx *ctx)
+{
+	struct probe_batch *batch = &ctx->batch;
+	int size;
+	int ret;
+
+	if (!batch->size)
+		return;
+
+	/* send the data uncompressed if it doesn't compress */
+	if (batch->packed) {
+		size = probe_rice_encode(batch->packed, batch->data, batch->size,
+					 batch->format);
+		if (size > 0) {
+			ret = probe_extract_packet(ctx->point->buffer_id.full_id,
+						   batch->format | (PROBE_COMPRESSION_RICE <<
+								    PROBE_SHIFT_COMPRESSION),
+						   batch->timestamp, batch->packed, size, NULL, 0);
+			goto out;
+		}
+	}
+
+	ret = probe_extract_packet(ctx->point->buffer_id.full_id, batch->format,
+				   batch->timestamp, batch->data, batch->size, NULL, 0);
+out:
+	if (ret < 0)
+		tr_err(&pr_tr, "failed to send batch of buffer %u",
+		       ctx->point->buffer_id.full_id);
+
+	batch->size = 0;
+}
+
+static void probe_batch_flush_all(struct probe_pdata *_probe)
+{
+	uint32_t i;
+
+	for (i = 0; i < CONFIG_PROBE_POINTS_MAX; i++)
+		if (_probe->ctx[i].batch.data)
+			probe_batch_flush(&_probe->ctx[i]);
+}
+
+/**
+ * \brief Add a transaction to the batch of a probe point. The batch is sent
+ *	  when the format changes or when the transaction doesn't fit in.
+ * \param[in] ctx probe point context.
+ * \param[in] format audio format.
+ * \param[in] head first part of data.
+ * \param[in] head_size first part size.
+ * \param[in] tail second part of data.
+ * \param[in] tail_size second part size.
+ * \return 0 on success, error code otherwise.
+ */
+static int probe_batch_add(struct probe_point_ctx *ctx, uint32_t format,
+			   void *head, uint32_t head_size,
+			   void *tail, uint32_t tail_size)
+{
+	struct probe_batch *batch = &ctx->batch;
+	uint32_t bytes = head_size + tail_size;
+
+	if (batch->size && (batch->format != format ||
+			    batch->size + bytes > CONFIG_PROBE_EXTRACTION_BATCH_SIZE))
+		probe_batch_flush(ctx);
+
+	/* too big to be batched, send it as is */
+	if (bytes > CONFIG_PROBE_EXTRACTION_BATCH_SIZE)
+		return probe_extract_packet(ctx->point->buffer_id.full_id, format,
+					    sof_cycle_get_64(), head, head_size,
+					    tail, tail_size);
+
+	if (!batch->size) {
+		batch->format = format;
+		batch->timestamp = sof_cycle_get_64();
+	}
+
+	memcpy_s(batch->data + batch->size, CONFIG_PROBE_EXTRACTION_BATCH_SIZE - batch->size,
+		 head, head_size);
+	batch->size += head_size;
+	memcpy_s(batch->data + batch->size, CONFIG_PROBE_EXTRACTION_BATCH_SIZE - batch->size,
+		 tail, tail_size);
+	batch->size += tail_size;
+
+	return 0;
+}
+
+/**
+ * \brief Add the selected channels of every decimation factor frame to the
+ *	  batch of a probe point, with integer samples optionally truncated
+ *	  to 16 bits.
+ * \param[in] ctx probe point context.
+ * \param[in] stream audio stream of the data.
+ * \param[in] data frames to add.
+ * \param[in] bytes size of the frames.
+ */
+static void probe_batch_add_reduced(struct probe_point_ctx *ctx,
+				    const struct audio_stream *stream,
+				    const uint8_t *data, uint32_t bytes)
+{
+	struct probe_extract_opts *opts = &ctx->opts;
+	struct probe_batch *batch = &ctx->batch;
+	enum sof_ipc_frame frame_fmt = audio_stream_get_frm_fmt(stream);
+	enum sof_ipc_frame out_fmt = frame_fmt;
+	uint32_t channels = audio_stream_get_channels(stream);
+	uint32_t frame_bytes = audio_stream_frame_bytes(stream);
+	uint32_t ch_mask = MASK(channels - 1, 0);
+	uint32_t out_frame_bytes;
+	uint32_t format;
+	uint32_t ch;
+	const uint8_t *end = data + bytes;
+	uint8_t *dst;
+	int32_t sample;
+
+	if (opts->ch_mask)
+		ch_mask &= opts->ch_mask;
+
+	if (!ch_mask || !frame_bytes)
+		return;
+
+	if (opts->s16 && frame_fmt != SOF_IPC_FRAME_FLOAT)
+		out_fmt = SOF_IPC_FRAME_S16_LE;
+
+	out_frame_bytes = __builtin_popcount(ch_mask) *
+		(out_fmt == SOF_IPC_FRAME_S16_LE ? sizeof(int16_t) : sizeof(int32_t));
+	format = probe_gen_format(out_fmt, audio_stream_get_rate(stream),
+				  __builtin_popcount(ch_mask)) |
+		 ((opts->decimation - 1) << PROBE_SHIFT_DECIMATION);
+
+	if (batch->size && batch->format != format)
+		probe_batch_flush(ctx);
+
+	for (; data < end; data += frame_bytes) {
+		if (opts->phase) {
+			opts->phase--;
+			continue;
+		}
+
+		opts->phase = opts->decimation - 1;
+		if (batch->size + out_frame_bytes > CONFIG_PROBE_EXTRACTION_BATCH_SIZE)
+			probe_batch_flush(ctx);
+
+		if (!batch->size) {
+			batch->format = format;
+			batch->timestamp = sof_cycle_get_64();
+		}
+
+		dst = batch->data + batch->size;
+		for (ch = 0; ch < channels; ch++) {
+			if (!(ch_mask & BIT(ch)))
+				continue;
+
+			switch (frame_fmt) {
+			case SOF_IPC_FRAME_S16_LE:
+				sample = ((const int16_t *)data)[ch];
+				break;
+			case SOF_IPC_FRAME_S24_4LE:
+				/* 16 bit result needs the top of 24 bits */
+				sample = ((const int32_t *)data)[ch];
+				if (out_fmt == SOF_IPC_FRAME_S16_LE)
+					sample = sign_extend_s24(sample) >> 8;
+				break;
+			default:
+				sample = ((const int32_t *)data)[ch];
+				if (out_fmt == SOF_IPC_FRAME_S16_LE)
+					sample >>= 16;
+				break;
+			}
+
+			if (out_fmt == SOF_IPC_FRAME_S16_LE) {
+				*(int16_t *)dst = sample;
+				dst += sizeof(int16_t);
+			} else {
+				*(int32_t *)dst = sample;
+				dst += sizeof(int32_t);
+			}
+		}
+
+		batch->size += out_frame_bytes;
+	}
+}
+#endif /* CONFIG_PROBE_EXTRACTION_BATCH */
+
 /**
  * \brief General extraction probe callback, called from buffer produce.
- *	  It will search for probe point connected to this buffer.
- *	  Extraction probe: generate format, header and copy data to probe buffer.
- *	  Injection probe: find corresponding DMA, check avail data, copy data,
+ *	  Extraction probe: generate format, header and copy data to probe buffer,
+ *	  or add the data to the batch of the probe point.
+ *	  Injection probe: check avail data of the probe point DMA, copy data,
  *	  update pointers and request more data from host if needed.
- * \param[in] arg pointer to buffer_id.
+ * \param[in] arg pointer to probe point context.
  * \param[in] cb_data pointer to buffer callback transaction data.
  */
 static void probe_cb_produce(void *arg, struct buffer_cb_transact *cb_data)
 {
 	struct probe_pdata *_probe = probe_get();
+	struct probe_point_ctx *ctx = arg;
 	struct comp_buffer *buffer = cb_data->buffer;
 	struct probe_dma_ext *dma;
-	uint32_t buffer_id;
 	uint32_t head, tail;
 	uint32_t free_bytes = 0;
 	int32_t copy_bytes = 0;
 	int ret;
-	uint32_t i, j;
 	uint32_t format;
-	uint64_t checksum;
-
-	buffer_id = *(uint32_t *)arg;
-
-	/* search for probe point connected to this buffer */
-	for (i = 0; i < CONFIG_PROBE_POINTS_MAX; i++)
-		if (_probe->probe_points[i].buffer_id.full_id == buffer_id)
-			break;
-
-	if (i == CONFIG_PROBE_POINTS_MAX) {
-		tr_err(&pr_tr, "probe not found for buffer id: %d",
-		       buffer_id);
-		return;
-	}
 
-	if (_probe->probe_points[i].purpose == PROBE_PURPOSE_EXTRACTION) {
+	if (ctx->point->purpose == PROBE_PURPOSE_EXTRACTION) {
 		format = probe_gen_format(audio_stream_get_frm_fmt(&buffer->stream),
 					  audio_stream_get_rate(&buffer->stream),
 					  audio_stream_get_channels(&buffer->stream));
-		ret = probe_gen_header(buffer_id,
-				       cb_data->transaction_amount,
-				       format, &checksum);
-		if (ret < 0)
-			goto err;
 
 		/* check if transaction amount exceeds component buffer end addr */
 		/* if yes: divide copying into two stages, head and tail */
@@ -948,45 +1334,36 @@ static void probe_cb_produce(void *arg, struct buffer_cb_transact *cb_data)
 			head = (uintptr_t)audio_stream_get_end_addr(&buffer->stream) -
 			       (uintptr_t)cb_data->transaction_begin_address;
 			tail = (uintptr_t)cb_data->transaction_amount - head;
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      cb_data->transaction_begin_address,
-					      head);
-			if (ret < 0)
-				goto err;
-
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      audio_stream_get_addr(&buffer->stream), tail);
-			if (ret < 0)
-				goto err;
 		} else {
-			ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-					      cb_data->transaction_begin_address,
-					      cb_data->transaction_amount);
-			if (ret < 0)
-				goto err;
+			head = cb_data->transaction_amount;
+			tail = 0;
 		}
 
-		ret = copy_to_pbuffer(&_probe->ext_dma.dmapb,
-				      &checksum, sizeof(checksum));
+#if CONFIG_PROBE_EXTRACTION_BATCH
+		if (ctx->opts.ch_mask || ctx->opts.decimation > 1 || ctx->opts.s16 ||
+		    ctx->opts.rice) {
+			probe_batch_add_reduced(ctx, &buffer->stream,
+						cb_data->transaction_begin_address, head);
+			probe_batch_add_reduced(ctx, &buffer->stream,
+						audio_stream_get_addr(&buffer->stream), tail);
+			ret = 0;
+		} else {
+			ret = probe_batch_add(ctx, format, cb_data->transaction_begin_address,
+					      head, audio_stream_get_addr(&buffer->stream), tail);
+		}
+#else
+		ret = probe_extract_packet(ctx->point->buffer_id.full_id, format,
+					   sof_cycle_get_64(),
+					   cb_data->transaction_begin_address, head,
+					   audio_stream_get_addr(&buffer->stream), tail);
+#endif
 		if (ret < 0)
 			goto err;
 
 		kick_probe_task(_probe);
 	} else {
-		/* search for DMA used by this probe point */
-		for (j = 0; j < CONFIG_PROBE_DMA_MAX; j++) {
-			if (_probe->inject_dma[j].stream_tag !=
-			    PROBE_DMA_INVALID &&
-			    _probe->inject_dma[j].stream_tag ==
-			    _probe->probe_points[i].stream_tag) {
-				break;
-			}
-		}
-		if (j == CONFIG_PROBE_DMA_MAX) {
-			tr_err(&pr_tr, "dma not found");
-			return;
-		}
-		dma = &_probe->inject_dma[j];
+		/* DMA used by this probe point, set on attach */
+		dma = ctx->dma;
 		/* get avail data info */
 #if CONFIG_ZEPHYR_NATIVE_DRIVERS
 		struct dma_status stat;
@@ -1065,11 +1442,12 @@ err:
 
 /**
  * \brief Callback for buffer free, it will remove probe point.
- * \param[in] arg pointer to buffer_id.
+ * \param[in] arg pointer to probe point context.
  */
 static void probe_cb_free(void *arg)
 {
-	uint32_t buffer_id = *(uint32_t *)arg;
+	struct probe_point_ctx *ctx = arg;
+	uint32_t buffer_id = ctx->point->buffer_id.full_id;
 	int ret;
 
 	tr_dbg(&pr_tr, "buffer_id = %u", buffer_id);
@@ -1146,6 +1524,8 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 	uint32_t first_free;
 	uint32_t dma_found;
 	uint32_t fw_logs;
+	struct probe_point_ctx *ctx;
+	struct probe_dma_ext *dma = NULL;
 	struct ipc_comp_dev *dev = NULL;
 #if CONFIG_IPC_MAJOR_4
 	struct comp_buffer *buf = NULL;
@@ -1161,21 +1541,31 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 	/* add all probe points if they are corresponding to valid component and DMA */
 	for (i = 0; i < count; i++) {
 		const probe_point_id_t *buf_id = &probe[i].buffer_id;
+		uint32_t purpose = probe[i].purpose & PROBE_PURPOSE_MASK;
+		uint32_t options = probe[i].purpose & ~PROBE_PURPOSE_MASK;
 		uint32_t stream_tag;
 
 		tr_dbg(&pr_tr, "\tprobe[%u] buffer_id = %u, purpose = %u, stream_tag = %u",
 		       i, buf_id->full_id, probe[i].purpose,
 		       probe[i].stream_tag);
 
-		if (!verify_purpose(probe[i].purpose)) {
+		if (!verify_purpose(purpose)) {
 			tr_err(&pr_tr, "error: invalid purpose %d",
-			       probe[i].purpose);
+			       purpose);
+
+			return -EINVAL;
+		}
+
+		if (options && (purpose != PROBE_PURPOSE_EXTRACTION ||
+				!IS_ENABLED(CONFIG_PROBE_EXTRACTION_BATCH))) {
+			tr_err(&pr_tr, "error: options %#x not supported for purpose %u",
+			       options, purpose);
 
 			return -EINVAL;
 		}
 
 		if (_probe->ext_dma.stream_tag == PROBE_DMA_INVALID &&
-		    probe_purpose_needs_ext_dma(probe[i].purpose)) {
+		    probe_purpose_needs_ext_dma(purpose)) {
 			tr_err(&pr_tr, "extraction DMA not enabled.");
 			return -EINVAL;
 		}
@@ -1229,11 +1619,9 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 			/* and check if probe is already attached */
 			buffer_id = _probe->probe_points[j].buffer_id.full_id;
 			if (buffer_id == buf_id->full_id) {
-				if (_probe->probe_points[j].purpose ==
-				    probe[i].purpose) {
+				if (_probe->probe_points[j].purpose == purpose) {
 					tr_err(&pr_tr, "Probe already attached to buffer %u with purpose %u",
-					       buffer_id,
-					       probe[i].purpose);
+					       buffer_id, purpose);
 
 					return -EINVAL;
 				}
@@ -1248,7 +1636,7 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 		}
 
 		/* if connecting injection probe, check for associated DMA */
-		if (probe[i].purpose == PROBE_PURPOSE_INJECTION) {
+		if (purpose == PROBE_PURPOSE_INJECTION) {
 			dma_found = 0;
 
 			for (j = 0; j < CONFIG_PROBE_DMA_MAX; j++) {
@@ -1279,6 +1667,7 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 			}
 
 			stream_tag = probe[i].stream_tag;
+			dma = &_probe->inject_dma[j];
 		} else {
 			/* prepare extraction DMA */
 			for (j = 0; j < CONFIG_PROBE_POINTS_MAX; j++) {
@@ -1295,11 +1684,47 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 			stream_tag = _probe->ext_dma.stream_tag;
 		}
 
+#if CONFIG_PROBE_EXTRACTION_BATCH
+		ctx = &_probe->ctx[first_free];
+		if (!fw_logs && purpose == PROBE_PURPOSE_EXTRACTION) {
+			ctx->opts.ch_mask = (options & PROBE_OPT_MASK_CH_MASK) >>
+					    PROBE_OPT_SHIFT_CH_MASK;
+			ctx->opts.decimation = ((options & PROBE_OPT_MASK_DECIMATION) >>
+						PROBE_OPT_SHIFT_DECIMATION) + 1;
+			ctx->opts.phase = 0;
+			ctx->opts.s16 = !!(options & PROBE_OPT_MASK_S16);
+			ctx->opts.rice = !!(options & PROBE_OPT_MASK_RICE);
+
+			ctx->batch.data = rmalloc(SOF_MEM_FLAG_USER,
+						  CONFIG_PROBE_EXTRACTION_BATCH_SIZE);
+			if (!ctx->batch.data) {
+				tr_err(&pr_tr, "batch alloc failed");
+				return -ENOMEM;
+			}
+			ctx->batch.size = 0;
+
+			if (ctx->opts.rice) {
+				ctx->batch.packed = rmalloc(SOF_MEM_FLAG_USER,
+							    CONFIG_PROBE_EXTRACTION_BATCH_SIZE);
+				if (!ctx->batch.packed) {
+					tr_err(&pr_tr, "batch alloc failed");
+					rfree(ctx->batch.data);
+					ctx->batch.data = NULL;
+					return -ENOMEM;
+				}
+			}
+		}
+#endif
+
 		/* probe point valid, save it */
 		_probe->probe_points[first_free].buffer_id = *buf_id;
-		_probe->probe_points[first_free].purpose = probe[i].purpose;
+		_probe->probe_points[first_free].purpose = purpose;
 		_probe->probe_points[first_free].stream_tag = stream_tag;
 
+		ctx = &_probe->ctx[first_free];
+		ctx->point = &_probe->probe_points[first_free];
+		ctx->dma = dma;
+
 		if (fw_logs) {
 #if CONFIG_LOG_BACKEND_SOF_PROBE
 			probe_logging_init(probe_logging_hook);
@@ -1307,8 +1732,6 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 			return -EINVAL;
 #endif
 		} else {
-			probe_point_id_t *new_buf_id = &_probe->probe_points[first_free].buffer_id;
-
 #if CONFIG_IPC_MAJOR_4
 			struct comp_buffer *probe_buf = buf;
 #else
@@ -1316,7 +1739,7 @@ int probe_point_add(uint32_t count, const struct probe_point *probe)
 #endif
 			probe_buf->probe_cb_produce = probe_cb_produce;
 			probe_buf->probe_cb_free = probe_cb_free;
-			probe_buf->probe_cb_arg = &new_buf_id->full_id;
+			probe_buf->probe_cb_arg = ctx;
 		}
 	}
 
@@ -1451,6 +1874,15 @@ int probe_point_remove(uint32_t count, const uint32_t *buffer_id)
 					probe_buf->probe_cb_free = NULL;
 					probe_buf->probe_cb_arg = NULL;
 				}
+#endif
+#if CONFIG_PROBE_EXTRACTION_BATCH
+				if (_probe->ctx[j].batch.data) {
+					probe_batch_flush(&_probe->ctx[j]);
+					rfree(_probe->ctx[j].batch.data);
+					rfree(_probe->ctx[j].batch.packed);
+					_probe->ctx[j].batch.data = NULL;
+					_probe->ctx[j].batch.packed = NULL;
+				}
 #endif
 				_probe->probe_points[j].stream_tag =
 					PROBE_POINT_INVALID;
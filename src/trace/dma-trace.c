@@ -10,6 +10,7 @@
 #include <sof/ipc/msg.h>
 #include <rtos/alloc.h>
 #include <rtos/cache.h>
+#include <rtos/interrupt.h>
 #include <sof/lib/cpu.h>
 #include <sof/lib/dma.h>
 #include <sof/lib/memory.h>
@@ -27,6 +28,7 @@
 #include <ipc/trace.h>
 #include <kernel/abi.h>
 #include <user/abi_dbg.h>
+#include <user/trace.h>
 #include <sof_versions.h>
 
 #ifdef __ZEPHYR__
@@ -48,6 +50,8 @@ SOF_DEFINE_REG_UUID(dma_trace_task);
 static int dma_trace_get_avail_data(struct dma_trace_data *d,
 				    struct dma_trace_buf *buffer,
 				    int avail);
+static void dtrace_merge_rings(struct dma_trace_data *d);
+static void dtrace_merge_rings_unlocked(struct dma_trace_data *d);
 
 /** Periodically runs and starts the DMA even when the buffer is not
  * full.
@@ -58,10 +62,14 @@ static enum task_state trace_work(void *data)
 	struct dma_trace_buf *buffer = &d->dmatb;
 	struct dma_sg_config *config = &d->config;
 	k_spinlock_key_t key;
-	uint32_t avail = buffer->avail;
+	uint32_t avail;
 	int32_t size;
 	uint32_t overflow;
 
+	/* collect the records from all cores */
+	dtrace_merge_rings(d);
+	avail = buffer->avail;
+
 	/* The host DMA channel is not available */
 	if (!d->dc.chan)
 		return SOF_TASK_STATE_RESCHEDULE;
@@ -247,6 +255,35 @@ static void dma_trace_buffer_free(struct dma_trace_data *d)
 	k_spin_unlock(&d->lock, key);
 }
 
+/* The rings are kept once allocated, other cores may be writing to them */
+static int dma_trace_rings_init(struct dma_trace_data *d)
+{
+	const uint32_t ring_size = ALIGN_DOWN(DMA_TRACE_LOCAL_SIZE / 2, sizeof(uint32_t));
+	uint8_t *buf;
+	int i;
+
+	if (d->ring[0].data)
+		return 0;
+
+	/* Coherent memory as the primary core reads the other cores' rings */
+	buf = rzalloc(SOF_MEM_FLAG_USER | SOF_MEM_FLAG_COHERENT,
+		      ring_size * CONFIG_CORE_COUNT);
+	if (!buf) {
+		mtrace_printf(LOG_LEVEL_ERROR, "ring alloc failed");
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+		d->ring[i].size = ring_size;
+		atomic_init(&d->ring[i].w_off, 0);
+		atomic_init(&d->ring[i].r_off, 0);
+		d->ring[i].dropped_entries = 0;
+		d->ring[i].data = buf + i * ring_size;
+	}
+
+	return 0;
+}
+
 static int dma_trace_buffer_init(struct dma_trace_data *d)
 {
 	struct dma_trace_buf *buffer = &d->dmatb;
@@ -281,6 +318,10 @@ static int dma_trace_buffer_init(struct dma_trace_data *d)
 	if (err < 0)
 		return err;
 
+	err = dma_trace_rings_init(d);
+	if (err < 0)
+		return err;
+
 	/* For DMA to work properly the buffer must be correctly aligned */
 	buf = rballoc_align(SOF_MEM_FLAG_USER | SOF_MEM_FLAG_DMA,
 			    DMA_TRACE_LOCAL_SIZE, addr_align);
@@ -426,6 +467,12 @@ void dma_trace_flush(void *t)
 	if (!dma_trace_initialized(trace_data))
 		return;
 
+	/* only the primary core consumes the rings, no locking as this
+	 * is used on panic when the lock may be already held
+	 */
+	if (cpu_get_id() == PLATFORM_PRIMARY_CORE_ID)
+		dtrace_merge_rings_unlocked(trace_data);
+
 	buffer = &trace_data->dmatb;
 	avail = buffer->avail;
 
@@ -521,73 +568,199 @@ static int dtrace_calc_buf_overflow(struct dma_trace_buf *buffer,
 	return overflow;
 }
 
-/** Ring buffer implementation, drops on overflow. */
-static void dtrace_add_event(const char *e, uint32_t length)
+/** Copies a record to the DMA buffer, the caller checks for overflow */
+static void dtrace_buf_write(struct dma_trace_buf *buffer, const char *e, uint32_t length)
 {
-	struct dma_trace_data *trace_data = dma_trace_data_get();
-	struct dma_trace_buf *buffer = &trace_data->dmatb;
-	uint32_t margin;
-	uint32_t overflow;
+	uint32_t margin = dtrace_calc_buf_margin(buffer);
 	int ret;
 
-	margin = dtrace_calc_buf_margin(buffer);
-	overflow = dtrace_calc_buf_overflow(buffer, length);
+	/* check for buffer wrap */
+	if (margin > length) {
+		/* no wrap */
+		dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
+					 length);
+		ret = memcpy_s(buffer->w_ptr, length, e, length);
+		assert(!ret);
+		dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
+					length);
+		buffer->w_ptr = (char *)buffer->w_ptr + length;
+	} else {
+		/* data is bigger than remaining margin so we wrap */
+		dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
+					 margin);
+		ret = memcpy_s(buffer->w_ptr, margin, e, margin);
+		assert(!ret);
+		dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
+					margin);
+		buffer->w_ptr = buffer->addr;
+
+		dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
+					 length - margin);
+		ret = memcpy_s(buffer->w_ptr, length - margin,
+			       e + margin, length - margin);
+		assert(!ret);
+		dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
+					length - margin);
+		buffer->w_ptr = (char *)buffer->w_ptr + length - margin;
+	}
+}
 
-	/* tracing dropped entries */
-	if (trace_data->dropped_entries) {
-		if (!overflow) {
-			/*
-			 * if any dropped entries have appeared and there
-			 * is not any overflow, their amount will be logged
-			 */
-			uint32_t tmp_dropped_entries =
-				trace_data->dropped_entries;
-			trace_data->dropped_entries = 0;
-			mtrace_printf(LOG_LEVEL_WARNING,
-				      "number of dropped logs = %u",
-				      tmp_dropped_entries);
-		}
+/*
+ * Ring offsets are shared between cores. The atomic store of an offset
+ * orders it after the record accesses before it and the atomic load orders
+ * it before the record accesses after it, so a record is only read once it
+ * is written and its space is only reused once it is read.
+ */
+
+/** Returns the oldest record in the ring or NULL if the ring is empty */
+static const char *dtrace_ring_peek(struct dma_trace_ring *ring, uint32_t *length)
+{
+	uint32_t w_off = atomic_read(&ring->w_off);
+	uint32_t r_off = atomic_read(&ring->r_off);
+	uint32_t len;
+
+	if (r_off == w_off)
+		return NULL;
+
+	len = *(volatile uint32_t *)(ring->data + r_off);
+	if (!len) {
+		/* wrap marker, the record is at the ring start */
+		r_off = 0;
+		atomic_set(&ring->r_off, r_off);
+		len = *(volatile uint32_t *)ring->data;
 	}
 
-	/* checking overflow */
-	if (!overflow) {
-		/* check for buffer wrap */
-		if (margin > length) {
-			/* no wrap */
-			dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						 length);
-			ret = memcpy_s(buffer->w_ptr, length, e, length);
-			assert(!ret);
-			dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						length);
-			buffer->w_ptr = (char *)buffer->w_ptr + length;
-		} else {
-			/* data is bigger than remaining margin so we wrap */
-			dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						 margin);
-			ret = memcpy_s(buffer->w_ptr, margin, e, margin);
-			assert(!ret);
-			dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						margin);
-			buffer->w_ptr = buffer->addr;
-
-			dcache_invalidate_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						 length - margin);
-			ret = memcpy_s(buffer->w_ptr, length - margin,
-				       e + margin, length - margin);
-			assert(!ret);
-			dcache_writeback_region((__sparse_force void __sparse_cache *)buffer->w_ptr,
-						length - margin);
-			buffer->w_ptr = (char *)buffer->w_ptr + length - margin;
+	*length = len;
+	return (const char *)ring->data + r_off + sizeof(uint32_t);
+}
+
+static void dtrace_ring_consume(struct dma_trace_ring *ring, uint32_t length)
+{
+	uint32_t r_off = atomic_read(&ring->r_off) + sizeof(uint32_t) +
+		ALIGN_UP(length, sizeof(uint32_t));
+
+	if (r_off >= ring->size)
+		r_off = 0;
+
+	atomic_set(&ring->r_off, r_off);
+}
+
+static uint64_t dtrace_record_timestamp(const char *e, uint32_t length)
+{
+	const struct log_entry_header *hdr = (const struct log_entry_header *)e;
+
+	/* records without a log header go out first */
+	return length >= sizeof(*hdr) ? hdr->timestamp : 0;
+}
+
+/** Moves the records from the per core rings to the DMA buffer in
+ * timestamp order. Runs on the primary core, the caller holds the lock.
+ */
+static void dtrace_merge_rings_unlocked(struct dma_trace_data *d)
+{
+	struct dma_trace_buf *buffer = &d->dmatb;
+	const char *e;
+	const char *next_e = NULL;
+	uint32_t length;
+	uint32_t next_length = 0;
+	uint64_t next_ts = 0;
+	uint64_t ts;
+	int next;
+	int i;
+
+	if (!d->ring[0].data)
+		return;
+
+	for (;;) {
+		/* find the oldest record of the heads of the rings */
+		next = -1;
+		for (i = 0; i < CONFIG_CORE_COUNT; i++) {
+			e = dtrace_ring_peek(&d->ring[i], &length);
+			if (!e)
+				continue;
+
+			ts = dtrace_record_timestamp(e, length);
+			if (next < 0 || ts < next_ts) {
+				next = i;
+				next_e = e;
+				next_length = length;
+				next_ts = ts;
+			}
 		}
 
-		buffer->avail += length;
-		trace_data->posn.messages++;
-	} else {
+		/* done, or no space until the DMA has copied to host */
+		if (next < 0 || dtrace_calc_buf_overflow(buffer, next_length))
+			break;
+
+		dtrace_buf_write(buffer, next_e, next_length);
+		buffer->avail += next_length;
+		d->posn.messages++;
+		dtrace_ring_consume(&d->ring[next], next_length);
+	}
+}
+
+static void dtrace_merge_rings(struct dma_trace_data *d)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&d->lock);
+	dtrace_merge_rings_unlocked(d);
+	k_spin_unlock(&d->lock, key);
+}
+
+/** Per core ring implementation, drops on overflow. */
+static void dtrace_add_event(const char *e, uint32_t length)
+{
+	struct dma_trace_data *trace_data = dma_trace_data_get();
+	struct dma_trace_ring *ring = &trace_data->ring[cpu_get_id()];
+	uint32_t size = sizeof(uint32_t) + ALIGN_UP(length, sizeof(uint32_t));
+	uint32_t r_off = atomic_read(&ring->r_off);
+	uint32_t w_off = atomic_read(&ring->w_off);
+	uint32_t margin = ring->size - w_off;
+	uint32_t free;
+	int ret;
+
+	/* one word is kept unused so that equal offsets mean empty */
+	if (r_off > w_off)
+		free = r_off - w_off - sizeof(uint32_t);
+	else
+		free = margin + r_off - sizeof(uint32_t);
+
+	/* a record that doesn't fit before the end starts from ring start */
+	if (size > margin && free >= margin + size) {
+		*(volatile uint32_t *)(ring->data + w_off) = 0;
+		w_off = 0;
+	} else if (size > margin || free < size) {
 		/* if there is not enough memory for new log, we drop it */
-		trace_data->dropped_entries++;
+		ring->dropped_entries++;
+		return;
 	}
 
+	/* tracing dropped entries */
+	if (ring->dropped_entries) {
+		/*
+		 * if any dropped entries have appeared and there
+		 * is not any overflow, their amount will be logged
+		 */
+		uint32_t tmp_dropped_entries = ring->dropped_entries;
+
+		ring->dropped_entries = 0;
+		mtrace_printf(LOG_LEVEL_WARNING,
+			      "number of dropped logs = %u",
+			      tmp_dropped_entries);
+	}
+
+	*(volatile uint32_t *)(ring->data + w_off) = length;
+	ret = memcpy_s(ring->data + w_off + sizeof(uint32_t), ring->size - w_off - sizeof(uint32_t),
+		       e, length);
+	assert(!ret);
+
+	w_off += size;
+	if (w_off >= ring->size)
+		w_off = 0;
+
+	/* publish the record, it is written before the new offset */
+	atomic_set(&ring->w_off, w_off);
 }
 
 /** Main dma-trace entry point */
@@ -595,7 +768,11 @@ void dtrace_event(const char *e, uint32_t length)
 {
 	struct dma_trace_data *trace_data = dma_trace_data_get();
 	struct dma_trace_buf *buffer = NULL;
-	k_spinlock_key_t key;
+	struct dma_trace_ring *ring;
+	uint32_t flags;
+	uint32_t w_off;
+	uint32_t r_off;
+	uint32_t used;
 
 	if (!dma_trace_initialized(trace_data) ||
 	    length > DMA_TRACE_LOCAL_SIZE / 8 || length == 0) {
@@ -604,23 +781,28 @@ void dtrace_event(const char *e, uint32_t length)
 
 	buffer = &trace_data->dmatb;
 
-	key = k_spin_lock(&trace_data->lock);
+	/* The ring is written only by this core, so masking the local
+	 * interrupts is enough to serialize the writers.
+	 */
+	irq_local_disable(flags);
 	dtrace_add_event(e, length);
+	irq_local_enable(flags);
 
 	/* if DMA trace copying is working or secondary core
 	 * don't check if local buffer is half full
 	 */
 	if (trace_data->copy_in_progress ||
-	    cpu_get_id() != PLATFORM_PRIMARY_CORE_ID) {
-		k_spin_unlock(&trace_data->lock, key);
+	    cpu_get_id() != PLATFORM_PRIMARY_CORE_ID)
 		return;
-	}
 
-	k_spin_unlock(&trace_data->lock, key);
+	ring = &trace_data->ring[PLATFORM_PRIMARY_CORE_ID];
+	w_off = atomic_read(&ring->w_off);
+	r_off = atomic_read(&ring->r_off);
+	used = w_off >= r_off ? w_off - r_off : ring->size - r_off + w_off;
 
 	/* schedule copy now if buffer > 50% full */
 	if (trace_data->enabled &&
-	    buffer->avail >= (DMA_TRACE_LOCAL_SIZE / 2)) {
+	    (buffer->avail >= (DMA_TRACE_LOCAL_SIZE / 2) || used >= ring->size / 2)) {
 		reschedule_task(&trace_data->dmat_work,
 				DMA_TRACE_RESCHEDULE_TIME);
 		/* reschedule should not be interrupted
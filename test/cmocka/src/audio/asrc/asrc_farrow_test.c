@@ -0,0 +1,342 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/module_adapter/module/generic.h>
+#include <sof/audio/format.h>
+#include "asrc_farrow.h"
+
+#define TEST_CHANNELS_MAX	8
+#define TEST_FILTER_LENGTH	64
+#define TEST_BLOCK_FRAMES	48
+#define TEST_OUT_FRAMES		64
+#define TEST_TONE_HZ		997.0
+#define TEST_TONE_AMPLITUDE	0.891	/* -1 dBFS */
+#define TEST_SETTLE_FRAMES	512
+#define TEST_MEASURE_FRAMES	4096
+
+/* Minimum signal to noise and distortion ratio of the converted tone */
+#define TEST_SINAD_DB_S16	85.0
+#define TEST_SINAD_DB_S32	90.0
+
+static struct comp_dev test_dev;
+static struct processing_module test_mod = {
+	.dev = &test_dev,
+};
+
+/* Channel by channel filter, as the FIR was computed before channel blocking */
+static int64_t ref_fir(const struct asrc_farrow *src_obj, const int32_t *buffer32,
+		       const int16_t *buffer16)
+{
+	int64_t prod = 0;
+	int n;
+
+	for (n = 0; n < src_obj->filter_length; n++) {
+		if (buffer32)
+			prod += (int64_t)buffer32[n] * (src_obj->impulse_response[n] >> 8);
+		else
+			prod += (int64_t)buffer16[n] * src_obj->impulse_response[n];
+	}
+
+	return prod;
+}
+
+static void test_fir_setup(struct asrc_farrow *src_obj, int32_t *impulse_response,
+			   int num_channels, enum asrc_io_format format)
+{
+	int n;
+
+	memset(src_obj, 0, sizeof(*src_obj));
+	src_obj->num_channels = num_channels;
+	src_obj->filter_length = TEST_FILTER_LENGTH;
+	src_obj->buffer_length = 2 * TEST_FILTER_LENGTH;
+	src_obj->buffer_write_position = rand() % TEST_FILTER_LENGTH;
+	src_obj->output_format = format;
+	src_obj->impulse_response = impulse_response;
+
+	/* Q1.30 impulse response with large values to exercise saturation */
+	for (n = 0; n < TEST_FILTER_LENGTH; n++)
+		impulse_response[n] = (int32_t)((rand() & 0xffff) << 16 | (rand() & 0xffff));
+}
+
+/* Blocked filter matches the channel by channel filter for all channel counts */
+static void test_asrc_fir_filter32(void **state)
+{
+	static int32_t delay[TEST_CHANNELS_MAX][2 * TEST_FILTER_LENGTH];
+	static int32_t out[3 * TEST_CHANNELS_MAX];
+	int32_t impulse_response[TEST_FILTER_LENGTH];
+	int32_t *ring_buffers[TEST_CHANNELS_MAX];
+	int32_t *output_buffers[TEST_CHANNELS_MAX];
+	struct asrc_farrow src_obj;
+	enum asrc_io_format format;
+	int64_t prod;
+	int32_t ref;
+	int channels;
+	int ch;
+	int n;
+
+	(void)state;
+
+	for (format = ASRC_IOF_DEINTERLEAVED; format <= ASRC_IOF_INTERLEAVED; format++) {
+		for (channels = 1; channels <= TEST_CHANNELS_MAX; channels++) {
+			test_fir_setup(&src_obj, impulse_response, channels, format);
+			src_obj.ring_buffers32 = ring_buffers;
+			for (ch = 0; ch < channels; ch++) {
+				for (n = 0; n < 2 * TEST_FILTER_LENGTH; n++)
+					delay[ch][n] = (int32_t)((rand() & 0xffff) << 16 |
+								 (rand() & 0xffff));
+				ring_buffers[ch] = delay[ch];
+				output_buffers[ch] = format == ASRC_IOF_INTERLEAVED ?
+					out + ch : out + ch * 3;
+			}
+
+			asrc_fir_filter32(&src_obj, output_buffers, 1);
+
+			for (ch = 0; ch < channels; ch++) {
+				prod = ref_fir(&src_obj,
+					       &delay[ch][src_obj.buffer_write_position], NULL);
+				ref = sat_int32(Q_SHIFT(prod, 53, 31));
+				n = format == ASRC_IOF_INTERLEAVED ? channels : 1;
+				assert_int_equal(output_buffers[ch][n], ref);
+			}
+		}
+	}
+}
+
+static void test_asrc_fir_filter16(void **state)
+{
+	static int16_t delay[TEST_CHANNELS_MAX][2 * TEST_FILTER_LENGTH];
+	static int16_t out[3 * TEST_CHANNELS_MAX];
+	int32_t impulse_response[TEST_FILTER_LENGTH];
+	int16_t *ring_buffers[TEST_CHANNELS_MAX];
+	int16_t *output_buffers[TEST_CHANNELS_MAX];
+	struct asrc_farrow src_obj;
+	enum asrc_io_format format;
+	int64_t prod;
+	int32_t prod32;
+	int16_t ref;
+	int channels;
+	int ch;
+	int n;
+
+	(void)state;
+
+	for (format = ASRC_IOF_DEINTERLEAVED; format <= ASRC_IOF_INTERLEAVED; format++) {
+		for (channels = 1; channels <= TEST_CHANNELS_MAX; channels++) {
+			test_fir_setup(&src_obj, impulse_response, channels, format);
+			src_obj.ring_buffers16 = ring_buffers;
+			for (ch = 0; ch < channels; ch++) {
+				for (n = 0; n < 2 * TEST_FILTER_LENGTH; n++)
+					delay[ch][n] = (int16_t)rand();
+				ring_buffers[ch] = delay[ch];
+				output_buffers[ch] = format == ASRC_IOF_INTERLEAVED ?
+					out + ch : out + ch * 3;
+			}
+
+			asrc_fir_filter16(&src_obj, output_buffers, 1);
+
+			for (ch = 0; ch < channels; ch++) {
+				prod = ref_fir(&src_obj, NULL,
+					       &delay[ch][src_obj.buffer_write_position]);
+				prod32 = sat_int32(Q_SHIFT(prod, 45, 31));
+				ref = sat_int16(Q_SHIFT_RND(prod32, 31, 15));
+				n = format == ASRC_IOF_INTERLEAVED ? channels : 1;
+				assert_int_equal(output_buffers[ch][n], ref);
+			}
+		}
+	}
+}
+
+struct test_asrc {
+	struct asrc_farrow *src_obj;
+	void *delay;
+	int channels;
+	int bit_depth;
+};
+
+static void test_asrc_create(struct test_asrc *t, int channels, int bit_depth,
+			     int fs_in, int fs_out)
+{
+	int sample_bytes = bit_depth / 8;
+	int size;
+	int ch;
+
+	t->channels = channels;
+	t->bit_depth = bit_depth;
+	assert_int_equal(asrc_get_required_size(&test_mod, &size, channels, bit_depth),
+			 ASRC_EC_OK);
+	t->src_obj = calloc(1, size);
+	assert_non_null(t->src_obj);
+	assert_int_equal(asrc_initialise(&test_mod, t->src_obj, channels, fs_in, fs_out,
+					 ASRC_IOF_INTERLEAVED, ASRC_IOF_INTERLEAVED,
+					 ASRC_BM_LINEAR, TEST_OUT_FRAMES, bit_depth,
+					 ASRC_CM_FEEDBACK, ASRC_OM_PUSH), ASRC_EC_OK);
+
+	/* mirrored delay lines of all channels in one block, as the component does */
+	t->src_obj->buffer_length = t->src_obj->filter_length * 2;
+	t->src_obj->buffer_write_position = t->src_obj->filter_length - 1;
+	t->delay = calloc(channels, t->src_obj->buffer_length * sample_bytes);
+	assert_non_null(t->delay);
+	for (ch = 0; ch < channels; ch++) {
+		if (bit_depth == 32)
+			t->src_obj->ring_buffers32[ch] = (int32_t *)t->delay +
+				ch * t->src_obj->buffer_length;
+		else
+			t->src_obj->ring_buffers16[ch] = (int16_t *)t->delay +
+				ch * t->src_obj->buffer_length;
+	}
+
+	assert_int_equal(asrc_update_drift(&test_dev, t->src_obj, Q_CONVERT_FLOAT(1.0, 30)),
+			 ASRC_EC_OK);
+}
+
+static void test_asrc_free(struct test_asrc *t)
+{
+	asrc_free_polyphase_filter(&test_mod, t->src_obj);
+	free(t->delay);
+	free(t->src_obj);
+}
+
+/* Converts a tone and returns the worst channel SINAD in dB. The tone is
+ * fitted to the output by least squares and the residual is the noise and
+ * distortion of the conversion.
+ */
+static double test_asrc_sinad(int channels, int bit_depth, int fs_in, int fs_out)
+{
+	static int32_t in32[TEST_BLOCK_FRAMES * TEST_CHANNELS_MAX];
+	static int32_t out32[TEST_OUT_FRAMES * TEST_CHANNELS_MAX];
+	static int16_t in16[TEST_BLOCK_FRAMES * TEST_CHANNELS_MAX];
+	static int16_t out16[TEST_OUT_FRAMES * TEST_CHANNELS_MAX];
+	static double y[TEST_CHANNELS_MAX][TEST_SETTLE_FRAMES + TEST_MEASURE_FRAMES];
+	const int total = TEST_SETTLE_FRAMES + TEST_MEASURE_FRAMES;
+	const double scale = bit_depth == 32 ? 2147483648.0 : 32768.0;
+	void *input_buffers[TEST_CHANNELS_MAX];
+	void *output_buffers[TEST_CHANNELS_MAX];
+	struct test_asrc t;
+	double sinad = 1000.0;
+	double w_in = 2.0 * M_PI * TEST_TONE_HZ / fs_in;
+	double w_out = 2.0 * M_PI * TEST_TONE_HZ / fs_out;
+	double ss, sc, cc, ys, yc, det, a, b, e, noise, signal;
+	long in_frame = 0;
+	int num_out = 0;
+	int in_frames;
+	int out_frames;
+	int write_index;
+	int ch, i, n;
+
+	test_asrc_create(&t, channels, bit_depth, fs_in, fs_out);
+	for (ch = 0; ch < channels; ch++) {
+		input_buffers[ch] = bit_depth == 32 ? (void *)(in32 + ch) : (void *)(in16 + ch);
+		output_buffers[ch] = bit_depth == 32 ? (void *)(out32 + ch) : (void *)(out16 + ch);
+	}
+
+	while (num_out < total) {
+		/* a different phase per channel */
+		for (i = 0; i < TEST_BLOCK_FRAMES; i++) {
+			for (ch = 0; ch < channels; ch++) {
+				e = TEST_TONE_AMPLITUDE * sin(w_in * (in_frame + i) + ch) * scale;
+				if (bit_depth == 32)
+					in32[i * channels + ch] = sat_int32((int64_t)lrint(e));
+				else
+					in16[i * channels + ch] = sat_int16(lrint(e));
+			}
+		}
+
+		in_frames = TEST_BLOCK_FRAMES;
+		if (bit_depth == 32)
+			assert_int_equal(asrc_process_push32(&test_dev, t.src_obj,
+							     (int32_t **)input_buffers, &in_frames,
+							     (int32_t **)output_buffers,
+							     &out_frames, &write_index, 0),
+					 ASRC_EC_OK);
+		else
+			assert_int_equal(asrc_process_push16(&test_dev, t.src_obj,
+							     (int16_t **)input_buffers, &in_frames,
+							     (int16_t **)output_buffers,
+							     &out_frames, &write_index, 0),
+					 ASRC_EC_OK);
+
+		assert_int_equal(in_frames, TEST_BLOCK_FRAMES);
+		in_frame += in_frames;
+
+		for (i = 0; i < out_frames && num_out < total; i++, num_out++)
+			for (ch = 0; ch < channels; ch++)
+				y[ch][num_out] = (bit_depth == 32 ?
+						  out32[i * channels + ch] :
+						  out16[i * channels + ch]) / scale;
+	}
+
+	for (ch = 0; ch < channels; ch++) {
+		ss = 0;
+		sc = 0;
+		cc = 0;
+		ys = 0;
+		yc = 0;
+		for (n = TEST_SETTLE_FRAMES; n < total; n++) {
+			ss += sin(w_out * n) * sin(w_out * n);
+			sc += sin(w_out * n) * cos(w_out * n);
+			cc += cos(w_out * n) * cos(w_out * n);
+			ys += y[ch][n] * sin(w_out * n);
+			yc += y[ch][n] * cos(w_out * n);
+		}
+
+		det = ss * cc - sc * sc;
+		a = (ys * cc - yc * sc) / det;
+		b = (yc * ss - ys * sc) / det;
+
+		noise = 0;
+		signal = 0;
+		for (n = TEST_SETTLE_FRAMES; n < total; n++) {
+			e = a * sin(w_out * n) + b * cos(w_out * n);
+			signal += e * e;
+			noise += (y[ch][n] - e) * (y[ch][n] - e);
+		}
+
+		/* the tone passes at the original level */
+		assert_true(fabs(sqrt(a * a + b * b) - TEST_TONE_AMPLITUDE) < 0.01);
+		sinad = fmin(sinad, 10.0 * log10(signal / noise));
+	}
+
+	test_asrc_free(&t);
+	return sinad;
+}
+
+static void test_asrc_sinad_s32(void **state)
+{
+	(void)state;
+
+	assert_true(test_asrc_sinad(8, 32, 48000, 44100) > TEST_SINAD_DB_S32);
+	assert_true(test_asrc_sinad(2, 32, 44100, 48000) > TEST_SINAD_DB_S32);
+	assert_true(test_asrc_sinad(3, 32, 48000, 16000) > TEST_SINAD_DB_S32);
+}
+
+static void test_asrc_sinad_s16(void **state)
+{
+	(void)state;
+
+	assert_true(test_asrc_sinad(8, 16, 48000, 44100) > TEST_SINAD_DB_S16);
+	assert_true(test_asrc_sinad(2, 16, 44100, 48000) > TEST_SINAD_DB_S16);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_asrc_fir_filter32),
+		cmocka_unit_test(test_asrc_fir_filter16),
+		cmocka_unit_test(test_asrc_sinad_s32),
+		cmocka_unit_test(test_asrc_sinad_s16),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
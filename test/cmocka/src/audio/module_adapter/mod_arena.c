@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <sof/audio/component.h>
+#include <sof/audio/module_adapter/module/generic.h>
+
+#define TEST_ALLOCS		5
+#define TEST_ALLOC_SIZE		40
+#define TEST_PREPARE_SIZE	100
+
+static const struct sof_uuid test_mod_uuid = {
+	0x1234abcd, 0x1234, 0x5678, { 0x9a, 0xbc, 0xde, 0xf0, 0x12, 0x34, 0x56, 0x78 }
+};
+
+/* heap allocations, the arena block is one */
+static int heap_allocs;
+
+void *sof_heap_alloc(struct k_heap *heap, uint32_t flags, size_t bytes, size_t alignment)
+{
+	heap_allocs++;
+
+	return malloc(bytes);
+}
+
+void sof_heap_free(struct k_heap *heap, void *addr)
+{
+	free(addr);
+}
+
+struct test_mod_data {
+	void *init_ptr[TEST_ALLOCS];
+	void *prepare_ptr;
+};
+
+static int test_mod_init(struct processing_module *mod)
+{
+	struct test_mod_data *cd = mod_zalloc(mod, sizeof(*cd));
+	int i;
+
+	if (!cd)
+		return -ENOMEM;
+
+	for (i = 0; i < TEST_ALLOCS; i++) {
+		cd->init_ptr[i] = mod_alloc_align(mod, TEST_ALLOC_SIZE, 16);
+		if (!cd->init_ptr[i])
+			return -ENOMEM;
+		memset(cd->init_ptr[i], i, TEST_ALLOC_SIZE);
+	}
+
+	/* scratch of init, given back right away */
+	mod_free(mod, mod_alloc(mod, TEST_ALLOC_SIZE));
+
+	mod->priv.private = cd;
+	return 0;
+}
+
+static int test_mod_prepare(struct processing_module *mod, struct sof_source **sources,
+			    int num_of_sources, struct sof_sink **sinks, int num_of_sinks)
+{
+	struct test_mod_data *cd = mod->priv.private;
+
+	cd->prepare_ptr = mod_alloc(mod, TEST_PREPARE_SIZE);
+
+	return cd->prepare_ptr ? 0 : -ENOMEM;
+}
+
+static int test_mod_process(struct processing_module *mod, struct sof_source **sources,
+			    int num_of_sources, struct sof_sink **sinks, int num_of_sinks)
+{
+	return 0;
+}
+
+static const struct module_interface test_mod_interface = {
+	.init = test_mod_init,
+	.prepare = test_mod_prepare,
+	.process = test_mod_process,
+};
+
+static const struct comp_driver test_mod_drv = {
+	.uid = &test_mod_uuid,
+	.adapter_ops = &test_mod_interface,
+};
+
+static struct mod_alloc_ctx test_alloc_ctx;
+
+static struct processing_module *test_mod_new(void)
+{
+	struct processing_module *mod = test_calloc(1, sizeof(*mod));
+	struct comp_dev *dev = test_calloc(1, sizeof(*dev));
+
+	dev->drv = &test_mod_drv;
+	mod->dev = dev;
+	dev->mod = mod;
+	mod->priv.resources.alloc = &test_alloc_ctx;
+	mod_resource_init(mod);
+
+	return mod;
+}
+
+static void test_mod_delete(struct processing_module *mod)
+{
+	mod_free_all(mod);
+	test_free(mod->dev);
+	test_free(mod);
+}
+
+static bool test_in_arena(struct processing_module *mod, const void *ptr, size_t size)
+{
+	const struct mod_arena *arena = &mod->priv.resources.arena;
+
+	return (const uint8_t *)ptr >= arena->base &&
+		(const uint8_t *)ptr + size <= arena->base + arena->size;
+}
+
+/* The first instance learns the arena size, the second one uses it */
+static void test_mod_arena_learn(void **state)
+{
+	struct processing_module *mod;
+	struct test_mod_data *cd;
+	int allocs;
+	int i;
+
+	(void)state;
+
+	mod = test_mod_new();
+	assert_int_equal(module_init(mod), 0);
+	assert_int_equal(module_prepare(mod, NULL, 0, NULL, 0), 0);
+	assert_null(mod->priv.resources.arena.base);
+	assert_true(mod->priv.resources.arena.need >=
+		    TEST_ALLOCS * TEST_ALLOC_SIZE + TEST_PREPARE_SIZE);
+	test_mod_delete(mod);
+
+	mod = test_mod_new();
+	allocs = heap_allocs;
+	assert_int_equal(module_init(mod), 0);
+	assert_int_equal(module_prepare(mod, NULL, 0, NULL, 0), 0);
+
+	/* one block for all allocations of init and prepare */
+	assert_int_equal(heap_allocs - allocs, 1);
+	assert_false(mod->priv.resources.arena.open);
+
+	cd = mod->priv.private;
+	assert_true(test_in_arena(mod, cd, sizeof(*cd)));
+	assert_true(test_in_arena(mod, cd->prepare_ptr, TEST_PREPARE_SIZE));
+	for (i = 0; i < TEST_ALLOCS; i++) {
+		assert_true(test_in_arena(mod, cd->init_ptr[i], TEST_ALLOC_SIZE));
+		assert_int_equal((uintptr_t)cd->init_ptr[i] & 15, 0);
+		assert_int_equal(((uint8_t *)cd->init_ptr[i])[TEST_ALLOC_SIZE - 1], i);
+	}
+
+	/* freeing arena memory is done with the module */
+	assert_int_equal(mod_free(mod, cd->init_ptr[0]), 0);
+
+	/* after prepare the heap is used */
+	cd->prepare_ptr = mod_alloc(mod, TEST_PREPARE_SIZE);
+	assert_non_null(cd->prepare_ptr);
+	assert_false(test_in_arena(mod, cd->prepare_ptr, TEST_PREPARE_SIZE));
+	assert_int_equal(mod_free(mod, cd->prepare_ptr), 0);
+
+	test_mod_delete(mod);
+}
+
+/* A reserved block too small for all allocations is completed by the heap */
+static void test_mod_arena_reserve(void **state)
+{
+	struct processing_module *mod;
+	struct test_mod_data *cd;
+	void *ptr;
+
+	(void)state;
+
+	mod = test_mod_new();
+	assert_int_equal(mod_arena_reserve(mod, 2 * TEST_ALLOC_SIZE), 0);
+	assert_int_equal(mod_arena_reserve(mod, TEST_ALLOC_SIZE), -EBUSY);
+
+	/* the last allocation can be given back and reused */
+	mod->priv.resources.arena.open = true;
+	ptr = mod_alloc(mod, TEST_ALLOC_SIZE);
+	assert_true(test_in_arena(mod, ptr, TEST_ALLOC_SIZE));
+	assert_int_equal(mod_free(mod, ptr), 0);
+	assert_ptr_equal(mod_alloc(mod, TEST_ALLOC_SIZE), ptr);
+	mod_free_all(mod);
+	assert_null(mod->priv.resources.arena.base);
+
+	assert_int_equal(mod_arena_reserve(mod, 2 * TEST_ALLOC_SIZE), 0);
+	assert_int_equal(module_init(mod), 0);
+	assert_int_equal(module_prepare(mod, NULL, 0, NULL, 0), 0);
+	cd = mod->priv.private;
+	assert_false(test_in_arena(mod, cd->prepare_ptr, TEST_PREPARE_SIZE));
+	test_mod_delete(mod);
+}
+
+/* New instance with an init configuration, the module owns and frees it */
+static struct processing_module *test_mod_new_cfg(uint32_t value)
+{
+	struct processing_module *mod = test_mod_new();
+	uint32_t *blob = malloc(sizeof(*blob));
+
+	*blob = value;
+	mod->priv.cfg.data = blob;
+	mod->priv.cfg.size = sizeof(*blob);
+
+	return mod;
+}
+
+/* Instances with another init configuration do not take the learned size */
+static void test_mod_arena_config(void **state)
+{
+	struct processing_module *mod;
+
+	(void)state;
+
+	mod = test_mod_new_cfg(1);
+	assert_int_equal(module_init(mod), 0);
+	assert_null(mod->priv.resources.arena.base);
+	assert_int_equal(module_prepare(mod, NULL, 0, NULL, 0), 0);
+	test_mod_delete(mod);
+
+	mod = test_mod_new_cfg(1);
+	assert_int_equal(module_init(mod), 0);
+	assert_non_null(mod->priv.resources.arena.base);
+	test_mod_delete(mod);
+
+	mod = test_mod_new_cfg(2);
+	assert_int_equal(module_init(mod), 0);
+	assert_null(mod->priv.resources.arena.base);
+	test_mod_delete(mod);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_mod_arena_learn),
+		cmocka_unit_test(test_mod_arena_reserve),
+		cmocka_unit_test(test_mod_arena_config),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
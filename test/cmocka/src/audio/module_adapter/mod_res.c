@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <cmocka.h>
+
+#include <sof/audio/component.h>
+#include <sof/audio/module_adapter/module/generic.h>
+
+#define TEST_ALLOCS		1000
+#define TEST_ALLOC_SIZE		24
+#define TEST_BENCH_THREADS	4
+#define TEST_BENCH_ROUNDS	20
+
+static const struct sof_uuid test_mod_uuid = {
+	0x1234abcd, 0x1234, 0x5678, { 0x9a, 0xbc, 0xde, 0xf0, 0x12, 0x34, 0x56, 0x78 }
+};
+
+/* heap blocks not given back, the record table included */
+static int heap_blocks;
+
+void *sof_heap_alloc(struct k_heap *heap, uint32_t flags, size_t bytes, size_t alignment)
+{
+	__atomic_add_fetch(&heap_blocks, 1, __ATOMIC_RELAXED);
+
+	return malloc(bytes);
+}
+
+void sof_heap_free(struct k_heap *heap, void *addr)
+{
+	if (addr)
+		__atomic_sub_fetch(&heap_blocks, 1, __ATOMIC_RELAXED);
+
+	free(addr);
+}
+
+static const struct comp_driver test_mod_drv = {
+	.uid = &test_mod_uuid,
+};
+
+static struct mod_alloc_ctx test_alloc_ctx;
+
+/* plain malloc(), the benchmark threads cannot use the cmocka allocator */
+static struct processing_module *test_mod_new(void)
+{
+	struct processing_module *mod = calloc(1, sizeof(*mod));
+	struct comp_dev *dev = calloc(1, sizeof(*dev));
+
+	dev->drv = &test_mod_drv;
+	mod->dev = dev;
+	dev->mod = mod;
+	mod->priv.resources.alloc = &test_alloc_ctx;
+	mod_resource_init(mod);
+
+	return mod;
+}
+
+static void test_mod_delete(struct processing_module *mod)
+{
+	mod_free_all(mod);
+	free(mod->dev);
+	free(mod);
+}
+
+/* Fisher-Yates shuffle with a fixed seed, the same order on each run */
+static void test_shuffle(void **ptr, int n, unsigned int *seed)
+{
+	void *tmp;
+	int i, j;
+
+	for (i = n - 1; i > 0; i--) {
+		j = rand_r(seed) % (i + 1);
+		tmp = ptr[i];
+		ptr[i] = ptr[j];
+		ptr[j] = tmp;
+	}
+}
+
+/* Records survive table growth and are found in any order */
+static void test_mod_res_random_free(void **state)
+{
+	struct processing_module *mod;
+	unsigned int seed = 1;
+	void **ptr;
+	int blocks = heap_blocks;
+	int i;
+
+	(void)state;
+
+	ptr = malloc(TEST_ALLOCS * sizeof(*ptr));
+	mod = test_mod_new();
+	for (i = 0; i < TEST_ALLOCS; i++) {
+		ptr[i] = mod_alloc(mod, TEST_ALLOC_SIZE + i);
+		assert_non_null(ptr[i]);
+		memset(ptr[i], i, TEST_ALLOC_SIZE + i);
+	}
+
+	assert_int_equal(mod->priv.resources.count, TEST_ALLOCS);
+	assert_true(mod->priv.resources.table_size >= 2 * TEST_ALLOCS);
+	assert_int_equal(mod->priv.resources.table_size & (mod->priv.resources.table_size - 1), 0);
+
+	test_shuffle(ptr, TEST_ALLOCS, &seed);
+	for (i = 0; i < TEST_ALLOCS; i++)
+		assert_int_equal(mod_free(mod, ptr[i]), 0);
+
+	assert_int_equal(mod->priv.resources.count, 0);
+	assert_int_equal(mod->priv.resources.heap_usage, 0);
+	assert_true(mod->priv.resources.heap_high_water_mark >=
+		    TEST_ALLOCS * TEST_ALLOC_SIZE);
+
+	test_mod_delete(mod);
+	free(ptr);
+	assert_int_equal(heap_blocks, blocks);
+}
+
+/* Pointers not allocated by the module are refused */
+static void test_mod_res_invalid_free(void **state)
+{
+	struct processing_module *mod;
+	int local;
+	void *ptr;
+
+	(void)state;
+
+	mod = test_mod_new();
+	assert_int_equal(mod_free(mod, &local), -ENOENT);
+
+	ptr = mod_alloc(mod, TEST_ALLOC_SIZE);
+	assert_int_equal(mod_free(mod, &local), -ENOENT);
+	assert_int_equal(mod_free(mod, ptr), 0);
+	assert_int_equal(mod_free(mod, ptr), -ENOENT);
+	assert_int_equal(mod_free(mod, NULL), 0);
+
+	test_mod_delete(mod);
+}
+
+/* Records left over are freed with the module, the table with them */
+static void test_mod_res_free_all(void **state)
+{
+	struct processing_module *mod;
+	int blocks = heap_blocks;
+	void *ptr[TEST_ALLOCS / 10];
+	int i;
+
+	(void)state;
+
+	mod = test_mod_new();
+	for (i = 0; i < ARRAY_SIZE(ptr); i++)
+		ptr[i] = mod_alloc(mod, TEST_ALLOC_SIZE);
+
+	for (i = 0; i < ARRAY_SIZE(ptr); i += 3)
+		assert_int_equal(mod_free(mod, ptr[i]), 0);
+
+	mod_free_all(mod);
+	assert_null(mod->priv.resources.table);
+	assert_int_equal(mod->priv.resources.count, 0);
+	assert_int_equal(mod->priv.resources.heap_usage, 0);
+	assert_int_equal(heap_blocks, blocks);
+
+	/* the module can allocate again */
+	assert_non_null(mod_alloc(mod, TEST_ALLOC_SIZE));
+	test_mod_delete(mod);
+	assert_int_equal(heap_blocks, blocks);
+}
+
+struct test_bench {
+	pthread_t thread;
+	int allocs;
+	uint64_t alloc_ns;
+	uint64_t free_ns;
+};
+
+static uint64_t test_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* Each thread is a core with its own module */
+static void *test_bench_thread(void *arg)
+{
+	struct test_bench *b = arg;
+	struct processing_module *mod = test_mod_new();
+	void **ptr = malloc(b->allocs * sizeof(*ptr));
+	unsigned int seed = b->allocs;
+	uint64_t t;
+	int round;
+	int i;
+
+	for (round = 0; round < TEST_BENCH_ROUNDS; round++) {
+		t = test_now_ns();
+		for (i = 0; i < b->allocs; i++)
+			ptr[i] = mod_alloc(mod, TEST_ALLOC_SIZE);
+		b->alloc_ns += test_now_ns() - t;
+
+		test_shuffle(ptr, b->allocs, &seed);
+		t = test_now_ns();
+		for (i = 0; i < b->allocs; i++)
+			mod_free(mod, ptr[i]);
+		b->free_ns += test_now_ns() - t;
+	}
+
+	test_mod_delete(mod);
+	free(ptr);
+	return NULL;
+}
+
+/*
+ * Latency of mod_alloc() and mod_free() by resource count and cores. Timing
+ * is not checked and takes a while, so it only runs when SOF_MOD_RES_BENCH
+ * is set in the environment.
+ */
+static void test_mod_res_bench(void **state)
+{
+	static const int allocs[] = { 16, 256, 4096 };
+	struct test_bench b[TEST_BENCH_THREADS];
+	uint64_t alloc_ns, free_ns, n;
+	int threads;
+	int i, j;
+
+	(void)state;
+
+	if (!getenv("SOF_MOD_RES_BENCH"))
+		skip();
+
+	for (i = 0; i < ARRAY_SIZE(allocs); i++) {
+		for (threads = 1; threads <= TEST_BENCH_THREADS; threads <<= 1) {
+			memset(b, 0, sizeof(b));
+			for (j = 0; j < threads; j++) {
+				b[j].allocs = allocs[i];
+				assert_int_equal(pthread_create(&b[j].thread, NULL,
+								test_bench_thread, &b[j]), 0);
+			}
+
+			alloc_ns = 0;
+			free_ns = 0;
+			for (j = 0; j < threads; j++) {
+				pthread_join(b[j].thread, NULL);
+				alloc_ns += b[j].alloc_ns;
+				free_ns += b[j].free_ns;
+			}
+
+			n = (uint64_t)threads * allocs[i] * TEST_BENCH_ROUNDS;
+			print_message("resources %4d threads %d: alloc %4llu ns, free %4llu ns\n",
+				      allocs[i], threads, (unsigned long long)(alloc_ns / n),
+				      (unsigned long long)(free_ns / n));
+		}
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_mod_res_random_free),
+		cmocka_unit_test(test_mod_res_invalid_free),
+		cmocka_unit_test(test_mod_res_free_all),
+		cmocka_unit_test(test_mod_res_bench),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
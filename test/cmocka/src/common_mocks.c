@@ -12,6 +12,7 @@
 #include <sof/ipc/topology.h>
 #include <sof/ipc/msg.h>
 #include <sof/ipc/driver.h>
+#include <sof/ipc/notification_pool.h>
 #include <sof/schedule/edf_schedule.h>
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/schedule.h>
@@ -256,6 +257,11 @@ int WEAK platform_ipc_init(struct ipc *ipc)
 	return 0;
 }
 
+int WEAK ipc_notification_pool_init(void)
+{
+	return 0;
+}
+
 enum task_state WEAK ipc_platform_do_cmd(struct ipc *ipc)
 {
 	return 0;
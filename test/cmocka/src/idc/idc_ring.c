@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cmocka.h>
+
+#include <sof/lib/idc_ring.h>
+
+#define TEST_RING_SIZE		CONFIG_IDC_RING_SIZE
+#define TEST_STRESS_MSGS	200000
+#define TEST_STRESS_PAIRS	3
+
+/* Checks if the message reserved as the seq-th one has been completed */
+static bool test_done(const struct idc_ring *ring, uint32_t seq)
+{
+	return (int32_t)((uint32_t)atomic_read(&ring->tail) - seq) > 0;
+}
+
+/* Entries are taken in order until all are in flight */
+static void test_idc_ring_full(void **state)
+{
+	struct idc_ring_entry *entry;
+	struct idc_ring ring = { 0 };
+	int i;
+
+	(void)state;
+
+	assert_null(idc_ring_peek(&ring));
+
+	for (i = 0; i < TEST_RING_SIZE; i++) {
+		entry = idc_ring_reserve(&ring);
+		assert_ptr_equal(entry, ring.entry + i);
+		entry->msg.header = i;
+	}
+
+	assert_null(idc_ring_reserve(&ring));
+	assert_int_equal(idc_ring_commit(&ring), TEST_RING_SIZE);
+	assert_int_equal(idc_ring_commit(&ring), 0);
+
+	/* completing the oldest entry makes it available again */
+	assert_int_equal(idc_ring_peek(&ring)->msg.header, 0);
+	assert_false(test_done(&ring, 0));
+	idc_ring_complete(&ring);
+	assert_true(test_done(&ring, 0));
+	assert_false(test_done(&ring, 1));
+	assert_ptr_equal(idc_ring_reserve(&ring), ring.entry);
+	assert_null(idc_ring_reserve(&ring));
+
+	for (i = 1; i < TEST_RING_SIZE; i++) {
+		assert_int_equal(idc_ring_peek(&ring)->msg.header, i);
+		idc_ring_complete(&ring);
+	}
+
+	/* the last one is reserved but not committed */
+	assert_null(idc_ring_peek(&ring));
+}
+
+/* Reserved entries are seen by the consumer only after the commit */
+static void test_idc_ring_commit(void **state)
+{
+	struct idc_ring ring = { 0 };
+	int i;
+
+	(void)state;
+
+	idc_ring_reserve(&ring)->msg.header = 0;
+	assert_int_equal(idc_ring_commit(&ring), 1);
+
+	for (i = 1; i < 3; i++)
+		idc_ring_reserve(&ring)->msg.header = i;
+
+	assert_int_equal(idc_ring_peek(&ring)->msg.header, 0);
+	idc_ring_complete(&ring);
+	assert_null(idc_ring_peek(&ring));
+
+	assert_int_equal(idc_ring_commit(&ring), 2);
+	for (i = 1; i < 3; i++) {
+		assert_int_equal(idc_ring_peek(&ring)->msg.header, i);
+		idc_ring_complete(&ring);
+	}
+
+	assert_true(test_done(&ring, 2));
+	assert_null(idc_ring_peek(&ring));
+}
+
+/* Entries and completions keep working when the counters wrap */
+static void test_idc_ring_wrap(void **state)
+{
+	struct idc_ring ring;
+	uint32_t first = UINT32_MAX - 1;
+	int i;
+
+	(void)state;
+
+	atomic_init(&ring.head, first);
+	atomic_init(&ring.tail, first);
+	ring.reserved = first;
+
+	for (i = 0; i < TEST_RING_SIZE; i++)
+		assert_ptr_equal(idc_ring_reserve(&ring),
+				 ring.entry + (uint32_t)(first + i) % TEST_RING_SIZE);
+
+	assert_null(idc_ring_reserve(&ring));
+	assert_int_equal(idc_ring_commit(&ring), TEST_RING_SIZE);
+
+	for (i = 0; i < TEST_RING_SIZE; i++) {
+		assert_false(test_done(&ring, first + i));
+		assert_ptr_equal(idc_ring_peek(&ring),
+				 ring.entry + (uint32_t)(first + i) % TEST_RING_SIZE);
+		idc_ring_complete(&ring);
+		assert_true(test_done(&ring, first + i));
+	}
+
+	assert_null(idc_ring_peek(&ring));
+}
+
+struct test_pair {
+	struct idc_ring ring;
+	pthread_t producer;
+	pthread_t consumer;
+	int producer_errors;
+	int consumer_errors;
+};
+
+/* Source core, commits of 1 to 3 messages with a payload per message */
+static void *test_producer(void *arg)
+{
+	struct test_pair *pair = arg;
+	struct idc_ring_entry *entry;
+	uint32_t sent = 0;
+	int batch = 0;
+
+	while (sent < TEST_STRESS_MSGS) {
+		entry = idc_ring_reserve(&pair->ring);
+		if (!entry) {
+			idc_ring_commit(&pair->ring);
+			sched_yield();
+			continue;
+		}
+
+		if (entry != pair->ring.entry + sent % TEST_RING_SIZE)
+			pair->producer_errors++;
+
+		entry->msg.header = sent;
+		entry->msg.size = sizeof(sent);
+		memcpy(entry->payload, &sent, sizeof(sent));
+
+		if (++batch == 1 + sent++ % 3) {
+			idc_ring_commit(&pair->ring);
+			batch = 0;
+		}
+	}
+
+	idc_ring_commit(&pair->ring);
+
+	while (!test_done(&pair->ring, sent - 1))
+		sched_yield();
+
+	return NULL;
+}
+
+/* Target core, messages are handled in order with the payload they were sent with */
+static void *test_consumer(void *arg)
+{
+	struct test_pair *pair = arg;
+	struct idc_ring_entry *entry;
+	uint32_t received = 0;
+	uint32_t payload;
+
+	while (received < TEST_STRESS_MSGS) {
+		entry = idc_ring_peek(&pair->ring);
+		if (!entry) {
+			sched_yield();
+			continue;
+		}
+
+		memcpy(&payload, entry->payload, sizeof(payload));
+		if (entry->msg.header != received || payload != received ||
+		    entry->msg.size != sizeof(payload))
+			pair->consumer_errors++;
+
+		idc_ring_complete(&pair->ring);
+		received++;
+	}
+
+	return NULL;
+}
+
+/* Several core pairs exchange messages concurrently without a shared lock */
+static void test_idc_ring_stress(void **state)
+{
+	static struct test_pair pairs[TEST_STRESS_PAIRS];
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < TEST_STRESS_PAIRS; i++) {
+		memset(&pairs[i].ring, 0, sizeof(pairs[i].ring));
+		assert_int_equal(pthread_create(&pairs[i].consumer, NULL, test_consumer,
+						&pairs[i]), 0);
+		assert_int_equal(pthread_create(&pairs[i].producer, NULL, test_producer,
+						&pairs[i]), 0);
+	}
+
+	for (i = 0; i < TEST_STRESS_PAIRS; i++) {
+		pthread_join(pairs[i].producer, NULL);
+		pthread_join(pairs[i].consumer, NULL);
+		assert_int_equal(pairs[i].producer_errors, 0);
+		assert_int_equal(pairs[i].consumer_errors, 0);
+		assert_true(test_done(&pairs[i].ring, TEST_STRESS_MSGS - 1));
+		assert_false(test_done(&pairs[i].ring, TEST_STRESS_MSGS));
+		assert_null(idc_ring_peek(&pairs[i].ring));
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_idc_ring_full),
+		cmocka_unit_test(test_idc_ring_commit),
+		cmocka_unit_test(test_idc_ring_wrap),
+		cmocka_unit_test(test_idc_ring_stress),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <cmocka.h>
+
+#include <sof/ipc/notification_pool.h>
+
+#define TEST_SIZE		CONFIG_IPC_NOTIFICATION_POOL_PAYLOAD_SIZE
+#define TEST_MSG_COUNT		CONFIG_IPC_NOTIFICATION_POOL_COUNT
+#define TEST_STRESS_GETS	100000
+#define TEST_STRESS_THREADS	3
+
+static int setup(void **state)
+{
+	(void)state;
+
+	return ipc_notification_pool_init();
+}
+
+/* Messages are sent and returned to the pool by their callback */
+static void test_put(struct ipc_msg *msg)
+{
+	msg->callback(msg);
+}
+
+/* Any payload up to the configured size takes a message */
+static void test_notification_pool_get(void **state)
+{
+	struct ipc_msg *msg[TEST_MSG_COUNT];
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < TEST_MSG_COUNT; i++) {
+		msg[i] = ipc_notification_pool_get(i & 1 ? TEST_SIZE : sizeof(uint32_t));
+		assert_non_null(msg[i]);
+		assert_int_equal(msg[i]->tx_size, i & 1 ? TEST_SIZE : sizeof(uint32_t));
+		assert_non_null(msg[i]->tx_data);
+	}
+
+	for (i = 0; i < TEST_MSG_COUNT; i++)
+		test_put(msg[i]);
+
+	/* payloads bigger than the messages are refused */
+	assert_null(ipc_notification_pool_get(TEST_SIZE + 1));
+}
+
+/* Notifications are dropped while all messages are in flight */
+static void test_notification_pool_drop(void **state)
+{
+	struct ipc_msg *msg[TEST_MSG_COUNT];
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < TEST_MSG_COUNT; i++) {
+		msg[i] = ipc_notification_pool_get(TEST_SIZE);
+		assert_non_null(msg[i]);
+	}
+
+	assert_null(ipc_notification_pool_get(TEST_SIZE));
+	assert_null(ipc_notification_pool_get(TEST_SIZE));
+
+	test_put(msg[1]);
+	assert_ptr_equal(ipc_notification_pool_get(TEST_SIZE), msg[1]);
+
+	for (i = 0; i < TEST_MSG_COUNT; i++)
+		test_put(msg[i]);
+}
+
+struct test_user {
+	pthread_t thread;
+	int errors;
+};
+
+static int test_owner[TEST_MSG_COUNT];
+static struct ipc_msg *test_msgs[TEST_MSG_COUNT];
+
+static int test_msg_index(struct ipc_msg *msg)
+{
+	int i;
+
+	for (i = 0; i < TEST_MSG_COUNT; i++)
+		if (test_msgs[i] == msg)
+			return i;
+
+	return -1;
+}
+
+/* Contexts of one core, no message is handed out twice */
+static void *test_user(void *arg)
+{
+	struct test_user *user = arg;
+	struct ipc_msg *msg;
+	int index;
+	int i;
+
+	for (i = 0; i < TEST_STRESS_GETS; i++) {
+		msg = ipc_notification_pool_get(TEST_SIZE);
+		if (!msg) {
+			sched_yield();
+			continue;
+		}
+
+		index = test_msg_index(msg);
+		if (index < 0 || __atomic_exchange_n(&test_owner[index], 1, __ATOMIC_SEQ_CST))
+			user->errors++;
+
+		if (index >= 0)
+			__atomic_store_n(&test_owner[index], 0, __ATOMIC_SEQ_CST);
+
+		test_put(msg);
+	}
+
+	return NULL;
+}
+
+/* Concurrent users take and return messages without a lock */
+static void test_notification_pool_stress(void **state)
+{
+	static struct test_user users[TEST_STRESS_THREADS];
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < TEST_MSG_COUNT; i++)
+		test_msgs[i] = ipc_notification_pool_get(TEST_SIZE);
+	for (i = 0; i < TEST_MSG_COUNT; i++)
+		test_put(test_msgs[i]);
+
+	for (i = 0; i < TEST_STRESS_THREADS; i++)
+		assert_int_equal(pthread_create(&users[i].thread, NULL, test_user, &users[i]), 0);
+
+	for (i = 0; i < TEST_STRESS_THREADS; i++) {
+		pthread_join(users[i].thread, NULL);
+		assert_int_equal(users[i].errors, 0);
+	}
+
+	/* all messages are back in the pool */
+	for (i = 0; i < TEST_MSG_COUNT; i++)
+		assert_non_null(ipc_notification_pool_get(TEST_SIZE));
+	assert_null(ipc_notification_pool_get(TEST_SIZE));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup(test_notification_pool_get, setup),
+		cmocka_unit_test_setup(test_notification_pool_drop, setup),
+		cmocka_unit_test_setup(test_notification_pool_stress, setup),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
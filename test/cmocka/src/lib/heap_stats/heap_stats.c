@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <sof/lib/heap_stats.h>
+#include <sof/objpool.h>
+
+#define TEST_HEAP_SIZE		4096
+#define TEST_LARGEST_FREE	1000
+
+static size_t test_largest_free(struct heap_stats *stats)
+{
+	return TEST_LARGEST_FREE;
+}
+
+static void test_heap_stats_usage(void **state)
+{
+	struct heap_stats_record rec;
+	struct heap_stats stats;
+
+	(void)state;
+
+	heap_stats_register(&stats, HEAP_STATS_SYSTEM, HEAP_STATS_SYSTEM_SOF, TEST_HEAP_SIZE,
+			    test_largest_free);
+
+	heap_stats_alloc(&stats, 100, 0);
+	heap_stats_alloc(&stats, 200, 0);
+	heap_stats_free(&stats, 100);
+	heap_stats_alloc(&stats, 0, 0);
+	heap_stats_alloc(&stats, 50, 0);
+
+	assert_int_equal(heap_stats_get(&rec, 1), 1);
+	assert_int_equal(rec.type, HEAP_STATS_SYSTEM);
+	assert_int_equal(rec.id, HEAP_STATS_SYSTEM_SOF);
+	assert_int_equal(rec.size, TEST_HEAP_SIZE);
+	assert_int_equal(rec.used, 250);
+	assert_int_equal(rec.peak, 300);
+	assert_int_equal(rec.largest_free, TEST_LARGEST_FREE);
+	assert_int_equal(rec.alloc_count, 3);
+	assert_int_equal(rec.free_count, 1);
+	assert_int_equal(rec.fail_count, 1);
+
+	/* a free larger than the usage cannot wrap it */
+	heap_stats_free(&stats, 1000);
+	assert_int_equal(heap_stats_get(&rec, 1), 1);
+	assert_int_equal(rec.used, 0);
+	assert_int_equal(rec.peak, 300);
+
+	heap_stats_unregister(&stats);
+	assert_int_equal(heap_stats_get(&rec, 1), 0);
+}
+
+static void test_heap_stats_latency(void **state)
+{
+	struct heap_stats_record rec;
+	struct heap_stats stats;
+	int i;
+
+	(void)state;
+
+	heap_stats_register(&stats, HEAP_STATS_VREGION, 0, 0, NULL);
+
+	heap_stats_alloc(&stats, 8, 0);
+	heap_stats_alloc(&stats, 8, 31);
+	heap_stats_alloc(&stats, 8, 32);
+	heap_stats_alloc(&stats, 8, 63);
+	heap_stats_alloc(&stats, 8, 64);
+	heap_stats_alloc(&stats, 8, UINT32_MAX);
+
+	assert_int_equal(heap_stats_get(&rec, 1), 1);
+	assert_int_equal(rec.largest_free, HEAP_STATS_LARGEST_FREE_UNKNOWN);
+	assert_int_equal(rec.latency[0], 2);
+	assert_int_equal(rec.latency[1], 2);
+	assert_int_equal(rec.latency[2], 1);
+	for (i = 3; i < HEAP_STATS_LATENCY_BINS - 1; i++)
+		assert_int_equal(rec.latency[i], 0);
+	/* slower allocations than the histogram covers go to the last bin */
+	assert_int_equal(rec.latency[HEAP_STATS_LATENCY_BINS - 1], 1);
+
+	heap_stats_unregister(&stats);
+}
+
+static void test_heap_stats_registry(void **state)
+{
+	struct heap_stats_record rec[3];
+	struct heap_stats stats[3];
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < 3; i++)
+		heap_stats_register(&stats[i], HEAP_STATS_MODULE, i, 0, NULL);
+
+	/* records are in registration order and limited to max */
+	assert_int_equal(heap_stats_get(rec, 2), 2);
+	assert_int_equal(rec[0].id, 0);
+	assert_int_equal(rec[1].id, 1);
+
+	heap_stats_unregister(&stats[1]);
+	assert_int_equal(heap_stats_get(rec, 3), 2);
+	assert_int_equal(rec[0].id, 0);
+	assert_int_equal(rec[1].id, 2);
+
+	heap_stats_unregister(&stats[0]);
+	heap_stats_unregister(&stats[2]);
+}
+
+/* the pool memory is counted when it grows and when it is pruned */
+static void test_heap_stats_objpool(void **state)
+{
+	struct objpool_head head = {.list = LIST_INIT(head.list)};
+	struct heap_stats_record rec;
+	struct heap_stats stats;
+	void *obj[3];
+	int i;
+
+	(void)state;
+
+	heap_stats_register(&stats, HEAP_STATS_MODULE, 0, 0, NULL);
+	head.stats = &stats;
+
+	/* pools of 2 and 4 objects */
+	for (i = 0; i < 3; i++) {
+		obj[i] = objpool_alloc(&head, 16, 0);
+		assert_non_null(obj[i]);
+	}
+
+	assert_int_equal(heap_stats_get(&rec, 1), 1);
+	assert_int_equal(rec.alloc_count, 2);
+	assert_true(rec.used > 6 * 16);
+
+	/* returned objects stay in the pool */
+	assert_int_equal(objpool_free(&head, obj[0]), 0);
+	assert_int_equal(heap_stats_get(&rec, 1), 1);
+	assert_int_equal(rec.free_count, 0);
+
+	objpool_prune(&head);
+	assert_int_equal(heap_stats_get(&rec, 1), 1);
+	assert_int_equal(rec.free_count, 2);
+	assert_int_equal(rec.used, 0);
+
+	heap_stats_unregister(&stats);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_heap_stats_usage),
+		cmocka_unit_test(test_heap_stats_latency),
+		cmocka_unit_test(test_heap_stats_registry),
+		cmocka_unit_test(test_heap_stats_objpool),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
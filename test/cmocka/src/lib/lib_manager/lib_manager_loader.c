@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <sof/lib_manager_loader.h>
+#include <rimage/sof/user/manifest.h>
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <errno.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define TEST_CHUNK_SIZE		64
+#define TEST_DMA_SIZE		(2 * TEST_CHUNK_SIZE)
+#define TEST_MAX_SIZE		1024
+#define TEST_MAX_EVENTS		256
+
+enum test_event_type {
+	EV_DMA_WAIT,
+	EV_DMA_RELOAD,
+};
+
+struct test_event {
+	enum test_event_type type;
+	uint32_t chunk;		/* chunk index of the event */
+};
+
+/* Host DMA writing the source image to the circular buffer as space allows */
+struct test_ctx {
+	uint8_t dma_buf[TEST_DMA_SIZE];
+	uint8_t src[TEST_MAX_SIZE];
+	uint8_t dst[TEST_MAX_SIZE];
+	uint32_t src_size;
+	uint32_t src_off;	/* bytes written by DMA */
+	uint32_t w_off;		/* DMA write offset */
+	uint32_t pending;	/* bytes written but not yet reloaded */
+	uint32_t read;		/* bytes reloaded */
+	int dma_wait_fail;	/* fail the wait of this chunk, -1 for none */
+	struct test_event events[TEST_MAX_EVENTS];
+	int num_events;
+};
+
+static void test_event_add(struct test_ctx *ctx, enum test_event_type type, uint32_t chunk)
+{
+	assert_true(ctx->num_events < TEST_MAX_EVENTS);
+	ctx->events[ctx->num_events].type = type;
+	ctx->events[ctx->num_events].chunk = chunk;
+	ctx->num_events++;
+}
+
+/* The DMA transfers all it can to the free space of buffer */
+static void test_dma_run(struct test_ctx *ctx)
+{
+	while (ctx->pending < TEST_DMA_SIZE && ctx->src_off < ctx->src_size) {
+		ctx->dma_buf[ctx->w_off] = ctx->src[ctx->src_off++];
+		ctx->w_off = (ctx->w_off + 1) % TEST_DMA_SIZE;
+		ctx->pending++;
+	}
+}
+
+static int test_dma_wait(void *data, uint32_t size)
+{
+	struct test_ctx *ctx = data;
+	uint32_t chunk = ctx->read / TEST_CHUNK_SIZE;
+
+	test_event_add(ctx, EV_DMA_WAIT, chunk);
+	if ((int)chunk == ctx->dma_wait_fail)
+		return -ETIMEDOUT;
+
+	test_dma_run(ctx);
+	return ctx->pending >= size ? 0 : -ETIMEDOUT;
+}
+
+static int test_dma_reload(void *data, uint32_t size)
+{
+	struct test_ctx *ctx = data;
+
+	test_event_add(ctx, EV_DMA_RELOAD, ctx->read / TEST_CHUNK_SIZE);
+	assert_true(size <= ctx->pending);
+	ctx->pending -= size;
+	ctx->read += size;
+	return 0;
+}
+
+static const struct lib_manager_loader_ops test_ops = {
+	.dma_wait = test_dma_wait,
+	.dma_reload = test_dma_reload,
+};
+
+static void test_setup(struct test_ctx *ctx, struct lib_manager_loader *ld, uint32_t size)
+{
+	uint32_t i;
+
+	memset(ctx, 0, sizeof(*ctx));
+	ctx->src_size = size;
+	ctx->dma_wait_fail = -1;
+	for (i = 0; i < size; i++)
+		ctx->src[i] = i * 7 + (i >> 8);
+
+	lib_manager_loader_init(ld, &test_ops, ctx, ctx->dma_buf, TEST_DMA_SIZE,
+				TEST_CHUNK_SIZE);
+}
+
+static int test_find_event(struct test_ctx *ctx, enum test_event_type type, uint32_t chunk)
+{
+	int i;
+
+	for (i = 0; i < ctx->num_events; i++)
+		if (ctx->events[i].type == type && ctx->events[i].chunk == chunk)
+			return i;
+
+	return -1;
+}
+
+static void test_loader_store(void **state)
+{
+	struct lib_manager_loader ld;
+	struct test_ctx ctx;
+	uint32_t size = 5 * TEST_CHUNK_SIZE + 24;
+
+	(void)state;
+
+	test_setup(&ctx, &ld, size);
+	assert_int_equal(lib_manager_loader_store(&ld, ctx.dst, size), 0);
+	assert_memory_equal(ctx.dst, ctx.src, size);
+	assert_int_equal(ctx.read, size);
+}
+
+/* Two stores continue from the DMA buffer position of the previous one */
+static void test_loader_store_split(void **state)
+{
+	struct lib_manager_loader ld;
+	struct test_ctx ctx;
+	uint32_t first = TEST_CHUNK_SIZE + 8;
+	uint32_t size = 7 * TEST_CHUNK_SIZE;
+
+	(void)state;
+
+	test_setup(&ctx, &ld, size);
+	assert_int_equal(lib_manager_loader_store(&ld, ctx.dst, first), 0);
+	assert_int_equal(lib_manager_loader_store(&ld, ctx.dst + first, size - first), 0);
+	assert_memory_equal(ctx.dst, ctx.src, size);
+}
+
+/* Each chunk is given back to the DMA before the next one is waited for */
+static void test_loader_store_order(void **state)
+{
+	struct lib_manager_loader ld;
+	struct test_ctx ctx;
+	uint32_t chunks = 6;
+	uint32_t size = chunks * TEST_CHUNK_SIZE;
+	uint32_t n;
+	int reload;
+
+	(void)state;
+
+	test_setup(&ctx, &ld, size);
+	assert_int_equal(lib_manager_loader_store(&ld, ctx.dst, size), 0);
+	assert_memory_equal(ctx.dst, ctx.src, size);
+
+	for (n = 0; n < chunks; n++) {
+		reload = test_find_event(&ctx, EV_DMA_RELOAD, n);
+		assert_true(reload > test_find_event(&ctx, EV_DMA_WAIT, n));
+		if (n < chunks - 1)
+			assert_true(reload < test_find_event(&ctx, EV_DMA_WAIT, n + 1));
+	}
+}
+
+/* A DMA error stops loading */
+static void test_loader_store_dma_fail(void **state)
+{
+	struct lib_manager_loader ld;
+	struct test_ctx ctx;
+	uint32_t size = 4 * TEST_CHUNK_SIZE;
+
+	(void)state;
+
+	test_setup(&ctx, &ld, size);
+	ctx.dma_wait_fail = 2;
+	assert_int_equal(lib_manager_loader_store(&ld, ctx.dst, size), -ETIMEDOUT);
+	assert_int_equal(test_find_event(&ctx, EV_DMA_RELOAD, 2), -1);
+	assert_int_equal(ctx.read, 2 * TEST_CHUNK_SIZE);
+}
+
+#define TEST_LZ4_HISTORY	16	/* image bytes before the compressed part */
+
+static uint8_t *test_lz4_block(uint8_t *p, uint32_t raw_size, uint32_t comp_size)
+{
+	struct sof_man_lz4_block blk = {
+		.raw_size = raw_size,
+		.comp_size = comp_size,
+	};
+
+	memcpy(p, &blk, sizeof(blk));
+	return p + sizeof(blk);
+}
+
+/*
+ * Two frames with stored data, an overlapping match, a match into the image
+ * before dst and extended literal and match lengths. Returns the decompressed
+ * size and the expected data in raw.
+ */
+static uint32_t test_lz4_setup(struct test_ctx *ctx, struct lib_manager_loader *ld,
+			       uint8_t *raw)
+{
+	uint8_t *frame;
+	uint8_t *p;
+	uint32_t n = 0;
+	int i;
+
+	test_setup(ctx, ld, 2 * TEST_CHUNK_SIZE);
+	memset(ctx->src, 0, sizeof(ctx->src));
+	for (i = 0; i < TEST_LZ4_HISTORY; i++)
+		ctx->dst[i] = 0xa0 + i;
+
+	/* frame 0: stored block, then 'x' repeated by a match with offset 1 */
+	frame = ctx->src;
+	p = test_lz4_block(frame, 10, 10);
+	memcpy(p, "0123456789", 10);
+	memcpy(raw + n, p, 10);
+	p += 10;
+	n += 10;
+
+	p = test_lz4_block(p, 13, 4);
+	*p++ = 0x18;
+	*p++ = 'x';
+	*p++ = 1;
+	*p++ = 0;
+	memset(raw + n, 'x', 13);
+	n += 13;
+
+	/* end of blocks, the frame is padded */
+	test_lz4_block(p, 0, 0);
+
+	/* frame 1: match of 6 image bytes before dst, then literals "yz" */
+	frame = ctx->src + TEST_CHUNK_SIZE;
+	p = test_lz4_block(frame, 8, 6);
+	*p++ = 0x02;
+	*p++ = TEST_LZ4_HISTORY + n;
+	*p++ = 0;
+	*p++ = 0x20;
+	*p++ = 'y';
+	*p++ = 'z';
+	memcpy(raw + n, ctx->dst, 6);
+	raw[n + 6] = 'y';
+	raw[n + 7] = 'z';
+	n += 8;
+
+	/* 20 literals and an overlapping match of 22 bytes, both with extended length */
+	p = test_lz4_block(p, 43, 27);
+	*p++ = 0xff;
+	*p++ = 5;
+	for (i = 0; i < 20; i++) {
+		*p++ = 'A' + i;
+		raw[n + i] = 'A' + i;
+	}
+
+	*p++ = 20;
+	*p++ = 0;
+	*p++ = 3;
+	for (i = 0; i < 22; i++)
+		raw[n + 20 + i] = 'A' + i % 20;
+
+	*p++ = 0x10;
+	*p++ = '!';
+	raw[n + 42] = '!';
+	n += 43;
+
+	/* the last frame is ended by its end */
+	assert_true(p <= frame + TEST_CHUNK_SIZE);
+
+	return n;
+}
+
+static void test_loader_store_lz4(void **state)
+{
+	struct lib_manager_loader ld;
+	struct test_ctx ctx;
+	uint8_t staging[2 * TEST_CHUNK_SIZE];
+	uint8_t raw[TEST_CHUNK_SIZE * 2];
+	uint32_t size;
+
+	(void)state;
+
+	size = test_lz4_setup(&ctx, &ld, raw);
+	assert_int_equal(lib_manager_loader_store_lz4(&ld, ctx.dst, ctx.dst + TEST_LZ4_HISTORY,
+						      size, staging), 0);
+	assert_memory_equal(ctx.dst + TEST_LZ4_HISTORY, raw, size);
+	assert_int_equal(ctx.dst[TEST_LZ4_HISTORY + size], 0);
+	assert_int_equal(ctx.read, 2 * TEST_CHUNK_SIZE);
+}
+
+/* Corrupted data is rejected */
+static void test_loader_store_lz4_corrupt(void **state)
+{
+	struct lib_manager_loader ld;
+	struct test_ctx ctx;
+	uint8_t staging[2 * TEST_CHUNK_SIZE];
+	uint8_t raw[TEST_CHUNK_SIZE * 2];
+	uint32_t size;
+
+	(void)state;
+
+	/* match before the start of the image */
+	size = test_lz4_setup(&ctx, &ld, raw);
+	ctx.src[TEST_CHUNK_SIZE + sizeof(struct sof_man_lz4_block) + 1]++;
+	assert_int_equal(lib_manager_loader_store_lz4(&ld, ctx.dst, ctx.dst + TEST_LZ4_HISTORY,
+						      size, staging), -EINVAL);
+
+	/* decompressed data beyond the image */
+	size = test_lz4_setup(&ctx, &ld, raw);
+	assert_int_equal(lib_manager_loader_store_lz4(&ld, ctx.dst, ctx.dst + TEST_LZ4_HISTORY,
+						      size - 1, staging), -EINVAL);
+
+	/* a frame without data */
+	size = test_lz4_setup(&ctx, &ld, raw);
+	memset(ctx.src + TEST_CHUNK_SIZE, 0, TEST_CHUNK_SIZE);
+	assert_int_equal(lib_manager_loader_store_lz4(&ld, ctx.dst, ctx.dst + TEST_LZ4_HISTORY,
+						      size, staging), -EINVAL);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_loader_store),
+		cmocka_unit_test(test_loader_store_split),
+		cmocka_unit_test(test_loader_store_order),
+		cmocka_unit_test(test_loader_store_dma_fail),
+		cmocka_unit_test(test_loader_store_lz4),
+		cmocka_unit_test(test_loader_store_lz4_corrupt),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
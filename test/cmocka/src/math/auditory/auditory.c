@@ -317,6 +317,98 @@ static void test_mel_to_hz(void **state)
 	assert_true(delta_max < MEL_TO_HZ_MAX_ERROR_ABS);
 }
 
+#define MEL_FB_FULL_SCALE_FFT_SIZE	512
+#define MEL_FB_FULL_SCALE_MEL_BINS	23
+#define MEL_FB_FULL_SCALE_HEADROOM	3
+
+/* Runs a filterbank with all FFT output bins set to the same value */
+static void filterbank_constant_test(int bits, int32_t value, int32_t *mel_log)
+{
+	const int half_fft = MEL_FB_FULL_SCALE_FFT_SIZE / 2 + 1;
+	const int fft_size = MEL_FB_FULL_SCALE_FFT_SIZE * sizeof(struct icomplex32);
+	struct psy_mel_filterbank fb;
+	struct icomplex16 *fft_out_16;
+	struct icomplex32 *fft_out;
+	struct icomplex32 *fft_buf;
+	int16_t mel_log_16[MEL_FB_FULL_SCALE_MEL_BINS];
+	int i;
+
+	fft_buf = malloc(fft_size);
+	fft_out = malloc(fft_size);
+	assert_non_null(fft_buf);
+	assert_non_null(fft_out);
+
+	fb.samplerate = 16000;
+	fb.start_freq = 100;
+	fb.end_freq = 7500;
+	fb.mel_bins = MEL_FB_FULL_SCALE_MEL_BINS;
+	fb.slaney_normalize = false;
+	fb.mel_log_scale = MEL_LOG;
+	fb.fft_bins = MEL_FB_FULL_SCALE_FFT_SIZE;
+	fb.half_fft_bins = half_fft;
+	fb.scratch_data1 = (int16_t *)fft_buf;
+	fb.scratch_data2 = (int16_t *)fft_out;
+	fb.scratch_length1 = fft_size / sizeof(int16_t);
+	fb.scratch_length2 = fft_size / sizeof(int16_t);
+	assert_int_equal(mod_psy_get_mel_filterbank(&dummy, &fb), 0);
+
+	if (bits == 16) {
+		fft_out_16 = (struct icomplex16 *)fft_out;
+		for (i = 0; i < half_fft; i++) {
+			fft_out_16[i].real = value;
+			fft_out_16[i].imag = value;
+		}
+
+		psy_apply_mel_filterbank_16(&fb, fft_out_16, (int32_t *)fft_buf, mel_log_16, 0);
+		for (i = 0; i < MEL_FB_FULL_SCALE_MEL_BINS; i++)
+			mel_log[i] = mel_log_16[i];
+	} else {
+		for (i = 0; i < half_fft; i++) {
+			fft_out[i].real = value;
+			fft_out[i].imag = value;
+		}
+
+		psy_apply_mel_filterbank_32(&fb, fft_out, (int32_t *)fft_buf, mel_log, 0);
+		for (i = 0; i < MEL_FB_FULL_SCALE_MEL_BINS; i++)
+			mel_log[i] >>= 16;
+	}
+
+	mod_psy_free_mel_filterbank(&dummy, &fb);
+	free(fft_out);
+	free(fft_buf);
+}
+
+/* A negative power of two has one more bit of magnitude than the OR of the
+ * one's complement values tells, the shifted power must not wrap around.
+ */
+static void filterbank_full_scale_test(int bits)
+{
+	int32_t full_scale = -(1 << (bits - 1 - MEL_FB_FULL_SCALE_HEADROOM));
+	int32_t mel_log_full[MEL_FB_FULL_SCALE_MEL_BINS];
+	int32_t mel_log_ref[MEL_FB_FULL_SCALE_MEL_BINS];
+	int i;
+
+	filterbank_constant_test(bits, full_scale, mel_log_full);
+	filterbank_constant_test(bits, full_scale + 1, mel_log_ref);
+
+	for (i = 0; i < MEL_FB_FULL_SCALE_MEL_BINS; i++)
+		assert_true(abs(mel_log_full[i] - mel_log_ref[i]) <= 1);
+}
+
+static void test_mel_filterbank_16_full_scale(void **state)
+{
+	(void)state;
+
+	filterbank_full_scale_test(16);
+}
+
+static void test_mel_filterbank_32_full_scale(void **state)
+{
+	(void)state;
+
+	filterbank_full_scale_test(32);
+}
+
 static void test_mel_filterbank_16_test1(void **state)
 {
 	(void)state;
@@ -440,6 +532,8 @@ int main(void)
 		cmocka_unit_test(test_mel_filterbank_32_test3),
 		cmocka_unit_test(test_mel_filterbank_16_test4),
 		cmocka_unit_test(test_mel_filterbank_32_test4),
+		cmocka_unit_test(test_mel_filterbank_16_full_scale),
+		cmocka_unit_test(test_mel_filterbank_32_full_scale),
 		cmocka_unit_test(test_hz_to_mel),
 		cmocka_unit_test(test_mel_to_hz),
 	};
@@ -0,0 +1,353 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <sof/audio/module_adapter/module/generic.h>
+#include <sof/audio/format.h>
+#include <sof/math/chmatrix.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <cmocka.h>
+
+#define TEST_FRAMES	37
+#define TEST_CH_MAX	SOFM_CHMATRIX_CHANNELS_MAX
+#define ONE		SOFM_CHMATRIX_ONE_Q10
+
+struct processing_module dummy;
+
+/* Q6.10 matrix multiply with rounding and saturation, as the selector did it */
+static void ref_mix_s32(const int16_t coeffs[][TEST_CH_MAX], const int32_t *src, int32_t *dst,
+			int dst_channels, int src_channels, int frames, int bits)
+{
+	int64_t acc;
+	int f, i, j;
+
+	for (f = 0; f < frames; f++) {
+		for (i = 0; i < dst_channels; i++) {
+			acc = 0;
+			for (j = 0; j < src_channels; j++)
+				acc += (int64_t)src[j] * coeffs[i][j];
+
+			acc = (acc + (1 << 9)) >> 10;
+			dst[i] = bits == 24 ? sat_int24(acc) : sat_int32(acc);
+		}
+		src += src_channels;
+		dst += dst_channels;
+	}
+}
+
+static void ref_mix_s16(const int16_t coeffs[][TEST_CH_MAX], const int16_t *src, int16_t *dst,
+			int dst_channels, int src_channels, int frames)
+{
+	int32_t acc;
+	int f, i, j;
+
+	for (f = 0; f < frames; f++) {
+		for (i = 0; i < dst_channels; i++) {
+			acc = 0;
+			for (j = 0; j < src_channels; j++)
+				acc += (int32_t)src[j] * coeffs[i][j];
+
+			dst[i] = sat_int16((acc + (1 << 9)) >> 10);
+		}
+		src += src_channels;
+		dst += dst_channels;
+	}
+}
+
+static void fill_s32(int32_t *x, int n, int bits)
+{
+	uint32_t seed = 12345;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		seed = seed * 1103515245 + 12345;
+		x[i] = (int32_t)seed >> (32 - bits);
+	}
+
+	/* full scale samples to exercise the saturation */
+	x[0] = bits == 24 ? INT24_MAXVALUE : INT32_MAX;
+	x[1] = bits == 24 ? INT24_MINVALUE : INT32_MIN;
+}
+
+static void fill_s16(int16_t *x, int n)
+{
+	uint32_t seed = 54321;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		seed = seed * 1103515245 + 12345;
+		x[i] = (int16_t)(seed >> 16);
+	}
+
+	x[0] = INT16_MAX;
+	x[1] = INT16_MIN;
+}
+
+static void test_mix(const int16_t coeffs[][TEST_CH_MAX], int dst_channels, int src_channels,
+		     enum sofm_chmatrix_type type)
+{
+	static int32_t src32[TEST_FRAMES * TEST_CH_MAX];
+	static int32_t dst32[TEST_FRAMES * TEST_CH_MAX];
+	static int32_t ref32[TEST_FRAMES * TEST_CH_MAX];
+	static int16_t src16[TEST_FRAMES * TEST_CH_MAX];
+	static int16_t dst16[TEST_FRAMES * TEST_CH_MAX];
+	static int16_t ref16[TEST_FRAMES * TEST_CH_MAX];
+	struct sofm_chmatrix m;
+	int n = TEST_FRAMES * dst_channels;
+
+	assert_int_equal(sofm_chmatrix_init_q10(&m, SOF_IPC_FRAME_S16_LE, &coeffs[0][0],
+						TEST_CH_MAX, dst_channels, src_channels), 0);
+	assert_int_equal(m.type, type);
+	fill_s16(src16, TEST_FRAMES * src_channels);
+	sofm_chmatrix_process_linear(&m, src16, dst16, TEST_FRAMES);
+	ref_mix_s16(coeffs, src16, ref16, dst_channels, src_channels, TEST_FRAMES);
+	assert_memory_equal(dst16, ref16, n * sizeof(int16_t));
+
+	assert_int_equal(sofm_chmatrix_init_q10(&m, SOF_IPC_FRAME_S24_4LE, &coeffs[0][0],
+						TEST_CH_MAX, dst_channels, src_channels), 0);
+	assert_int_equal(m.type, type);
+	fill_s32(src32, TEST_FRAMES * src_channels, 24);
+	sofm_chmatrix_process_linear(&m, src32, dst32, TEST_FRAMES);
+	ref_mix_s32(coeffs, src32, ref32, dst_channels, src_channels, TEST_FRAMES, 24);
+	assert_memory_equal(dst32, ref32, n * sizeof(int32_t));
+
+	assert_int_equal(sofm_chmatrix_init_q10(&m, SOF_IPC_FRAME_S32_LE, &coeffs[0][0],
+						TEST_CH_MAX, dst_channels, src_channels), 0);
+	assert_int_equal(m.type, type);
+	fill_s32(src32, TEST_FRAMES * src_channels, 32);
+	sofm_chmatrix_process_linear(&m, src32, dst32, TEST_FRAMES);
+	ref_mix_s32(coeffs, src32, ref32, dst_channels, src_channels, TEST_FRAMES, 32);
+	assert_memory_equal(dst32, ref32, n * sizeof(int32_t));
+}
+
+static void test_chmatrix_copy(void **state)
+{
+	const int16_t coeffs[TEST_CH_MAX][TEST_CH_MAX] = {
+		{ ONE, 0, 0, 0 },
+		{ 0, ONE, 0, 0 },
+		{ 0, 0, ONE, 0 },
+		{ 0, 0, 0, ONE },
+	};
+
+	(void)state;
+
+	test_mix(coeffs, 4, 4, SOFM_CHMATRIX_COPY);
+}
+
+static void test_chmatrix_pick(void **state)
+{
+	/* swapped stereo to 4.0 with a silent channel */
+	const int16_t coeffs[TEST_CH_MAX][TEST_CH_MAX] = {
+		{ 0, ONE },
+		{ ONE, 0 },
+		{ 0, 0 },
+		{ 0, ONE },
+	};
+
+	(void)state;
+
+	test_mix(coeffs, 4, 2, SOFM_CHMATRIX_PICK);
+}
+
+static void test_chmatrix_sparse(void **state)
+{
+	/* 5.1 to stereo downmix */
+	const int16_t coeffs[TEST_CH_MAX][TEST_CH_MAX] = {
+		{ 724, 512, 0, 0, 362, 0 },
+		{ 0, 512, 724, 0, 0, 362 },
+	};
+
+	(void)state;
+
+	test_mix(coeffs, 2, 6, SOFM_CHMATRIX_SPARSE);
+}
+
+static void test_chmatrix_dense(void **state)
+{
+	const int16_t coeffs[TEST_CH_MAX][TEST_CH_MAX] = {
+		{ 2 * ONE, -ONE, 300 },
+		{ -700, 0, 1500 },
+		{ 32767, -32768, 1 },
+	};
+
+	(void)state;
+
+	test_mix(coeffs, 3, 3, SOFM_CHMATRIX_DENSE);
+}
+
+static void test_chmatrix_invalid(void **state)
+{
+	const int16_t coeffs[TEST_CH_MAX][TEST_CH_MAX] = { { ONE } };
+	struct sofm_chmatrix m;
+
+	(void)state;
+
+	assert_int_equal(sofm_chmatrix_init_q10(&m, SOF_IPC_FRAME_U8, &coeffs[0][0],
+						TEST_CH_MAX, 1, 1), -EINVAL);
+	assert_int_equal(sofm_chmatrix_init_q10(&m, SOF_IPC_FRAME_S16_LE, &coeffs[0][0],
+						TEST_CH_MAX, TEST_CH_MAX + 1, 1), -EINVAL);
+	assert_int_equal(sofm_chmatrix_init_chmap(&m, SOF_IPC_FRAME_S32_LE, 0, 1,
+						  TEST_CH_MAX + 1), -EINVAL);
+	assert_int_equal(sofm_chmatrix_init_chmap(&m, SOF_IPC_FRAME_S32_LE, 0, 0, 1), -EINVAL);
+}
+
+/* S24 picks saturate samples out of the 24 bit range like the mixing kernels */
+static void test_chmatrix_pick_s24_sat(void **state)
+{
+	const int16_t coeffs[TEST_CH_MAX][TEST_CH_MAX] = {
+		{ 0, ONE },
+		{ ONE, 0 },
+	};
+	const int32_t src[] = { INT24_MAXVALUE + 1, INT24_MINVALUE - 1, -5, 7 };
+	const int32_t ref[] = { INT24_MINVALUE, INT24_MAXVALUE, 7, -5 };
+	int32_t dst[ARRAY_SIZE(ref)];
+	struct sofm_chmatrix m;
+
+	(void)state;
+
+	assert_int_equal(sofm_chmatrix_init_q10(&m, SOF_IPC_FRAME_S24_4LE, &coeffs[0][0],
+						TEST_CH_MAX, 2, 2), 0);
+	assert_int_equal(m.type, SOFM_CHMATRIX_PICK);
+	sofm_chmatrix_process_linear(&m, src, dst, 2);
+	assert_memory_equal(dst, ref, sizeof(ref));
+}
+
+/* Frames with more channels than the matrix, the extra sink channels are not touched */
+static void test_chmatrix_frame_channels(void **state)
+{
+	const int16_t coeffs[TEST_CH_MAX][TEST_CH_MAX] = {
+		{ ONE, 0 },
+		{ 0, ONE },
+	};
+	const int src_frame = 3;
+	const int dst_frame = 4;
+	const int frames = 5;
+	int32_t src_buf[3 * 5];
+	int32_t dst_buf[4 * 5 + 1];
+	struct cir_buf_source source = {
+		.buf_start = src_buf,
+		.buf_end = src_buf + ARRAY_SIZE(src_buf),
+		.ptr = src_buf + 4,
+	};
+	struct cir_buf_sink sink = {
+		.buf_start = dst_buf,
+		.buf_end = dst_buf + ARRAY_SIZE(dst_buf),
+		.ptr = dst_buf + 7,
+	};
+	struct sofm_chmatrix m;
+	const int32_t *x;
+	int32_t *y;
+	int f, i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(src_buf); i++)
+		src_buf[i] = 1000 + i;
+	for (i = 0; i < ARRAY_SIZE(dst_buf); i++)
+		dst_buf[i] = -1;
+
+	assert_int_equal(sofm_chmatrix_init_q10(&m, SOF_IPC_FRAME_S32_LE, &coeffs[0][0],
+						TEST_CH_MAX, 2, 2), 0);
+	assert_int_equal(m.type, SOFM_CHMATRIX_COPY);
+	assert_int_equal(sofm_chmatrix_set_frame_channels(&m, 1, dst_frame), -EINVAL);
+	assert_int_equal(sofm_chmatrix_set_frame_channels(&m, src_frame, dst_frame), 0);
+	assert_int_equal(m.type, SOFM_CHMATRIX_PICK);
+	sofm_chmatrix_process(&m, &source, &sink, frames);
+
+	x = source.ptr;
+	y = sink.ptr;
+	for (f = 0; f < frames; f++) {
+		int32_t in[3];
+
+		for (i = 0; i < src_frame; i++) {
+			x = cir_buf_wrap((void *)x, source.buf_start, source.buf_end);
+			in[i] = *x++;
+		}
+
+		for (i = 0; i < dst_frame; i++) {
+			y = cir_buf_wrap(y, sink.buf_start, sink.buf_end);
+			assert_int_equal(*y++, i < 2 ? in[i] : -1);
+		}
+	}
+}
+
+/* Channel map picks from circular buffers with frames split by the wrap */
+static void test_chmatrix_chmap_wrap(void **state)
+{
+	/* sink 0 <- source 2, sink 1 muted, sink 2 <- source 0, sink 3 out of range */
+	const uint32_t chmap = 0x50f2;
+	const int src_channels = 3;
+	const int dst_channels = 4;
+	int32_t src_buf[3 * 10 + 1];
+	int32_t dst_buf[4 * 10 + 3];
+	struct cir_buf_source source = {
+		.buf_start = src_buf,
+		.buf_end = src_buf + ARRAY_SIZE(src_buf),
+		.ptr = src_buf + 7,
+	};
+	struct cir_buf_sink sink = {
+		.buf_start = dst_buf,
+		.buf_end = dst_buf + ARRAY_SIZE(dst_buf),
+		.ptr = dst_buf + 29,
+	};
+	struct sofm_chmatrix m;
+	const int32_t *x;
+	int32_t *y;
+	int frames = 10;
+	int f, i;
+
+	(void)state;
+
+	for (i = 0; i < ARRAY_SIZE(src_buf); i++)
+		src_buf[i] = 1000 + i;
+	memset(dst_buf, 0x55, sizeof(dst_buf));
+
+	assert_int_equal(sofm_chmatrix_init_chmap(&m, SOF_IPC_FRAME_S32_LE, chmap,
+						  dst_channels, src_channels), 0);
+	assert_int_equal(m.type, SOFM_CHMATRIX_PICK);
+	sofm_chmatrix_process(&m, &source, &sink, frames);
+
+	x = source.ptr;
+	y = sink.ptr;
+	for (f = 0; f < frames; f++) {
+		int32_t in[3];
+		int32_t expect[4];
+
+		for (i = 0; i < src_channels; i++) {
+			x = cir_buf_wrap((void *)x, source.buf_start, source.buf_end);
+			in[i] = *x++;
+		}
+
+		expect[0] = in[2];
+		expect[1] = 0;
+		expect[2] = in[0];
+		expect[3] = 0;
+
+		for (i = 0; i < dst_channels; i++) {
+			y = cir_buf_wrap(y, sink.buf_start, sink.buf_end);
+			assert_int_equal(*y++, expect[i]);
+		}
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_chmatrix_copy),
+		cmocka_unit_test(test_chmatrix_pick),
+		cmocka_unit_test(test_chmatrix_sparse),
+		cmocka_unit_test(test_chmatrix_dense),
+		cmocka_unit_test(test_chmatrix_invalid),
+		cmocka_unit_test(test_chmatrix_chmap_wrap),
+		cmocka_unit_test(test_chmatrix_pick_s24_sat),
+		cmocka_unit_test(test_chmatrix_frame_channels),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <errno.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <sof/audio/format.h>
+#include <sof/math/icomplex32.h>
+#include <sof/math/stft.h>
+
+#define TEST_FFT_SIZE		8
+#define TEST_HOP_SIZE		4
+#define TEST_PREV_SIZE		(TEST_FFT_SIZE - TEST_HOP_SIZE)
+#define TEST_IBUF_SIZE		6	/* Not a multiple of hop, reads wrap */
+#define TEST_OBUF_SIZE		(TEST_FFT_SIZE + TEST_HOP_SIZE)
+#define TEST_FRAMES		5
+#define TEST_OLA_VALUE		1000
+
+static void test_write_samples(struct sofm_stft_buffer *buf, int32_t first, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) {
+		*buf->w_ptr++ = first + i;
+		buf->w_ptr = sofm_stft_buffer_wrap(buf, buf->w_ptr);
+	}
+
+	buf->s_avail += n;
+	buf->s_free -= n;
+}
+
+static int32_t test_read_sample(struct sofm_stft_buffer *buf)
+{
+	int32_t sample = *buf->r_ptr;
+
+	*buf->r_ptr++ = 0;
+	buf->r_ptr = sofm_stft_buffer_wrap(buf, buf->r_ptr);
+	buf->s_avail--;
+	buf->s_free++;
+	return sample;
+}
+
+/* The FFT input must be the latest FFT size of the input stream, oldest
+ * first, also when the hop of new data wraps in the circular buffer.
+ */
+static void test_math_stft_fill_fft_buffer(void **state)
+{
+	struct sofm_stft_buffer ibuf;
+	struct icomplex32 fft_buf[TEST_FFT_SIZE];
+	int32_t storage[TEST_IBUF_SIZE];
+	int32_t prev_data[TEST_PREV_SIZE];
+	int32_t expect;
+	int frame;
+	int i;
+
+	(void)state;
+
+	memset(prev_data, 0, sizeof(prev_data));
+	sofm_stft_buffer_init(&ibuf, storage, TEST_IBUF_SIZE);
+	for (frame = 0; frame < TEST_FRAMES; frame++) {
+		/* Input stream is 1, 2, 3, ... */
+		test_write_samples(&ibuf, frame * TEST_HOP_SIZE + 1, TEST_HOP_SIZE);
+		sofm_stft_fill_fft_buffer(&ibuf, prev_data, TEST_PREV_SIZE, fft_buf,
+					  TEST_HOP_SIZE);
+		assert_int_equal(ibuf.s_avail, 0);
+		assert_int_equal(ibuf.s_free, TEST_IBUF_SIZE);
+		for (i = 0; i < TEST_FFT_SIZE; i++) {
+			expect = (frame + 1) * TEST_HOP_SIZE - TEST_FFT_SIZE + 1 + i;
+			assert_int_equal(fft_buf[i].real, expect > 0 ? expect : 0);
+			assert_int_equal(fft_buf[i].imag, 0);
+		}
+	}
+}
+
+/* With hop of half FFT size a constant IFFT output overlaps twice after
+ * the first hop.
+ */
+static void test_math_stft_overlap_add(void **state)
+{
+	struct sofm_stft_buffer obuf;
+	struct icomplex32 fft_buf[TEST_FFT_SIZE];
+	int32_t storage[TEST_OBUF_SIZE] __attribute__((aligned(8)));
+	int32_t expect;
+	int frame;
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < TEST_FFT_SIZE; i++) {
+		fft_buf[i].real = TEST_OLA_VALUE;
+		fft_buf[i].imag = -1;
+	}
+
+	memset(storage, 0, sizeof(storage));
+	sofm_stft_buffer_init(&obuf, storage, TEST_OBUF_SIZE);
+	for (frame = 0; frame < TEST_FRAMES; frame++) {
+		sofm_stft_overlap_add(&obuf, fft_buf, INT32_MAX, TEST_FFT_SIZE, TEST_HOP_SIZE);
+		assert_int_equal(obuf.s_avail, TEST_HOP_SIZE);
+		expect = frame ? 2 * TEST_OLA_VALUE : TEST_OLA_VALUE;
+		for (i = 0; i < TEST_HOP_SIZE; i++)
+			assert_int_equal(test_read_sample(&obuf), expect);
+	}
+}
+
+static void test_math_stft_window(void **state)
+{
+	struct icomplex32 fft_buf[TEST_FFT_SIZE];
+	int32_t window[TEST_FFT_SIZE];
+	int i;
+
+	(void)state;
+
+	assert_int_equal(sofm_stft_get_window(window, TEST_FFT_SIZE, SOFM_STFT_HANN_WINDOW), 0);
+	assert_int_equal(sofm_stft_get_window(window, TEST_FFT_SIZE,
+					      (enum sofm_stft_window_type)-1), -EINVAL);
+
+	/* Rectangular window keeps the real part and ignores the imaginary */
+	assert_int_equal(sofm_stft_get_window(window, TEST_FFT_SIZE,
+					      SOFM_STFT_RECTANGULAR_WINDOW), 0);
+	for (i = 0; i < TEST_FFT_SIZE; i++) {
+		fft_buf[i].real = (i & 1) ? -i * 100000 : i * 100000;
+		fft_buf[i].imag = i;
+	}
+
+	sofm_stft_apply_window(fft_buf, window, TEST_FFT_SIZE);
+	for (i = 0; i < TEST_FFT_SIZE; i++) {
+		assert_int_equal(fft_buf[i].real, (i & 1) ? -i * 100000 : i * 100000);
+		assert_int_equal(fft_buf[i].imag, i);
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_math_stft_fill_fft_buffer),
+		cmocka_unit_test(test_math_stft_overlap_add),
+		cmocka_unit_test(test_math_stft_window),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <string.h>
+#include <cmocka.h>
+#include <sof/audio/format.h>
+#include <sof/math/iir_df1.h>
+#include <user/eq.h>
+
+#define TEST_FRAMES		256
+#define TEST_BIQUADS		2
+
+/* Butterworth 1 kHz low-pass and 100 Hz high-pass at 48 kHz, the a1 and
+ * a2 are negated. Unity gain is 16384 in Q2.14.
+ */
+static const int32_t test_biquads[TEST_BIQUADS * SOF_EQ_IIR_NBIQUAD] = {
+	Q_CONVERT_FLOAT(-0.831005589346, 30), Q_CONVERT_FLOAT(1.815341082704, 30),
+	Q_CONVERT_FLOAT(0.003916126660, 30), Q_CONVERT_FLOAT(0.007832253321, 30),
+	Q_CONVERT_FLOAT(0.003916126660, 30), 0, 16384,
+	Q_CONVERT_FLOAT(-0.981658549223, 30), Q_CONVERT_FLOAT(1.981488509144, 30),
+	Q_CONVERT_FLOAT(0.990786764592, 30), Q_CONVERT_FLOAT(-1.981573529184, 30),
+	Q_CONVERT_FLOAT(0.990786764592, 30), 0, 16384,
+};
+
+static int32_t test_config[SOF_EQ_IIR_NHEADER + TEST_BIQUADS * SOF_EQ_IIR_NBIQUAD];
+
+static struct sof_eq_iir_header *test_header(int num_sections, int num_sections_in_series)
+{
+	struct sof_eq_iir_header *eq = (struct sof_eq_iir_header *)test_config;
+
+	memset(test_config, 0, sizeof(test_config));
+	eq->num_sections = num_sections;
+	eq->num_sections_in_series = num_sections_in_series;
+	memcpy(eq->biquads, test_biquads, sizeof(test_biquads));
+	return eq;
+}
+
+/* Filter random input with iir_df1_nch() and with iir_df1() for every
+ * channel separately, the outputs must be identical.
+ */
+static void test_iir_df1_nch(struct sof_eq_iir_header *eq, int nch)
+{
+	struct iir_state_df1 ref[PLATFORM_MAX_CHANNELS];
+	struct iir_state_df1 iir;
+	int32_t ref_delay[PLATFORM_MAX_CHANNELS][TEST_BIQUADS * IIR_DF1_NUM_STATE];
+	int32_t delay[PLATFORM_MAX_CHANNELS * TEST_BIQUADS * IIR_DF1_NUM_STATE];
+	int32_t data[PLATFORM_MAX_CHANNELS];
+	int32_t x[PLATFORM_MAX_CHANNELS];
+	int32_t *d;
+	int frame;
+	int ch;
+
+	memset(ref_delay, 0, sizeof(ref_delay));
+	memset(delay, 0, sizeof(delay));
+	srand(nch);
+
+	if (eq) {
+		iir_init_coef_df1(&iir, eq);
+		for (ch = 0; ch < nch; ch++) {
+			iir_init_coef_df1(&ref[ch], eq);
+			d = ref_delay[ch];
+			iir_init_delay_df1(&ref[ch], &d);
+		}
+	} else {
+		iir_reset_df1(&iir);
+		for (ch = 0; ch < nch; ch++)
+			iir_reset_df1(&ref[ch]);
+	}
+
+	for (frame = 0; frame < TEST_FRAMES; frame++) {
+		for (ch = 0; ch < nch; ch++) {
+			x[ch] = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+			data[ch] = x[ch];
+		}
+
+		iir_df1_nch(&iir, delay, data, nch);
+		for (ch = 0; ch < nch; ch++)
+			assert_int_equal(data[ch], iir_df1(&ref[ch], x[ch]));
+	}
+}
+
+static void test_iir_df1_nch_series(void **state)
+{
+	(void)state;
+
+	test_iir_df1_nch(test_header(TEST_BIQUADS, TEST_BIQUADS), PLATFORM_MAX_CHANNELS);
+}
+
+static void test_iir_df1_nch_parallel(void **state)
+{
+	(void)state;
+
+	test_iir_df1_nch(test_header(TEST_BIQUADS, 1), PLATFORM_MAX_CHANNELS);
+}
+
+static void test_iir_df1_nch_odd_channels(void **state)
+{
+	(void)state;
+
+	test_iir_df1_nch(test_header(TEST_BIQUADS, TEST_BIQUADS), 3);
+}
+
+static void test_iir_df1_nch_mono(void **state)
+{
+	(void)state;
+
+	test_iir_df1_nch(test_header(TEST_BIQUADS, TEST_BIQUADS), 1);
+}
+
+static void test_iir_df1_nch_bypass(void **state)
+{
+	(void)state;
+
+	test_iir_df1_nch(NULL, PLATFORM_MAX_CHANNELS);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_iir_df1_nch_series),
+		cmocka_unit_test(test_iir_df1_nch_parallel),
+		cmocka_unit_test(test_iir_df1_nch_odd_channels),
+		cmocka_unit_test(test_iir_df1_nch_mono),
+		cmocka_unit_test(test_iir_df1_nch_bypass),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,73 @@
+#!/bin/bash
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright(c) 2026 Intel Corporation.
+
+# Measures the sof-logger decoding throughput on a generated trace.
+#
+# Usage: logger-bench.sh <tools build dir> [trace size in MiB] [runs]
+#
+# The tools build dir is where tools/ was built with CMake, it must contain
+# logger/sof-logger and logger/sof-logger-trace-gen. The trace and its
+# dictionary are generated to a temporary directory and decoded to text,
+# raw text and CSV when supported, the best of the runs is reported.
+
+set -e
+
+usage()
+{
+	echo "Usage: $0 <tools build dir> [trace size in MiB] [runs]"
+	exit 1
+}
+
+[ -n "$1" ] || usage
+
+BUILD_DIR=$1
+SIZE_MB=${2:-64}
+RUNS=${3:-3}
+LOGGER=$BUILD_DIR/logger/sof-logger
+GEN=$BUILD_DIR/logger/sof-logger-trace-gen
+
+for tool in "$LOGGER" "$GEN"; do
+	[ -x "$tool" ] || { echo "$tool not found"; exit 1; }
+done
+
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+"$GEN" -l "$WORK_DIR/bench.ldc" -o "$WORK_DIR/bench.bin" -s "$SIZE_MB"
+
+# decode with the given extra options, print the best time in ms
+run()
+{
+	local best=0
+	local start
+	local ms
+	local i
+
+	for i in $(seq "$RUNS"); do
+		start=$(date +%s%N)
+		"$LOGGER" -n -l "$WORK_DIR/bench.ldc" -i "$WORK_DIR/bench.bin" \
+			-o /dev/null "$@"
+		ms=$((($(date +%s%N) - start) / 1000000))
+		if [ "$best" -eq 0 ] || [ "$ms" -lt "$best" ]; then
+			best=$ms
+		fi
+	done
+
+	echo "$best"
+}
+
+report()
+{
+	local name=$1
+	local ms=$2
+
+	[ "$ms" -gt 0 ] || ms=1
+	echo "$name: $ms ms, $((SIZE_MB * 1000 / ms)) MiB/s"
+}
+
+report "text" "$(run)"
+report "raw" "$(run -r)"
+if "$LOGGER" -h | grep -q -- ' -x'; then
+	report "csv" "$(run -x)"
+fi
@@ -0,0 +1,301 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2026 Intel Corporation.
+
+/*
+ * Generates a synthetic dictionary (.ldc) and a DMA trace dump decoded by
+ * it, as input for the sof-logger throughput benchmark. The dictionary has
+ * the same layout as the one written by smex, the trace is a sequence of
+ * struct log_entry_header records each followed by its parameters. Records
+ * pick dictionary entries with a skewed distribution like real firmware
+ * logs, where a few log sites fire most of the time.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <ipc/info.h>
+#include <smex/ldc.h>
+#include <sof/lib/uuid.h>
+#include <user/abi_dbg.h>
+#include <user/trace.h>
+
+#define GEN_LOGS_BASE		0x1ffe0000
+#define GEN_UIDS_BASE		0x1fffa000
+#define GEN_UIDS_COUNT		8
+#define GEN_MAX_PARAMS		4
+#define GEN_DEFAULT_ENTRIES	512
+#define GEN_DEFAULT_SIZE_MB	64
+#define GEN_TICKS_PER_RECORD	1920
+#define GEN_ARRAY_SIZE(a)	(sizeof(a) / sizeof((a)[0]))
+
+/* must match struct ldc_entry_header in convert.c */
+struct gen_entry_header {
+	uint32_t level;
+	uint32_t component_class;
+	uint32_t params_num;
+	uint32_t line_idx;
+	uint32_t file_name_len;
+	uint32_t text_len;
+};
+
+struct gen_entry {
+	uint32_t address;
+	uint32_t params_num;
+	int uuid_param;		/* first parameter is a %pU uuid pointer */
+};
+
+static const char * const gen_files[] = {
+	"src/audio/pipeline/pipeline-stream.c",
+	"src/audio/module_adapter/module_adapter.c",
+	"src/ipc/ipc4/handler.c",
+	"src/schedule/ll_schedule.c",
+	"src/audio/copier/copier.c",
+};
+
+static const char * const gen_formats[GEN_MAX_PARAMS + 1] = {
+	"pipeline state change",
+	"comp %d status",
+	"buffer %u avail 0x%x",
+	"period %d frames %u xrun %#x",
+	"dma %d chan %u pos 0x%08x len %u",
+};
+
+/* the same with a %pU uuid as the first parameter */
+static const char * const gen_uuid_formats[GEN_MAX_PARAMS + 1] = {
+	NULL,
+	"%pU init",
+	"%pU state %d",
+	"%pU period %u pos 0x%x",
+	"%pU dma %d chan %u pos 0x%08x",
+};
+
+static void usage(const char *name)
+{
+	fprintf(stdout, "Usage %s -l ldc_file -o trace_file [-s size_mb] [-e entries]\n",
+		name);
+	fprintf(stdout, "\t -l ldc_file\tdictionary to write\n");
+	fprintf(stdout, "\t -o trace_file\ttrace dump to write\n");
+	fprintf(stdout, "\t -s size_mb\ttrace size in MiB, %d by default\n",
+		GEN_DEFAULT_SIZE_MB);
+	fprintf(stdout, "\t -e entries\tnumber of dictionary entries, %d by default\n",
+		GEN_DEFAULT_ENTRIES);
+	exit(0);
+}
+
+/* xorshift32, the same data on every run */
+static uint32_t gen_rand(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+static int gen_write(FILE *f, const void *data, size_t size)
+{
+	if (fwrite(data, size, 1, f) != 1) {
+		fprintf(stderr, "error: write failed: %s\n", strerror(errno));
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static int gen_ldc(FILE *f, struct gen_entry *entries, int num_entries)
+{
+	struct snd_sof_logs_header logs_hdr;
+	struct snd_sof_uids_header uids_hdr;
+	struct sof_uuid_entry uids[GEN_UIDS_COUNT];
+	struct gen_entry_header hdr;
+	static const uint32_t pad;
+	uint8_t *data;
+	uint32_t size = 0;
+	const char *text;
+	uint32_t len;
+	int ret;
+	int i;
+
+	/* entries are aligned to words like in the firmware image */
+	data = calloc(num_entries, sizeof(hdr) + 128);
+	if (!data)
+		return -ENOMEM;
+
+	for (i = 0; i < num_entries; i++) {
+		const char *file = gen_files[i % GEN_ARRAY_SIZE(gen_files)];
+
+		entries[i].params_num = i % (GEN_MAX_PARAMS + 1);
+		entries[i].uuid_param = entries[i].params_num && !(i % 7);
+		entries[i].address = GEN_LOGS_BASE + size;
+
+		text = entries[i].uuid_param ? gen_uuid_formats[entries[i].params_num] :
+			gen_formats[entries[i].params_num];
+
+		hdr.level = LOG_LEVEL_CRITICAL + i % 4;
+		hdr.component_class = 0;
+		hdr.params_num = entries[i].params_num;
+		hdr.line_idx = 100 + i;
+		hdr.file_name_len = strlen(file) + 1;
+		hdr.text_len = strlen(text) + 1;
+
+		memcpy(data + size, &hdr, sizeof(hdr));
+		size += sizeof(hdr);
+		memcpy(data + size, file, hdr.file_name_len);
+		size += hdr.file_name_len;
+		memcpy(data + size, text, hdr.text_len);
+		size += hdr.text_len;
+		len = (4 - size % 4) % 4;
+		memcpy(data + size, &pad, len);
+		size += len;
+	}
+
+	memset(&logs_hdr, 0, sizeof(logs_hdr));
+	memcpy(logs_hdr.sig, SND_SOF_LOGS_SIG, SND_SOF_LOGS_SIG_SIZE);
+	logs_hdr.base_address = GEN_LOGS_BASE;
+	logs_hdr.data_length = size;
+	logs_hdr.data_offset = sizeof(logs_hdr);
+	logs_hdr.version.abi_version = SOF_ABI_DBG_VERSION;
+
+	memset(uids, 0, sizeof(uids));
+	for (i = 0; i < GEN_UIDS_COUNT; i++) {
+		uids[i].id.a = 0x5a5a0000 + i;
+		uids[i].id.b = i;
+		snprintf((char *)uids[i].name, UUID_NAME_MAX_LEN, "gen%d", i);
+	}
+
+	memset(&uids_hdr, 0, sizeof(uids_hdr));
+	memcpy(uids_hdr.sig, SND_SOF_UIDS_SIG, SND_SOF_UIDS_SIG_SIZE);
+	uids_hdr.base_address = GEN_UIDS_BASE;
+	uids_hdr.data_length = sizeof(uids);
+	uids_hdr.data_offset = sizeof(uids_hdr);
+
+	ret = gen_write(f, &logs_hdr, sizeof(logs_hdr));
+	if (!ret)
+		ret = gen_write(f, data, size);
+	if (!ret)
+		ret = gen_write(f, &uids_hdr, sizeof(uids_hdr));
+	if (!ret)
+		ret = gen_write(f, uids, sizeof(uids));
+
+	free(data);
+	return ret;
+}
+
+static int gen_trace(FILE *f, const struct gen_entry *entries, int num_entries,
+		     uint64_t size)
+{
+	struct log_entry_header rec;
+	uint32_t params[GEN_MAX_PARAMS];
+	uint32_t seed = 0x12345678;
+	const struct gen_entry *e;
+	uint64_t written = 0;
+	uint64_t count = 0;
+	uint32_t r;
+	int ret;
+	int i;
+
+	memset(&rec, 0, sizeof(rec));
+
+	while (written < size) {
+		/* half of the records come from the first 1/16 of the entries */
+		r = gen_rand(&seed);
+		if (r & 1)
+			e = &entries[(r >> 1) % (num_entries / 16 + 1)];
+		else
+			e = &entries[(r >> 1) % num_entries];
+
+		rec.uid = r & 2 ? GEN_UIDS_BASE + ((r >> 8) % GEN_UIDS_COUNT) *
+			sizeof(struct sof_uuid_entry) : 0;
+		rec.id_0 = (r >> 12) & 0xf;
+		rec.id_1 = (r >> 16) & 0xf;
+		rec.core_id = (r >> 20) & 0x3;
+		rec.timestamp = ++count * GEN_TICKS_PER_RECORD;
+		rec.log_entry_address = e->address;
+
+		for (i = 0; i < e->params_num; i++)
+			params[i] = gen_rand(&seed) & 0xffff;
+
+		if (e->uuid_param)
+			params[0] = GEN_UIDS_BASE + (params[0] % GEN_UIDS_COUNT) *
+				sizeof(struct sof_uuid_entry);
+
+		ret = gen_write(f, &rec, sizeof(rec));
+		if (!ret && e->params_num)
+			ret = gen_write(f, params, e->params_num * sizeof(params[0]));
+		if (ret)
+			return ret;
+
+		written += sizeof(rec) + e->params_num * sizeof(params[0]);
+	}
+
+	fprintf(stdout, "%llu records, %llu bytes\n", (unsigned long long)count,
+		(unsigned long long)written);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	const char *ldc_file = NULL;
+	const char *trace_file = NULL;
+	struct gen_entry *entries;
+	int num_entries = GEN_DEFAULT_ENTRIES;
+	uint64_t size_mb = GEN_DEFAULT_SIZE_MB;
+	FILE *ldc_fd = NULL;
+	FILE *trace_fd = NULL;
+	int opt;
+	int ret;
+
+	while ((opt = getopt(argc, argv, "l:o:s:e:h")) != -1) {
+		switch (opt) {
+		case 'l':
+			ldc_file = optarg;
+			break;
+		case 'o':
+			trace_file = optarg;
+			break;
+		case 's':
+			size_mb = strtoull(optarg, NULL, 0);
+			break;
+		case 'e':
+			num_entries = atoi(optarg);
+			break;
+		case 'h':
+		default:
+			usage(argv[0]);
+		}
+	}
+
+	if (!ldc_file || !trace_file || !size_mb || num_entries <= 0)
+		usage(argv[0]);
+
+	entries = calloc(num_entries, sizeof(*entries));
+	if (!entries)
+		return EXIT_FAILURE;
+
+	ldc_fd = fopen(ldc_file, "wb");
+	trace_fd = fopen(trace_file, "wb");
+	if (!ldc_fd || !trace_fd) {
+		fprintf(stderr, "error: can't open output: %s\n", strerror(errno));
+		ret = -errno;
+		goto out;
+	}
+
+	ret = gen_ldc(ldc_fd, entries, num_entries);
+	if (!ret)
+		ret = gen_trace(trace_fd, entries, num_entries, size_mb << 20);
+
+out:
+	if (ldc_fd)
+		fclose(ldc_fd);
+	if (trace_fd)
+		fclose(trace_fd);
+	free(entries);
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <errno.h>
+#include <inttypes.h>
 #include <unistd.h>
 #include <math.h>
 #include <sof/lib/uuid.h>
@@ -51,6 +52,29 @@ struct ldc_entry {
 	uint32_t *params;
 };
 
+/** Dictionary entry parsed once from the dictionary and cached by its
+ * address. file_name and text share one allocation.
+ */
+struct ldc_cache_entry {
+	uint32_t address;
+	struct ldc_entry_header header;
+	char *file_name;
+	char *text;
+};
+
+/** Open addressing hash table of parsed dictionary entries */
+struct ldc_cache {
+	struct ldc_cache_entry *slots;
+	uint32_t size; /* power of two */
+	uint32_t count;
+};
+
+/** Dictionary entries are parsed from memory, the logs section of the ldc
+ * file is read once in convert().
+ */
+static uint8_t *ldc_data;
+static struct ldc_cache ldc_cache;
+
 /** Dictionary entry + formatted parameters */
 struct proc_ldc_entry {
 	int subst_mask;
@@ -66,7 +90,7 @@ struct proc_ldc_entry {
 
 static const char *missing = "<missing>";
 
-static int read_entry_from_ldc_file(struct ldc_entry *entry, uint32_t log_entry_address);
+static int get_ldc_entry(struct ldc_entry *entry, uint32_t log_entry_address);
 
 char *format_uid_raw(const struct sof_uuid_entry *uid_entry, int use_colors, int name_first,
 		     bool be, bool upper)
@@ -192,13 +216,11 @@ static const char *asprintf_entry_text(uint32_t entry_address)
 	struct ldc_entry entry;
 	int ret;
 
-	ret = read_entry_from_ldc_file(&entry, entry_address);
+	ret = get_ldc_entry(&entry, entry_address);
 	if (ret)
 		return NULL;
 
-	free(entry.file_name);
-
-	return entry.text;
+	return strdup(entry.text);
 }
 
 /** printf-like formatting from the binary ldc_entry input to the
@@ -605,93 +627,203 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 	fflush(out_fd);
 }
 
-static int read_entry_from_ldc_file(struct ldc_entry *entry, uint32_t log_entry_address)
+#define LDC_CACHE_INIT_SIZE	1024
+
+static uint32_t ldc_cache_hash(uint32_t address)
 {
-	uint32_t base_address = global_config->logs_header->base_address;
-	uint32_t data_offset = global_config->logs_header->data_offset;
+	/* Knuth multiplicative hash, entries are at least word aligned */
+	return (address >> 2) * 2654435761u;
+}
 
-	int ret;
+static struct ldc_cache_entry *ldc_cache_slot(struct ldc_cache_entry *slots, uint32_t size,
+					      uint32_t address)
+{
+	uint32_t i = ldc_cache_hash(address) & (size - 1);
 
-	/* evaluate entry offset in input file */
-	uint32_t entry_offset = (log_entry_address - base_address) + data_offset;
+	/* linear probing, the table always has free slots */
+	while (slots[i].text && slots[i].address != address)
+		i = (i + 1) & (size - 1);
 
-	entry->file_name = NULL;
-	entry->text = NULL;
-	entry->params = NULL;
+	return &slots[i];
+}
 
-	/* set file position to beginning of processed entry */
-	ret = fseek(global_config->ldc_fd, entry_offset, SEEK_SET);
-	if (ret) {
-		log_err("Failed to seek to entry header for offset 0x%x in dictionary.\n",
-			entry_offset);
-		ret = -errno;
-		goto out;
+static int ldc_cache_grow(void)
+{
+	uint32_t size = ldc_cache.size ? 2 * ldc_cache.size : LDC_CACHE_INIT_SIZE;
+	struct ldc_cache_entry *slots;
+	uint32_t i;
+
+	slots = calloc(size, sizeof(*slots));
+	if (!slots) {
+		log_err("can't allocate %u entries for dictionary cache\n", size);
+		return -ENOMEM;
 	}
 
-	/* fetching elf header params */
-	ret = fread(&entry->header, sizeof(entry->header), 1, global_config->ldc_fd);
-	if (ret != 1) {
+	for (i = 0; i < ldc_cache.size; i++)
+		if (ldc_cache.slots[i].text)
+			*ldc_cache_slot(slots, size, ldc_cache.slots[i].address) =
+				ldc_cache.slots[i];
+
+	free(ldc_cache.slots);
+	ldc_cache.slots = slots;
+	ldc_cache.size = size;
+	return 0;
+}
+
+static void ldc_cache_free(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < ldc_cache.size; i++)
+		free(ldc_cache.slots[i].file_name);
+
+	free(ldc_cache.slots);
+	ldc_cache.slots = NULL;
+	ldc_cache.size = 0;
+	ldc_cache.count = 0;
+}
+
+/** Parses a dictionary entry from the logs section in memory and adds it
+ * to the cache slot.
+ */
+static int parse_ldc_entry(struct ldc_cache_entry *slot, uint32_t log_entry_address)
+{
+	uint32_t base_address = global_config->logs_header->base_address;
+	uint32_t data_length = global_config->logs_header->data_length;
+	struct ldc_entry_header header;
+	uint32_t entry_offset = log_entry_address - base_address;
+	const uint8_t *data;
+	char *strings;
+
+	if (entry_offset > data_length || data_length - entry_offset < sizeof(header)) {
 		log_err("Failed to read entry header for offset 0x%x in dictionary.\n",
 			entry_offset);
-		ret = -1;
-		goto out;
+		return -EINVAL;
 	}
-	if (entry->header.file_name_len > TRACE_MAX_FILENAME_LEN) {
+
+	data = ldc_data + entry_offset;
+	memcpy(&header, data, sizeof(header));
+	data += sizeof(header);
+	if (header.file_name_len > TRACE_MAX_FILENAME_LEN) {
 		log_err("Invalid filename length %d or ldc file does not match firmware\n",
-			entry->header.file_name_len);
-		ret = -EINVAL;
-		goto out;
+			header.file_name_len);
+		return -EINVAL;
 	}
-	entry->file_name = (char *)malloc(entry->header.file_name_len + 1);
 
-	if (!entry->file_name) {
-		log_err("can't allocate %d byte for entry.file_name\n",
-			entry->header.file_name_len);
-		ret = -ENOMEM;
-		goto out;
+	if (header.text_len > TRACE_MAX_TEXT_LEN) {
+		log_err("Invalid text length.\n");
+		return -EINVAL;
 	}
 
-	ret = fread(entry->file_name, sizeof(char), entry->header.file_name_len,
-		    global_config->ldc_fd);
-	entry->file_name[entry->header.file_name_len] = '\0';
-
-	if (ret != entry->header.file_name_len) {
-		log_err("Failed to read source filename for offset 0x%x in dictionary.\n",
+	if (data_length - entry_offset - sizeof(header) <
+	    header.file_name_len + header.text_len) {
+		log_err("Failed to read log message at offset 0x%x from dictionary.\n",
 			entry_offset);
-		ret = -1;
-		goto out;
+		return -EINVAL;
 	}
 
-	/* fetching text */
-	if (entry->header.text_len > TRACE_MAX_TEXT_LEN) {
-		log_err("Invalid text length.\n");
-		ret = -EINVAL;
-		goto out;
+	strings = malloc(header.file_name_len + header.text_len + 2);
+	if (!strings) {
+		log_err("can't allocate %d byte for entry strings\n",
+			header.file_name_len + header.text_len + 2);
+		return -ENOMEM;
 	}
-	entry->text = (char *)malloc(entry->header.text_len + 1);
-	if (!entry->text) {
-		log_err("can't allocate %d byte for entry.text\n", entry->header.text_len);
-		ret = -ENOMEM;
-		goto out;
+
+	slot->address = log_entry_address;
+	slot->header = header;
+	slot->file_name = strings;
+	memcpy(slot->file_name, data, header.file_name_len);
+	slot->file_name[header.file_name_len] = '\0';
+	slot->text = strings + header.file_name_len + 1;
+	memcpy(slot->text, data + header.file_name_len, header.text_len);
+	slot->text[header.text_len] = '\0';
+	ldc_cache.count++;
+
+	return 0;
+}
+
+/** Looks up the dictionary entry for the address, parsing it on first
+ * use. The returned strings are owned by the cache, entry->params is
+ * left NULL.
+ */
+static int get_ldc_entry(struct ldc_entry *entry, uint32_t log_entry_address)
+{
+	struct ldc_cache_entry *slot;
+	int ret;
+
+	entry->file_name = NULL;
+	entry->text = NULL;
+	entry->params = NULL;
+
+	/* keep load factor at most one half */
+	if (2 * (ldc_cache.count + 1) > ldc_cache.size) {
+		ret = ldc_cache_grow();
+		if (ret)
+			return ret;
 	}
-	ret = fread(entry->text, sizeof(char), entry->header.text_len, global_config->ldc_fd);
-	if (ret != entry->header.text_len) {
-		log_err("Failed to read log message at offset 0x%x from dictionary.\n",
-			entry_offset);
-		ret = -1;
-		goto out;
+
+	slot = ldc_cache_slot(ldc_cache.slots, ldc_cache.size, log_entry_address);
+	if (!slot->text) {
+		ret = parse_ldc_entry(slot, log_entry_address);
+		if (ret)
+			return ret;
 	}
-	entry->text[entry->header.text_len] = '\0';
+
+	entry->header = slot->header;
+	entry->file_name = slot->file_name;
+	entry->text = slot->text;
 
 	return 0;
+}
 
-out:
-	free(entry->text);
-	entry->text = NULL;
-	free(entry->file_name);
-	entry->file_name = NULL;
+/** Writes one entry as a CSV line without text formatting: timestamp in
+ * DSP ticks, core, component uid pointer, ids, level, dictionary entry
+ * address and the raw parameters. The convert of CSV input formats the
+ * lines to text later.
+ */
+static void print_entry_csv(const struct log_entry_header *dma_log,
+			    const struct ldc_entry *entry)
+{
+	FILE *out_fd = global_config->out_fd;
+	int i;
 
-	return ret;
+	fprintf(out_fd, "%" PRIu64 ",%u,0x%08x,%u,%u,%u,0x%08x",
+		(uint64_t)dma_log->timestamp, dma_log->core_id, dma_log->uid,
+		dma_log->id_0, dma_log->id_1, entry->header.level,
+		dma_log->log_entry_address);
+
+	for (i = 0; i < entry->header.params_num; i++)
+		fprintf(out_fd, ",0x%08x", entry->params[i]);
+
+	fprintf(out_fd, "\n");
+
+	/* flush only live streams, file conversions are buffered */
+	if (global_config->trace || global_config->serial_fd >= 0)
+		fflush(out_fd);
+}
+
+/** Outputs an entry with its parameters in the selected format.
+ *
+ * @param[in] dma_log protocol header of the entry
+ * @param[in] entry dictionary entry with params set, text is not modified
+ * @param[in,out] last_timestamp timestamp of the previous entry, updated
+ */
+static void output_entry(const struct log_entry_header *dma_log, struct ldc_entry *entry,
+			 uint64_t *last_timestamp)
+{
+	/* process_params() edits the text, so format a copy of it */
+	char text[TRACE_MAX_TEXT_LEN + 1];
+	struct ldc_entry e = *entry;
+
+	if (global_config->csv_output) {
+		print_entry_csv(dma_log, entry);
+	} else {
+		memcpy(text, entry->text, entry->header.text_len + 1);
+		e.text = text;
+		print_entry_params(dma_log, &e, *last_timestamp);
+	}
+
+	*last_timestamp = dma_log->timestamp;
 }
 
 /** Gets the dictionary entry matching the log entry argument, reads
@@ -705,30 +837,25 @@ out:
  */
 static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_timestamp)
 {
+	uint32_t params[TRACE_MAX_PARAMS_COUNT];
 	struct ldc_entry entry;
 	int ret;
 
-	ret = read_entry_from_ldc_file(&entry, dma_log->log_entry_address);
+	ret = get_ldc_entry(&entry, dma_log->log_entry_address);
 	if (ret < 0) {
-		log_err("read_entry_from_ldc_file(0x%x) returned %d\n",
+		log_err("get_ldc_entry(0x%x) returned %d\n",
 			dma_log->log_entry_address, ret);
-		goto out;
+		return ret;
 	}
 
 	/* fetching entry params from dma dump */
 	if (entry.header.params_num > TRACE_MAX_PARAMS_COUNT) {
 		log_err("Invalid number of parameters.\n");
-		ret = -EINVAL;
-		goto out;
-	}
-	entry.params = (uint32_t *)malloc(sizeof(uint32_t) * entry.header.params_num);
-	if (!entry.params) {
-		log_err("can't allocate %d byte for entry.params\n",
-			(int)(sizeof(uint32_t) * entry.header.params_num));
-		ret = -ENOMEM;
-		goto out;
+		return -EINVAL;
 	}
 
+	entry.params = params;
+
 	if (global_config->serial_fd < 0) {
 		ret = fread(entry.params, sizeof(uint32_t), entry.header.params_num,
 			    global_config->in_fd);
@@ -744,7 +871,7 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 				fprintf(global_config->out_fd,
 					"warn: log's End Of File. Device suspend?\n");
 
-			goto out;
+			return ret;
 		}
 	} else { /* serial */
 		size_t size = sizeof(uint32_t) * entry.header.params_num;
@@ -760,7 +887,7 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 				ret = -errno;
 				log_err("Failed to fread %d params from serial: %s\n",
 					entry.header.params_num, strerror(errno));
-				goto out;
+				return ret;
 			}
 			if (ret != size)
 				log_err("Partial read of %u bytes of %zu, reading more\n",
@@ -769,20 +896,9 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 	} /* serial */
 
 	/* printing entry content */
-	print_entry_params(dma_log, &entry, *last_timestamp);
-	*last_timestamp = dma_log->timestamp;
-
-	/* set f_ldc file position to the beginning */
-	rewind(global_config->ldc_fd);
+	output_entry(dma_log, &entry, last_timestamp);
 
-	ret = 0;
-out:
-	/* free alocated memory */
-	free(entry.params);
-	free(entry.text);
-	free(entry.file_name);
-
-	return ret;
+	return 0;
 }
 
 static int serial_read(uint64_t *last_timestamp)
@@ -838,6 +954,73 @@ static int serial_read(uint64_t *last_timestamp)
 	return fetch_entry(&dma_log, last_timestamp);
 }
 
+/** Reads the CSV lines written with csv_output and formats them to text.
+ * Lines that don't start with a timestamp, e.g. warnings, are skipped.
+ */
+static int csv_read(uint64_t *last_timestamp)
+{
+	struct log_entry_header dma_log;
+	uint32_t params[TRACE_MAX_PARAMS_COUNT];
+	struct ldc_entry entry;
+	char line[256];
+	unsigned long long timestamp;
+	unsigned int core_id, uid, id_0, id_1, level, address;
+	char *p, *end;
+	int line_num = 0;
+	int ret;
+	int i;
+
+	while (fgets(line, sizeof(line), global_config->in_fd)) {
+		line_num++;
+		ret = sscanf(line, "%llu,%u,%x,%u,%u,%u,%x", &timestamp, &core_id, &uid,
+			     &id_0, &id_1, &level, &address);
+		if (ret != 7)
+			continue;
+
+		ret = get_ldc_entry(&entry, address);
+		if (ret < 0) {
+			log_err("line %d: get_ldc_entry(0x%x) returned %d\n",
+				line_num, address, ret);
+			return ret;
+		}
+
+		if (entry.header.params_num > TRACE_MAX_PARAMS_COUNT) {
+			log_err("Invalid number of parameters.\n");
+			return -EINVAL;
+		}
+
+		/* the parameters follow the seven header fields */
+		p = line;
+		for (i = 0; i < 7 && p; i++) {
+			p = strchr(p, ',');
+			if (p)
+				p++;
+		}
+
+		for (i = 0; i < entry.header.params_num; i++) {
+			params[i] = p ? strtoul(p, &end, 0) : 0;
+			if (!p || end == p) {
+				log_err("line %d: %d params expected for %s:%d\n", line_num,
+					entry.header.params_num, entry.file_name,
+					entry.header.line_idx);
+				return -EINVAL;
+			}
+			p = *end == ',' ? end + 1 : end;
+		}
+
+		dma_log.uid = uid;
+		dma_log.id_0 = id_0;
+		dma_log.id_1 = id_1;
+		dma_log.core_id = core_id;
+		dma_log.timestamp = timestamp;
+		dma_log.log_entry_address = address;
+		entry.params = params;
+		output_entry(&dma_log, &entry, last_timestamp);
+	}
+
+	return -ferror(global_config->in_fd);
+}
+
 /** Main logger loop */
 static int logger_read(void)
 {
@@ -848,9 +1031,18 @@ static int logger_read(void)
 	bool ldc_address_OK = false;
 	unsigned int skipped_dwords = 0;
 
-	if (!global_config->raw_output)
+	if (global_config->csv_input)
+		global_config->csv_output = 0;
+
+	if (global_config->csv_output)
+		fprintf(global_config->out_fd,
+			"timestamp,core,uid,id_0,id_1,level,entry,params\n");
+	else if (!global_config->raw_output)
 		print_table_header();
 
+	if (global_config->csv_input)
+		return csv_read(&last_timestamp);
+
 	if (global_config->serial_fd >= 0)
 		/* Wait for CTRL-C */
 		for (;;) {
@@ -1146,6 +1338,26 @@ int convert(void)
 		goto out;
 	}
 
+	/* read the logs section once, entries are parsed from memory */
+	ldc_data = malloc(logs_hdr->data_length);
+	if (!ldc_data) {
+		log_err("failed to alloc memory for logs dictionary.\n");
+		ret = -ENOMEM;
+		goto out;
+	}
+	ret = fseek(config->ldc_fd, logs_hdr->data_offset, SEEK_SET);
+	if (ret) {
+		log_err("Error while seeking to logs dictionary in %s.\n", config->ldc_file);
+		ret = -errno;
+		goto out;
+	}
+	count = fread(ldc_data, logs_hdr->data_length, 1, config->ldc_fd);
+	if (!count) {
+		log_err("failed to read logs dictionary data.\n");
+		ret = -ferror(config->ldc_fd);
+		goto out;
+	}
+
 	if (config->filter_config) {
 		ret = filter_update_firmware();
 		if (ret) {
@@ -1156,6 +1368,9 @@ int convert(void)
 
 	ret = logger_read();
 out:
+	ldc_cache_free();
+	free(ldc_data);
+	ldc_data = NULL;
 	free(config->uids_dict);
 	return ret;
 }
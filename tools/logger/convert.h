@@ -39,6 +39,8 @@ struct convert_config {
 	int serial_fd;
 	int raw_output;
 	int dump_ldc;
+	int csv_output;
+	int csv_input;
 	int hide_location;
 	int relative_timestamps;
 	int8_t time_precision;
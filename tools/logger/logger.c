@@ -72,6 +72,10 @@ static void usage(void)
 		APP_NAME);
 	fprintf(stdout, "%s:\t -L\t\t\tHide log location in source code\n",
 		APP_NAME);
+	fprintf(stdout, "%s:\t -x\t\t\tExport entries as CSV with raw parameters, no text\n",
+		APP_NAME);
+	fprintf(stdout, "%s:\t -X\t\t\tInput is a CSV export from -x, format it to text\n",
+		APP_NAME);
 	fprintf(stdout,
 		"%s:\t -e 0/1\t\t\tTimestamps relative to first entry seen. Defaults to\n",
 		APP_NAME);
@@ -297,7 +301,7 @@ struct convert_config * const global_config = &_global_config;
 
 int main(int argc, char *argv[])
 {
-	static const char optstring[] = "ho:i:l:ps:c:u:tv:rd:Le:f:gF:n";
+	static const char optstring[] = "ho:i:l:ps:c:u:tv:rd:Le:f:gF:nxX";
 	struct convert_config config;
 	unsigned int baud = 0;
 	const char *snapshot_file = 0;
@@ -320,6 +324,8 @@ int main(int argc, char *argv[])
 	config.serial_fd = -EINVAL;
 	config.raw_output = 0;
 	config.dump_ldc = 0;
+	config.csv_output = 0;
+	config.csv_input = 0;
 	config.hide_location = 0;
 	config.time_precision = 6;
 	config.relative_timestamps = INT_MAX; /* unspecified */
@@ -368,6 +374,12 @@ int main(int argc, char *argv[])
 		case 'L':
 			config.hide_location = 1;
 			break;
+		case 'x':
+			config.csv_output = 1;
+			break;
+		case 'X':
+			config.csv_input = 1;
+			break;
 		case 'e': {
 			int i = atoi(optarg);
 
@@ -51,16 +51,14 @@ typedef struct snd_sof_pcm {
 
 static int plug_pipeline_set_state(snd_sof_plug_t *plug, int state,
 				   struct ipc4_pipeline_set_state *pipe_state,
-				   struct tplg_pipeline_info *pipe_info,
-				   struct plug_socket_desc *ipc)
+				   struct tplg_pipeline_info *pipe_info)
 {
-	struct ipc4_message_reply reply = {{ 0 }};
 	int ret;
 
 	pipe_state->primary.r.ppl_id = pipe_info->instance_id;
 
-	ret = plug_ipc_cmd_tx_rx(ipc, pipe_state, sizeof(*pipe_state),
-				 &reply, sizeof(reply));
+	ret = plug_ipc_batch_add(&plug->ipc, &plug->batch, pipe_state, sizeof(*pipe_state),
+				 pipe_info->name);
 	if (ret < 0)
 		SNDERR("failed pipeline %d set state %d\n", pipe_info->instance_id, state);
 
@@ -93,26 +91,24 @@ static int plug_pipelines_set_state(snd_sof_plug_t *plug, int state)
 			struct tplg_pipeline_info *pipe_info = pipeline_list->pipelines[i];
 			int ret;
 
-			ret = plug_pipeline_set_state(plug, state, &pipe_state, pipe_info,
-						      &plug->ipc);
+			ret = plug_pipeline_set_state(plug, state, &pipe_state, pipe_info);
 			if (ret < 0)
 				return ret;
 		}
 
-		return 0;
+		return plug_ipc_batch_flush(&plug->ipc, &plug->batch);
 	}
 
 	for (i = 0; i < pipeline_list->count; i++) {
 		struct tplg_pipeline_info *pipe_info = pipeline_list->pipelines[i];
 		int ret;
 
-		ret = plug_pipeline_set_state(plug, state, &pipe_state, pipe_info,
-					      &plug->ipc);
+		ret = plug_pipeline_set_state(plug, state, &pipe_state, pipe_info);
 		if (ret < 0)
 			return ret;
 	}
 
-	return 0;
+	return plug_ipc_batch_flush(&plug->ipc, &plug->batch);
 }
 
 static int plug_pcm_start(snd_pcm_ioplug_t *io)
@@ -40,6 +40,7 @@ typedef struct snd_sof_plug {
 	struct list_item pipeline_list;
 	int instance_ids[SND_SOC_TPLG_DAPM_LAST];
 	struct plug_socket_desc ipc;
+	struct plug_ipc_batch batch;	/* queued module and pipeline operations */
 
 	struct plug_shm_desc glb_ctx;
 
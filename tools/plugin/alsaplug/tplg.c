@@ -910,7 +910,6 @@ out:
 static int plug_set_up_widget_ipc(snd_sof_plug_t *plug, struct tplg_comp_info *comp_info)
 {
 	struct ipc4_module_init_instance *module_init = &comp_info->module_init;
-	struct ipc4_message_reply reply;
 	void *msg;
 	int size, ret;
 
@@ -925,25 +924,17 @@ static int plug_set_up_widget_ipc(snd_sof_plug_t *plug, struct tplg_comp_info *c
 	memcpy(msg, module_init, sizeof(*module_init));
 	memcpy(msg + sizeof(*module_init), comp_info->ipc_payload, comp_info->ipc_size);
 
-	ret = plug_ipc_cmd_tx_rx(&plug->ipc, msg, size, &reply, sizeof(reply));
+	ret = plug_ipc_batch_add(&plug->ipc, &plug->batch, msg, size, comp_info->name);
 	free(msg);
-	if (ret < 0) {
+	if (ret < 0)
 		SNDERR("error: can't set up widget %s\n", comp_info->name);
-		return ret;
-	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		SNDERR("widget %s set up failed with status %d\n",
-		       comp_info->name, reply.primary.r.status);
-		return -EINVAL;
-	}
-	return 0;
+	return ret;
 }
 
 static int plug_set_up_pipeline(snd_sof_plug_t *plug, struct tplg_pipeline_info *pipe_info)
 {
 	struct ipc4_pipeline_create msg = {{ 0 }};
-	struct ipc4_message_reply reply;
 	int ret;
 
 	msg.primary.r.type = SOF_IPC4_GLB_CREATE_PIPELINE;
@@ -953,18 +944,12 @@ static int plug_set_up_pipeline(snd_sof_plug_t *plug, struct tplg_pipeline_info
 	msg.primary.r.instance_id = pipe_info->instance_id;
 	msg.primary.r.ppl_mem_size = pipe_info->mem_usage;
 
-	ret = plug_ipc_cmd_tx_rx(&plug->ipc, &msg, sizeof(msg), &reply, sizeof(reply));
+	ret = plug_ipc_batch_add(&plug->ipc, &plug->batch, &msg, sizeof(msg), pipe_info->name);
 	if (ret < 0) {
 		SNDERR("error: can't set up pipeline %s\n", pipe_info->name);
 		return ret;
 	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		SNDERR("pipeline %s instance ID %d set up failed with status %d\n",
-		       pipe_info->name, pipe_info->instance_id, reply.primary.r.status);
-		return -EINVAL;
-	}
-
 	tplg_debug("pipeline %s instance_id %d mem_usage %d set up\n", pipe_info->name,
 		   pipe_info->instance_id, pipe_info->mem_usage);
 
@@ -1100,7 +1085,6 @@ static int plug_set_up_route(snd_sof_plug_t *plug, struct tplg_route_info *route
 	struct tplg_comp_info *src_comp_info = route_info->source;
 	struct tplg_comp_info *sink_comp_info = route_info->sink;
 	struct ipc4_module_bind_unbind bu;
-	struct ipc4_message_reply reply;
 	int ret;
 
 	bu.primary.r.module_id = src_comp_info->module_id;
@@ -1116,19 +1100,13 @@ static int plug_set_up_route(snd_sof_plug_t *plug, struct tplg_route_info *route
 	bu.extension.r.dst_queue = 0;
 	bu.extension.r.src_queue = 0;
 
-	ret = plug_ipc_cmd_tx_rx(&plug->ipc, &bu, sizeof(bu), &reply, sizeof(reply));
+	ret = plug_ipc_batch_add(&plug->ipc, &plug->batch, &bu, sizeof(bu), src_comp_info->name);
 	if (ret < 0) {
 		SNDERR("error: can't set up route %s -> %s\n", src_comp_info->name,
 		       sink_comp_info->name);
 		return ret;
 	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		SNDERR("route %s -> %s ID set up failed with status %d\n",
-		       src_comp_info->name, sink_comp_info->name, reply.primary.r.status);
-		return -EINVAL;
-	}
-
 	tplg_debug("route %s -> %s set up\n", src_comp_info->name, sink_comp_info->name);
 
 	return 0;
@@ -1175,6 +1153,11 @@ static int plug_set_up_widget(snd_sof_plug_t *plug, struct tplg_comp_info *comp_
 		priv_size = tplg_bytes->priv.size;
 		abi = (struct sof_abi_hdr *)ctl->data;
 
+		/* the widget must exist before its kcontrol data is sent */
+		ret = plug_ipc_batch_flush(&plug->ipc, &plug->batch);
+		if (ret < 0)
+			return ret;
+
 		/* send IPC with kcontrol data */
 		ret = plug_send_bytes_data(&plug->ipc, comp_info->module_id,
 					   comp_info->instance_id, abi);
@@ -1312,6 +1295,10 @@ int plug_set_up_pipelines(snd_sof_plug_t *plug, int dir, snd_pcm_hw_params_t *pa
 		if (ret < 0)
 			return ret;
 
+		ret = plug_ipc_batch_flush(&plug->ipc, &plug->batch);
+		if (ret < 0)
+			return ret;
+
 		tplg_debug("Setting up capture pipelines complete\n");
 
 		return 0;
@@ -1325,6 +1312,10 @@ int plug_set_up_pipelines(snd_sof_plug_t *plug, int dir, snd_pcm_hw_params_t *pa
 	if (ret < 0)
 		return ret;
 
+	ret = plug_ipc_batch_flush(&plug->ipc, &plug->batch);
+	if (ret < 0)
+		return ret;
+
 	tplg_debug("Setting up playback pipelines complete\n");
 
 	return 0;
@@ -1333,7 +1324,6 @@ int plug_set_up_pipelines(snd_sof_plug_t *plug, int dir, snd_pcm_hw_params_t *pa
 static int plug_delete_pipeline(snd_sof_plug_t *plug, struct tplg_pipeline_info *pipe_info)
 {
 	struct ipc4_pipeline_delete msg;
-	struct ipc4_message_reply reply;
 	int ret;
 
 	msg.primary.r.type = SOF_IPC4_GLB_DELETE_PIPELINE;
@@ -1341,18 +1331,12 @@ static int plug_delete_pipeline(snd_sof_plug_t *plug, struct tplg_pipeline_info
 	msg.primary.r.rsp = SOF_IPC4_MESSAGE_DIR_MSG_REQUEST;
 	msg.primary.r.instance_id = pipe_info->instance_id;
 
-	ret = plug_ipc_cmd_tx_rx(&plug->ipc, &msg, sizeof(msg), &reply, sizeof(reply));
+	ret = plug_ipc_batch_add(&plug->ipc, &plug->batch, &msg, sizeof(msg), pipe_info->name);
 	if (ret < 0) {
 		SNDERR("error: can't delete pipeline %s\n", pipe_info->name);
 		return ret;
 	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		SNDERR("pipeline %s instance ID %d delete failed with status %d\n",
-		       pipe_info->name, pipe_info->instance_id, reply.primary.r.status);
-		return -EINVAL;
-	}
-
 	tplg_debug("pipeline %s instance_id %d freed\n", pipe_info->name,
 		   pipe_info->instance_id);
 
@@ -1364,7 +1348,6 @@ static int plug_free_route(snd_sof_plug_t *plug, struct tplg_route_info *route_i
 	struct tplg_comp_info *src_comp_info = route_info->source;
 	struct tplg_comp_info *sink_comp_info = route_info->sink;
 	struct ipc4_module_bind_unbind bu;
-	struct ipc4_message_reply reply;
 	int ret;
 
 	/* only unbind when widgets belong to separate pipelines */
@@ -1384,19 +1367,13 @@ static int plug_free_route(snd_sof_plug_t *plug, struct tplg_route_info *route_i
 	bu.extension.r.dst_queue = 0;
 	bu.extension.r.src_queue = 0;
 
-	ret = plug_ipc_cmd_tx_rx(&plug->ipc, &bu, sizeof(bu), &reply, sizeof(reply));
+	ret = plug_ipc_batch_add(&plug->ipc, &plug->batch, &bu, sizeof(bu), src_comp_info->name);
 	if (ret < 0) {
-		SNDERR("error: can't set up route %s -> %s\n", src_comp_info->name,
+		SNDERR("error: can't free route %s -> %s\n", src_comp_info->name,
 		       sink_comp_info->name);
 		return ret;
 	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		SNDERR("route %s -> %s ID set up failed with status %d\n",
-		       src_comp_info->name, sink_comp_info->name, reply.primary.r.status);
-		return -EINVAL;
-	}
-
 	tplg_debug("route %s -> %s freed\n", src_comp_info->name, sink_comp_info->name);
 
 	return 0;
@@ -1512,6 +1489,10 @@ int plug_free_pipelines(snd_sof_plug_t *plug, struct tplg_pipeline_list *pipelin
 			return ret;
 	}
 
+	ret = plug_ipc_batch_flush(&plug->ipc, &plug->batch);
+	if (ret < 0)
+		return ret;
+
 	plug->instance_ids[SND_SOC_TPLG_DAPM_SCHEDULER] = 0;
 	return 0;
 }
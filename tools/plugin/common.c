@@ -317,6 +317,96 @@ int plug_ipc_cmd_tx_rx(struct plug_socket_desc *ipc, void *msg, size_t len, void
 	return 0;
 }
 
+/* sends the queued operations, the batch is empty afterwards also on failure */
+int plug_ipc_batch_flush(struct plug_socket_desc *ipc, struct plug_ipc_batch *batch)
+{
+	char reply_msg[sizeof(struct ipc4_message_reply) + SOF_IPC4_BATCH_MAX_OPS * sizeof(uint32_t)];
+	struct ipc4_message_reply *reply = (struct ipc4_message_reply *)reply_msg;
+	uint32_t *status = (uint32_t *)(reply + 1);
+	struct ipc4_batch *hdr = (struct ipc4_batch *)batch->msg;
+	uint32_t done;
+	int err;
+
+	if (!batch->count)
+		return 0;
+
+	hdr->primary.dat = 0;
+	hdr->primary.r.count = batch->count;
+	hdr->primary.r.type = SOF_IPC4_GLB_BATCH;
+	hdr->primary.r.msg_tgt = SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG;
+	hdr->primary.r.rsp = SOF_IPC4_MESSAGE_DIR_MSG_REQUEST;
+	hdr->extension.dat = 0;
+	hdr->extension.r.data_size = batch->size - sizeof(*hdr);
+
+	memset(reply_msg, 0, sizeof(reply_msg));
+	err = plug_ipc_cmd_tx_rx(ipc, batch->msg, batch->size, reply_msg, sizeof(reply_msg));
+	if (err < 0) {
+		SNDERR("failed to send IPC batch\n");
+	} else if (reply->primary.r.status != IPC4_SUCCESS) {
+		/* the last operation run is the failing one, the others were reverted */
+		done = reply->extension.dat;
+		if (done && done <= batch->count)
+			SNDERR("batch operation for %s failed with status %u\n",
+			       batch->name[done - 1], status[done - 1]);
+		else
+			SNDERR("batch of %d operations failed with status %d\n",
+			       batch->count, reply->primary.r.status);
+		err = -EINVAL;
+	}
+
+	batch->count = 0;
+	batch->size = sizeof(*hdr);
+
+	return err;
+}
+
+/* queues an operation, it is sent with plug_ipc_batch_flush() */
+int plug_ipc_batch_add(struct plug_socket_desc *ipc, struct plug_ipc_batch *batch,
+		       void *msg, size_t len, const char *name)
+{
+	struct ipc4_message_request *request = msg;
+	size_t data_size = len - sizeof(*request);
+	size_t op_size = SOF_IPC4_BATCH_OP_SIZE(data_size);
+	struct ipc4_message_reply reply = {{ 0 }};
+	struct ipc4_batch_op *op;
+	int err;
+
+	if (!batch->count)
+		batch->size = sizeof(struct ipc4_batch);
+
+	if (batch->count == SOF_IPC4_BATCH_MAX_OPS || batch->size + op_size > IPC3_MAX_MSG_SIZE) {
+		err = plug_ipc_batch_flush(ipc, batch);
+		if (err < 0)
+			return err;
+	}
+
+	/* too big for a batch, send it alone */
+	if (batch->size + op_size > IPC3_MAX_MSG_SIZE) {
+		err = plug_ipc_cmd_tx_rx(ipc, msg, len, &reply, sizeof(reply));
+		if (err < 0)
+			return err;
+
+		if (reply.primary.r.status != IPC4_SUCCESS) {
+			SNDERR("operation for %s failed with status %d\n", name,
+			       reply.primary.r.status);
+			return -EINVAL;
+		}
+
+		return 0;
+	}
+
+	op = (struct ipc4_batch_op *)(batch->msg + batch->size);
+	memset(op, 0, op_size);
+	op->request = *request;
+	op->data_size = data_size;
+	memcpy(op->data, request + 1, data_size);
+
+	batch->name[batch->count++] = name;
+	batch->size += op_size;
+
+	return 0;
+}
+
 void plug_ctl_ipc_message(struct ipc4_module_large_config *config, int param_id,
 			  size_t size, uint32_t module_id, uint32_t instance_id,
 			  uint32_t type)
@@ -12,6 +12,7 @@
 #include <semaphore.h>
 #include <alsa/asoundlib.h>
 #include <ipc/control.h>
+#include <ipc4/batch.h>
 #include <tplg_parser/topology.h>
 
 /* temporary - current MAXLEN is not define in UAPI header - fix pending */
@@ -167,6 +168,14 @@ struct plug_socket_desc {
 	char path[NAME_SIZE];
 };
 
+/* IPC4 operations sent together in one SOF_IPC4_GLB_BATCH message */
+struct plug_ipc_batch {
+	char msg[IPC3_MAX_MSG_SIZE];	/* struct ipc4_batch and the operations */
+	size_t size;
+	int count;
+	const char *name[SOF_IPC4_BATCH_MAX_OPS];	/* object of each operation */
+};
+
 struct plug_sem_desc {
 	char name[NAME_SIZE];
 	sem_t *sem;
@@ -272,6 +281,11 @@ void plug_socket_free(struct plug_socket_desc *ipc);
 int plug_ipc_cmd_tx_rx(struct plug_socket_desc *ipc, void *msg, size_t len, void *reply,
 		       size_t rlen);
 
+int plug_ipc_batch_add(struct plug_socket_desc *ipc, struct plug_ipc_batch *batch,
+		       void *msg, size_t len, const char *name);
+
+int plug_ipc_batch_flush(struct plug_socket_desc *ipc, struct plug_ipc_batch *batch);
+
 /*
  * Locking
  */
@@ -45,6 +45,7 @@
 #include <sof/audio/pipeline.h>
 #include <sof/audio/component.h>
 #include <sof/audio/component_ext.h>
+#include <ipc4/batch.h>
 
 #include "common.h"
 #include "pipe.h"
@@ -278,11 +279,144 @@ static int pipe_sof_ipc_cmd_after(struct sof_pipe *sp, void *mailbox, size_t byt
 	return ret;
 }
 
+/* PAUSED operation whose local processing stops a running pipeline thread */
+static bool pipe_batch_op_stops_thread(struct ipc4_message_request *in)
+{
+	struct ipc4_pipeline_set_state *state = (struct ipc4_pipeline_set_state *)in;
+	struct ipc_comp_dev *ipc_pipe;
+
+	if (in->primary.r.msg_tgt != SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG ||
+	    in->primary.r.type != SOF_IPC4_GLB_SET_PIPELINE_STATE ||
+	    state->primary.r.ppl_state != SOF_IPC4_PIPELINE_STATE_PAUSED)
+		return false;
+
+	ipc_pipe = ipc_get_pipeline_by_id(ipc_get(), state->primary.r.ppl_id);
+
+	return ipc_pipe && ipc_pipe->pipeline->status != COMP_STATE_INIT;
+}
+
+/* operations the core reverts when a batch fails, see ipc4_batch_add_undo() */
+static bool pipe_batch_op_reverted(struct ipc4_message_request *in)
+{
+	uint32_t type = in->primary.r.type;
+
+	if (in->primary.r.msg_tgt == SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG)
+		return type == SOF_IPC4_GLB_CREATE_PIPELINE ||
+		       type == SOF_IPC4_GLB_SET_PIPELINE_STATE;
+
+	return type == SOF_IPC4_MOD_INIT_INSTANCE || type == SOF_IPC4_MOD_BIND ||
+	       type == SOF_IPC4_MOD_UNBIND;
+}
+
+/* restarts the pipeline thread stopped for an operation that had no effect */
+static void pipe_batch_op_restart_thread(struct sof_pipe *sp, struct ipc4_message_request *in)
+{
+	struct ipc4_pipeline_set_state *state = (struct ipc4_pipeline_set_state *)in;
+	struct ipc_comp_dev *ipc_pipe;
+
+	ipc_pipe = ipc_get_pipeline_by_id(ipc_get(), state->primary.r.ppl_id);
+	if (!ipc_pipe || pipe_thread_start(sp, ipc_pipe->pipeline) < 0)
+		fprintf(sp->log, "error: can't restart pipeline %u thread\n",
+			state->primary.r.ppl_id);
+}
+
+/*
+ * The local processing of a batch runs for each operation. Local actions
+ * needed before the core are done for all operations first, the actions
+ * after the core only for operations that succeeded and were not reverted.
+ * Threads stopped for operations that were reverted or never ran are
+ * started again.
+ */
+static int pipe_ipc_batch_do(struct sof_pipe *sp, void *mailbox, size_t bytes)
+{
+	char mailbox_copy[IPC3_MAX_MSG_SIZE] = {0};
+	struct ipc4_batch *batch = (struct ipc4_batch *)mailbox_copy;
+	struct ipc4_message_request *req[SOF_IPC4_BATCH_MAX_OPS];
+	struct ipc4_message_reply *reply = mailbox;
+	bool stopped[SOF_IPC4_BATCH_MAX_OPS];
+	size_t offset = sizeof(*batch);
+	struct ipc4_batch_op *op;
+	const uint32_t *status;
+	uint32_t count, run;
+	bool failed, kept;
+	int err = 0;
+	int ret;
+	int i;
+
+	/* preserve mailbox contents for local "after" config */
+	memcpy(mailbox_copy, mailbox, bytes);
+
+	count = batch->primary.r.count;
+	if (count > SOF_IPC4_BATCH_MAX_OPS) {
+		fprintf(sp->log, "ipc: batch of %u operations\n", count);
+		return -EINVAL;
+	}
+
+	for (i = 0; i < count; i++) {
+		op = (struct ipc4_batch_op *)(mailbox_copy + offset);
+		if (offset + sizeof(*op) > bytes) {
+			fprintf(sp->log, "ipc: batch operation %d out of message\n", i);
+			err = -EINVAL;
+			break;
+		}
+
+		/* local processing only needs the request header */
+		req[i] = &op->request;
+		stopped[i] = pipe_batch_op_stops_thread(req[i]);
+		err = pipe_sof_ipc_cmd_before(sp, req[i], sizeof(*req[i]));
+		if (err < 0) {
+			fprintf(sp->log, "error: local IPC processing failed\n");
+			break;
+		}
+
+		offset += SOF_IPC4_BATCH_OP_SIZE(op->data_size);
+	}
+
+	if (!err)
+		err = pipe_ipc_message(sp, mailbox, bytes);
+
+	/* the core has run none of the operations */
+	if (err < 0) {
+		while (i--)
+			if (stopped[i])
+				pipe_batch_op_restart_thread(sp, req[i]);
+		return err;
+	}
+
+	/* the reply is followed by the status of each operation run */
+	status = (const uint32_t *)((char *)mailbox + sizeof(*reply));
+	run = MIN(reply->extension.dat, count);
+	failed = reply->primary.r.status != IPC4_SUCCESS;
+
+	for (i = 0; i < count; i++) {
+		kept = i < run && status[i] == IPC4_SUCCESS &&
+		       !(failed && pipe_batch_op_reverted(req[i]));
+		if (!kept) {
+			if (stopped[i])
+				pipe_batch_op_restart_thread(sp, req[i]);
+			continue;
+		}
+
+		ret = pipe_sof_ipc_cmd_after(sp, req[i], sizeof(*req[i]));
+		if (ret < 0) {
+			fprintf(sp->log, "error: local IPC processing failed\n");
+			err = ret;
+		}
+	}
+
+	return err;
+}
+
 int pipe_ipc_do(struct sof_pipe *sp, void *mailbox, size_t bytes)
 {
 	char mailbox_copy[IPC3_MAX_MSG_SIZE] = {0};
+	struct ipc4_message_request *in = mailbox;
 	int err = 0;
 
+	if (in->primary.r.msg_tgt == SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG &&
+	    in->primary.r.type == SOF_IPC4_GLB_BATCH)
+		return pipe_ipc_batch_do(sp, mailbox, bytes);
+
 	/* preserve mailbox contents for local "after" config */
 	memcpy(mailbox_copy, mailbox, bytes);
 
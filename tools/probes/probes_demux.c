@@ -50,6 +50,8 @@ struct dma_frame_parser {
 	size_t packet_size;
 	uint8_t *w_ptr;				/* Write pointer to copy data to */
 	uint32_t total_data_to_copy;		/* Total bytes left to copy */
+	uint8_t *decoded;			/* Decompressed packet data */
+	size_t decoded_size;			/* Size of decoded buffer */
 	int start;				/* Start of unfilled data */
 	int len;				/* Data buffer fill level */
 	uint8_t data[DATA_READ_LIMIT];
@@ -138,6 +140,9 @@ int init_wave(struct dma_frame_parser *p, uint32_t buffer_id, uint32_t format)
 		p->files[i].header.fmt.sample_rate = 48000;
 	else
 		p->files[i].header.fmt.sample_rate = sample_rate[rate_idx];
+	/* the rate is given before decimation */
+	p->files[i].header.fmt.sample_rate /= ((format & PROBE_MASK_DECIMATION) >>
+					       PROBE_SHIFT_DECIMATION) + 1;
 	p->files[i].header.fmt.bits_per_sample = (((format & PROBE_MASK_CONTAINER_SIZE) >> PROBE_SHIFT_CONTAINER_SIZE) + 1) * 8;
 	p->files[i].header.fmt.byte_rate = p->files[i].header.fmt.sample_rate *
 					p->files[i].header.fmt.num_channels *
@@ -179,6 +184,112 @@ void finalize_wave_files(struct dma_frame_parser *p)
 	}
 }
 
+struct bit_reader {
+	const uint8_t *data;
+	size_t bits;		/* Number of bits in data */
+	size_t pos;		/* Position of next bit */
+};
+
+static int read_bits(struct bit_reader *r, uint32_t bits, uint32_t *value)
+{
+	*value = 0;
+	if (r->pos + bits > r->bits)
+		return -EINVAL;
+
+	for (; bits; bits--, r->pos++)
+		*value = (*value << 1) | ((r->data[r->pos >> 3] >> (7 - (r->pos & 7))) & 1);
+
+	return 0;
+}
+
+/* Decode delta and Rice compressed data, see PROBE_COMPRESSION_RICE */
+static int decode_rice(struct dma_frame_parser *p, const uint8_t *src, uint32_t size,
+		       uint32_t format, uint32_t *decoded_bytes)
+{
+	uint32_t channels = ((format & PROBE_MASK_NB_CHANNELS) >> PROBE_SHIFT_NB_CHANNELS) + 1;
+	uint32_t sample_bytes = ((format & PROBE_MASK_CONTAINER_SIZE) >>
+				 PROBE_SHIFT_CONTAINER_SIZE) + 1;
+	uint32_t prev[(PROBE_MASK_NB_CHANNELS >> PROBE_SHIFT_NB_CHANNELS) + 1];
+	uint64_t sum[(PROBE_MASK_NB_CHANNELS >> PROBE_SHIFT_NB_CHANNELS) + 1];
+	uint64_t count[(PROBE_MASK_NB_CHANNELS >> PROBE_SHIFT_NB_CHANNELS) + 1];
+	struct bit_reader r;
+	uint8_t *new_decoded;
+	uint8_t *dst;
+	uint32_t frames;
+	uint32_t frame;
+	uint32_t value;
+	uint32_t bit;
+	uint32_t ch;
+	uint32_t k;
+	uint32_t q;
+	uint64_t bytes;
+
+	if (size < sizeof(frames))
+		return -EINVAL;
+
+	memcpy(&frames, src, sizeof(frames));
+	bytes = (uint64_t)frames * channels * sample_bytes;
+	if (bytes > PACKET_DATA_SIZE_MAX)
+		return -EINVAL;
+
+	if (bytes > p->decoded_size) {
+		new_decoded = realloc(p->decoded, bytes);
+		if (!new_decoded)
+			return -ENOMEM;
+
+		p->decoded = new_decoded;
+		p->decoded_size = bytes;
+	}
+
+	r.data = src + sizeof(frames);
+	r.bits = (size_t)(size - sizeof(frames)) * 8;
+	r.pos = 0;
+
+	for (ch = 0; ch < channels; ch++) {
+		prev[ch] = 0;
+		sum[ch] = PROBE_RICE_INIT_A;
+		count[ch] = 1;
+	}
+
+	dst = p->decoded;
+	for (frame = 0; frame < frames; frame++) {
+		for (ch = 0; ch < channels; ch++) {
+			for (k = 0; k < 31 && (count[ch] << k) < sum[ch]; k++)
+				;
+
+			/* quotient in unary or escape to plain value */
+			for (q = 0; q < PROBE_RICE_ESCAPE; q++) {
+				if (read_bits(&r, 1, &bit) < 0)
+					return -EINVAL;
+				if (!bit)
+					break;
+			}
+
+			if (q == PROBE_RICE_ESCAPE) {
+				if (read_bits(&r, 32, &value) < 0)
+					return -EINVAL;
+			} else {
+				if (read_bits(&r, k, &value) < 0)
+					return -EINVAL;
+				value |= q << k;
+			}
+
+			sum[ch] += value;
+			if (++count[ch] == PROBE_RICE_RESET) {
+				sum[ch] >>= 1;
+				count[ch] >>= 1;
+			}
+
+			prev[ch] += (value >> 1) ^ -(value & 1);
+			memcpy(dst, &prev[ch], sample_bytes);
+			dst += sample_bytes;
+		}
+	}
+
+	*decoded_bytes = bytes;
+	return 0;
+}
+
 int validate_data_packet(struct probe_data_packet *packet)
 {
 	uint64_t *checksump;
@@ -256,6 +367,7 @@ struct dma_frame_parser *parser_init(void)
 
 void parser_free(struct dma_frame_parser *p)
 {
+	free(p->decoded);
 	free(p->packet);
 	free(p);
 }
@@ -313,6 +425,8 @@ int parser_parse_data(struct dma_frame_parser *p, size_t d_len)
 				if (validate_data_packet(p->packet) == 0) {
 					int file = get_buffer_file(p->files,
 								   p->packet->buffer_id);
+					uint8_t *data = p->packet->data;
+					uint32_t size = p->packet->data_size_bytes;
 
 					if (file < 0)
 						file = init_wave(p, p->packet->buffer_id,
@@ -325,10 +439,21 @@ int parser_parse_data(struct dma_frame_parser *p, size_t d_len)
 						return -EIO;
 					}
 
-					fwrite(p->packet->data, 1,
-					       p->packet->data_size_bytes,
-					       p->files[file].fd);
-					p->files[file].size += p->packet->data_size_bytes;
+					if ((p->packet->format & PROBE_MASK_COMPRESSION) >>
+					    PROBE_SHIFT_COMPRESSION == PROBE_COMPRESSION_RICE) {
+						if (decode_rice(p, data, size, p->packet->format,
+								&size) < 0) {
+							fprintf(stderr,
+								"error: corrupted compressed data of %u\n",
+								p->packet->buffer_id);
+							p->state = READY;
+							break;
+						}
+						data = p->decoded;
+					}
+
+					fwrite(data, 1, size, p->files[file].fd);
+					p->files[file].size += size;
 					}
 				p->state = READY;
 				break;
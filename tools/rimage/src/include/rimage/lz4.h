@@ -0,0 +1,23 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2026 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __LZ4_H__
+#define __LZ4_H__
+
+#include <stdint.h>
+
+/**
+ * Compress image data to SOF_MAN_LZ4 frames
+ * @param [in]image whole image, matches can refer to any of its data
+ * @param [in]start offset of the first byte to compress
+ * @param [in]end offset after the last byte to compress
+ * @param [out]out frames, the last one is padded to the frame size
+ * @param [in]out_size size of the out buffer
+ * @return size of the frames, negative error code if they don't fit
+ */
+int lz4_compress_frames(const uint8_t *image, uint32_t start, uint32_t end,
+			uint8_t *out, uint32_t out_size);
+
+#endif /* __LZ4_H__ */
@@ -68,6 +68,9 @@ struct image {
 
 	/* Do not mark detached sections */
 	bool ignore_detached;
+
+	/* Compress loadable modules image */
+	bool compress;
 };
 
 struct memory_zone {
@@ -153,7 +153,8 @@ union sof_man_fw_header_image_flags {
 		uint32_t tp : 1;
 		uint32_t image_type : 2;
 		uint32_t relocatable_lib : 1;
-		uint32_t _rsvd0 : 28;
+		uint32_t compressed : 1;	/* payload in SOF_MAN_LZ4 frames */
+		uint32_t _rsvd0 : 27;
 	} fields;
 };
 
@@ -284,4 +285,24 @@ struct sof_man_module_manifest {
 #define SOF_MODULE_DRAM_LINK_START	0
 #define SOF_MODULE_DRAM_LINK_END	0x08000000
 
+/*
+ * Compressed library payload. Everything in the library image after the first
+ * MAN_MAX_SIZE_V1_8 bytes is split into frames of SOF_MAN_LZ4_FRAME_SIZE bytes,
+ * one frame is loaded at a time. A frame is a sequence of blocks, each being a
+ * struct sof_man_lz4_block header, followed by comp_size bytes of data. A
+ * header with raw_size 0 or the end of the frame ends the block sequence. Data
+ * with comp_size equal to raw_size is stored uncompressed, otherwise it is an
+ * LZ4 block, whose matches can refer to any earlier data of the image in a
+ * 64KiB window, also across blocks and frames. Authentication covers the
+ * compressed image, preload_page_count is the size of the decompressed one.
+ */
+#define SOF_MAN_LZ4_FRAME_SIZE		MAN_MAX_SIZE_V1_8
+#define SOF_MAN_LZ4_MIN_MATCH		4
+#define SOF_MAN_LZ4_MAX_OFFSET		0xffff
+
+struct sof_man_lz4_block {
+	uint32_t raw_size;		/* decompressed size, 0 ends the frame */
+	uint32_t comp_size;		/* data size in the frame */
+} __attribute__((packed));
+
 #endif /* __RIMAGE_USER_MANIFEST_H__ */
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: BSD-3-Clause
+/*
+ * Copyright(c) 2026 Intel Corporation. All rights reserved.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rimage/lz4.h>
+#include <rimage/sof/user/manifest.h>
+
+#define LZ4_HASH_BITS		16
+#define LZ4_MAX_BLOCK		(16 * 1024)
+#define LZ4_MIN_BLOCK		64
+
+/* Last image offset of a 4 byte sequence with a given hash */
+struct lz4_ctx {
+	uint32_t table[1 << LZ4_HASH_BITS];
+};
+
+static uint32_t lz4_read32(const uint8_t *p)
+{
+	return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint32_t lz4_hash(uint32_t seq)
+{
+	return (seq * 2654435761U) >> (32 - LZ4_HASH_BITS);
+}
+
+/* Token length field, continued with bytes of 255 */
+static uint8_t *lz4_put_len(uint8_t *op, const uint8_t *op_end, uint32_t len)
+{
+	for (len -= 15; len >= 255; len -= 255) {
+		if (op == op_end)
+			return NULL;
+		*op++ = 255;
+	}
+
+	if (op == op_end)
+		return NULL;
+	*op++ = len;
+
+	return op;
+}
+
+/* One sequence, without a match when match_len is 0 */
+static uint8_t *lz4_put_seq(uint8_t *op, const uint8_t *op_end, const uint8_t *lit,
+			    uint32_t lit_len, uint32_t offset, uint32_t match_len)
+{
+	uint32_t mlen = match_len ? match_len - SOF_MAN_LZ4_MIN_MATCH : 0;
+
+	if (op == op_end)
+		return NULL;
+	*op++ = (lit_len < 15 ? lit_len : 15) << 4 | (mlen < 15 ? mlen : 15);
+
+	if (lit_len >= 15) {
+		op = lz4_put_len(op, op_end, lit_len);
+		if (!op)
+			return NULL;
+	}
+
+	if (op_end - op < lit_len)
+		return NULL;
+	memcpy(op, lit, lit_len);
+	op += lit_len;
+
+	/* a sequence without a match can only end the block */
+	if (!match_len)
+		return op;
+
+	if (op_end - op < 2)
+		return NULL;
+	*op++ = offset;
+	*op++ = offset >> 8;
+
+	if (mlen >= 15)
+		op = lz4_put_len(op, op_end, mlen);
+
+	return op;
+}
+
+/* Compress image data from pos to end to an LZ4 block, return its size or 0 */
+static uint32_t lz4_compress_block(struct lz4_ctx *ctx, const uint8_t *image,
+				   uint32_t pos, uint32_t end, uint8_t *out, uint32_t out_size)
+{
+	uint8_t *op = out;
+	uint8_t *op_end = out + out_size;
+	uint32_t anchor = pos;
+	uint32_t ip = pos;
+	uint32_t cand;
+	uint32_t len;
+	uint32_t h;
+
+	while (ip + SOF_MAN_LZ4_MIN_MATCH <= end) {
+		h = lz4_hash(lz4_read32(image + ip));
+		cand = ctx->table[h];
+		ctx->table[h] = ip;
+
+		/* the table can hold offsets of a failed attempt beyond ip */
+		if (cand >= ip || ip - cand > SOF_MAN_LZ4_MAX_OFFSET ||
+		    lz4_read32(image + cand) != lz4_read32(image + ip)) {
+			ip++;
+			continue;
+		}
+
+		len = SOF_MAN_LZ4_MIN_MATCH;
+		while (ip + len < end && image[cand + len] == image[ip + len])
+			len++;
+
+		op = lz4_put_seq(op, op_end, image + anchor, ip - anchor, ip - cand, len);
+		if (!op)
+			return 0;
+
+		ip += len;
+		anchor = ip;
+	}
+
+	if (anchor < end) {
+		op = lz4_put_seq(op, op_end, image + anchor, end - anchor, 0, 0);
+		if (!op)
+			return 0;
+	}
+
+	return op - out;
+}
+
+int lz4_compress_frames(const uint8_t *image, uint32_t start, uint32_t end,
+			uint8_t *out, uint32_t out_size)
+{
+	struct sof_man_lz4_block blk;
+	struct lz4_ctx *ctx;
+	uint32_t frame_end;
+	uint32_t pos = start;
+	uint32_t op = 0;
+	uint32_t raw;
+	uint32_t comp;
+
+	ctx = malloc(sizeof(*ctx));
+	if (!ctx)
+		return -ENOMEM;
+
+	memset(ctx->table, 0xff, sizeof(ctx->table));
+
+	while (pos < end) {
+		if (out_size - op < SOF_MAN_LZ4_FRAME_SIZE) {
+			free(ctx);
+			return -ENOSPC;
+		}
+
+		frame_end = op + SOF_MAN_LZ4_FRAME_SIZE;
+
+		/* fill the frame with blocks, smaller ones at its end */
+		raw = LZ4_MAX_BLOCK;
+		while (pos < end && frame_end - op > sizeof(blk)) {
+			if (raw > end - pos)
+				raw = end - pos;
+
+			comp = lz4_compress_block(ctx, image, pos, pos + raw,
+						  out + op + sizeof(blk),
+						  frame_end - op - sizeof(blk));
+			if (!comp || comp >= raw) {
+				/* store if compression doesn't help and the data fits */
+				if (raw <= frame_end - op - sizeof(blk)) {
+					memcpy(out + op + sizeof(blk), image + pos, raw);
+					comp = raw;
+				} else if (raw > LZ4_MIN_BLOCK) {
+					raw /= 2;
+					continue;
+				} else {
+					break;
+				}
+			}
+
+			blk.raw_size = raw;
+			blk.comp_size = comp;
+			memcpy(out + op, &blk, sizeof(blk));
+			op += sizeof(blk) + comp;
+			pos += raw;
+		}
+
+		/* zero the rest of the frame, also data of a failed attempt, to end it */
+		memset(out + op, 0, frame_end - op);
+		op = frame_end;
+	}
+
+	free(ctx);
+
+	return op;
+}
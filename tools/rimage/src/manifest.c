@@ -26,6 +26,7 @@
 #include <rimage/file_utils.h>
 #include <rimage/misc_utils.h>
 #include <rimage/hash.h>
+#include <rimage/lz4.h>
 
 static bool cse_header_is_valid(const struct image *image, const void *buffer, size_t size)
 {
@@ -1526,11 +1527,60 @@ static int man_init_image_ace_v1_5(struct image *image)
 	return 0;
 }
 
+/*
+ * Replace the library data after the manifest with its LZ4 frames. The
+ * firmware decompresses it to the size given by the preload page count,
+ * so the count of the raw image is returned in raw_pages.
+ */
+static int man_compress_library(struct image *image, struct sof_man_fw_desc *desc,
+				uint32_t *raw_pages)
+{
+	uint32_t raw_size;
+	uint8_t *raw;
+	uint8_t *frames;
+	int size;
+
+	*raw_pages = DIV_ROUND_UP(image->image_end - image->meu_offset, MAN_PAGE_SIZE);
+	raw_size = *raw_pages * MAN_PAGE_SIZE;
+	if (raw_size <= MAN_MAX_SIZE_V1_8)
+		return 0;
+
+	/* the firmware decompresses whole pages, pad with zeroes */
+	raw = calloc(raw_size, 1);
+	frames = malloc(raw_size);
+	if (!raw || !frames) {
+		free(raw);
+		free(frames);
+		return -ENOMEM;
+	}
+
+	memcpy(raw, image->fw_image, image->image_end < raw_size ? image->image_end : raw_size);
+
+	size = lz4_compress_frames(raw, MAN_MAX_SIZE_V1_8, raw_size, frames, raw_size);
+	if (size < 0 || MAN_MAX_SIZE_V1_8 + size >= image->image_end) {
+		fprintf(stdout, " library: compression doesn't reduce size, stored as is\n");
+		goto out;
+	}
+
+	fprintf(stdout, " library: compressed 0x%x to 0x%x bytes\n",
+		raw_size - MAN_MAX_SIZE_V1_8, size);
+
+	memcpy(image->fw_image + MAN_MAX_SIZE_V1_8, frames, size);
+	image->image_end = MAN_MAX_SIZE_V1_8 + size;
+	desc->header.fw_image_flags.fields.compressed = 1;
+
+out:
+	free(frames);
+	free(raw);
+	return 0;
+}
+
 int man_write_fw_ace_v1_5(struct image *image)
 {
 	struct hash_context hash;
 	struct sof_man_fw_desc *desc;
 	struct fw_image_manifest_ace_v1_5 *m;
+	uint32_t raw_pages = 0;
 	int ret;
 
 	/* init image */
@@ -1586,12 +1636,26 @@ int man_write_fw_ace_v1_5(struct image *image)
 	if (ret)
 		goto err;
 
+	/* calculate hash for each module, of the data before compression */
+	man_hash_modules(image, desc);
+
+	if (image->compress && image->loadable_module) {
+		ret = man_compress_library(image, desc, &raw_pages);
+		if (ret)
+			goto err;
+	}
+
 	fprintf(stdout, "Firmware completing manifest v2.5\n");
 
 	/* create structures from end of file to start of file */
 	ri_adsp_meta_data_create_v2_5(image, MAN_META_EXT_OFFSET_ACE_V1_5,
 			image->meu_offset);
 	ri_plat_ext_data_create_ace_v1_5(image);
+
+	/* the firmware stores the decompressed library */
+	if (desc->header.fw_image_flags.fields.compressed)
+		desc->header.preload_page_count = raw_pages;
+
 	ri_css_v2_5_hdr_create(image);
 	ri_cse_create_ace_v1_5(image);
 
@@ -1599,9 +1663,6 @@ int man_write_fw_ace_v1_5(struct image *image)
 		FILE_TEXT_OFFSET_V1_8 - MAN_DESC_OFFSET_V1_8 + image->image_end,
 		desc->header.preload_page_count);
 
-	/* calculate hash for each module */
-	man_hash_modules(image, desc);
-
 	/* calculate hash inside ADSP meta data extension for padding to end */
 	assert(image->meu_offset < image->image_end);
 	ret = hash_sha384(image->fw_image + image->meu_offset, image->image_end - image->meu_offset,
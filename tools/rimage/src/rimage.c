@@ -36,6 +36,7 @@ static void usage(char *name)
 	fprintf(stdout, "\t -q resign binary from infile and validate the output signature\n");
 	fprintf(stdout, "\t -p set PV bit\n");
 	fprintf(stdout, "\t -d ignore detached sections\n");
+	fprintf(stdout, "\t -z compress loadable modules image, ACE manifest only\n");
 	fprintf(stdout, "\t -Q, --quiet suppress informational stdout logs\n");
 }
 
@@ -58,7 +59,7 @@ int main(int argc, char *argv[])
 
 	image.imr_type = MAN_DEFAULT_IMR_TYPE;
 
-	while ((opt = getopt_long(argc, argv, "ho:va:s:k:ri:f:b:ec:y:q:pldQ",
+	while ((opt = getopt_long(argc, argv, "ho:va:s:k:ri:f:b:ec:y:q:pldzQ",
 				  long_options, NULL)) != -1) {
 		switch (opt) {
 		case 'o':
@@ -114,6 +115,9 @@ int main(int argc, char *argv[])
 			/* ignore detached sections */
 			image.ignore_detached = true;
 			break;
+		case 'z':
+			image.compress = true;
+			break;
 		case 'Q':
 			quiet = true;
 			break;
@@ -190,6 +194,15 @@ int main(int argc, char *argv[])
 	if (ret < 0)
 		goto out;
 
+	/* only the ACE manifest writer compresses, and only loadable modules */
+	if (image.compress && (!image.loadable_module || !image.adsp->man_ace_v1_5 ||
+			       image.meu_offset || image.in_file || image.verify_file)) {
+		fprintf(stderr,
+			"error: -z requires -l and an ACE manifest, not supported with MEU, resign or verify\n");
+		ret = -EINVAL;
+		goto out;
+	}
+
 	/* verify mode ? */
 	if (image.verify_file) {
 		ret = verify_image(&image);
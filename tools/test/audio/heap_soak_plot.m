@@ -0,0 +1,85 @@
+function heap_soak_plot(csv_fn)
+
+%%
+% heap_soak_plot - Plot heap statistics of testbench pipeline runs
+%
+% heap_soak_plot(csv_fn)
+%
+% Inputs
+%   csv_fn - heap statistics log from testbench option -m
+%
+% Outputs
+%   none, the plots show per heap usage, peak usage, largest free
+%   block and allocation count over the runs, and the allocation
+%   latency histogram of the last run.
+%
+
+% SPDX-License-Identifier: BSD-3-Clause
+% Copyright(c) 2026 Intel Corporation.
+
+% Columns of the log
+COL_RUN = 1;
+COL_TYPE = 2;
+COL_ID = 3;
+COL_USED = 5;
+COL_PEAK = 6;
+COL_LARGEST = 7;
+COL_ALLOCS = 8;
+COL_FAILS = 10;
+COL_LAT = 11;
+LAT_SHIFT = 5;
+
+d = dlmread(csv_fn, ',', 1, 0);
+type_names = {'system', 'vregion', 'module'};
+
+% One curve per heap, heaps are identified by type and id
+heaps = unique(d(:, [COL_TYPE COL_ID]), 'rows');
+n_heaps = size(heaps, 1);
+labels = cell(n_heaps, 1);
+for i = 1:n_heaps
+	labels{i} = sprintf('%s %d', type_names{heaps(i, 1) + 1}, heaps(i, 2));
+end
+
+figure;
+for i = 1:n_heaps
+	h = d(d(:, COL_TYPE) == heaps(i, 1) & d(:, COL_ID) == heaps(i, 2), :);
+
+	subplot(2, 2, 1); hold on;
+	plot(h(:, COL_RUN), h(:, COL_USED));
+	subplot(2, 2, 2); hold on;
+	plot(h(:, COL_RUN), h(:, COL_PEAK));
+	subplot(2, 2, 3); hold on;
+	largest = h(:, COL_LARGEST);
+	largest(largest < 0) = NaN;
+	plot(h(:, COL_RUN), largest);
+	subplot(2, 2, 4); hold on;
+	plot(h(:, COL_RUN), h(:, COL_ALLOCS) + h(:, COL_FAILS));
+end
+
+subplot(2, 2, 1); grid on; xlabel('Run'); ylabel('Bytes'); title('Used');
+subplot(2, 2, 2); grid on; xlabel('Run'); ylabel('Bytes'); title('Peak');
+legend(labels);
+subplot(2, 2, 3); grid on; xlabel('Run'); ylabel('Bytes');
+title('Largest free block');
+subplot(2, 2, 4); grid on; xlabel('Run'); ylabel('Count');
+title('Allocations');
+
+% Latency histogram of the last run, summed over the heaps
+last = d(d(:, COL_RUN) == max(d(:, COL_RUN)), :);
+lat = sum(last(:, COL_LAT:end), 1);
+n_bins = length(lat);
+bin_labels = cell(n_bins, 1);
+for i = 1:n_bins - 1
+	bin_labels{i} = sprintf('<%d', 2^(i + LAT_SHIFT - 1));
+end
+bin_labels{n_bins} = sprintf('>=%d', 2^(n_bins + LAT_SHIFT - 2));
+
+figure;
+bar(lat);
+set(gca, 'xtick', 1:n_bins, 'xticklabel', bin_labels);
+grid on;
+xlabel('Cycles');
+ylabel('Allocations');
+title('Allocation latency, last run');
+
+end
@@ -7,6 +7,7 @@
 #define _TESTBENCH_TOPOLOGY_IPC4_H
 
 #include <module/ipc4/base-config.h>
+#include <ipc4/batch.h>
 #include "testbench/utils.h"
 
 #define TB_IPC4_MAX_TPLG_OBJECT_SIZE	4096
@@ -29,6 +30,14 @@
 #define TB_FILE_OUT_DAI_MODULE_ID	0x9c
 #define TB_FILE_IN_DAI_MODULE_ID	0x9d
 
+/* Operations sent to the DSP together in one SOF_IPC4_GLB_BATCH message */
+struct tb_ipc_batch {
+	char msg[TB_IPC4_MAX_MSG_SIZE];	/* struct ipc4_batch and the operations */
+	size_t size;
+	int count;
+	const char *name[SOF_IPC4_BATCH_MAX_OPS];	/* object of each operation */
+};
+
 enum tb_pin_type {
 	TB_PIN_TYPE_INPUT = 0,
 	TB_PIN_TYPE_OUTPUT,
@@ -38,6 +47,7 @@ int tb_delete_pipeline(struct testbench_prm *tp, struct tplg_pipeline_info *pipe
 int tb_free_all_pipelines(struct testbench_prm *tp);
 int tb_free_route(struct testbench_prm *tp, struct tplg_route_info *route_info);
 int tb_get_instance_id_from_pipeline_id(struct testbench_prm *tp, int id);
+int tb_ipc_batch_flush(struct testbench_prm *tp);
 int tb_is_single_format(struct sof_ipc4_pin_format *fmts, int num_formats);
 int tb_match_audio_format(struct testbench_prm *tp, struct tplg_comp_info *comp_info,
 			  struct tb_config *config);
@@ -71,6 +71,8 @@ struct tb_mq_desc {
 	char queue_name[TB_NAME_SIZE];
 };
 
+struct tb_ipc_batch;
+
 struct tb_config {
 	char name[TB_MAX_CONFIG_NAME_SIZE];
 	unsigned long buffer_frames;
@@ -99,6 +101,7 @@ struct testbench_prm {
 	char *tplg_file; /* topology file to use */
 	char *bits_in; /* input bit format */
 	char *control_file;
+	char *heap_stats_file; /* heap statistics log, one row per heap and run */
 	int input_file_num; /* number of input files */
 	int output_file_num; /* number of output files */
 	int pipeline_num;
@@ -130,6 +133,7 @@ struct testbench_prm {
 	struct tplg_context tplg;
 
 	FILE *control_fh;
+	FILE *heap_stats_fh;
 	struct tb_glb_state glb_ctx;
 
 #if CONFIG_IPC_MAJOR_4
@@ -140,6 +144,7 @@ struct testbench_prm {
 	int instance_ids[SND_SOC_TPLG_DAPM_LAST];
 	struct tb_mq_desc ipc_tx;
 	struct tb_mq_desc ipc_rx;
+	struct tb_ipc_batch *batch;	/* queued module and pipeline operations */
 	int pcm_id;	// TODO: This needs to be cleaned up
 	struct tplg_pcm_info *pcm_info;
 	struct tb_config config[TB_MAX_CONFIG_COUNT];
@@ -8,6 +8,7 @@
 #include <sof/audio/module_adapter/module/generic.h>
 #include <sof/ipc/driver.h>
 #include <sof/ipc/topology.h>
+#include <sof/lib/heap_stats.h>
 #include <sof/list.h>
 #include <tplg_parser/topology.h>
 
@@ -129,7 +130,8 @@ static void print_usage(char *executable)
 	printf("  -p <pipeline1,pipeline2,...>\n");
 	printf("  -C <number of copy() iterations>\n");
 	printf("  -P <number of dynamic pipeline iterations>\n");
-	printf("  -s <script file to set controls, with amixer and sleep commands>\n\n");
+	printf("  -s <script file to set controls, with amixer and sleep commands>\n");
+	printf("  -m <heap statistics log file, a CSV row per heap and pipeline run>\n\n");
 	printf("Options for input and output format override:\n");
 	printf("  -b <input_format>, S16_LE, S24_LE, or S32_LE\n");
 	printf("  -c <input channels>\n");
@@ -147,7 +149,7 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 	int option = 0;
 	int ret = 0;
 
-	while ((option = getopt(argc, argv, "hd:i:o:t:b:r:R:c:n:C:P:p:s:")) != -1) {
+	while ((option = getopt(argc, argv, "hd:i:o:t:b:r:R:c:n:C:P:p:s:m:")) != -1) {
 		switch (option) {
 		/* input sample file */
 		case 'i':
@@ -222,6 +224,11 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 			tp->control_file = strdup(optarg);
 			break;
 
+		/* heap statistics log file name */
+		case 'm':
+			tp->heap_stats_file = strdup(optarg);
+			break;
+
 		/* print usage */
 		case 'h':
 			print_usage(argv[0]);
@@ -310,6 +317,45 @@ static void test_pipeline_stats(struct testbench_prm *tp, long long delta_t,
 		       (float)frames_out / tp->fs_out * 1000000 / delta_t);
 }
 
+/*
+ * Print the heap statistics and append them to the log, to follow usage,
+ * fragmentation and allocation latency over the dynamic pipeline runs.
+ */
+static void test_heap_stats(struct testbench_prm *tp, int run)
+{
+	struct heap_stats_record records[TB_NUM_WIDGETS_SUPPORTED];
+	struct heap_stats_record *rec;
+	unsigned int count;
+	unsigned int i;
+	int largest;
+	int j;
+
+	count = heap_stats_get(records, ARRAY_SIZE(records));
+	if (!count)
+		return;
+
+	printf("Heap statistics (type id: used peak largest_free allocs frees fails)\n");
+	for (i = 0; i < count; i++) {
+		rec = &records[i];
+		largest = rec->largest_free == HEAP_STATS_LARGEST_FREE_UNKNOWN ?
+			-1 : (int)rec->largest_free;
+		printf("  %u %u: %u %u %d %u %u %u\n", rec->type, rec->id, rec->used, rec->peak,
+		       largest, rec->alloc_count, rec->free_count, rec->fail_count);
+
+		if (!tp->heap_stats_fh)
+			continue;
+
+		fprintf(tp->heap_stats_fh, "%d,%u,%u,%u,%u,%u,%d,%u,%u,%u", run, rec->type,
+			rec->id, rec->size, rec->used, rec->peak, largest,
+			rec->alloc_count, rec->free_count, rec->fail_count);
+		for (j = 0; j < HEAP_STATS_LATENCY_BINS; j++)
+			fprintf(tp->heap_stats_fh, ",%u", rec->latency[j]);
+		fprintf(tp->heap_stats_fh, "\n");
+	}
+
+	printf("\n");
+}
+
 /*
  * Tester thread, one for each virtual core. This is NOT the thread that will
  * execute the virtual core.
@@ -416,6 +462,7 @@ out:
 		}
 
 		test_pipeline_stats(tp, delta_t, heap_usage_records, heap_usage_records_count);
+		test_heap_stats(tp, dp_count);
 
 		err = tb_free_all_pipelines(tp);
 		if (err < 0) {
@@ -506,6 +553,22 @@ int main(int argc, char **argv)
 		}
 	}
 
+	if (tp->heap_stats_file) {
+		tp->heap_stats_fh = fopen(tp->heap_stats_file, "w");
+		if (!tp->heap_stats_fh) {
+			fprintf(stderr, "error: opening heap statistics log %s (%s).\n",
+				tp->heap_stats_file, strerror(errno));
+			ret = -errno;
+			goto out;
+		}
+
+		fprintf(tp->heap_stats_fh, "run,type,id,size,used,peak,largest_free,"
+			"allocs,frees,fails");
+		for (i = 0; i < HEAP_STATS_LATENCY_BINS; i++)
+			fprintf(tp->heap_stats_fh, ",lat%d", i);
+		fprintf(tp->heap_stats_fh, "\n");
+	}
+
 	/* build, run and teardown pipelines */
 	pipline_test(tp);
 
@@ -521,6 +584,10 @@ out:
 	if (tp->control_fh)
 		fclose(tp->control_fh);
 
+	free(tp->heap_stats_file);
+	if (tp->heap_stats_fh)
+		fclose(tp->heap_stats_fh);
+
 	for (i = 0; i < tp->output_file_num; i++)
 		free(tp->output_file[i]);
 
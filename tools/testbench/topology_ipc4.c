@@ -74,6 +74,97 @@ static int tb_mq_cmd_tx_rx(struct tb_mq_desc *ipc_tx, struct tb_mq_desc *ipc_rx,
 	return 0;
 }
 
+/* Sends the queued operations, the batch is empty afterwards also on failure */
+int tb_ipc_batch_flush(struct testbench_prm *tp)
+{
+	char reply_msg[sizeof(struct ipc4_message_reply) + SOF_IPC4_BATCH_MAX_OPS * sizeof(uint32_t)];
+	struct ipc4_message_reply *reply = (struct ipc4_message_reply *)reply_msg;
+	uint32_t *status = (uint32_t *)(reply + 1);
+	struct tb_ipc_batch *batch = tp->batch;
+	struct ipc4_batch *hdr;
+	uint32_t done;
+	int ret;
+
+	if (!batch || !batch->count)
+		return 0;
+
+	hdr = (struct ipc4_batch *)batch->msg;
+	hdr->primary.dat = 0;
+	hdr->primary.r.count = batch->count;
+	hdr->primary.r.type = SOF_IPC4_GLB_BATCH;
+	hdr->primary.r.msg_tgt = SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG;
+	hdr->primary.r.rsp = SOF_IPC4_MESSAGE_DIR_MSG_REQUEST;
+	hdr->extension.dat = 0;
+	hdr->extension.r.data_size = batch->size - sizeof(*hdr);
+
+	memset(reply_msg, 0, sizeof(reply_msg));
+	ret = tb_mq_cmd_tx_rx(&tp->ipc_tx, &tp->ipc_rx, batch->msg, batch->size,
+			      reply_msg, sizeof(reply_msg));
+	if (ret < 0) {
+		/* the last operation run is the failing one, the others were reverted */
+		done = reply->extension.dat;
+		if (done && done <= batch->count)
+			fprintf(stderr, "error: batch operation for %s failed with status %u\n",
+				batch->name[done - 1], status[done - 1]);
+		else
+			fprintf(stderr, "error: batch of %d operations failed with status %d\n",
+				batch->count, reply->primary.r.status);
+	}
+
+	batch->count = 0;
+	batch->size = sizeof(*hdr);
+
+	return ret;
+}
+
+/* Queues an operation, it is sent with tb_ipc_batch_flush() */
+static int tb_ipc_batch_add(struct testbench_prm *tp, void *msg, size_t len, const char *name)
+{
+	struct ipc4_message_request *request = msg;
+	size_t data_size = len - sizeof(*request);
+	size_t op_size = SOF_IPC4_BATCH_OP_SIZE(data_size);
+	struct tb_ipc_batch *batch = tp->batch;
+	struct ipc4_message_reply reply = {{ 0 }};
+	struct ipc4_batch_op *op;
+	int ret;
+
+	if (!batch) {
+		batch = calloc(1, sizeof(*batch));
+		if (!batch)
+			return -ENOMEM;
+
+		batch->size = sizeof(struct ipc4_batch);
+		tp->batch = batch;
+	}
+
+	if (batch->count == SOF_IPC4_BATCH_MAX_OPS ||
+	    batch->size + op_size > sizeof(struct ipc4_batch) + MAILBOX_HOSTBOX_SIZE) {
+		ret = tb_ipc_batch_flush(tp);
+		if (ret < 0)
+			return ret;
+	}
+
+	/* too big for a batch, send it alone */
+	if (batch->size + op_size > sizeof(struct ipc4_batch) + MAILBOX_HOSTBOX_SIZE) {
+		ret = tb_mq_cmd_tx_rx(&tp->ipc_tx, &tp->ipc_rx, msg, len, &reply, sizeof(reply));
+		if (ret < 0)
+			fprintf(stderr, "error: operation for %s failed with status %d\n",
+				name, reply.primary.r.status);
+		return ret;
+	}
+
+	op = (struct ipc4_batch_op *)(batch->msg + batch->size);
+	memset(op, 0, op_size);
+	op->request = *request;
+	op->data_size = data_size;
+	memcpy(op->data, request + 1, data_size);
+
+	batch->name[batch->count++] = name;
+	batch->size += op_size;
+
+	return 0;
+}
+
 static int tb_parse_ipc4_comp_tokens(struct testbench_prm *tp,
 				     struct ipc4_base_module_cfg *base_cfg)
 {
@@ -106,7 +197,6 @@ static void tb_setup_widget_ipc_msg(struct tplg_comp_info *comp_info)
 int tb_set_up_widget_ipc(struct testbench_prm *tp, struct tplg_comp_info *comp_info)
 {
 	struct ipc4_module_init_instance *module_init = &comp_info->module_init;
-	struct ipc4_message_reply reply;
 	void *msg;
 	int size;
 	int ret = 0;
@@ -121,20 +211,13 @@ int tb_set_up_widget_ipc(struct testbench_prm *tp, struct tplg_comp_info *comp_i
 
 	memcpy(msg, module_init, sizeof(*module_init));
 	memcpy(msg + sizeof(*module_init), comp_info->ipc_payload, comp_info->ipc_size);
-	ret = tb_mq_cmd_tx_rx(&tp->ipc_tx, &tp->ipc_rx, msg, size, &reply, sizeof(reply));
+	ret = tb_ipc_batch_add(tp, msg, size, comp_info->name);
 
 	free(msg);
-	if (ret < 0) {
+	if (ret < 0)
 		fprintf(stderr, "error: can't set up widget %s\n", comp_info->name);
-		return ret;
-	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		fprintf(stderr, "widget %s set up failed with status %d\n",
-			comp_info->name, reply.primary.r.status);
-		return -EINVAL;
-	}
-	return 0;
+	return ret;
 }
 
 int tb_set_up_route(struct testbench_prm *tp, struct tplg_route_info *route_info)
@@ -142,7 +225,6 @@ int tb_set_up_route(struct testbench_prm *tp, struct tplg_route_info *route_info
 	struct tplg_comp_info *src_comp_info = route_info->source;
 	struct tplg_comp_info *sink_comp_info = route_info->sink;
 	struct ipc4_module_bind_unbind bu = {{0}};
-	struct ipc4_message_reply reply;
 	int ret;
 
 	bu.primary.r.module_id = src_comp_info->module_id;
@@ -158,19 +240,13 @@ int tb_set_up_route(struct testbench_prm *tp, struct tplg_route_info *route_info
 	bu.extension.r.dst_queue = 0;
 	bu.extension.r.src_queue = 0;
 
-	ret = tb_mq_cmd_tx_rx(&tp->ipc_tx, &tp->ipc_rx, &bu, sizeof(bu), &reply, sizeof(reply));
+	ret = tb_ipc_batch_add(tp, &bu, sizeof(bu), src_comp_info->name);
 	if (ret < 0) {
 		fprintf(stderr, "error: can't set up route %s -> %s\n", src_comp_info->name,
 			sink_comp_info->name);
 		return ret;
 	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		fprintf(stderr, "route %s -> %s ID set up failed with status %d\n",
-			src_comp_info->name, sink_comp_info->name, reply.primary.r.status);
-		return -EINVAL;
-	}
-
 	tplg_debug("route %s -> %s set up\n", src_comp_info->name, sink_comp_info->name);
 
 	return 0;
@@ -179,7 +255,6 @@ int tb_set_up_route(struct testbench_prm *tp, struct tplg_route_info *route_info
 int tb_set_up_pipeline(struct testbench_prm *tp, struct tplg_pipeline_info *pipe_info)
 {
 	struct ipc4_pipeline_create msg = {.primary.dat = 0, .extension.dat = 0};
-	struct ipc4_message_reply reply;
 	int ret;
 
 	msg.primary.r.type = SOF_IPC4_GLB_CREATE_PIPELINE;
@@ -188,18 +263,12 @@ int tb_set_up_pipeline(struct testbench_prm *tp, struct tplg_pipeline_info *pipe
 	pipe_info->instance_id = tp->instance_ids[SND_SOC_TPLG_DAPM_SCHEDULER]++;
 	msg.primary.r.instance_id = pipe_info->instance_id;
 	msg.primary.r.ppl_mem_size = pipe_info->mem_usage;
-	ret = tb_mq_cmd_tx_rx(&tp->ipc_tx, &tp->ipc_rx, &msg, sizeof(msg), &reply, sizeof(reply));
+	ret = tb_ipc_batch_add(tp, &msg, sizeof(msg), pipe_info->name);
 	if (ret < 0) {
 		fprintf(stderr, "error: can't set up pipeline %s\n", pipe_info->name);
 		return ret;
 	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		fprintf(stderr, "pipeline %s instance ID %d set up failed with status %d\n",
-			pipe_info->name, pipe_info->instance_id, reply.primary.r.status);
-		return -EINVAL;
-	}
-
 	tplg_debug("pipeline %s instance_id %d mem_usage %d set up\n", pipe_info->name,
 		   pipe_info->instance_id, pipe_info->mem_usage);
 
@@ -463,16 +532,13 @@ int tb_set_up_widget_base_config(struct testbench_prm *tp, struct tplg_comp_info
 
 static int tb_pipeline_set_state(struct testbench_prm *tp, int state,
 				 struct ipc4_pipeline_set_state *pipe_state,
-				 struct tplg_pipeline_info *pipe_info,
-				 struct tb_mq_desc *ipc_tx, struct tb_mq_desc *ipc_rx)
+				 struct tplg_pipeline_info *pipe_info)
 {
-	struct ipc4_message_reply reply = {{ 0 }};
 	int ret;
 
 	pipe_state->primary.r.ppl_id = pipe_info->instance_id;
 
-	ret = tb_mq_cmd_tx_rx(ipc_tx, ipc_rx, pipe_state, sizeof(*pipe_state),
-			      &reply, sizeof(reply));
+	ret = tb_ipc_batch_add(tp, pipe_state, sizeof(*pipe_state), pipe_info->name);
 	if (ret < 0)
 		fprintf(stderr, "failed pipeline %d set state %d\n", pipe_info->instance_id, state);
 
@@ -504,24 +570,22 @@ int tb_pipelines_set_state(struct testbench_prm *tp, int state, int dir)
 	if (dir == SOF_IPC_STREAM_CAPTURE) {
 		for (i = pipeline_list->count - 1; i >= 0; i--) {
 			pipe_info = pipeline_list->pipelines[i];
-			ret = tb_pipeline_set_state(tp, state, &pipe_state, pipe_info,
-						    &tp->ipc_tx, &tp->ipc_rx);
+			ret = tb_pipeline_set_state(tp, state, &pipe_state, pipe_info);
 			if (ret < 0)
 				return ret;
 		}
 
-		return 0;
+		return tb_ipc_batch_flush(tp);
 	}
 
 	for (i = 0; i < pipeline_list->count; i++) {
 		pipe_info = pipeline_list->pipelines[i];
-		ret = tb_pipeline_set_state(tp, state, &pipe_state, pipe_info,
-					    &tp->ipc_tx, &tp->ipc_rx);
+		ret = tb_pipeline_set_state(tp, state, &pipe_state, pipe_info);
 		if (ret < 0)
 			return ret;
 	}
 
-	return 0;
+	return tb_ipc_batch_flush(tp);
 }
 
 /*
@@ -1616,7 +1680,6 @@ int tb_set_reset_state(struct testbench_prm *tp)
 int tb_delete_pipeline(struct testbench_prm *tp, struct tplg_pipeline_info *pipe_info)
 {
 	struct ipc4_pipeline_delete msg = {{0}};
-	struct ipc4_message_reply reply;
 	int ret;
 
 	msg.primary.r.type = SOF_IPC4_GLB_DELETE_PIPELINE;
@@ -1624,18 +1687,12 @@ int tb_delete_pipeline(struct testbench_prm *tp, struct tplg_pipeline_info *pipe
 	msg.primary.r.rsp = SOF_IPC4_MESSAGE_DIR_MSG_REQUEST;
 	msg.primary.r.instance_id = pipe_info->instance_id;
 
-	ret = tb_mq_cmd_tx_rx(&tp->ipc_tx, &tp->ipc_rx, &msg, sizeof(msg), &reply, sizeof(reply));
+	ret = tb_ipc_batch_add(tp, &msg, sizeof(msg), pipe_info->name);
 	if (ret < 0) {
 		fprintf(stderr, "error: can't delete pipeline %s\n", pipe_info->name);
 		return ret;
 	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		fprintf(stderr, "pipeline %s instance ID %d delete failed with status %d\n",
-			pipe_info->name, pipe_info->instance_id, reply.primary.r.status);
-		return -EINVAL;
-	}
-
 	tplg_debug("pipeline %s instance_id %d freed\n", pipe_info->name,
 		   pipe_info->instance_id);
 
@@ -1647,7 +1704,6 @@ int tb_free_route(struct testbench_prm *tp, struct tplg_route_info *route_info)
 	struct tplg_comp_info *src_comp_info = route_info->source;
 	struct tplg_comp_info *sink_comp_info = route_info->sink;
 	struct ipc4_module_bind_unbind bu = {{0}};
-	struct ipc4_message_reply reply;
 	int ret;
 
 	/* only unbind when widgets belong to separate pipelines */
@@ -1667,19 +1723,13 @@ int tb_free_route(struct testbench_prm *tp, struct tplg_route_info *route_info)
 	bu.extension.r.dst_queue = 0;
 	bu.extension.r.src_queue = 0;
 
-	ret = tb_mq_cmd_tx_rx(&tp->ipc_tx, &tp->ipc_rx, &bu, sizeof(bu), &reply, sizeof(reply));
+	ret = tb_ipc_batch_add(tp, &bu, sizeof(bu), src_comp_info->name);
 	if (ret < 0) {
-		fprintf(stderr, "error: can't set up route %s -> %s\n", src_comp_info->name,
+		fprintf(stderr, "error: can't free route %s -> %s\n", src_comp_info->name,
 			sink_comp_info->name);
 		return ret;
 	}
 
-	if (reply.primary.r.status != IPC4_SUCCESS) {
-		fprintf(stderr, "route %s -> %s ID set up failed with status %d\n",
-			src_comp_info->name, sink_comp_info->name, reply.primary.r.status);
-		return -EINVAL;
-	}
-
 	tplg_debug("route %s -> %s freed\n", src_comp_info->name, sink_comp_info->name);
 
 	return 0;
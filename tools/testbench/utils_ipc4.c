@@ -297,6 +297,11 @@ static int tb_set_up_widget(struct testbench_prm *tp, struct tplg_comp_info *com
 
 		abi = (struct sof_abi_hdr *)ctl->data;
 
+		/* the widget must exist before its kcontrol data is sent */
+		ret = tb_ipc_batch_flush(tp);
+		if (ret < 0)
+			return ret;
+
 		/* send IPC with kcontrol data */
 		ret = tb_send_bytes_data(&tp->ipc_tx, &tp->ipc_rx,
 					 comp_info->module_id, comp_info->instance_id, abi);
@@ -434,6 +439,10 @@ static int tb_set_up_pipelines(struct testbench_prm *tp, int dir)
 		if (ret < 0)
 			return ret;
 
+		ret = tb_ipc_batch_flush(tp);
+		if (ret < 0)
+			return ret;
+
 		tb_debug_print("Setting up capture pipelines complete\n");
 
 		return 0;
@@ -447,6 +456,10 @@ static int tb_set_up_pipelines(struct testbench_prm *tp, int dir)
 	if (ret < 0)
 		return ret;
 
+	ret = tb_ipc_batch_flush(tp);
+	if (ret < 0)
+		return ret;
+
 	tb_debug_print("Setting up playback pipelines complete\n");
 
 	return 0;
@@ -572,6 +585,10 @@ static int tb_free_pipelines(struct testbench_prm *tp, int dir)
 			if (ret < 0)
 				return ret;
 		}
+
+		ret = tb_ipc_batch_flush(tp);
+		if (ret < 0)
+			return ret;
 	}
 
 	tp->instance_ids[SND_SOC_TPLG_DAPM_SCHEDULER] = 0;
@@ -632,6 +649,8 @@ void tb_free_topology(struct testbench_prm *tp)
 
 	free(ctx->tplg_base);
 	free(tp->glb_ctx.ctl);
+	free(tp->batch);
+	tp->batch = NULL;
 	tb_debug_print("freed all pipelines, widgets, routes and pcms\n");
 }
 
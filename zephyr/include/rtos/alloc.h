@@ -114,6 +114,11 @@ void *sof_heap_alloc(struct k_heap *heap, uint32_t flags, size_t bytes,
 void sof_heap_free(struct k_heap *heap, void *addr);
 #endif
 
+#if CONFIG_SOF_HEAP_STATS
+/* Largest block, up to max bytes, that can be allocated from a heap now */
+size_t sof_heap_largest_free(struct k_heap *h, size_t max);
+#endif
+
 #if CONFIG_SOF_FULL_ZEPHYR_APPLICATION
 struct k_heap *sof_sys_heap_get(void);
 #else
@@ -17,6 +17,16 @@
 #define __cold_rodata
 #endif
 
+/*
+ * Loadable module code, only used after the module has been prepared. It is
+ * loaded to SRAM on the first prepare() or by llext_manager_prefetch().
+ */
+#ifdef LL_EXTENSION_BUILD
+#define __lazy __section(".lazy")
+#else
+#define __lazy
+#endif
+
 #ifdef __ZEPHYR__
 bool ll_sch_is_current(void);
 #else
@@ -10,6 +10,7 @@
 #include <rtos/interrupt.h>
 #include <sof/drivers/interrupt-map.h>
 #include <sof/schedule/schedule.h>
+#include <sof/lib/heap_stats.h>
 #include <sof/lib/notifier.h>
 #include <sof/lib/pm_runtime.h>
 #include <sof/audio/pipeline.h>
@@ -149,6 +150,10 @@ extern char _end[], _heap_sentry[];
 
 static struct k_heap sof_heap;
 
+#if CONFIG_SOF_HEAP_STATS && !defined(CONFIG_SOF_NATIVE_SIM_HOST_HEAP)
+static struct heap_stats sof_heap_stats;
+#endif
+
 #if !defined(CONFIG_SOF_NATIVE_SIM_HOST_HEAP)
 /**
  * Checks whether pointer is from a given heap memory.
@@ -172,6 +177,9 @@ static bool is_heap_pointer(const struct k_heap *heap, void *ptr)
 
 #if CONFIG_SOF_USERSPACE_USE_SHARED_HEAP
 static struct k_heap shared_buffer_heap;
+#if CONFIG_SOF_HEAP_STATS && !defined(CONFIG_SOF_NATIVE_SIM_HOST_HEAP)
+static struct heap_stats shared_buffer_heap_stats;
+#endif
 
 /**
  * Returns the start of HPSRAM Shared memory heap.
@@ -394,10 +402,74 @@ struct k_heap *sof_sys_user_heap_get(void)
 }
 
 #if !defined(CONFIG_SOF_NATIVE_SIM_HOST_HEAP)
+#if CONFIG_SOF_HEAP_STATS
+/* Statistics of the heaps allocated here, NULL for the others */
+static struct heap_stats *heap_stats_of(struct k_heap *h)
+{
+	if (h == &sof_heap)
+		return &sof_heap_stats;
+#if CONFIG_SOF_USERSPACE_USE_SHARED_HEAP
+	if (h == &shared_buffer_heap)
+		return &shared_buffer_heap_stats;
+#endif
+	return NULL;
+}
+
+/**
+ * Returns the largest block that can be allocated from a heap, found by
+ * trying allocations. The lock is taken for each try only, so the result
+ * is a snapshot.
+ * @param h Heap.
+ * @param max Upper bound of the search.
+ * @return Size of the largest free block, a multiple of 8 bytes.
+ */
+size_t sof_heap_largest_free(struct k_heap *h, size_t max)
+{
+	size_t lo = 0;
+	size_t hi = max / 8;
+	size_t mid;
+	k_spinlock_key_t key;
+	void *p;
+
+	/* lo blocks of 8 bytes fit, more than hi do not */
+	while (lo < hi) {
+		mid = lo + (hi - lo + 1) / 2;
+		key = k_spin_lock(&h->lock);
+		p = sys_heap_alloc(&h->heap, mid * 8);
+		if (p)
+			sys_heap_free(&h->heap, p);
+		k_spin_unlock(&h->lock, key);
+
+		if (p)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+
+	return lo * 8;
+}
+
+static size_t sof_heap_stats_largest_free(struct heap_stats *stats)
+{
+	return sof_heap_largest_free(&sof_heap, stats->size - stats->used);
+}
+
+#if CONFIG_SOF_USERSPACE_USE_SHARED_HEAP
+static size_t shared_buffer_heap_stats_largest_free(struct heap_stats *stats)
+{
+	return sof_heap_largest_free(&shared_buffer_heap, stats->size - stats->used);
+}
+#endif
+#endif /* CONFIG_SOF_HEAP_STATS */
+
 static void *heap_alloc_aligned(struct k_heap *h, size_t min_align, size_t bytes)
 {
 	k_spinlock_key_t key;
 	void *ret;
+#if CONFIG_SOF_HEAP_STATS
+	struct heap_stats *hs = heap_stats_of(h);
+	uint32_t start = k_cycle_get_32();
+#endif
 #if CONFIG_SYS_HEAP_RUNTIME_STATS && CONFIG_IPC_MAJOR_4
 	struct sys_memory_stats stats;
 #endif
@@ -418,6 +490,11 @@ static void *heap_alloc_aligned(struct k_heap *h, size_t min_align, size_t bytes
 
 	key = k_spin_lock(&h->lock);
 	ret = sys_heap_aligned_alloc(&h->heap, min_align, bytes);
+#if CONFIG_SOF_HEAP_STATS
+	if (hs)
+		heap_stats_alloc(hs, ret ? sys_heap_usable_size(&h->heap, ret) : 0,
+				 k_cycle_get_32() - start);
+#endif
 	k_spin_unlock(&h->lock, key);
 
 #if CONFIG_SYS_HEAP_RUNTIME_STATS && CONFIG_IPC_MAJOR_4
@@ -459,6 +536,13 @@ static void heap_free(struct k_heap *h, void *mem)
 	}
 #endif
 
+#if CONFIG_SOF_HEAP_STATS
+	struct heap_stats *hs = heap_stats_of(h);
+
+	if (hs)
+		heap_stats_free(hs, sys_heap_usable_size(&h->heap, mem));
+#endif
+
 	sys_heap_free(&h->heap, mem);
 
 	k_spin_unlock(&h->lock, key);
@@ -821,11 +905,21 @@ void sof_heap_free(struct k_heap *heap, void *addr)
 static int heap_init(void)
 {
 	sys_heap_init(&sof_heap.heap, heapmem, HEAPMEM_SIZE - SHARED_BUFFER_HEAP_MEM_SIZE);
+#if CONFIG_SOF_HEAP_STATS && !defined(CONFIG_SOF_NATIVE_SIM_HOST_HEAP)
+	heap_stats_register(&sof_heap_stats, HEAP_STATS_SYSTEM, HEAP_STATS_SYSTEM_SOF,
+			    HEAPMEM_SIZE - SHARED_BUFFER_HEAP_MEM_SIZE,
+			    sof_heap_stats_largest_free);
+#endif
 
 #if CONFIG_SOF_USERSPACE_USE_SHARED_HEAP
 	shared_buffer_heap.heap.init_mem = shared_heapmem;
 	shared_buffer_heap.heap.init_bytes = SHARED_BUFFER_HEAP_MEM_SIZE;
 	sys_heap_init(&shared_buffer_heap.heap, shared_heapmem, SHARED_BUFFER_HEAP_MEM_SIZE);
+#if CONFIG_SOF_HEAP_STATS && !defined(CONFIG_SOF_NATIVE_SIM_HOST_HEAP)
+	heap_stats_register(&shared_buffer_heap_stats, HEAP_STATS_SYSTEM,
+			    HEAP_STATS_SYSTEM_SHARED_BUFFER, SHARED_BUFFER_HEAP_MEM_SIZE,
+			    shared_buffer_heap_stats_largest_free);
+#endif
 #endif
 
 #if CONFIG_L3_HEAP
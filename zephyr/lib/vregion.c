@@ -9,6 +9,7 @@
 #include <zephyr/init.h>
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <sof/lib/heap_stats.h>
 #include <sof/lib/vpage.h>
 #include <sof/lib/vregion.h>
 #include <rtos/alloc.h>
@@ -96,8 +97,36 @@ struct vregion {
 
 	/* lifetime heap */
 	struct vlinear_heap lifetime;	/* lifetime linear heap */
+
+#if CONFIG_SOF_HEAP_STATS
+	struct heap_stats stats;	/* usage and latency of both heaps */
+#endif
 };
 
+#if CONFIG_SOF_HEAP_STATS
+/* vregions are numbered in creation order in heap statistics */
+static atomic_t vregion_count;
+
+/* lifetime space left, or largest free interim block once it is created */
+static size_t vregion_largest_free(struct heap_stats *stats)
+{
+	struct vregion *vr = container_of(stats, struct vregion, stats);
+	size_t largest;
+
+	k_mutex_lock(&vr->lock, K_FOREVER);
+
+	if (vr->type == VREGION_MEM_TYPE_INTERIM)
+		largest = sof_heap_largest_free(&vr->interim.heap,
+						vr->interim.heap.heap.init_bytes);
+	else
+		largest = vr->lifetime.size - vr->lifetime.used;
+
+	k_mutex_unlock(&vr->lock);
+
+	return largest;
+}
+#endif
+
 /**
  * @brief Create a new virtual region instance.
  *
@@ -159,6 +188,11 @@ struct vregion *vregion_create(size_t memsize)
 	/* The creator is the first user */
 	vr->use_count = 1;
 
+#if CONFIG_SOF_HEAP_STATS
+	heap_stats_register(&vr->stats, HEAP_STATS_VREGION, atomic_inc(&vregion_count),
+			    total_size, vregion_largest_free);
+#endif
+
 	/* log the new vregion */
 	LOG_INF("new at base %p size %#zx pages %u metadata at %p",
 		(void *)vr->base, total_size, pages, (void *)vr);
@@ -203,6 +237,9 @@ struct vregion *vregion_put(struct vregion *vr)
 	/* log the vregion being destroyed */
 	LOG_DBG("destroy %p size %#zx pages %u", (void *)vr->base, vr->size, vr->pages);
 	LOG_DBG(" lifetime used %zu free count %d", vr->lifetime.used, vr->lifetime.free_count);
+#if CONFIG_SOF_HEAP_STATS
+	heap_stats_unregister(&vr->stats);
+#endif
 	vpage_free(vr->base);
 	rfree(vr);
 
@@ -379,14 +416,21 @@ void vregion_free(struct vregion *vr, void *ptr)
 	if (vr->type == VREGION_MEM_TYPE_INTERIM &&
 	    ptr >= (void *)vr->interim.heap.heap.init_mem &&
 	    ptr < (void *)((uint8_t *)vr->interim.heap.heap.init_mem +
-			   vr->interim.heap.heap.init_bytes))
+			   vr->interim.heap.heap.init_bytes)) {
+#if CONFIG_SOF_HEAP_STATS
+		heap_stats_free(&vr->stats, sys_heap_usable_size(&vr->interim.heap.heap, ptr));
+#endif
 		interim_free(&vr->interim, ptr);
-	else if (ptr >= (void *)vr->lifetime.base &&
-		   ptr < (void *)(vr->lifetime.base + vr->lifetime.size))
+	} else if (ptr >= (void *)vr->lifetime.base &&
+		   ptr < (void *)(vr->lifetime.base + vr->lifetime.size)) {
 		/* pointer is in lifetime area - no-op free */
+#if CONFIG_SOF_HEAP_STATS
+		heap_stats_free(&vr->stats, 0);
+#endif
 		lifetime_free(&vr->lifetime, ptr);
-	else
+	} else {
 		LOG_ERR("error: vregion free invalid pointer %p", ptr);
+	}
 
 	k_mutex_unlock(&vr->lock);
 }
@@ -403,6 +447,10 @@ EXPORT_SYMBOL(vregion_free);
  */
 void *vregion_alloc_align(struct vregion *vr, size_t size, size_t alignment)
 {
+#if CONFIG_SOF_HEAP_STATS
+	uint32_t start = k_cycle_get_32();
+#endif
+	size_t bytes = 0;
 	void *p;
 
 	if (!vr || !size)
@@ -416,15 +464,23 @@ void *vregion_alloc_align(struct vregion *vr, size_t size, size_t alignment)
 	switch (vr->type) {
 	case VREGION_MEM_TYPE_INTERIM:
 		p = interim_alloc(&vr->interim, size, alignment);
+		if (p)
+			bytes = sys_heap_usable_size(&vr->interim.heap.heap, p);
 		break;
 	case VREGION_MEM_TYPE_LIFETIME:
+		bytes = vr->lifetime.used;
 		p = lifetime_alloc(&vr->lifetime, size, alignment);
+		bytes = vr->lifetime.used - bytes;
 		break;
 	default:
 		LOG_ERR("error: invalid memory type %d", vr->type);
 		p = NULL;
 	}
 
+#if CONFIG_SOF_HEAP_STATS
+	heap_stats_alloc(&vr->stats, bytes, k_cycle_get_32() - start);
+#endif
+
 	k_mutex_unlock(&vr->lock);
 
 	return p;